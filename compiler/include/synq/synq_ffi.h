@@ -8,6 +8,8 @@
 #ifndef SYNQ_SYNQ_FFI_H
 #define SYNQ_SYNQ_FFI_H
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -65,6 +67,27 @@ synq_status synq_export_openqasm3(const synq_program* program,
                                   char** out_openqasm3,
                                   char** out_diagnostic);
 
+/*
+ * Receives `length` bytes of UTF-8 output, which are not NUL-terminated and
+ * are valid only for the duration of the call. Return 0 to continue; any
+ * other value stops the operation.
+ */
+typedef int (*synq_write_fn)(void* user_data, const char* utf8, size_t length);
+
+/*
+ * Exports the same subset as `synq_export_openqasm3`, passing the OpenQASM 3
+ * source to `write` in order, in chunks, instead of returning one allocated
+ * string, so output of any size needs no whole-program buffer. The program is
+ * validated before the first call: on SYNQ_STATUS_EXPORT_ERROR for an
+ * unsupported program `write` is never called. If `write` returns nonzero the
+ * export stops with SYNQ_STATUS_EXPORT_ERROR and the bytes already written
+ * are incomplete. Diagnostic ownership follows `synq_parse_file`.
+ */
+synq_status synq_export_openqasm3_to_writer(const synq_program* program,
+                                            synq_write_fn write,
+                                            void* user_data,
+                                            char** out_diagnostic);
+
 /* Releases a string allocated by this library. NULL is accepted. */
 void synq_string_free(char* value);
 
@@ -21,8 +21,46 @@
 // SOFTWARE.
 #include "ast.h"
 
-ProgramNode::~ProgramNode() {
-    for (ASTNode* stmt : statements) {
-        delete stmt;
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+
+// Large enough that a million-statement program needs only a few thousand
+// blocks; a node larger than this gets a block of its own.
+constexpr std::size_t kArenaBlockBytes = std::size_t{1} << 16;
+
+std::size_t padding_for(const unsigned char* cursor, std::size_t alignment) {
+    return (alignment - reinterpret_cast<std::uintptr_t>(cursor) % alignment) % alignment;
+}
+
+}  // namespace
+
+ASTArena::~ASTArena() {
+    for (auto node = nodes_.rbegin(); node != nodes_.rend(); ++node) (*node)->~ASTNode();
+}
+
+void ASTArena::reset() {
+    for (auto node = nodes_.rbegin(); node != nodes_.rend(); ++node) (*node)->~ASTNode();
+    nodes_.clear();
+    if (blocks_.empty()) return;
+    if (blocks_.size() > 1) blocks_.erase(blocks_.begin(), blocks_.end() - 1);
+    cursor_ = blocks_.back().get();
+    remaining_ = block_bytes_;
+}
+
+void* ASTArena::allocate(std::size_t size, std::size_t alignment) {
+    std::size_t padding = cursor_ == nullptr ? 0 : padding_for(cursor_, alignment);
+    if (cursor_ == nullptr || padding + size > remaining_) {
+        const std::size_t block_bytes = std::max(kArenaBlockBytes, size + alignment);
+        blocks_.emplace_back(new unsigned char[block_bytes]);
+        cursor_ = blocks_.back().get();
+        remaining_ = block_bytes;
+        block_bytes_ = block_bytes;
+        padding = padding_for(cursor_, alignment);
     }
+    unsigned char* storage = cursor_ + padding;
+    cursor_ = storage + size;
+    remaining_ -= padding + size;
+    return storage;
 }
\ No newline at end of file
@@ -23,16 +23,39 @@
 #define SYNQ_COMPILER_AST_H
 
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
 #include <optional>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "diagnostic.h"
 
+// Explicit node tag for the recovery-profile statement classes below. Passes
+// switch on `node_kind()` (or use `node_cast`) rather than probing with
+// dynamic_cast, so classifying a statement is one byte compare.
+enum class ASTNodeKind : std::uint8_t {
+    Program,
+    Instruction,
+    QuantumGate,
+    Measurement,
+    QubitDeclaration,
+    CallableDeclaration,
+    CallableCall,
+    ClassicalControl,
+    Declaration,
+    MutableDeclaration,
+    Assignment,
+};
+
 class ASTNode {
 public:
+    explicit ASTNode(ASTNodeKind node_kind) : node_kind_(node_kind) {}
     virtual ~ASTNode() {}
+    ASTNodeKind node_kind() const { return node_kind_; }
        virtual std::string profileQKernels() { return ""; }
        virtual std::string annotateWithAI() { return ""; }
        virtual std::string renderFlowGraph() { return ""; }
@@ -44,13 +67,76 @@ public:
        virtual std::string toJSON() { return ""; }
        virtual std::string toBinaryBlob() { return ""; }
        virtual std::string getName() { return ""; }
+
+private:
+    ASTNodeKind node_kind_;
+};
+
+// Returns `node` as `Node` when its tag matches, otherwise null.
+template <typename Node>
+Node* node_cast(ASTNode* node) {
+    return node != nullptr && node->node_kind() == Node::kNodeKind ? static_cast<Node*>(node) : nullptr;
+}
+
+template <typename Node>
+const Node* node_cast(const ASTNode* node) {
+    return node != nullptr && node->node_kind() == Node::kNodeKind ? static_cast<const Node*>(node) : nullptr;
+}
+
+// Bump allocator owning every node of one program. Nodes are placed back to
+// back in large blocks and are destroyed together, newest first, when the
+// arena is; a single node is never freed on its own.
+class ASTArena {
+public:
+    ASTArena() = default;
+    ~ASTArena();
+    ASTArena(const ASTArena&) = delete;
+    ASTArena& operator=(const ASTArena&) = delete;
+
+    template <typename Node, typename... Args>
+    Node* make(Args&&... args) {
+        static_assert(std::is_base_of_v<ASTNode, Node>, "the AST arena only holds AST nodes");
+        // Grow first so recording the node for destruction cannot throw.
+        if (nodes_.size() == nodes_.capacity()) nodes_.reserve(nodes_.empty() ? 64 : nodes_.size() * 2);
+        Node* node = new (allocate(sizeof(Node), alignof(Node))) Node(std::forward<Args>(args)...);
+        nodes_.push_back(node);
+        return node;
+    }
+
+    std::size_t node_count() const { return nodes_.size(); }
+
+    // Destroys every node and rewinds to the start of the current block, so a
+    // caller that consumes nodes as they are parsed reuses the same memory.
+    void reset();
+
+private:
+    void* allocate(std::size_t size, std::size_t alignment);
+
+    std::vector<std::unique_ptr<unsigned char[]>> blocks_;
+    unsigned char* cursor_ = nullptr;
+    std::size_t remaining_ = 0;
+    std::size_t block_bytes_ = 0;
+    std::vector<ASTNode*> nodes_;
 };
 
-// AST node for the root of a program (contains a list of statements).
+// AST node for the root of a program (contains a list of statements). Every
+// statement and nested body lives in `arena`; `statements` only orders them.
 class ProgramNode : public ASTNode {
 public:
+    static constexpr ASTNodeKind kNodeKind = ASTNodeKind::Program;
+
     std::vector<ASTNode*> statements;
-    ~ProgramNode();
+    ASTArena arena;
+
+    ProgramNode() : ASTNode(kNodeKind) {}
+
+    // Allocates a node in this program's arena and appends it as a statement.
+    template <typename Node, typename... Args>
+    Node* append(Args&&... args) {
+        Node* node = arena.make<Node>(std::forward<Args>(args)...);
+        statements.push_back(node);
+        return node;
+    }
 };
 
 // A deliberately small instruction node used by the recovery parser profile.
@@ -58,6 +144,8 @@ public:
 // it is not a complete SynQ language AST.
 class InstructionNode : public ASTNode {
 public:
+    static constexpr ASTNodeKind kNodeKind = ASTNodeKind::Instruction;
+
     std::string op;
     std::vector<std::string> args;
     std::size_t line = 0;
@@ -68,7 +156,7 @@ public:
 
     InstructionNode(std::string operation, std::vector<std::string> arguments, std::size_t line_number,
                     synq::compiler::SourceSpan source_span)
-        : op(std::move(operation)), args(std::move(arguments)), line(line_number), span(source_span) {}
+        : ASTNode(kNodeKind), op(std::move(operation)), args(std::move(arguments)), line(line_number), span(source_span) {}
 
     std::string toString() override {
         return op + (args.empty() ? "" : " " + args.front());
@@ -94,6 +182,8 @@ enum class QuantumGateKind {
 
 class QuantumGateNode : public ASTNode {
 public:
+    static constexpr ASTNodeKind kNodeKind = ASTNodeKind::QuantumGate;
+
     QuantumGateKind kind;
     std::string source_name;
     std::optional<std::string> literal_angle;
@@ -117,7 +207,7 @@ public:
                     std::size_t line_number,
                     synq::compiler::SourceSpan source_span,
                     std::vector<std::string> register_names = {})
-        : kind(gate_kind),
+        : ASTNode(kNodeKind), kind(gate_kind),
           source_name(std::move(original_name)),
           literal_angle(std::move(angle)),
           qubit_indices(std::move(operands)),
@@ -147,6 +237,8 @@ public:
 // value, execution, or classical control flow.
 class MeasurementNode : public ASTNode {
 public:
+    static constexpr ASTNodeKind kNodeKind = ASTNodeKind::Measurement;
+
     std::size_t qubit_index = 0;
     std::string qubit_register_name = "q";
     std::optional<std::string> result_name;
@@ -165,7 +257,7 @@ public:
                     synq::compiler::SourceSpan source_span,
                     std::optional<std::string> declared_result,
                     std::string source_register = "q", bool enable_feedback = false)
-        : qubit_index(index), qubit_register_name(std::move(source_register)),
+        : ASTNode(kNodeKind), qubit_index(index), qubit_register_name(std::move(source_register)),
           result_name(std::move(declared_result)), feedback_enabled(enable_feedback),
           line(line_number), span(source_span) {}
 
@@ -180,6 +272,8 @@ public:
 // not allocate runtime resources, model liveness, or validate later operands.
 class QubitDeclarationNode : public ASTNode {
 public:
+    static constexpr ASTNodeKind kNodeKind = ASTNodeKind::QubitDeclaration;
+
     std::string name;
     std::size_t qubit_count = 0;
     std::size_t line = 0;
@@ -187,7 +281,7 @@ public:
 
     QubitDeclarationNode(std::string identifier, std::size_t count, std::size_t line_number,
                          synq::compiler::SourceSpan source_span)
-        : name(std::move(identifier)), qubit_count(count), line(line_number), span(source_span) {}
+        : ASTNode(kNodeKind), name(std::move(identifier)), qubit_count(count), line(line_number), span(source_span) {}
 
     std::string toString() override {
         return "qubit " + name + "[" + std::to_string(qubit_count) + "]";
@@ -265,9 +359,12 @@ struct ParameterizedRoutineBody {
 };
 
 // Alpha callable metadata. The legacy declaration-only form keeps a null body;
-// the bounded kernel increment may attach exactly one typed quantum-gate body.
+// the bounded kernel increment may attach exactly one typed quantum-gate body,
+// allocated in the same program arena as the declaration.
 class CallableDeclarationNode : public ASTNode {
 public:
+    static constexpr ASTNodeKind kNodeKind = ASTNodeKind::CallableDeclaration;
+
     CallableDeclarationKind kind = CallableDeclarationKind::Function;
     std::string name;
     QuantumGateNode* body = nullptr;
@@ -280,14 +377,13 @@ public:
 
     CallableDeclarationNode(CallableDeclarationKind declaration_kind, std::string identifier,
                             std::size_t line_number, synq::compiler::SourceSpan source_span)
-        : kind(declaration_kind), name(std::move(identifier)), line(line_number), span(source_span) {}
+        : ASTNode(kNodeKind), kind(declaration_kind), name(std::move(identifier)), line(line_number), span(source_span) {}
 
     CallableDeclarationNode(CallableDeclarationKind declaration_kind, std::string identifier,
-                            QuantumGateNode* owned_body, std::size_t line_number,
+                            QuantumGateNode* arena_body, std::size_t line_number,
                             synq::compiler::SourceSpan source_span)
-        : kind(declaration_kind), name(std::move(identifier)), body(owned_body), line(line_number), span(source_span) {}
-
-    ~CallableDeclarationNode() override { delete body; }
+        : ASTNode(kNodeKind), kind(declaration_kind), name(std::move(identifier)), body(arena_body),
+          line(line_number), span(source_span) {}
 
     std::string toString() override {
         return std::string(kind == CallableDeclarationKind::Function ? "fn " : "kernel ") + name + "()";
@@ -298,17 +394,19 @@ public:
 // It has no values, arguments, runtime dispatch, stack frame, or execution.
 class CallableCallNode : public ASTNode {
 public:
+    static constexpr ASTNodeKind kNodeKind = ASTNodeKind::CallableCall;
+
     std::string name;
     std::vector<std::string> arguments;
     std::size_t line = 0;
     synq::compiler::SourceSpan span;
 
     CallableCallNode(std::string identifier, std::size_t line_number, synq::compiler::SourceSpan source_span)
-        : name(std::move(identifier)), line(line_number), span(source_span) {}
+        : ASTNode(kNodeKind), name(std::move(identifier)), line(line_number), span(source_span) {}
 
     CallableCallNode(std::string identifier, std::vector<std::string> actuals, std::size_t line_number,
                      synq::compiler::SourceSpan source_span)
-        : name(std::move(identifier)), arguments(std::move(actuals)), line(line_number), span(source_span) {}
+        : ASTNode(kNodeKind), name(std::move(identifier)), arguments(std::move(actuals)), line(line_number), span(source_span) {}
 
     std::string toString() override { return "call " + name + "()"; }
 };
@@ -378,6 +476,8 @@ struct ClassicalCondition {
 
 class ClassicalControlNode : public ASTNode {
 public:
+    static constexpr ASTNodeKind kNodeKind = ASTNodeKind::ClassicalControl;
+
     ClassicalControlKind kind;
     ClassicalCondition condition;
     ASTNode* body = nullptr;
@@ -385,18 +485,16 @@ public:
     std::size_t line = 0;
     synq::compiler::SourceSpan span;
 
-    ClassicalControlNode(ClassicalControlKind control_kind, ClassicalCondition typed_condition, ASTNode* owned_body,
+    ClassicalControlNode(ClassicalControlKind control_kind, ClassicalCondition typed_condition, ASTNode* arena_body,
                          std::size_t line_number, synq::compiler::SourceSpan source_span,
                          bool enable_feedback = false)
-        : kind(control_kind),
+        : ASTNode(kNodeKind), kind(control_kind),
           condition(std::move(typed_condition)),
-          body(owned_body),
+          body(arena_body),
           feedback_enabled(enable_feedback),
           line(line_number),
           span(source_span) {}
 
-    ~ClassicalControlNode() override { delete body; }
-
     std::string toString() override {
         return std::string(kind == ClassicalControlKind::If ? "if " : "while ") +
                condition.source_text + " " + (body == nullptr ? "" : body->toString());
@@ -422,6 +520,8 @@ enum class ClassicalLiteralKind {
 // while direct legacy construction defaults deliberately to SourceText.
 class DeclarationNode : public ASTNode {
 public:
+    static constexpr ASTNodeKind kNodeKind = ASTNodeKind::Declaration;
+
     std::string name;
     std::string value;
     ClassicalLiteralKind literal_kind = ClassicalLiteralKind::SourceText;
@@ -436,7 +536,7 @@ public:
 
     DeclarationNode(std::string identifier, std::string source_value, std::size_t line_number,
                     ClassicalLiteralKind kind, synq::compiler::SourceSpan source_span)
-        : name(std::move(identifier)), value(std::move(source_value)), literal_kind(kind), line(line_number),
+        : ASTNode(kNodeKind), name(std::move(identifier)), value(std::move(source_value)), literal_kind(kind), line(line_number),
           span(source_span) {}
 
     std::string toString() override {
@@ -449,6 +549,8 @@ public:
 // the separate bounded state evaluator.
 class MutableDeclarationNode : public ASTNode {
 public:
+    static constexpr ASTNodeKind kNodeKind = ASTNodeKind::MutableDeclaration;
+
     std::string name;
     std::string value;
     ClassicalLiteralKind literal_kind = ClassicalLiteralKind::SourceText;
@@ -457,7 +559,7 @@ public:
 
     MutableDeclarationNode(std::string identifier, std::string source_value, std::size_t line_number,
                            ClassicalLiteralKind kind, synq::compiler::SourceSpan source_span)
-        : name(std::move(identifier)), value(std::move(source_value)), literal_kind(kind), line(line_number),
+        : ASTNode(kNodeKind), name(std::move(identifier)), value(std::move(source_value)), literal_kind(kind), line(line_number),
           span(source_span) {}
 
     std::string toString() override { return "var " + name + " = " + value; }
@@ -467,6 +569,8 @@ public:
 // storage, aliases, compound assignment, or a general runtime.
 class AssignmentNode : public ASTNode {
 public:
+    static constexpr ASTNodeKind kNodeKind = ASTNodeKind::Assignment;
+
     std::string target;
     std::string value;
     ClassicalLiteralKind literal_kind = ClassicalLiteralKind::SourceText;
@@ -475,7 +579,7 @@ public:
 
     AssignmentNode(std::string identifier, std::string source_value, std::size_t line_number,
                    ClassicalLiteralKind kind, synq::compiler::SourceSpan source_span)
-        : target(std::move(identifier)), value(std::move(source_value)), literal_kind(kind), line(line_number),
+        : ASTNode(kNodeKind), target(std::move(identifier)), value(std::move(source_value)), literal_kind(kind), line(line_number),
           span(source_span) {}
 
     std::string toString() override { return "set " + target + " = " + value; }
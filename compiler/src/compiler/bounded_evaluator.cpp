@@ -1,8 +1,10 @@
 #include "bounded_evaluator.h"
 
+#include <array>
 #include <charconv>
+#include <functional>
 #include <limits>
-#include <map>
+#include <unordered_map>
 #include <utility>
 
 namespace synq::compiler {
@@ -25,7 +27,8 @@ struct EvaluationBudget {
     std::size_t operations = 0;
 };
 
-bool enter_expression(const SourceSpan& span, std::size_t depth, EvaluationBudget& budget, Diagnostic& diagnostic) {
+bool enter_expression(const SourceSpan& span, std::size_t depth, const EvaluationBudget& budget,
+                      Diagnostic& diagnostic) {
     if (depth > budget.max_depth) {
         diagnostic = error("SYNQ-E006", span, "bounded constant evaluation exceeds its expression-depth limit",
                            "reduce expression nesting or increase the explicitly configured depth limit");
@@ -44,6 +47,101 @@ bool consume_operation(const SourceSpan& span, EvaluationBudget& budget, Diagnos
     return true;
 }
 
+// Expression-tree failures, shared by the tree walker and the bytecode
+// compiler and interpreter so both engines report them identically.
+Diagnostic invalid_integer_literal(const SourceSpan& span) {
+    return error("SYNQ-E004", span, "invalid internal Integer literal in evaluation tree",
+                 "use a parser-produced bounded Integer expression tree");
+}
+
+Diagnostic invalid_integer_shape(const SourceSpan& span) {
+    return error("SYNQ-E004", span, "invalid internal Integer arithmetic tree shape",
+                 "use a parser-produced bounded Integer expression tree");
+}
+
+Diagnostic invalid_boolean_shape(const SourceSpan& span) {
+    return error("SYNQ-E004", span, "invalid internal Boolean expression tree shape",
+                 "use a parser-produced bounded Boolean expression tree");
+}
+
+Diagnostic unbound_integer_reference(const SourceSpan& span, const std::string& name) {
+    return error("SYNQ-E003", span, "Integer evaluation reference `" + name + "` has no prior evaluated Integer binding",
+                 "use an earlier supported Integer declaration");
+}
+
+Diagnostic unbound_boolean_reference(const SourceSpan& span, const std::string& name) {
+    return error("SYNQ-E003", span, "Boolean evaluation reference `" + name + "` has no prior evaluated Boolean binding",
+                 "use an earlier supported Boolean declaration");
+}
+
+Diagnostic integer_overflow(const SourceSpan& span) {
+    return error("SYNQ-E005", span, "Integer arithmetic is invalid or overflows int64",
+                 "use an in-range bounded Integer expression");
+}
+
+// Evaluated top-level bindings, one slot per program node. Every node these
+// evaluators accept sits before any U4 feedback pair, so its position is also
+// its Hybrid IR node index: the index name resolution records for each operand.
+// A slot stays empty until its binding has been evaluated.
+class RegisterFile {
+public:
+    explicit RegisterFile(std::size_t slots) : values_(slots), filled_(slots, false) {}
+
+    const BoundedValue* read(std::optional<std::size_t> slot) const {
+        if (!slot.has_value() || *slot >= values_.size() || !filled_[*slot]) return nullptr;
+        return &values_[*slot];
+    }
+
+    void write(std::size_t slot, BoundedValue value) {
+        values_[slot] = std::move(value);
+        filled_[slot] = true;
+    }
+
+private:
+    std::vector<BoundedValue> values_;
+    std::vector<bool> filled_;
+};
+
+// Identifier operands of one top-level expression tree. The evaluators visit
+// identifiers in the same depth-first order name resolution recorded their
+// binding indices, so each read takes the next recorded slot.
+class SlotOperands {
+public:
+    SlotOperands(const RegisterFile& registers, const std::vector<std::size_t>& binding_indices)
+        : registers_(registers), binding_indices_(binding_indices) {}
+
+    const BoundedValue* read(const std::string&) {
+        if (next_ >= binding_indices_.size()) return nullptr;
+        return registers_.read(binding_indices_[next_++]);
+    }
+
+private:
+    const RegisterFile& registers_;
+    const std::vector<std::size_t>& binding_indices_;
+    std::size_t next_ = 0;
+};
+
+// The formals of one local callable invocation, bound on the stack.
+class FrameOperands {
+public:
+    FrameOperands(const std::string& name, const BoundedValue& value) : names_{&name}, values_{&value}, count_(1) {}
+    FrameOperands(const std::string& first_name, const BoundedValue& first_value,
+                  const std::string& second_name, const BoundedValue& second_value)
+        : names_{&first_name, &second_name}, values_{&first_value, &second_value}, count_(2) {}
+
+    const BoundedValue* read(const std::string& name) const {
+        for (std::size_t index = 0; index < count_; ++index) {
+            if (*names_[index] == name) return values_[index];
+        }
+        return nullptr;
+    }
+
+private:
+    std::array<const std::string*, 2> names_{};
+    std::array<const BoundedValue*, 2> values_{};
+    std::size_t count_ = 0;
+};
+
 bool checked_arithmetic(ClassicalIntegerArithmeticExpressionKind kind, std::int64_t left, std::int64_t right,
                         std::int64_t& result) {
     constexpr auto minimum = std::numeric_limits<std::int64_t>::min();
@@ -70,50 +168,45 @@ bool checked_arithmetic(ClassicalIntegerArithmeticExpressionKind kind, std::int6
     }
 }
 
-bool evaluate_integer_tree(const ClassicalIntegerArithmeticExpression& expression,
-                           const std::map<std::string, BoundedValue>& values,
+template <typename Operands>
+bool evaluate_integer_tree(const ClassicalIntegerArithmeticExpression& expression, Operands& operands,
                            std::int64_t& result, EvaluationBudget& budget,
                            std::size_t depth, Diagnostic& diagnostic) {
     if (!enter_expression(expression.span, depth, budget, diagnostic)) return false;
     if (expression.kind == ClassicalIntegerArithmeticExpressionKind::IntegerLiteral) {
         if (!parse_integer(expression.source_text, result)) {
-            diagnostic = error("SYNQ-E004", expression.span, "invalid internal Integer literal in evaluation tree",
-                               "use a parser-produced bounded Integer expression tree");
+            diagnostic = invalid_integer_literal(expression.span);
             return false;
         }
         return true;
     }
     if (expression.kind == ClassicalIntegerArithmeticExpressionKind::IdentifierReference) {
-        const auto found = values.find(expression.source_text);
-        if (found == values.end() || found->second.kind != BoundedValueKind::Integer) {
-            diagnostic = error("SYNQ-E003", expression.span,
-                               "Integer evaluation reference `" + expression.source_text + "` has no prior evaluated Integer binding",
-                               "use an earlier supported Integer declaration");
+        const BoundedValue* found = operands.read(expression.source_text);
+        if (found == nullptr || found->kind != BoundedValueKind::Integer) {
+            diagnostic = unbound_integer_reference(expression.span, expression.source_text);
             return false;
         }
-        result = found->second.integer_value;
+        result = found->integer_value;
         return true;
     }
     if (expression.operands.size() != 2) {
-        diagnostic = error("SYNQ-E004", expression.span, "invalid internal Integer arithmetic tree shape",
-                           "use a parser-produced bounded Integer expression tree");
+        diagnostic = invalid_integer_shape(expression.span);
         return false;
     }
     std::int64_t left = 0;
     std::int64_t right = 0;
-    if (!evaluate_integer_tree(expression.operands[0], values, left, budget, depth + 1, diagnostic) ||
-        !evaluate_integer_tree(expression.operands[1], values, right, budget, depth + 1, diagnostic) ||
+    if (!evaluate_integer_tree(expression.operands[0], operands, left, budget, depth + 1, diagnostic) ||
+        !evaluate_integer_tree(expression.operands[1], operands, right, budget, depth + 1, diagnostic) ||
         !consume_operation(expression.span, budget, diagnostic)) return false;
     if (!checked_arithmetic(expression.kind, left, right, result)) {
-        diagnostic = error("SYNQ-E005", expression.span, "Integer arithmetic is invalid or overflows int64",
-                           "use an in-range bounded Integer expression");
+        diagnostic = integer_overflow(expression.span);
         return false;
     }
     return true;
 }
 
-bool evaluate_boolean_tree(const ClassicalBooleanExpression& expression,
-                           const std::map<std::string, BoundedValue>& values,
+template <typename Operands>
+bool evaluate_boolean_tree(const ClassicalBooleanExpression& expression, Operands& operands,
                            bool& result, EvaluationBudget& budget,
                            std::size_t depth, Diagnostic& diagnostic) {
     if (!enter_expression(expression.span, depth, budget, diagnostic)) return false;
@@ -122,37 +215,33 @@ bool evaluate_boolean_tree(const ClassicalBooleanExpression& expression,
         return true;
     }
     if (expression.kind == ClassicalBooleanExpressionKind::IdentifierReference) {
-        const auto found = values.find(expression.source_text);
-        if (found == values.end() || found->second.kind != BoundedValueKind::Boolean) {
-            diagnostic = error("SYNQ-E003", expression.span,
-                               "Boolean evaluation reference `" + expression.source_text + "` has no prior evaluated Boolean binding",
-                               "use an earlier supported Boolean declaration");
+        const BoundedValue* found = operands.read(expression.source_text);
+        if (found == nullptr || found->kind != BoundedValueKind::Boolean) {
+            diagnostic = unbound_boolean_reference(expression.span, expression.source_text);
             return false;
         }
-        result = found->second.boolean_value;
+        result = found->boolean_value;
         return true;
     }
     const std::size_t expected = expression.kind == ClassicalBooleanExpressionKind::Not ? 1 : 2;
     if (expression.operands.size() != expected) {
-        diagnostic = error("SYNQ-E004", expression.span, "invalid internal Boolean expression tree shape",
-                           "use a parser-produced bounded Boolean expression tree");
+        diagnostic = invalid_boolean_shape(expression.span);
         return false;
     }
     bool left = false;
-    if (!evaluate_boolean_tree(expression.operands[0], values, left, budget, depth + 1, diagnostic) ||
+    if (!evaluate_boolean_tree(expression.operands[0], operands, left, budget, depth + 1, diagnostic) ||
         !consume_operation(expression.span, budget, diagnostic)) return false;
     if (expression.kind == ClassicalBooleanExpressionKind::Not) {
         result = !left;
         return true;
     }
     bool right = false;
-    if (!evaluate_boolean_tree(expression.operands[1], values, right, budget, depth + 1, diagnostic)) return false;
+    if (!evaluate_boolean_tree(expression.operands[1], operands, right, budget, depth + 1, diagnostic)) return false;
     result = expression.kind == ClassicalBooleanExpressionKind::And ? left && right : left || right;
     return true;
 }
 
-bool evaluate_initializer(const ResolvedHybridDeclaration& declaration,
-                          const std::map<std::string, BoundedValue>& values,
+bool evaluate_initializer(const ResolvedHybridDeclaration& declaration, const RegisterFile& registers,
                           BoundedValue& value, EvaluationBudget& budget, Diagnostic& diagnostic) {
     const auto& initializer = declaration.declaration.initializer;
     switch (initializer.kind) {
@@ -179,14 +268,14 @@ bool evaluate_initializer(const ResolvedHybridDeclaration& declaration,
                                  initializer.source_text.substr(1, initializer.source_text.size() - 2)};
             return true;
         case ClassicalExpressionKind::IdentifierReference: {
-            const auto found = values.find(initializer.source_text);
-            if (found == values.end()) {
+            const BoundedValue* found = registers.read(declaration.initializer_binding_index);
+            if (found == nullptr) {
                 diagnostic = error("SYNQ-E003", initializer.span,
                                    "evaluation reference `" + initializer.source_text + "` has no prior evaluated binding",
                                    "use an earlier supported declaration");
                 return false;
             }
-            value = found->second;
+            value = *found;
             return true;
         }
         case ClassicalExpressionKind::IntegerArithmeticExpression: {
@@ -196,7 +285,8 @@ bool evaluate_initializer(const ResolvedHybridDeclaration& declaration,
                 return false;
             }
             std::int64_t parsed = 0;
-            if (!evaluate_integer_tree(*initializer.integer_arithmetic, values, parsed, budget, 1, diagnostic)) return false;
+            SlotOperands operands(registers, declaration.initializer_binding_indices);
+            if (!evaluate_integer_tree(*initializer.integer_arithmetic, operands, parsed, budget, 1, diagnostic)) return false;
             value = BoundedValue{BoundedValueKind::Integer, parsed, false, {}};
             return true;
         }
@@ -207,7 +297,8 @@ bool evaluate_initializer(const ResolvedHybridDeclaration& declaration,
                 return false;
             }
             bool parsed = false;
-            if (!evaluate_boolean_tree(*initializer.boolean_expression, values, parsed, budget, 1, diagnostic)) return false;
+            SlotOperands operands(registers, declaration.initializer_binding_indices);
+            if (!evaluate_boolean_tree(*initializer.boolean_expression, operands, parsed, budget, 1, diagnostic)) return false;
             value = BoundedValue{BoundedValueKind::Boolean, 0, parsed, {}};
             return true;
         }
@@ -223,8 +314,10 @@ bool evaluate_initializer(const ResolvedHybridDeclaration& declaration,
     return false;
 }
 
-bool evaluate_state_expression(const ClassicalExpression& expression,
-                               const std::map<std::string, BoundedValue>& values,
+// `binding_index` and `binding_indices` are the expression's resolved
+// whole-identifier binding and tree operand bindings.
+bool evaluate_state_expression(const ClassicalExpression& expression, std::optional<std::size_t> binding_index,
+                               const std::vector<std::size_t>& binding_indices, const RegisterFile& registers,
                                BoundedValue& value, EvaluationBudget& budget, Diagnostic& diagnostic) {
     switch (expression.kind) {
         case ClassicalExpressionKind::IntegerLiteral: {
@@ -250,14 +343,14 @@ bool evaluate_state_expression(const ClassicalExpression& expression,
                                  expression.source_text.substr(1, expression.source_text.size() - 2)};
             return true;
         case ClassicalExpressionKind::IdentifierReference: {
-            const auto found = values.find(expression.source_text);
-            if (found == values.end()) {
+            const BoundedValue* found = registers.read(binding_index);
+            if (found == nullptr) {
                 diagnostic = error("SYNQ-E010", expression.span,
                                    "state evaluation reference has no earlier evaluated binding",
                                    "use an earlier immutable declaration or mutable cell");
                 return false;
             }
-            value = found->second;
+            value = *found;
             return true;
         }
         case ClassicalExpressionKind::IntegerArithmeticExpression: {
@@ -267,7 +360,8 @@ bool evaluate_state_expression(const ClassicalExpression& expression,
                 return false;
             }
             std::int64_t parsed = 0;
-            if (!evaluate_integer_tree(*expression.integer_arithmetic, values, parsed, budget, 0, diagnostic)) return false;
+            SlotOperands operands(registers, binding_indices);
+            if (!evaluate_integer_tree(*expression.integer_arithmetic, operands, parsed, budget, 0, diagnostic)) return false;
             value = BoundedValue{BoundedValueKind::Integer, parsed, false, {}};
             return true;
         }
@@ -278,7 +372,8 @@ bool evaluate_state_expression(const ClassicalExpression& expression,
                 return false;
             }
             bool parsed = false;
-            if (!evaluate_boolean_tree(*expression.boolean_expression, values, parsed, budget, 0, diagnostic)) return false;
+            SlotOperands operands(registers, binding_indices);
+            if (!evaluate_boolean_tree(*expression.boolean_expression, operands, parsed, budget, 0, diagnostic)) return false;
             value = BoundedValue{BoundedValueKind::Boolean, 0, parsed, {}};
             return true;
         }
@@ -294,6 +389,378 @@ bool evaluate_state_expression(const ClassicalExpression& expression,
     return false;
 }
 
+// --eval-runtime compiles each expression tree it evaluates once, on first
+// use, into postfix bytecode over a value stack that holds
+// Integers and Booleans alike as int64. Instructions follow the order in which
+// the tree walker above visits a tree, so each check happens at the same
+// point. Failures the tree alone decides (the depth limit, a malformed literal
+// or shape) compile to a Fail instruction where the walker would stop.
+enum class RuntimeOpCode : std::uint8_t {
+    PushConstant,
+    LoadIntegerSlot,
+    LoadBooleanSlot,
+    LoadIntegerFormal,
+    LoadBooleanFormal,
+    Add,
+    Subtract,
+    Multiply,
+    ConsumeOperation,
+    Not,
+    And,
+    Or,
+    Fail,
+};
+
+// An identifier with no resolved slot or no matching formal.
+constexpr std::int64_t kNoOperandSource = -1;
+
+struct RuntimeInstruction {
+    // The constant, register slot, formal position, or failure index.
+    std::int64_t operand = 0;
+    // The RuntimeCode::sites entry naming the node a load or operation reports.
+    std::uint32_t site = 0;
+    RuntimeOpCode code = RuntimeOpCode::Fail;
+};
+
+struct RuntimeSite {
+    SourceSpan span;
+    std::string name;
+};
+
+struct RuntimeCode {
+    std::vector<RuntimeInstruction> instructions;
+    std::vector<RuntimeSite> sites;
+    std::vector<Diagnostic> failures;
+};
+
+// One compiled tree: instructions [begin, end) leave its value on the stack.
+struct RuntimeEntry {
+    std::size_t begin = 0;
+    std::size_t end = 0;
+    // Operations the tree consumes when it runs to completion.
+    std::size_t operations = 0;
+    std::size_t stack_depth = 0;
+    bool compiled = false;
+};
+
+class RuntimeCompiler {
+public:
+    RuntimeCompiler(RuntimeCode& code, std::size_t max_expression_depth) : code_(code) {
+        limits_.max_depth = max_expression_depth;
+    }
+
+    // Identifiers read the next of a top-level tree's resolved slots, in the
+    // order SlotOperands would take them.
+    void read_slots(const std::vector<std::size_t>& binding_indices) {
+        slots_ = &binding_indices;
+        next_slot_ = 0;
+        formal_count_ = 0;
+    }
+
+    // Identifiers read the formal they name, as FrameOperands would.
+    void read_formals(const std::string& first, const std::string* second) {
+        slots_ = nullptr;
+        formals_ = {&first, second};
+        formal_count_ = second == nullptr ? 1 : 2;
+    }
+
+    template <typename Expression>
+    RuntimeEntry compile(const Expression& expression, std::size_t depth) {
+        entry_ = RuntimeEntry{};
+        entry_.begin = code_.instructions.size();
+        height_ = 0;
+        visit(expression, depth);
+        entry_.end = code_.instructions.size();
+        entry_.compiled = true;
+        return entry_;
+    }
+
+private:
+    bool visit(const ClassicalIntegerArithmeticExpression& expression, std::size_t depth) {
+        Diagnostic diagnostic;
+        if (!enter_expression(expression.span, depth, limits_, diagnostic)) return fail(std::move(diagnostic));
+        if (expression.kind == ClassicalIntegerArithmeticExpressionKind::IntegerLiteral) {
+            std::int64_t value = 0;
+            if (!parse_integer(expression.source_text, value)) return fail(invalid_integer_literal(expression.span));
+            emit(RuntimeOpCode::PushConstant, value, 0);
+            return true;
+        }
+        if (expression.kind == ClassicalIntegerArithmeticExpressionKind::IdentifierReference) {
+            load(RuntimeOpCode::LoadIntegerSlot, RuntimeOpCode::LoadIntegerFormal, expression.span,
+                 expression.source_text);
+            return true;
+        }
+        if (expression.operands.size() != 2) return fail(invalid_integer_shape(expression.span));
+        if (!visit(expression.operands[0], depth + 1) || !visit(expression.operands[1], depth + 1)) return false;
+        ++entry_.operations;
+        switch (expression.kind) {
+            case ClassicalIntegerArithmeticExpressionKind::Add:
+                emit(RuntimeOpCode::Add, 0, site(expression.span, {}));
+                return true;
+            case ClassicalIntegerArithmeticExpressionKind::Subtract:
+                emit(RuntimeOpCode::Subtract, 0, site(expression.span, {}));
+                return true;
+            case ClassicalIntegerArithmeticExpressionKind::Multiply:
+                emit(RuntimeOpCode::Multiply, 0, site(expression.span, {}));
+                return true;
+            default:
+                emit(RuntimeOpCode::ConsumeOperation, 0, site(expression.span, {}));
+                return fail(integer_overflow(expression.span));
+        }
+    }
+
+    bool visit(const ClassicalBooleanExpression& expression, std::size_t depth) {
+        Diagnostic diagnostic;
+        if (!enter_expression(expression.span, depth, limits_, diagnostic)) return fail(std::move(diagnostic));
+        if (expression.kind == ClassicalBooleanExpressionKind::BooleanLiteral) {
+            emit(RuntimeOpCode::PushConstant, expression.boolean_value ? 1 : 0, 0);
+            return true;
+        }
+        if (expression.kind == ClassicalBooleanExpressionKind::IdentifierReference) {
+            load(RuntimeOpCode::LoadBooleanSlot, RuntimeOpCode::LoadBooleanFormal, expression.span,
+                 expression.source_text);
+            return true;
+        }
+        const bool negation = expression.kind == ClassicalBooleanExpressionKind::Not;
+        if (expression.operands.size() != (negation ? 1U : 2U)) return fail(invalid_boolean_shape(expression.span));
+        if (!visit(expression.operands[0], depth + 1)) return false;
+        ++entry_.operations;
+        emit(RuntimeOpCode::ConsumeOperation, 0, site(expression.span, {}));
+        if (negation) {
+            emit(RuntimeOpCode::Not, 0, 0);
+            return true;
+        }
+        if (!visit(expression.operands[1], depth + 1)) return false;
+        emit(expression.kind == ClassicalBooleanExpressionKind::And ? RuntimeOpCode::And : RuntimeOpCode::Or, 0, 0);
+        return true;
+    }
+
+    void load(RuntimeOpCode slot_code, RuntimeOpCode formal_code, const SourceSpan& span, const std::string& name) {
+        std::int64_t source = kNoOperandSource;
+        if (slots_ != nullptr) {
+            if (next_slot_ < slots_->size()) source = static_cast<std::int64_t>((*slots_)[next_slot_++]);
+            emit(slot_code, source, site(span, name));
+            return;
+        }
+        for (std::size_t index = 0; index < formal_count_; ++index) {
+            if (*formals_[index] == name) {
+                source = static_cast<std::int64_t>(index);
+                break;
+            }
+        }
+        emit(formal_code, source, site(span, name));
+    }
+
+    std::uint32_t site(const SourceSpan& span, std::string name) {
+        code_.sites.push_back({span, std::move(name)});
+        return static_cast<std::uint32_t>(code_.sites.size() - 1);
+    }
+
+    bool fail(Diagnostic diagnostic) {
+        code_.failures.push_back(std::move(diagnostic));
+        emit(RuntimeOpCode::Fail, static_cast<std::int64_t>(code_.failures.size() - 1), 0);
+        return false;
+    }
+
+    void emit(RuntimeOpCode code, std::int64_t operand, std::uint32_t site_index) {
+        code_.instructions.push_back({operand, site_index, code});
+        switch (code) {
+            case RuntimeOpCode::PushConstant:
+            case RuntimeOpCode::LoadIntegerSlot:
+            case RuntimeOpCode::LoadBooleanSlot:
+            case RuntimeOpCode::LoadIntegerFormal:
+            case RuntimeOpCode::LoadBooleanFormal:
+                ++height_;
+                if (height_ > entry_.stack_depth) entry_.stack_depth = height_;
+                break;
+            case RuntimeOpCode::Add:
+            case RuntimeOpCode::Subtract:
+            case RuntimeOpCode::Multiply:
+            case RuntimeOpCode::And:
+            case RuntimeOpCode::Or:
+                --height_;
+                break;
+            default:
+                break;
+        }
+    }
+
+    RuntimeCode& code_;
+    EvaluationBudget limits_;
+    RuntimeEntry entry_;
+    std::size_t height_ = 0;
+    const std::vector<std::size_t>* slots_ = nullptr;
+    std::size_t next_slot_ = 0;
+    std::array<const std::string*, 2> formals_{};
+    std::size_t formal_count_ = 0;
+};
+
+// The compiled trees of one --eval-runtime program, run against the driver's
+// register file. Slot by slot it holds a declaration's top-level initializer
+// tree or a local function's body, compiled when the driver first reaches it;
+// the driver still makes every check that precedes a tree in the order the
+// tree walker does.
+class RuntimeEngine {
+public:
+    RuntimeEngine(const ResolvedHybridProgram& program, std::size_t max_expression_depth,
+                  const RegisterFile& registers)
+        : program_(program), compiler_(code_, max_expression_depth), entries_(program.nodes.size()),
+          visited_(program.nodes.size(), false), registers_(registers) {}
+
+    // Compiles the slot's tree on first use. Not `compiled` when the slot
+    // holds no tree or its body does not parse.
+    const RuntimeEntry& entry(std::size_t slot) {
+        if (!visited_[slot]) {
+            visited_[slot] = true;
+            compile_slot(slot);
+            if (entries_[slot].stack_depth > stack_.size()) stack_.resize(entries_[slot].stack_depth);
+        }
+        return entries_[slot];
+    }
+
+    bool run(const RuntimeEntry& entry, const std::array<const BoundedValue*, 2>& formals, EvaluationBudget& budget,
+             std::int64_t& result, Diagnostic& diagnostic) {
+        // A tree that cannot reach the operation limit skips the per-operation
+        // check and is charged its whole count at once.
+        if (entry.operations <= budget.max_operations - budget.operations) {
+            if (!execute<false>(entry, formals, budget, result, diagnostic)) return false;
+            budget.operations += entry.operations;
+            return true;
+        }
+        return execute<true>(entry, formals, budget, result, diagnostic);
+    }
+
+private:
+    void compile_slot(std::size_t slot) {
+        if (const auto* declaration = std::get_if<ResolvedHybridDeclaration>(&program_.nodes[slot])) {
+            const ClassicalExpression& initializer = declaration->declaration.initializer;
+            compiler_.read_slots(declaration->initializer_binding_indices);
+            if (initializer.kind == ClassicalExpressionKind::IntegerArithmeticExpression &&
+                initializer.integer_arithmetic.has_value()) {
+                entries_[slot] = compiler_.compile(*initializer.integer_arithmetic, 0);
+            } else if (initializer.kind == ClassicalExpressionKind::BooleanExpression &&
+                       initializer.boolean_expression.has_value()) {
+                entries_[slot] = compiler_.compile(*initializer.boolean_expression, 0);
+            }
+        } else if (const auto* callable = std::get_if<HybridCallableDeclaration>(&program_.nodes[slot])) {
+            if (callable->classical_body.has_value()) {
+                const ClassicalCallableBody& body = *callable->classical_body;
+                compiler_.read_formals(body.parameter_name, nullptr);
+                compile_body(slot, body.parameter_type, body.source_expression, body.span);
+            } else if (callable->binary_classical_body.has_value()) {
+                const BinaryClassicalCallableBody& body = *callable->binary_classical_body;
+                compiler_.read_formals(body.first_parameter_name, &body.second_parameter_name);
+                compile_body(slot, body.parameter_type, body.source_expression, body.span);
+            }
+        }
+    }
+
+    void compile_body(std::size_t slot, ClassicalCallableValueType type,
+                      const std::string& source, const SourceSpan& span) {
+        if (type == ClassicalCallableValueType::Integer) {
+            ClassicalIntegerArithmeticExpression expression;
+            if (parse_bounded_integer_arithmetic_expression(source, span, expression)) {
+                entries_[slot] = compiler_.compile(expression, 1);
+            }
+        } else if (type == ClassicalCallableValueType::Boolean) {
+            ClassicalBooleanExpression expression;
+            if (parse_bounded_boolean_declaration_expression(source, span, expression)) {
+                entries_[slot] = compiler_.compile(expression, 1);
+            }
+        }
+    }
+
+    template <bool kCheckOperations>
+    bool execute(const RuntimeEntry& entry, const std::array<const BoundedValue*, 2>& formals,
+                 EvaluationBudget& budget, std::int64_t& result, Diagnostic& diagnostic) {
+        const RuntimeInstruction* instructions = code_.instructions.data();
+        std::int64_t* top = stack_.data();
+        const auto formal = [&formals](std::int64_t position) -> const BoundedValue* {
+            return position >= 0 && position < 2 ? formals[static_cast<std::size_t>(position)] : nullptr;
+        };
+        for (std::size_t pc = entry.begin; pc < entry.end; ++pc) {
+            const RuntimeInstruction& instruction = instructions[pc];
+            switch (instruction.code) {
+                case RuntimeOpCode::PushConstant:
+                    *top++ = instruction.operand;
+                    break;
+                case RuntimeOpCode::LoadIntegerSlot:
+                case RuntimeOpCode::LoadIntegerFormal: {
+                    const BoundedValue* found = instruction.code == RuntimeOpCode::LoadIntegerSlot
+                        ? registers_.read(static_cast<std::size_t>(instruction.operand))
+                        : formal(instruction.operand);
+                    if (found == nullptr || found->kind != BoundedValueKind::Integer) {
+                        const RuntimeSite& site = code_.sites[instruction.site];
+                        diagnostic = unbound_integer_reference(site.span, site.name);
+                        return false;
+                    }
+                    *top++ = found->integer_value;
+                    break;
+                }
+                case RuntimeOpCode::LoadBooleanSlot:
+                case RuntimeOpCode::LoadBooleanFormal: {
+                    const BoundedValue* found = instruction.code == RuntimeOpCode::LoadBooleanSlot
+                        ? registers_.read(static_cast<std::size_t>(instruction.operand))
+                        : formal(instruction.operand);
+                    if (found == nullptr || found->kind != BoundedValueKind::Boolean) {
+                        const RuntimeSite& site = code_.sites[instruction.site];
+                        diagnostic = unbound_boolean_reference(site.span, site.name);
+                        return false;
+                    }
+                    *top++ = found->boolean_value ? 1 : 0;
+                    break;
+                }
+                case RuntimeOpCode::Add:
+                case RuntimeOpCode::Subtract:
+                case RuntimeOpCode::Multiply: {
+                    const SourceSpan& span = code_.sites[instruction.site].span;
+                    if (kCheckOperations && !consume_operation(span, budget, diagnostic)) return false;
+                    const auto kind = instruction.code == RuntimeOpCode::Add
+                        ? ClassicalIntegerArithmeticExpressionKind::Add
+                        : instruction.code == RuntimeOpCode::Subtract ? ClassicalIntegerArithmeticExpressionKind::Subtract
+                                                                      : ClassicalIntegerArithmeticExpressionKind::Multiply;
+                    const std::int64_t right = *--top;
+                    if (!checked_arithmetic(kind, top[-1], right, top[-1])) {
+                        diagnostic = integer_overflow(span);
+                        return false;
+                    }
+                    break;
+                }
+                case RuntimeOpCode::ConsumeOperation:
+                    if (kCheckOperations &&
+                        !consume_operation(code_.sites[instruction.site].span, budget, diagnostic)) return false;
+                    break;
+                case RuntimeOpCode::Not:
+                    top[-1] = top[-1] == 0 ? 1 : 0;
+                    break;
+                case RuntimeOpCode::And: {
+                    const std::int64_t right = *--top;
+                    top[-1] = top[-1] != 0 && right != 0 ? 1 : 0;
+                    break;
+                }
+                case RuntimeOpCode::Or: {
+                    const std::int64_t right = *--top;
+                    top[-1] = top[-1] != 0 || right != 0 ? 1 : 0;
+                    break;
+                }
+                case RuntimeOpCode::Fail:
+                    diagnostic = code_.failures[static_cast<std::size_t>(instruction.operand)];
+                    return false;
+            }
+        }
+        result = top[-1];
+        return true;
+    }
+
+    const ResolvedHybridProgram& program_;
+    RuntimeCode code_;
+    RuntimeCompiler compiler_;
+    std::vector<RuntimeEntry> entries_;
+    std::vector<bool> visited_;
+    std::vector<std::int64_t> stack_;
+    const RegisterFile& registers_;
+};
+
 BoundedValueKind bounded_kind_for_callable_type(ClassicalCallableValueType type) {
     switch (type) {
         case ClassicalCallableValueType::Integer: return BoundedValueKind::Integer;
@@ -304,7 +771,7 @@ BoundedValueKind bounded_kind_for_callable_type(ClassicalCallableValueType type)
 }
 
 bool evaluate_callable_actual(const ClassicalCallableInvocation& invocation,
-                              const std::map<std::string, BoundedValue>& values,
+                              std::optional<std::size_t> binding_index, const RegisterFile& registers,
                               BoundedValue& value, Diagnostic& diagnostic) {
     if (invocation.actual_kind == ClassicalLiteralKind::Integer) {
         std::int64_t parsed = 0;
@@ -330,20 +797,19 @@ bool evaluate_callable_actual(const ClassicalCallableInvocation& invocation,
                  invocation.actual_source.substr(1, invocation.actual_source.size() - 2)};
         return true;
     }
-    const auto binding = values.find(invocation.actual_source);
-    if (invocation.actual_kind != ClassicalLiteralKind::SourceText || binding == values.end()) {
+    const BoundedValue* binding = registers.read(binding_index);
+    if (invocation.actual_kind != ClassicalLiteralKind::SourceText || binding == nullptr) {
         diagnostic = error("SYNQ-E013", invocation.span, "U5 callable actual has no evaluated immutable binding",
                            "use one earlier immutable binding or a supported literal actual");
         return false;
     }
-    value = binding->second;
+    value = *binding;
     return true;
 }
 
 bool evaluate_binary_callable_actual(const std::string& source, ClassicalLiteralKind kind,
-                                    const SourceSpan& span,
-                                    const std::map<std::string, BoundedValue>& values,
-                                    BoundedValue& value, Diagnostic& diagnostic) {
+                                    const SourceSpan& span, std::optional<std::size_t> binding_index,
+                                    const RegisterFile& registers, BoundedValue& value, Diagnostic& diagnostic) {
     if (kind == ClassicalLiteralKind::Integer) {
         std::int64_t parsed = 0;
         if (!parse_integer(source, parsed)) {
@@ -358,18 +824,20 @@ bool evaluate_binary_callable_actual(const std::string& source, ClassicalLiteral
         value = {BoundedValueKind::Boolean, 0, source == "true", {}};
         return true;
     }
-    const auto binding = values.find(source);
-    if (kind != ClassicalLiteralKind::SourceText || binding == values.end()) {
+    const BoundedValue* binding = registers.read(binding_index);
+    if (kind != ClassicalLiteralKind::SourceText || binding == nullptr) {
         diagnostic = error("SYNQ-E015", span, "U6 binary callable actual has no evaluated immutable binding",
                            "use an earlier immutable binding or a supported Integer or Boolean literal actual");
         return false;
     }
-    value = binding->second;
+    value = *binding;
     return true;
 }
 
-bool evaluate_classical_callable(const HybridCallableDeclaration& callable,
-                                 const BoundedValue& actual, BoundedValue& result,
+// `engine`, when present, runs the body compiled for the callable defined at
+// `callable_slot` in place of parsing and walking it.
+bool evaluate_classical_callable(const HybridCallableDeclaration& callable, std::size_t callable_slot,
+                                 const BoundedValue& actual, BoundedValue& result, RuntimeEngine* engine,
                                  EvaluationBudget& budget, Diagnostic& diagnostic) {
     if (!callable.classical_body.has_value()) {
         diagnostic = error("SYNQ-E013", callable.span, "runtime received a callable without a U5 local body",
@@ -382,21 +850,23 @@ bool evaluate_classical_callable(const HybridCallableDeclaration& callable,
                            "use a resolver-produced exact-type callable invocation");
         return false;
     }
-    std::map<std::string, BoundedValue> frame;
-    frame.emplace(body.parameter_name, actual);
+    FrameOperands frame(body.parameter_name, actual);
+    const RuntimeEntry* compiled = engine != nullptr ? &engine->entry(callable_slot) : nullptr;
     if (body.parameter_type == ClassicalCallableValueType::Integer) {
         if (body.source_expression == body.parameter_name) {
             result = actual;
             return true;
         }
         ClassicalIntegerArithmeticExpression expression;
-        if (!parse_bounded_integer_arithmetic_expression(body.source_expression, body.span, expression)) {
+        if (compiled != nullptr ? !compiled->compiled
+                                : !parse_bounded_integer_arithmetic_expression(body.source_expression, body.span, expression)) {
             diagnostic = error("SYNQ-E013", body.span, "runtime received an invalid U5 Integer callable body",
                                "use a resolver-produced parameter plus/minus/times Integer-literal body");
             return false;
         }
         std::int64_t value = 0;
-        if (!evaluate_integer_tree(expression, frame, value, budget, 1, diagnostic)) return false;
+        if (compiled != nullptr ? !engine->run(*compiled, {&actual, nullptr}, budget, value, diagnostic)
+                                : !evaluate_integer_tree(expression, frame, value, budget, 1, diagnostic)) return false;
         result = {BoundedValueKind::Integer, value, false, {}};
         return true;
     }
@@ -406,13 +876,20 @@ bool evaluate_classical_callable(const HybridCallableDeclaration& callable,
             return true;
         }
         ClassicalBooleanExpression expression;
-        if (!parse_bounded_boolean_declaration_expression(body.source_expression, body.span, expression)) {
+        if (compiled != nullptr ? !compiled->compiled
+                                : !parse_bounded_boolean_declaration_expression(body.source_expression, body.span, expression)) {
             diagnostic = error("SYNQ-E013", body.span, "runtime received an invalid U5 Boolean callable body",
                                "use a resolver-produced parameter or not-parameter body");
             return false;
         }
         bool value = false;
-        if (!evaluate_boolean_tree(expression, frame, value, budget, 1, diagnostic)) return false;
+        if (compiled != nullptr) {
+            std::int64_t word = 0;
+            if (!engine->run(*compiled, {&actual, nullptr}, budget, word, diagnostic)) return false;
+            value = word != 0;
+        } else if (!evaluate_boolean_tree(expression, frame, value, budget, 1, diagnostic)) {
+            return false;
+        }
         result = {BoundedValueKind::Boolean, 0, value, {}};
         return true;
     }
@@ -425,10 +902,10 @@ bool evaluate_classical_callable(const HybridCallableDeclaration& callable,
     return false;
 }
 
-bool evaluate_binary_classical_callable(const HybridCallableDeclaration& callable,
+bool evaluate_binary_classical_callable(const HybridCallableDeclaration& callable, std::size_t callable_slot,
                                         const BoundedValue& first_actual,
                                         const BoundedValue& second_actual,
-                                        BoundedValue& result,
+                                        BoundedValue& result, RuntimeEngine* engine,
                                         EvaluationBudget& budget, Diagnostic& diagnostic) {
     if (!callable.binary_classical_body.has_value() || callable.classical_body.has_value()) {
         diagnostic = error("SYNQ-E015", callable.span, "runtime received a callable without a U6 binary local body",
@@ -443,33 +920,110 @@ bool evaluate_binary_classical_callable(const HybridCallableDeclaration& callabl
                            "use a resolver-produced exact-type two-actual callable invocation");
         return false;
     }
-    std::map<std::string, BoundedValue> frame;
-    frame.emplace(body.first_parameter_name, first_actual);
-    frame.emplace(body.second_parameter_name, second_actual);
+    FrameOperands frame(body.first_parameter_name, first_actual, body.second_parameter_name, second_actual);
+    const RuntimeEntry* compiled = engine != nullptr ? &engine->entry(callable_slot) : nullptr;
     if (body.parameter_type == ClassicalCallableValueType::Integer) {
         ClassicalIntegerArithmeticExpression expression;
-        if (!parse_bounded_integer_arithmetic_expression(body.source_expression, body.span, expression)) {
+        if (compiled != nullptr ? !compiled->compiled
+                                : !parse_bounded_integer_arithmetic_expression(body.source_expression, body.span, expression)) {
             diagnostic = error("SYNQ-E015", body.span, "runtime received an invalid U6 Integer callable body",
                                "use a resolver-produced first-formal plus/minus/times second-formal body");
             return false;
         }
         std::int64_t value = 0;
-        if (!evaluate_integer_tree(expression, frame, value, budget, 1, diagnostic)) return false;
+        if (compiled != nullptr ? !engine->run(*compiled, {&first_actual, &second_actual}, budget, value, diagnostic)
+                                : !evaluate_integer_tree(expression, frame, value, budget, 1, diagnostic)) return false;
         result = {BoundedValueKind::Integer, value, false, {}};
         return true;
     }
     ClassicalBooleanExpression expression;
-    if (!parse_bounded_boolean_declaration_expression(body.source_expression, body.span, expression)) {
+    if (compiled != nullptr ? !compiled->compiled
+                            : !parse_bounded_boolean_declaration_expression(body.source_expression, body.span, expression)) {
         diagnostic = error("SYNQ-E015", body.span, "runtime received an invalid U6 Boolean callable body",
                            "use a resolver-produced first-formal and/or second-formal body");
         return false;
     }
     bool value = false;
-    if (!evaluate_boolean_tree(expression, frame, value, budget, 1, diagnostic)) return false;
+    if (compiled != nullptr) {
+        std::int64_t word = 0;
+        if (!engine->run(*compiled, {&first_actual, &second_actual}, budget, word, diagnostic)) return false;
+        value = word != 0;
+    } else if (!evaluate_boolean_tree(expression, frame, value, budget, 1, diagnostic)) {
+        return false;
+    }
     result = {BoundedValueKind::Boolean, 0, value, {}};
     return true;
 }
 
+// Results of earlier successful local function calls within one runtime
+// evaluation, keyed by the defining slot and the Integer or Boolean actuals.
+// Holds at most one entry per invocation, so max_callable_invocations bounds it.
+class InvocationMemo {
+public:
+    struct Key {
+        std::size_t callable_slot = 0;
+        std::array<BoundedValueKind, 2> kinds{};
+        std::array<std::int64_t, 2> actuals{};
+
+        bool operator==(const Key& other) const {
+            return callable_slot == other.callable_slot && kinds == other.kinds && actuals == other.actuals;
+        }
+    };
+
+    // False when an actual is a String, which is never memoized.
+    static bool make_key(std::size_t callable_slot, const BoundedValue& first, const BoundedValue* second, Key& key) {
+        key.callable_slot = callable_slot;
+        const BoundedValue* actuals[] = {&first, second};
+        for (std::size_t index = 0; index < 2; ++index) {
+            if (actuals[index] == nullptr) continue;
+            const BoundedValue& actual = *actuals[index];
+            if (actual.kind == BoundedValueKind::String) return false;
+            key.kinds[index] = actual.kind;
+            key.actuals[index] = actual.kind == BoundedValueKind::Integer ? actual.integer_value
+                                                                          : static_cast<std::int64_t>(actual.boolean_value);
+        }
+        return true;
+    }
+
+    // Replays a memoized call: charges the operations it consumed and returns
+    // its value. Returns false when the call is new, or when charging it would
+    // exceed the operation limit and the caller must evaluate it to fail at
+    // the exact operation.
+    bool replay(const Key& key, EvaluationBudget& budget, BoundedValue& value) const {
+        const auto found = calls_.find(key);
+        if (found == calls_.end() || found->second.operations > budget.max_operations - budget.operations) {
+            return false;
+        }
+        budget.operations += found->second.operations;
+        value = found->second.value;
+        return true;
+    }
+
+    void record(const Key& key, const BoundedValue& value, std::size_t operations) {
+        calls_.emplace(key, Call{value, operations});
+    }
+
+private:
+    struct Call {
+        BoundedValue value;
+        std::size_t operations = 0;
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            std::size_t hash = std::hash<std::size_t>{}(key.callable_slot);
+            for (std::size_t index = 0; index < 2; ++index) {
+                const auto word = static_cast<std::uint64_t>(key.actuals[index]) * 2U +
+                                  (key.kinds[index] == BoundedValueKind::Boolean ? 1U : 0U);
+                hash = hash * 0x100000001b3ULL ^ std::hash<std::uint64_t>{}(word);
+            }
+            return hash;
+        }
+    };
+
+    std::unordered_map<Key, Call, KeyHash> calls_;
+};
+
 }  // namespace
 
 bool BoundedEvaluationResult::ok() const { return evaluation.has_value() && diagnostics.empty(); }
@@ -501,10 +1055,10 @@ BoundedEvaluationResult evaluate_bounded_constants(const ResolvedHybridProgram&
         return result;
     }
     BoundedEvaluation evaluation;
-    std::map<std::string, BoundedValue> values;
+    RegisterFile registers(program.nodes.size());
     EvaluationBudget budget{options.max_expression_depth, options.max_operations, 0};
-    for (const auto& node : program.nodes) {
-        const auto* declaration = std::get_if<ResolvedHybridDeclaration>(&node);
+    for (std::size_t slot = 0; slot < program.nodes.size(); ++slot) {
+        const auto* declaration = std::get_if<ResolvedHybridDeclaration>(&program.nodes[slot]);
         if (declaration == nullptr) {
             result.diagnostics.push_back(error("SYNQ-E002", {},
                                                "bounded constant evaluation accepts declarations only",
@@ -513,11 +1067,11 @@ BoundedEvaluationResult evaluate_bounded_constants(const ResolvedHybridProgram&
         }
         BoundedValue value;
         Diagnostic diagnostic;
-        if (!evaluate_initializer(*declaration, values, value, budget, diagnostic)) {
+        if (!evaluate_initializer(*declaration, registers, value, budget, diagnostic)) {
             result.diagnostics.push_back(std::move(diagnostic));
             return result;
         }
-        values.emplace(declaration->declaration.name, value);
+        registers.write(slot, value);
         evaluation.bindings.push_back(EvaluatedBinding{declaration->declaration.name, std::move(value),
                                                        declaration->declaration.span});
     }
@@ -535,8 +1089,10 @@ BoundedStateEvaluationResult evaluate_bounded_state(const ResolvedHybridProgram&
     }
 
     BoundedStateEvaluation evaluation;
-    std::map<std::string, BoundedValue> values;
-    std::map<std::string, std::size_t> cell_indices;
+    RegisterFile registers(program.nodes.size());
+    // The cell each mutable-declaration slot owns in `evaluation.cells`.
+    constexpr std::size_t kNoCell = static_cast<std::size_t>(-1);
+    std::vector<std::size_t> cell_indices(program.nodes.size(), kNoCell);
     EvaluationBudget budget{options.max_expression_depth, options.max_operations, 0};
     std::size_t transitions = 0;
     const auto consume_transition = [&](const SourceSpan& span) -> bool {
@@ -550,15 +1106,19 @@ BoundedStateEvaluationResult evaluate_bounded_state(const ResolvedHybridProgram&
         return true;
     };
 
-    for (const ResolvedHybridNode& node : program.nodes) {
+    for (std::size_t slot = 0; slot < program.nodes.size(); ++slot) {
+        const ResolvedHybridNode& node = program.nodes[slot];
         if (const auto* declaration = std::get_if<ResolvedHybridDeclaration>(&node)) {
             BoundedValue value;
             Diagnostic diagnostic;
-            if (!evaluate_state_expression(declaration->declaration.initializer, values, value, budget, diagnostic)) {
+            if (!evaluate_state_expression(declaration->declaration.initializer,
+                                           declaration->initializer_binding_index,
+                                           declaration->initializer_binding_indices, registers, value, budget,
+                                           diagnostic)) {
                 result.diagnostics.push_back(std::move(diagnostic));
                 return result;
             }
-            values.emplace(declaration->declaration.name, std::move(value));
+            registers.write(slot, std::move(value));
             continue;
         }
 
@@ -571,21 +1131,25 @@ BoundedStateEvaluationResult evaluate_bounded_state(const ResolvedHybridProgram&
             }
             BoundedValue value;
             Diagnostic diagnostic;
-            if (!evaluate_state_expression(declaration->declaration.initializer, values, value, budget, diagnostic)) {
+            if (!evaluate_state_expression(declaration->declaration.initializer,
+                                           declaration->initializer_binding_index,
+                                           declaration->initializer_binding_indices, registers, value, budget,
+                                           diagnostic)) {
                 result.diagnostics.push_back(std::move(diagnostic));
                 return result;
             }
             if (!consume_transition(declaration->declaration.span)) return result;
-            cell_indices.emplace(declaration->declaration.name, evaluation.cells.size());
-            values.emplace(declaration->declaration.name, value);
+            cell_indices[slot] = evaluation.cells.size();
+            registers.write(slot, value);
             evaluation.cells.push_back({declaration->declaration.name, std::move(value), declaration->declaration.span,
                                         declaration->declaration.span});
             continue;
         }
 
         if (const auto* assignment = std::get_if<ResolvedHybridAssignment>(&node)) {
-            const auto cell = cell_indices.find(assignment->assignment.target_name);
-            if (cell == cell_indices.end()) {
+            const std::size_t target = assignment->target_binding_index;
+            const std::size_t cell = target < cell_indices.size() ? cell_indices[target] : kNoCell;
+            if (cell == kNoCell) {
                 result.diagnostics.push_back(error("SYNQ-E010", assignment->assignment.span,
                                                    "state evaluator received an assignment without an active mutable cell",
                                                    "use a resolver-produced assignment to an earlier mutable cell"));
@@ -593,20 +1157,22 @@ BoundedStateEvaluationResult evaluate_bounded_state(const ResolvedHybridProgram&
             }
             BoundedValue value;
             Diagnostic diagnostic;
-            if (!evaluate_state_expression(assignment->assignment.value, values, value, budget, diagnostic)) {
+            if (!evaluate_state_expression(assignment->assignment.value, assignment->value_binding_index,
+                                           assignment->value_binding_indices, registers, value, budget,
+                                           diagnostic)) {
                 result.diagnostics.push_back(std::move(diagnostic));
                 return result;
             }
-            if (value.kind != evaluation.cells[cell->second].value.kind) {
+            if (value.kind != evaluation.cells[cell].value.kind) {
                 result.diagnostics.push_back(error("SYNQ-E010", assignment->assignment.span,
                                                    "state evaluator received a static-type-incompatible assignment",
                                                    "use a resolver-produced assignment with the cell's exact static type"));
                 return result;
             }
             if (!consume_transition(assignment->assignment.span)) return result;
-            values[assignment->assignment.target_name] = value;
-            evaluation.cells[cell->second].value = std::move(value);
-            evaluation.cells[cell->second].last_write_span = assignment->assignment.span;
+            registers.write(target, value);
+            evaluation.cells[cell].value = std::move(value);
+            evaluation.cells[cell].last_write_span = assignment->assignment.span;
             continue;
         }
 
@@ -630,12 +1196,23 @@ BoundedRuntimeEvaluationResult evaluate_bounded_runtime(const ResolvedHybridProg
     }
 
     BoundedRuntimeEvaluation evaluation;
-    std::map<std::string, BoundedValue> values;
-    std::map<std::string, HybridCallableDeclaration> callables;
+    RegisterFile registers(program.nodes.size());
+    // Accepted local functions by defining slot, which is how name resolution
+    // records an invocation's target.
+    std::vector<const HybridCallableDeclaration*> callables(program.nodes.size(), nullptr);
+    std::size_t callable_count = 0;
+    const auto find_callable = [&callables](std::optional<std::size_t> slot) -> const HybridCallableDeclaration* {
+        return slot.has_value() && *slot < callables.size() ? callables[*slot] : nullptr;
+    };
     EvaluationBudget budget{options.max_expression_depth, options.max_operations, 0};
     std::size_t invocations = 0;
+    std::optional<RuntimeEngine> compiled;
+    if (!options.force_tree_walk) compiled.emplace(program, options.max_expression_depth, registers);
+    RuntimeEngine* engine = compiled.has_value() ? &*compiled : nullptr;
+    InvocationMemo memo;
 
-    for (const ResolvedHybridNode& node : program.nodes) {
+    for (std::size_t slot = 0; slot < program.nodes.size(); ++slot) {
+        const ResolvedHybridNode& node = program.nodes[slot];
         if (const auto* callable = std::get_if<HybridCallableDeclaration>(&node)) {
             if (!callable->classical_body.has_value() && !callable->binary_classical_body.has_value()) {
                 result.diagnostics.push_back(error("SYNQ-E014", callable->span,
@@ -649,13 +1226,14 @@ BoundedRuntimeEvaluationResult evaluate_bounded_runtime(const ResolvedHybridProg
                                                    "use one resolver-produced callable body shape"));
                 return result;
             }
-            if (callables.size() >= options.max_callable_declarations) {
+            if (callable_count >= options.max_callable_declarations) {
                 result.diagnostics.push_back(error("SYNQ-E012", callable->span,
                                                    "bounded runtime evaluation exceeds its callable-declaration limit",
                                                    "reduce U5 local function declarations or increase the explicitly configured limit"));
                 return result;
             }
-            callables.emplace(callable->name, *callable);
+            callables[slot] = callable;
+            ++callable_count;
             continue;
         }
 
@@ -671,25 +1249,40 @@ BoundedRuntimeEvaluationResult evaluate_bounded_runtime(const ResolvedHybridProg
                 }
                 const BinaryClassicalCallableInvocation& invocation =
                     *declaration->declaration.binary_classical_callable_invocation;
-                const auto callable = callables.find(invocation.function_name);
-                if (callable == callables.end() || !callable->second.binary_classical_body.has_value() ||
-                    !declaration->binary_classical_callable_declaration_index.has_value()) {
+                const HybridCallableDeclaration* callable =
+                    find_callable(declaration->binary_classical_callable_declaration_index);
+                if (callable == nullptr || !callable->binary_classical_body.has_value()) {
                     result.diagnostics.push_back(error("SYNQ-E015", declaration->declaration.span,
                                                        "runtime received an unresolved U6 binary callable invocation",
                                                        "use a resolver-produced earlier U6 two-formal function invocation"));
                     return result;
                 }
+                const std::size_t callable_slot = *declaration->binary_classical_callable_declaration_index;
                 BoundedValue first_actual;
                 BoundedValue second_actual;
                 if (!evaluate_binary_callable_actual(invocation.first_actual_source, invocation.first_actual_kind,
-                                                     invocation.span, values, first_actual, diagnostic) ||
+                                                     invocation.span,
+                                                     declaration->binary_classical_callable_first_actual_binding_index,
+                                                     registers, first_actual, diagnostic) ||
                     !evaluate_binary_callable_actual(invocation.second_actual_source, invocation.second_actual_kind,
-                                                     invocation.span, values, second_actual, diagnostic) ||
-                    !evaluate_binary_classical_callable(callable->second, first_actual, second_actual,
-                                                        value, budget, diagnostic)) {
+                                                     invocation.span,
+                                                     declaration->binary_classical_callable_second_actual_binding_index,
+                                                     registers, second_actual, diagnostic)) {
                     result.diagnostics.push_back(std::move(diagnostic));
                     return result;
                 }
+                InvocationMemo::Key key;
+                const bool memoized = options.memoize_invocations &&
+                                      InvocationMemo::make_key(callable_slot, first_actual, &second_actual, key);
+                if (!memoized || !memo.replay(key, budget, value)) {
+                    const std::size_t operations = budget.operations;
+                    if (!evaluate_binary_classical_callable(*callable, callable_slot, first_actual, second_actual,
+                                                            value, engine, budget, diagnostic)) {
+                        result.diagnostics.push_back(std::move(diagnostic));
+                        return result;
+                    }
+                    if (memoized) memo.record(key, value, budget.operations - operations);
+                }
                 ++invocations;
             } else if (declaration->declaration.classical_callable_invocation.has_value()) {
                 if (invocations >= options.max_callable_invocations || options.max_call_depth < 1) {
@@ -699,26 +1292,52 @@ BoundedRuntimeEvaluationResult evaluate_bounded_runtime(const ResolvedHybridProg
                     return result;
                 }
                 const ClassicalCallableInvocation& invocation = *declaration->declaration.classical_callable_invocation;
-                const auto callable = callables.find(invocation.function_name);
-                if (callable == callables.end() ||
-                    !declaration->classical_callable_declaration_index.has_value()) {
+                const HybridCallableDeclaration* callable =
+                    find_callable(declaration->classical_callable_declaration_index);
+                if (callable == nullptr) {
                     result.diagnostics.push_back(error("SYNQ-E013", declaration->declaration.span,
                                                        "runtime received an unresolved U5 callable invocation",
                                                        "use a resolver-produced earlier U5 function invocation"));
                     return result;
                 }
+                const std::size_t callable_slot = *declaration->classical_callable_declaration_index;
                 BoundedValue actual;
-                if (!evaluate_callable_actual(invocation, values, actual, diagnostic) ||
-                    !evaluate_classical_callable(callable->second, actual, value, budget, diagnostic)) {
+                if (!evaluate_callable_actual(invocation, declaration->classical_callable_actual_binding_index,
+                                              registers, actual, diagnostic)) {
                     result.diagnostics.push_back(std::move(diagnostic));
                     return result;
                 }
+                InvocationMemo::Key key;
+                const bool memoized = options.memoize_invocations &&
+                                      InvocationMemo::make_key(callable_slot, actual, nullptr, key);
+                if (!memoized || !memo.replay(key, budget, value)) {
+                    const std::size_t operations = budget.operations;
+                    if (!evaluate_classical_callable(*callable, callable_slot, actual, value, engine, budget,
+                                                     diagnostic)) {
+                        result.diagnostics.push_back(std::move(diagnostic));
+                        return result;
+                    }
+                    if (memoized) memo.record(key, value, budget.operations - operations);
+                }
                 ++invocations;
-            } else if (!evaluate_state_expression(declaration->declaration.initializer, values, value, budget, diagnostic)) {
+            } else if (engine != nullptr && engine->entry(slot).compiled) {
+                std::int64_t word = 0;
+                if (!engine->run(engine->entry(slot), {}, budget, word, diagnostic)) {
+                    result.diagnostics.push_back(std::move(diagnostic));
+                    return result;
+                }
+                const bool integer = declaration->declaration.initializer.kind ==
+                                     ClassicalExpressionKind::IntegerArithmeticExpression;
+                value = integer ? BoundedValue{BoundedValueKind::Integer, word, false, {}}
+                                : BoundedValue{BoundedValueKind::Boolean, 0, word != 0, {}};
+            } else if (!evaluate_state_expression(declaration->declaration.initializer,
+                                                  declaration->initializer_binding_index,
+                                                  declaration->initializer_binding_indices, registers, value, budget,
+                                                  diagnostic)) {
                 result.diagnostics.push_back(std::move(diagnostic));
                 return result;
             }
-            values.emplace(declaration->declaration.name, value);
+            registers.write(slot, value);
             evaluation.bindings.push_back({declaration->declaration.name, std::move(value), declaration->declaration.span});
             continue;
         }
@@ -94,6 +94,16 @@ struct BoundedRuntimeEvaluationOptions {
     std::size_t max_call_depth = 1;
     std::size_t max_expression_depth = 16;
     std::size_t max_operations = 128;
+    // Walks the expression trees directly instead of running their compiled
+    // bytecode, so results can be checked against the reference evaluator.
+    bool force_tree_walk = false;
+    // Reuses the result of an earlier call to the same local function with the
+    // same Integer or Boolean actuals. Bodies read only their formals, so no
+    // result changes: a reused call still counts against
+    // max_callable_invocations and is charged the operations its first
+    // evaluation consumed, or is evaluated again when that would exceed
+    // max_operations.
+    bool memoize_invocations = true;
 };
 
 struct BoundedRuntimeEvaluationResult {
@@ -120,7 +130,10 @@ BoundedStateEvaluationResult evaluate_bounded_state(const ResolvedHybridProgram&
 // Evaluates the U5 local classical callable subset only: immutable declarations
 // plus earlier one-formal non-recursive function definitions and one-actual
 // immutable invocation initializers. All quantum, control, state, ABI, target,
-// and unsupported callable nodes are rejected explicitly.
+// and unsupported callable nodes are rejected explicitly. Expression trees and
+// function bodies are compiled to bytecode once per call; results, diagnostics,
+// and every limit match walking the trees, which force_tree_walk still does.
+// Repeated calls with equal actuals are memoized for the length of one call.
 BoundedRuntimeEvaluationResult evaluate_bounded_runtime(const ResolvedHybridProgram& program,
                                                         const BoundedRuntimeEvaluationOptions& options);
 
@@ -1,10 +1,16 @@
 #include "bounded_simulator.h"
 
+#include "sweep_pool.h"
+
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <complex>
 #include <limits>
+#include <memory>
+#include <optional>
+#include <random>
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -18,6 +24,7 @@ constexpr double kProbabilityEpsilon = 1e-12;
 struct RegisterAllocation {
     std::size_t physical_offset = 0;
     std::size_t qubit_count = 0;
+    std::size_t position = 0;
 };
 
 Diagnostic error(const std::string& code, const SourceSpan& span, std::string message, std::string help) {
@@ -49,29 +56,150 @@ bool parse_angle(const std::string& text, double& angle) {
     }
 }
 
-void apply_single(std::vector<Complex>& state, std::size_t qubit, Complex a, Complex b, Complex c, Complex d) {
-    const std::size_t mask = std::size_t{1} << qubit;
-    for (std::size_t basis = 0; basis < state.size(); ++basis) {
-        if ((basis & mask) != 0) continue;
-        const std::size_t paired = basis | mask;
-        const Complex zero = state[basis];
-        const Complex one = state[paired];
-        state[basis] = a * zero + b * one;
-        state[paired] = c * zero + d * one;
+using Matrix2 = std::array<Complex, 4>;
+using Matrix4 = std::array<Complex, 16>;
+
+// One source gate lowered to a physical unitary. bell_pair lowers to an H
+// followed by a controlled X so that fusion sees only these two shapes.
+struct ElementaryGate {
+    bool controlled_x = false;
+    std::size_t qubit = 0;
+    std::size_t target = 0;
+    Matrix2 matrix{};
+};
+
+// The lowered position and kind of one rx, ry, rz, or p source gate.
+struct RotationSlot {
+    std::size_t elementary_index = 0;
+    QuantumGateKind kind = QuantumGateKind::Rx;
+};
+
+// A fused block touches the state vector once. Single blocks act on `first`;
+// pair blocks use local basis index bit(first) | bit(second) << 1.
+struct FusedOperation {
+    bool pair = false;
+    std::size_t first = 0;
+    std::size_t second = 0;
+    Matrix4 matrix{};
+};
+
+Matrix2 multiply(const Matrix2& left, const Matrix2& right) {
+    return {left[0] * right[0] + left[1] * right[2], left[0] * right[1] + left[1] * right[3],
+            left[2] * right[0] + left[3] * right[2], left[2] * right[1] + left[3] * right[3]};
+}
+
+Matrix4 multiply(const Matrix4& left, const Matrix4& right) {
+    Matrix4 product{};
+    for (std::size_t row = 0; row < 4; ++row) {
+        for (std::size_t column = 0; column < 4; ++column) {
+            Complex sum{0.0, 0.0};
+            for (std::size_t inner = 0; inner < 4; ++inner) sum += left[row * 4 + inner] * right[inner * 4 + column];
+            product[row * 4 + column] = sum;
+        }
+    }
+    return product;
+}
+
+Matrix4 embed_single(const FusedOperation& block, std::size_t qubit, const Matrix2& matrix) {
+    const bool on_first = qubit == block.first;
+    Matrix4 embedded{};
+    for (std::size_t row = 0; row < 4; ++row) {
+        for (std::size_t column = 0; column < 4; ++column) {
+            const std::size_t acted_row = on_first ? (row & 1) : (row >> 1);
+            const std::size_t acted_column = on_first ? (column & 1) : (column >> 1);
+            const std::size_t kept_row = on_first ? (row >> 1) : (row & 1);
+            const std::size_t kept_column = on_first ? (column >> 1) : (column & 1);
+            if (kept_row == kept_column) embedded[row * 4 + column] = matrix[acted_row * 2 + acted_column];
+        }
     }
+    return embedded;
 }
 
-void apply_cx(std::vector<Complex>& state, std::size_t control, std::size_t target) {
-    const std::size_t control_mask = std::size_t{1} << control;
-    const std::size_t target_mask = std::size_t{1} << target;
-    for (std::size_t basis = 0; basis < state.size(); ++basis) {
-        if ((basis & control_mask) == 0 || (basis & target_mask) != 0) continue;
-        const std::size_t paired = basis | target_mask;
-        std::swap(state[basis], state[paired]);
+Matrix4 embed_controlled_x(const FusedOperation& block, std::size_t control) {
+    const bool control_is_first = control == block.first;
+    Matrix4 embedded{};
+    for (std::size_t column = 0; column < 4; ++column) {
+        const std::size_t row = control_is_first ? (column ^ ((column & 1) << 1)) : (column ^ (column >> 1));
+        embedded[row * 4 + column] = Complex{1.0, 0.0};
+    }
+    return embedded;
+}
+
+// Groups gates before any state-vector sweep. Consecutive single-qubit gates
+// on one qubit are pre-multiplied while pending; a two-qubit gate absorbs the
+// pending gates on its operands and merges into the previous block on the
+// same qubit pair when no emitted block has touched either qubit since.
+class GateFuser {
+public:
+    explicit GateFuser(std::size_t qubit_count) : pending_(qubit_count), last_block_(qubit_count) {}
+
+    void add(const ElementaryGate& gate) {
+        if (!gate.controlled_x) {
+            auto& pending = pending_[gate.qubit];
+            pending = pending.has_value() ? multiply(gate.matrix, *pending) : gate.matrix;
+            return;
+        }
+        const std::size_t control = gate.qubit;
+        const std::size_t target = gate.target;
+        const auto& control_block = last_block_[control];
+        const bool merge = control_block.has_value() && control_block == last_block_[target];
+        FusedOperation fresh{true, control, target, {}};
+        FusedOperation& block = merge ? operations_[*control_block] : fresh;
+        Matrix4 unitary = embed_controlled_x(block, control);
+        for (const std::size_t qubit : {control, target}) {
+            if (!pending_[qubit].has_value()) continue;
+            unitary = multiply(unitary, embed_single(block, qubit, *pending_[qubit]));
+            pending_[qubit].reset();
+        }
+        if (merge) {
+            block.matrix = multiply(unitary, block.matrix);
+            return;
+        }
+        fresh.matrix = unitary;
+        last_block_[control] = last_block_[target] = operations_.size();
+        operations_.push_back(fresh);
+    }
+
+    // Flushes remaining single-qubit products into the last block touching
+    // their qubit, or into a single-qubit block when none exists.
+    std::vector<FusedOperation> finish() {
+        for (std::size_t qubit = 0; qubit < pending_.size(); ++qubit) {
+            if (!pending_[qubit].has_value()) continue;
+            if (last_block_[qubit].has_value()) {
+                FusedOperation& block = operations_[*last_block_[qubit]];
+                block.matrix = multiply(embed_single(block, qubit, *pending_[qubit]), block.matrix);
+            } else {
+                FusedOperation single{false, qubit, qubit, {}};
+                std::copy(pending_[qubit]->begin(), pending_[qubit]->end(), single.matrix.begin());
+                operations_.push_back(single);
+            }
+            pending_[qubit].reset();
+        }
+        return std::move(operations_);
     }
+
+private:
+    std::vector<std::optional<Matrix2>> pending_;
+    std::vector<std::optional<std::size_t>> last_block_;
+    std::vector<FusedOperation> operations_;
+};
+
+bool is_rotation_gate(QuantumGateKind kind) {
+    return kind == QuantumGateKind::Rx || kind == QuantumGateKind::Ry || kind == QuantumGateKind::Rz ||
+           kind == QuantumGateKind::Phase;
+}
+
+// The unitary of an rx, ry, rz, or p gate at `angle`.
+Matrix2 rotation_matrix(QuantumGateKind kind, double angle) {
+    const Complex i{0.0, 1.0};
+    const double half = angle / 2.0;
+    if (kind == QuantumGateKind::Rx) return {std::cos(half), -i * std::sin(half), -i * std::sin(half), std::cos(half)};
+    if (kind == QuantumGateKind::Ry) return {std::cos(half), -std::sin(half), std::sin(half), std::cos(half)};
+    if (kind == QuantumGateKind::Rz) return {std::exp(-i * half), 0.0, 0.0, std::exp(i * half)};
+    return {1.0, 0.0, 0.0, std::exp(i * angle)};
 }
 
-bool apply_gate(const HybridQuantumGate& gate, std::vector<Complex>& state, Diagnostic& diagnostic) {
+bool lower_gate(const HybridQuantumGate& gate, std::vector<ElementaryGate>& lowered, Diagnostic& diagnostic) {
     const auto require_one = [&]() -> bool {
         if (gate.qubit_indices.size() == 1) return true;
         diagnostic = error("SYNQ-SIM003", gate.span, "simulator received an unsupported single-qubit gate shape",
@@ -84,26 +212,29 @@ bool apply_gate(const HybridQuantumGate& gate, std::vector<Complex>& state, Diag
                            "use a parser-produced supported gate with two distinct in-range operands");
         return false;
     };
+    const auto single = [&](Matrix2 matrix) {
+        lowered.push_back(ElementaryGate{false, gate.qubit_indices[0], 0, matrix});
+    };
     const Complex i{0.0, 1.0};
     const double inverse_sqrt_two = 1.0 / std::sqrt(2.0);
+    const Matrix2 hadamard{inverse_sqrt_two, inverse_sqrt_two, inverse_sqrt_two, -inverse_sqrt_two};
 
     switch (gate.kind) {
         case QuantumGateKind::H:
             if (!require_one()) return false;
-            apply_single(state, gate.qubit_indices[0], inverse_sqrt_two, inverse_sqrt_two,
-                         inverse_sqrt_two, -inverse_sqrt_two);
+            single(hadamard);
             return true;
         case QuantumGateKind::X:
             if (!require_one()) return false;
-            apply_single(state, gate.qubit_indices[0], 0.0, 1.0, 1.0, 0.0);
+            single({0.0, 1.0, 1.0, 0.0});
             return true;
         case QuantumGateKind::Y:
             if (!require_one()) return false;
-            apply_single(state, gate.qubit_indices[0], 0.0, -i, i, 0.0);
+            single({0.0, -i, i, 0.0});
             return true;
         case QuantumGateKind::Z:
             if (!require_one()) return false;
-            apply_single(state, gate.qubit_indices[0], 1.0, 0.0, 0.0, -1.0);
+            single({1.0, 0.0, 0.0, -1.0});
             return true;
         case QuantumGateKind::Cx:
             if (!require_two() || gate.qubit_indices[0] == gate.qubit_indices[1]) {
@@ -111,7 +242,7 @@ bool apply_gate(const HybridQuantumGate& gate, std::vector<Complex>& state, Diag
                                                                 "use two distinct declared qubit indices");
                 return false;
             }
-            apply_cx(state, gate.qubit_indices[0], gate.qubit_indices[1]);
+            lowered.push_back(ElementaryGate{true, gate.qubit_indices[0], gate.qubit_indices[1], {}});
             return true;
         case QuantumGateKind::BellPair:
             if (!require_two() || gate.qubit_indices[0] == gate.qubit_indices[1]) {
@@ -119,9 +250,8 @@ bool apply_gate(const HybridQuantumGate& gate, std::vector<Complex>& state, Diag
                                                                 "use two distinct declared qubit indices");
                 return false;
             }
-            apply_single(state, gate.qubit_indices[0], inverse_sqrt_two, inverse_sqrt_two,
-                         inverse_sqrt_two, -inverse_sqrt_two);
-            apply_cx(state, gate.qubit_indices[0], gate.qubit_indices[1]);
+            single(hadamard);
+            lowered.push_back(ElementaryGate{true, gate.qubit_indices[0], gate.qubit_indices[1], {}});
             return true;
         case QuantumGateKind::Rx:
         case QuantumGateKind::Ry:
@@ -138,21 +268,7 @@ bool apply_gate(const HybridQuantumGate& gate, std::vector<Complex>& state, Diag
                                    "use a documented decimal or pi-form literal angle");
                 return false;
             }
-            if (gate.kind == QuantumGateKind::Rx) {
-                const double half = angle / 2.0;
-                apply_single(state, gate.qubit_indices[0], std::cos(half), -i * std::sin(half),
-                             -i * std::sin(half), std::cos(half));
-            } else if (gate.kind == QuantumGateKind::Ry) {
-                const double half = angle / 2.0;
-                apply_single(state, gate.qubit_indices[0], std::cos(half), -std::sin(half),
-                             std::sin(half), std::cos(half));
-            } else if (gate.kind == QuantumGateKind::Rz) {
-                const double half = angle / 2.0;
-                apply_single(state, gate.qubit_indices[0], std::exp(-i * half), 0.0,
-                             0.0, std::exp(i * half));
-            } else {
-                apply_single(state, gate.qubit_indices[0], 1.0, 0.0, 0.0, std::exp(i * angle));
-            }
+            single(rotation_matrix(gate.kind, angle));
             return true;
         }
         case QuantumGateKind::Unknown:
@@ -165,38 +281,273 @@ bool apply_gate(const HybridQuantumGate& gate, std::vector<Complex>& state, Diag
     return false;
 }
 
-double probability_one(const std::vector<Complex>& state, std::size_t qubit) {
-    const std::size_t mask = std::size_t{1} << qubit;
-    double probability = 0.0;
-    for (std::size_t basis = 0; basis < state.size(); ++basis) {
-        if ((basis & mask) != 0) probability += std::norm(state[basis]);
+template <typename Real>
+void apply_operation(SweepPool& pool, SimulationKernelIsa isa, AmplitudeBufferOf<Real>& state,
+                     const KernelOperation& operation) {
+    const std::size_t groups = kernel_group_count(operation, state.size());
+    pool.run(sweep_chunk_count(groups), [&](std::size_t chunk) {
+        const std::size_t begin = chunk * kSweepChunkGroups;
+        apply_kernel_operation(isa, state.data(), operation, begin, std::min(begin + kSweepChunkGroups, groups));
+    });
+}
+
+bool fits_sweep_block(const KernelOperation& operation, std::size_t block_qubits) {
+    return operation.first < block_qubits && operation.second < block_qubits;
+}
+
+// Applies `operations` in order. A run of consecutive operations that act only
+// on the low kSweepBlockQubits qubits is applied block by block instead of one
+// full sweep per operation, so each block stays in cache for the whole run.
+// Every amplitude still sees the same operations in the same order, so the
+// result is bitwise identical to unblocked sweeps.
+template <typename Real>
+void apply_operations(SweepPool& pool, SimulationKernelIsa isa, AmplitudeBufferOf<Real>& state,
+                      const std::vector<KernelOperation>& operations, bool cache_block) {
+    std::size_t state_qubits = 0;
+    while ((std::size_t{1} << state_qubits) < state.size()) ++state_qubits;
+    const std::size_t block_qubits = std::min(kSweepBlockQubits, state_qubits);
+    std::size_t index = 0;
+    while (index < operations.size()) {
+        std::size_t end = index;
+        while (cache_block && end < operations.size() && fits_sweep_block(operations[end], block_qubits)) ++end;
+        if (end - index < 2) {
+            apply_operation(pool, isa, state, operations[index]);
+            ++index;
+            continue;
+        }
+        const std::size_t block_amplitudes = std::size_t{1} << block_qubits;
+        pool.run(state.size() / block_amplitudes, [&](std::size_t block) {
+            for (std::size_t position = index; position < end; ++position) {
+                const KernelOperation& operation = operations[position];
+                const std::size_t groups = kernel_group_count(operation, block_amplitudes);
+                apply_kernel_operation(isa, state.data(), operation, block * groups, (block + 1) * groups);
+            }
+        });
+        index = end;
     }
-    return probability;
 }
 
-std::vector<Complex> collapsed_measurement_branch(const std::vector<Complex>& state, std::size_t qubit,
-                                                   bool observed_one, double branch_probability) {
-    std::vector<Complex> branch = state;
+// Sums partial(begin, end) over fixed chunks of [0, count) and combines the
+// chunk totals in index order, so the result does not depend on pool size.
+template <typename Partial>
+double chunked_sum(SweepPool& pool, std::vector<double>& totals, std::size_t count, const Partial& partial) {
+    totals.assign(sweep_chunk_count(count), 0.0);
+    pool.run(totals.size(), [&](std::size_t chunk) {
+        const std::size_t begin = chunk * kSweepChunkGroups;
+        totals[chunk] = partial(begin, std::min(begin + kSweepChunkGroups, count));
+    });
+    double sum = 0.0;
+    for (const double total : totals) sum += total;
+    return sum;
+}
+
+// Reductions widen each amplitude to double, so single-precision storage adds
+// no accumulation error of its own.
+template <typename Real>
+double probability_one(SweepPool& pool, std::vector<double>& totals, const AmplitudeBufferOf<Real>& state,
+                       std::size_t qubit) {
     const std::size_t mask = std::size_t{1} << qubit;
-    const double normalization = 1.0 / std::sqrt(branch_probability);
-    for (std::size_t basis = 0; basis < branch.size(); ++basis) {
-        const bool basis_is_one = (basis & mask) != 0;
-        if (basis_is_one != observed_one) {
-            branch[basis] = Complex{0.0, 0.0};
-        } else {
-            branch[basis] *= normalization;
+    const std::size_t low_mask = mask - 1;
+    return chunked_sum(pool, totals, state.size() / 2, [&](std::size_t begin, std::size_t end) {
+        double probability = 0.0;
+        for (std::size_t pair = begin; pair < end; ++pair) {
+            const std::size_t basis = ((pair & ~low_mask) << 1) | mask | (pair & low_mask);
+            probability += std::norm(Complex(state[basis]));
+        }
+        return probability;
+    });
+}
+
+template <typename Real>
+double total_probability(SweepPool& pool, std::vector<double>& totals, const AmplitudeBufferOf<Real>& state) {
+    return chunked_sum(pool, totals, state.size(), [&](std::size_t begin, std::size_t end) {
+        double norm = 0.0;
+        for (std::size_t basis = begin; basis < end; ++basis) norm += std::norm(Complex(state[basis]));
+        return norm;
+    });
+}
+
+// Accumulates the branch-weighted final distribution of the U4 pair in one
+// read-only pass over `state`, without materializing either collapsed branch.
+// The observed-zero branch keeps |state[b]|^2 where the measured bit is zero.
+// The observed-one branch applies `correction` to the amplitudes whose measured
+// bit is one, which is a 2x2 product over each amplitude pair of the corrected
+// qubit; normalizing the branch and then weighting it by its probability
+// cancel, so neither step appears. A branch at or below kProbabilityEpsilon
+// contributes nothing, as in the explicit enumeration.
+template <typename Real>
+void accumulate_feedback_probabilities(SweepPool& pool, const AmplitudeBufferOf<Real>& state,
+                                       std::size_t measured_qubit, const KernelOperation& correction,
+                                       double zero_weight, double one_weight,
+                                       std::vector<double>& final_probabilities) {
+    const std::size_t corrected_qubit = correction.first;
+    const std::size_t corrected_mask = std::size_t{1} << corrected_qubit;
+    const Complex u00{correction.matrix[0], correction.matrix[1]};
+    const Complex u01{correction.matrix[2], correction.matrix[3]};
+    const Complex u10{correction.matrix[4], correction.matrix[5]};
+    const Complex u11{correction.matrix[6], correction.matrix[7]};
+    const std::size_t groups = state.size() / 2;
+    pool.run(sweep_chunk_count(groups), [&](std::size_t chunk) {
+        const std::size_t begin = chunk * kSweepChunkGroups;
+        const std::size_t end = std::min(begin + kSweepChunkGroups, groups);
+        const std::size_t low_mask = corrected_mask - 1;
+        for (std::size_t group = begin; group < end; ++group) {
+            const std::size_t zero = ((group & ~low_mask) << 1) | (group & low_mask);
+            const std::size_t one = zero | corrected_mask;
+            const Complex zero_amplitude(state[zero]);
+            const Complex one_amplitude(state[one]);
+            const double zero_observed_one = static_cast<double>((zero >> measured_qubit) & 1);
+            const double one_observed_one = static_cast<double>((one >> measured_qubit) & 1);
+            const Complex branch_zero = zero_amplitude * zero_observed_one;
+            const Complex branch_one = one_amplitude * one_observed_one;
+            final_probabilities[zero] = zero_weight * (1.0 - zero_observed_one) * std::norm(zero_amplitude) +
+                                        one_weight * std::norm(u00 * branch_zero + u01 * branch_one);
+            final_probabilities[one] = zero_weight * (1.0 - one_observed_one) * std::norm(one_amplitude) +
+                                       one_weight * std::norm(u10 * branch_zero + u11 * branch_one);
+        }
+    });
+}
+
+// Allowed deviation of the final squared norm from one. Single precision
+// rounds each sweep at about 6e-8 relative, so its bound is much looser.
+double normalization_tolerance(SimulationPrecision precision) {
+    return precision == SimulationPrecision::F32 ? 1e-4 : 1e-9;
+}
+
+// Evolves |0...0> through the plan in `state`, checks normalization, and fills
+// the final distribution and the marginal of every planned measurement
+// (feedback measurement last). Returns false when normalization fails.
+template <typename Real>
+bool evolve_plan(const SimulationPlan& plan, SimulationKernelIsa isa, bool cache_block, double tolerance,
+                 SweepPool& pool, std::vector<double>& totals, AmplitudeBufferOf<Real>& state,
+                 std::vector<double>& final_probabilities, std::vector<double>& marginals) {
+    state.assign(std::size_t{1} << plan.qubit_count, std::complex<Real>{0, 0});
+    state.front() = std::complex<Real>{1, 0};
+    apply_operations(pool, isa, state, plan.operations, cache_block);
+
+    const double norm = total_probability(pool, totals, state);
+    if (!std::isfinite(norm) || std::abs(norm - 1.0) > tolerance) return false;
+
+    final_probabilities.resize(state.size());
+    if (plan.has_feedback) {
+        const std::size_t measured_qubit = plan.feedback_measurement.qubit_index;
+        const double probability_of_one = probability_one(pool, totals, state, measured_qubit);
+        const double probability_of_zero = 1.0 - probability_of_one;
+        accumulate_feedback_probabilities(pool, state, measured_qubit, plan.feedback_correction,
+                                          probability_of_zero > kProbabilityEpsilon ? 1.0 : 0.0,
+                                          probability_of_one > kProbabilityEpsilon ? 1.0 : 0.0, final_probabilities);
+    } else {
+        for (std::size_t basis = 0; basis < state.size(); ++basis) {
+            final_probabilities[basis] = std::norm(Complex(state[basis]));
+        }
+    }
+    marginals.clear();
+    for (const auto& planned : plan.measurements) {
+        marginals.push_back(probability_one(pool, totals, state, planned.qubit_index));
+    }
+    if (plan.has_feedback) {
+        marginals.push_back(probability_one(pool, totals, state, plan.feedback_measurement.qubit_index));
+    }
+    return true;
+}
+
+void write_measurement(const SimulationPlan& plan, const PlannedMeasurement& planned, double probability,
+                       MeasurementProbability& measurement) {
+    measurement.register_name = plan.registers[planned.register_position].name;
+    measurement.register_index = planned.register_index;
+    measurement.qubit_index = planned.qubit_index;
+    measurement.probability_one = probability;
+}
+
+bool is_clifford_gate(QuantumGateKind kind) {
+    switch (kind) {
+        case QuantumGateKind::H:
+        case QuantumGateKind::X:
+        case QuantumGateKind::Y:
+        case QuantumGateKind::Z:
+        case QuantumGateKind::Cx:
+        case QuantumGateKind::BellPair: return true;
+        default: return false;
+    }
+}
+
+// Appends the Clifford generators of a gate already validated by lower_gate.
+void lower_clifford_gate(const HybridQuantumGate& gate, std::vector<CliffordOperation>& lowered) {
+    const std::size_t first = gate.qubit_indices[0];
+    switch (gate.kind) {
+        case QuantumGateKind::H: lowered.push_back({CliffordOpcode::Hadamard, first, first}); return;
+        case QuantumGateKind::X: lowered.push_back({CliffordOpcode::PauliX, first, first}); return;
+        case QuantumGateKind::Y: lowered.push_back({CliffordOpcode::PauliY, first, first}); return;
+        case QuantumGateKind::Z: lowered.push_back({CliffordOpcode::PauliZ, first, first}); return;
+        case QuantumGateKind::BellPair: lowered.push_back({CliffordOpcode::Hadamard, first, first}); [[fallthrough]];
+        case QuantumGateKind::Cx:
+            lowered.push_back({CliffordOpcode::ControlledX, first, gate.qubit_indices[1]});
+            return;
+        default: return;
+    }
+}
+
+// Lists the stabilizer support in ascending basis order, or returns false when
+// basis indices would not fit or the list would exceed 2^max_rank entries.
+bool list_stabilizer_support(const StabilizerSupport& support, std::size_t max_rank,
+                             std::vector<std::size_t>& basis) {
+    if (support.qubit_count > 63 || support.rank > max_rank) return false;
+    basis.resize(std::size_t{1} << support.rank);
+    basis.front() = static_cast<std::size_t>(support.offset.front());
+    for (std::size_t direction = 0; direction < support.rank; ++direction) {
+        const std::size_t filled = std::size_t{1} << direction;
+        const auto step = static_cast<std::size_t>(support.directions[direction]);
+        for (std::size_t index = 0; index < filled; ++index) basis[filled + index] = basis[index] ^ step;
+    }
+    std::sort(basis.begin(), basis.end());
+    return true;
+}
+
+// Draws shots directly from the support of a register of at most 63 qubits:
+// each shot xors the offset with a uniformly random subset of the directions.
+void sample_stabilizer_shots(const StabilizerSupport& support, std::size_t shots, std::uint64_t seed,
+                             std::vector<std::size_t>& outcomes, std::vector<ShotCount>& histogram) {
+    std::mt19937_64 engine(seed);
+    outcomes.resize(shots);
+    for (auto& outcome : outcomes) {
+        const std::uint64_t draw = engine();
+        std::uint64_t value = support.offset.front();
+        for (std::size_t direction = 0; direction < support.rank; ++direction) {
+            if (((draw >> direction) & 1) != 0) value ^= support.directions[direction];
         }
+        outcome = static_cast<std::size_t>(value);
+    }
+    std::sort(outcomes.begin(), outcomes.end());
+    histogram.clear();
+    for (const std::size_t outcome : outcomes) {
+        if (histogram.empty() || histogram.back().basis_index != outcome) histogram.push_back({outcome, 0});
+        ++histogram.back().count;
     }
-    return branch;
 }
 
 }  // namespace
 
+const char* simulation_backend_name(SimulationBackend backend) {
+    return backend == SimulationBackend::Stabilizer ? "stabilizer" : "statevector";
+}
+
 bool BoundedSimulationResult::ok() const { return simulation.has_value() && diagnostics.empty(); }
 
-BoundedSimulationResult simulate_bounded_quantum(const ResolvedHybridProgram& program,
-                                                  const BoundedSimulationOptions& options) {
-    BoundedSimulationResult result;
+bool SimulationPlanResult::ok() const { return plan.has_value() && diagnostics.empty(); }
+
+bool ParameterSweepResult::ok() const { return sweep.has_value() && diagnostics.empty(); }
+
+SimulationWorkspace::SimulationWorkspace(std::size_t threads) : pool_(std::max<std::size_t>(threads, 1)) {}
+
+namespace {
+
+// Validates `program` and lowers it to a plan without state-vector operations.
+// `elementary` receives every lowered gate in order and `rotations` the
+// elementary index of each rx, ry, rz, or p source gate, so callers can fuse
+// the gates as written or after rebinding their angles.
+SimulationPlanResult lower_program(const ResolvedHybridProgram& program, const BoundedSimulationOptions& options,
+                                   std::vector<ElementaryGate>& elementary, std::vector<RotationSlot>& rotations) {
+    SimulationPlanResult result;
     if (!options.allow_experimental_local_simulation) {
         result.diagnostics.push_back(error("SYNQ-SIM000", {}, "bounded local simulation requires explicit opt-in",
                                            "set allow_experimental_local_simulation to true after reviewing the limits"));
@@ -205,7 +556,11 @@ BoundedSimulationResult simulate_bounded_quantum(const ResolvedHybridProgram& pr
 
     std::size_t qubit_count = 0;
     std::vector<SimulatedRegister> registers;
-    std::unordered_map<std::string, RegisterAllocation> allocations;
+    // Indexed by register SymbolId; unset entries are undeclared registers.
+    std::vector<std::optional<RegisterAllocation>> allocations(program.symbols.size());
+    const auto find_allocation = [&allocations](SymbolId id) -> const RegisterAllocation* {
+        return id < allocations.size() && allocations[id].has_value() ? &*allocations[id] : nullptr;
+    };
     std::vector<HybridQuantumGate> gates;
     std::vector<HybridMeasurement> measurements;
     struct RebasedMeasurementFeedback {
@@ -214,23 +569,28 @@ BoundedSimulationResult simulate_bounded_quantum(const ResolvedHybridProgram& pr
     };
     std::optional<RebasedMeasurementFeedback> feedback;
     bool measurements_started = false;
+    // Clifford-only programs may be wider than max_qubits on the stabilizer
+    // backend; which backend applies is known only after every gate is seen.
+    const std::size_t qubit_limit = options.allow_stabilizer_simulation
+                                        ? std::max(options.max_qubits, options.max_stabilizer_qubits)
+                                        : options.max_qubits;
     for (const auto& node : program.nodes) {
         if (const auto* qubits = std::get_if<HybridQubitDeclaration>(&node)) {
-            if (allocations.find(qubits->name) != allocations.end()) {
+            if (find_allocation(qubits->name) != nullptr) {
                 result.diagnostics.push_back(error("SYNQ-SIM001", qubits->span,
                                                    "simulator received a duplicate explicit qubit register declaration",
                                                    "use unique parser-produced qubit register declarations"));
                 return result;
             }
-            if (qubits->qubit_count == 0 || qubits->qubit_count > options.max_qubits ||
-                qubit_count > options.max_qubits - qubits->qubit_count) {
+            if (qubits->qubit_count == 0 || qubits->qubit_count > qubit_limit ||
+                qubit_count > qubit_limit - qubits->qubit_count) {
                 result.diagnostics.push_back(error("SYNQ-SIM001", qubits->span,
                                                    "simulator register declarations exceed the configured qubit limit",
                                                    "declare a positive combined register size no larger than max_qubits"));
                 return result;
             }
-            allocations.emplace(qubits->name, RegisterAllocation{qubit_count, qubits->qubit_count});
-            registers.push_back({qubits->name, qubits->qubit_count, qubit_count});
+            allocations.at(qubits->name) = RegisterAllocation{qubit_count, qubits->qubit_count, registers.size()};
+            registers.push_back({program.symbols.name(qubits->name), qubits->qubit_count, qubit_count});
             qubit_count += qubits->qubit_count;
             continue;
         }
@@ -290,27 +650,27 @@ BoundedSimulationResult simulate_bounded_quantum(const ResolvedHybridProgram& pr
             const auto* correction_gate = std::get_if<HybridQuantumGate>(&feedback_node->correction.body);
             if (correction_gate == nullptr || correction_gate->kind != QuantumGateKind::X ||
                 correction_gate->literal_angle.has_value() || correction_gate->qubit_indices.size() != 1 ||
-                correction_gate->qubit_register_names.size() != 1) {
+                correction_gate->qubit_registers.size() != 1) {
                 result.diagnostics.push_back(error("SYNQ-SIM006", feedback_node->correction.span,
                                                    "simulator accepts only one direct conditional x correction in a U4 feedback pair",
                                                    "use if <measurement-result> then quantum x register[index]"));
                 return result;
             }
-            const auto measurement_allocation = allocations.find(feedback_node->measurement.qubit_register_name);
-            const auto correction_allocation = allocations.find(correction_gate->qubit_register_names.front());
-            if (measurement_allocation == allocations.end() ||
-                feedback_node->measurement.qubit_index >= measurement_allocation->second.qubit_count ||
-                correction_allocation == allocations.end() ||
-                correction_gate->qubit_indices.front() >= correction_allocation->second.qubit_count) {
+            const RegisterAllocation* measurement_allocation = find_allocation(feedback_node->measurement.qubit_register);
+            const RegisterAllocation* correction_allocation = find_allocation(correction_gate->qubit_registers.front());
+            if (measurement_allocation == nullptr ||
+                feedback_node->measurement.qubit_index >= measurement_allocation->qubit_count ||
+                correction_allocation == nullptr ||
+                correction_gate->qubit_indices.front() >= correction_allocation->qubit_count) {
                 result.diagnostics.push_back(error("SYNQ-SIM001", feedback_node->measurement.span,
                                                    "simulator cannot map a U4 measurement-feedback operand to an explicit qubit register",
                                                    "declare both source and correction registers before simulation and use in-range indices"));
                 return result;
             }
             HybridMeasurement rebased_measurement = feedback_node->measurement;
-            rebased_measurement.qubit_index += measurement_allocation->second.physical_offset;
+            rebased_measurement.qubit_index += measurement_allocation->physical_offset;
             HybridQuantumGate rebased_correction = *correction_gate;
-            rebased_correction.qubit_indices.front() += correction_allocation->second.physical_offset;
+            rebased_correction.qubit_indices.front() += correction_allocation->physical_offset;
             feedback = RebasedMeasurementFeedback{std::move(rebased_measurement), std::move(rebased_correction)};
             measurements_started = true;
             continue;
@@ -322,7 +682,7 @@ BoundedSimulationResult simulate_bounded_quantum(const ResolvedHybridProgram& pr
                                                    "move measurements to the end of the bounded simulation program"));
                 return result;
             }
-            if (gate->qubit_register_names.size() != gate->qubit_indices.size()) {
+            if (gate->qubit_registers.size() != gate->qubit_indices.size()) {
                 result.diagnostics.push_back(error("SYNQ-SIM003", gate->span,
                                                    "simulator received mismatched quantum operand metadata",
                                                    "use a parser-produced supported gate with declared register operands"));
@@ -330,15 +690,14 @@ BoundedSimulationResult simulate_bounded_quantum(const ResolvedHybridProgram& pr
             }
             HybridQuantumGate rebased = *gate;
             for (std::size_t position = 0; position < rebased.qubit_indices.size(); ++position) {
-                const auto allocation = allocations.find(rebased.qubit_register_names[position]);
-                if (allocation == allocations.end() ||
-                    rebased.qubit_indices[position] >= allocation->second.qubit_count) {
+                const RegisterAllocation* allocation = find_allocation(rebased.qubit_registers[position]);
+                if (allocation == nullptr || rebased.qubit_indices[position] >= allocation->qubit_count) {
                     result.diagnostics.push_back(error("SYNQ-SIM001", gate->span,
                                                        "simulator cannot map a gate operand to an explicit qubit register",
                                                        "declare the referenced register before simulation and use an in-range index"));
                     return result;
                 }
-                rebased.qubit_indices[position] = allocation->second.physical_offset + rebased.qubit_indices[position];
+                rebased.qubit_indices[position] = allocation->physical_offset + rebased.qubit_indices[position];
             }
             gates.push_back(std::move(rebased));
             continue;
@@ -351,15 +710,15 @@ BoundedSimulationResult simulate_bounded_quantum(const ResolvedHybridProgram& pr
                 return result;
             }
             measurements_started = true;
-            const auto allocation = allocations.find(measurement->qubit_register_name);
-            if (allocation == allocations.end() || measurement->qubit_index >= allocation->second.qubit_count) {
+            const RegisterAllocation* allocation = find_allocation(measurement->qubit_register);
+            if (allocation == nullptr || measurement->qubit_index >= allocation->qubit_count) {
                 result.diagnostics.push_back(error("SYNQ-SIM001", measurement->span,
                                                    "simulator cannot map a measurement operand to an explicit qubit register",
                                                    "declare the referenced register before simulation and use an in-range index"));
                 return result;
             }
             HybridMeasurement rebased = *measurement;
-            rebased.qubit_index = allocation->second.physical_offset + measurement->qubit_index;
+            rebased.qubit_index = allocation->physical_offset + measurement->qubit_index;
             measurements.push_back(std::move(rebased));
             continue;
         }
@@ -369,7 +728,11 @@ BoundedSimulationResult simulate_bounded_quantum(const ResolvedHybridProgram& pr
         return result;
     }
 
-    if (registers.empty() || qubit_count == 0 || qubit_count > options.max_qubits) {
+    const bool stabilizer =
+        options.allow_stabilizer_simulation && !feedback.has_value() &&
+        std::all_of(gates.begin(), gates.end(), [](const HybridQuantumGate& gate) { return is_clifford_gate(gate.kind); });
+    if (registers.empty() || qubit_count == 0 ||
+        qubit_count > (stabilizer ? options.max_stabilizer_qubits : options.max_qubits)) {
         result.diagnostics.push_back(error("SYNQ-SIM001", {},
                                            "simulator requires explicit qubit register declarations inside the configured qubit limit",
                                            "declare one or more `qubit name[n]` registers totaling 1 through max_qubits qubits before simulation"));
@@ -381,73 +744,303 @@ BoundedSimulationResult simulate_bounded_quantum(const ResolvedHybridProgram& pr
         return result;
     }
 
-    std::vector<Complex> state(std::size_t{1} << qubit_count, Complex{0.0, 0.0});
-    state.front() = Complex{1.0, 0.0};
+    SimulationPlan plan;
+    plan.backend = stabilizer ? SimulationBackend::Stabilizer : SimulationBackend::StateVector;
+    plan.qubit_count = qubit_count;
+    plan.source_operation_count = gates.size() + (feedback.has_value() ? 1 : 0);
+    plan.registers = std::move(registers);
+    elementary.clear();
+    rotations.clear();
+    elementary.reserve(gates.size() + 1);
     for (const auto& gate : gates) {
+        if (is_rotation_gate(gate.kind)) rotations.push_back({elementary.size(), gate.kind});
         Diagnostic diagnostic;
-        if (!apply_gate(gate, state, diagnostic)) {
+        if (!lower_gate(gate, elementary, diagnostic)) {
             result.diagnostics.push_back(std::move(diagnostic));
             return result;
         }
     }
-
-    double norm = 0.0;
-    for (const auto& amplitude : state) norm += std::norm(amplitude);
-    if (!std::isfinite(norm) || std::abs(norm - 1.0) > 1e-9) {
-        result.diagnostics.push_back(error("SYNQ-SIM005", {}, "simulator state normalization check failed",
-                                           "reduce the circuit and report the reproducible input; no result was produced"));
-        return result;
+    if (stabilizer) {
+        for (const auto& gate : gates) lower_clifford_gate(gate, plan.clifford_operations);
     }
 
-    std::vector<double> final_probabilities(state.size(), 0.0);
+    const auto plan_measurement = [&](const HybridMeasurement& measurement) {
+        const RegisterAllocation& allocation = *allocations[measurement.qubit_register];
+        return PlannedMeasurement{allocation.position, measurement.qubit_index - allocation.physical_offset,
+                                  measurement.qubit_index};
+    };
+    for (const auto& measurement : measurements) plan.measurements.push_back(plan_measurement(measurement));
     if (feedback.has_value()) {
-        const double probability_of_one = probability_one(state, feedback->measurement.qubit_index);
-        const double probability_of_zero = 1.0 - probability_of_one;
-        if (probability_of_zero > kProbabilityEpsilon) {
-            const std::vector<Complex> zero_branch = collapsed_measurement_branch(
-                state, feedback->measurement.qubit_index, false, probability_of_zero);
-            for (std::size_t basis = 0; basis < zero_branch.size(); ++basis) {
-                final_probabilities[basis] += probability_of_zero * std::norm(zero_branch[basis]);
-            }
+        std::vector<ElementaryGate> correction;
+        Diagnostic diagnostic;
+        if (!lower_gate(feedback->correction, correction, diagnostic)) {
+            result.diagnostics.push_back(std::move(diagnostic));
+            return result;
         }
-        if (probability_of_one > kProbabilityEpsilon) {
-            std::vector<Complex> one_branch = collapsed_measurement_branch(
-                state, feedback->measurement.qubit_index, true, probability_of_one);
-            Diagnostic diagnostic;
-            if (!apply_gate(feedback->correction, one_branch, diagnostic)) {
-                result.diagnostics.push_back(std::move(diagnostic));
-                return result;
-            }
-            for (std::size_t basis = 0; basis < one_branch.size(); ++basis) {
-                final_probabilities[basis] += probability_of_one * std::norm(one_branch[basis]);
-            }
+        if (correction.size() != 1) {
+            result.diagnostics.push_back(error("SYNQ-SIM006", feedback->correction.span,
+                                               "simulator received an unsupported U4 correction shape",
+                                               "use one direct single-qubit x correction"));
+            return result;
         }
+        plan.has_feedback = true;
+        plan.feedback_measurement = plan_measurement(feedback->measurement);
+        plan.feedback_correction =
+            make_single_kernel_operation(correction.front().qubit, correction.front().matrix.data());
+    }
+    result.plan = std::move(plan);
+    return result;
+}
+
+// Fuses lowered gates and appends one kernel operation per fused block.
+void fuse_operations(const std::vector<ElementaryGate>& elementary, std::size_t qubit_count,
+                     std::vector<KernelOperation>& operations) {
+    GateFuser fuser(qubit_count);
+    for (const auto& gate : elementary) fuser.add(gate);
+    for (const auto& fused : fuser.finish()) {
+        operations.push_back(fused.pair ? make_pair_kernel_operation(fused.first, fused.second, fused.matrix.data())
+                                        : make_single_kernel_operation(fused.first, fused.matrix.data()));
+    }
+}
+
+}  // namespace
+
+SimulationPlanResult prepare_bounded_simulation(const ResolvedHybridProgram& program,
+                                                const BoundedSimulationOptions& options) {
+    std::vector<ElementaryGate> elementary;
+    std::vector<RotationSlot> rotations;
+    SimulationPlanResult result = lower_program(program, options, elementary, rotations);
+    if (result.ok() && result.plan->backend == SimulationBackend::StateVector) {
+        fuse_operations(elementary, result.plan->qubit_count, result.plan->operations);
+    }
+    return result;
+}
+
+namespace {
+
+// Runs a stabilizer plan in `tableau` and fills `simulation` apart from its
+// measurements, whose marginals are written to `marginals`.
+bool run_stabilizer_plan(const SimulationPlan& plan, const BoundedSimulationOptions& options,
+                         StabilizerTableau& tableau, StabilizerSupport& support, std::vector<std::size_t>& basis,
+                         std::vector<double>& weights, std::vector<std::size_t>& scratch, AliasTable& alias,
+                         std::vector<double>& marginals, BoundedSimulation& simulation,
+                         std::vector<Diagnostic>& diagnostics) {
+    if (options.shots != 0 && plan.qubit_count > 63) {
+        diagnostics.push_back(error("SYNQ-SIM001", {}, "stabilizer shot histograms support at most 63 qubits",
+                                    "omit shots to obtain marginal probabilities for wider Clifford programs"));
+        return false;
+    }
+    tableau.reset(plan.qubit_count);
+    for (const auto& operation : plan.clifford_operations) tableau.apply(operation);
+    tableau.measurement_support(support);
+    marginals.clear();
+    for (const auto& planned : plan.measurements) marginals.push_back(support.probability_one(planned.qubit_index));
+
+    const bool listed = list_stabilizer_support(support, options.max_qubits, basis);
+    const double probability = std::ldexp(1.0, -static_cast<int>(support.rank));
+    if (options.shots == 0) {
+        simulation.basis_probabilities_omitted = !listed;
+        if (listed) {
+            for (const std::size_t index : basis) simulation.basis_probabilities.push_back({index, probability});
+        }
+    } else if (listed) {
+        // The same alias-table draw as the state-vector path over the same support.
+        weights.assign(basis.size(), probability);
+        alias.assign(weights);
+        sample_shot_histogram(alias, basis, options.shots, options.seed, scratch, simulation.shot_counts);
     } else {
-        for (std::size_t basis = 0; basis < state.size(); ++basis) {
-            final_probabilities[basis] = std::norm(state[basis]);
+        sample_stabilizer_shots(support, options.shots, options.seed, scratch, simulation.shot_counts);
+    }
+    return true;
+}
+
+}  // namespace
+
+bool run_bounded_simulation(const SimulationPlan& plan, const BoundedSimulationOptions& options,
+                            SimulationWorkspace& workspace, BoundedSimulation& simulation,
+                            std::vector<Diagnostic>& diagnostics) {
+    if (plan.backend == SimulationBackend::Stabilizer) {
+        simulation.basis_probabilities.clear();
+        simulation.shot_counts.clear();
+        simulation.basis_probabilities_omitted = false;
+        if (!run_stabilizer_plan(plan, options, workspace.tableau_, workspace.stabilizer_support_,
+                                 workspace.support_, workspace.weights_, workspace.shot_scratch_, workspace.alias_,
+                                 workspace.marginals_, simulation, diagnostics)) {
+            return false;
+        }
+        simulation.qubit_count = plan.qubit_count;
+        simulation.kernel_isa = SimulationKernelIsa::Scalar;
+        simulation.precision = SimulationPrecision::F64;
+        simulation.backend = SimulationBackend::Stabilizer;
+        simulation.registers = plan.registers;
+        simulation.shots = options.shots;
+        simulation.seed = options.shots == 0 ? 0 : options.seed;
+        simulation.measurements.resize(plan.measurements.size());
+        for (std::size_t index = 0; index < plan.measurements.size(); ++index) {
+            write_measurement(plan, plan.measurements[index], workspace.marginals_[index],
+                              simulation.measurements[index]);
         }
+        return true;
     }
 
-    BoundedSimulation simulation;
-    simulation.qubit_count = qubit_count;
-    simulation.registers = registers;
-    for (std::size_t basis = 0; basis < final_probabilities.size(); ++basis) {
-        const double probability = final_probabilities[basis];
-        if (probability > kProbabilityEpsilon) simulation.basis_probabilities.push_back({basis, probability});
-    }
-    for (const auto& measurement : measurements) {
-        const auto allocation = allocations.find(measurement.qubit_register_name);
-        const std::size_t source_index = measurement.qubit_index - allocation->second.physical_offset;
-        simulation.measurements.push_back({measurement.qubit_register_name, source_index, measurement.qubit_index,
-                                           probability_one(state, measurement.qubit_index)});
+    const SimulationKernelIsa isa =
+        options.force_scalar_kernels ? SimulationKernelIsa::Scalar : detect_simulation_kernel_isa();
+    const double tolerance = normalization_tolerance(options.precision);
+    std::vector<double>& final_probabilities = workspace.probabilities_;
+    const bool normalized =
+        options.precision == SimulationPrecision::F32
+            ? evolve_plan(plan, isa, options.cache_block_sweeps, tolerance, workspace.pool_,
+                          workspace.partial_sums_, workspace.single_state_, final_probabilities,
+                          workspace.marginals_)
+            : evolve_plan(plan, isa, options.cache_block_sweeps, tolerance, workspace.pool_,
+                          workspace.partial_sums_, workspace.state_, final_probabilities, workspace.marginals_);
+    if (!normalized) {
+        diagnostics.push_back(error("SYNQ-SIM005", {}, "simulator state normalization check failed",
+                                    "reduce the circuit and report the reproducible input; no result was produced"));
+        return false;
     }
-    if (feedback.has_value()) {
-        const auto allocation = allocations.find(feedback->measurement.qubit_register_name);
-        const std::size_t source_index = feedback->measurement.qubit_index - allocation->second.physical_offset;
-        simulation.measurements.push_back({feedback->measurement.qubit_register_name, source_index,
-                                           feedback->measurement.qubit_index,
-                                           probability_one(state, feedback->measurement.qubit_index)});
+
+    simulation.qubit_count = plan.qubit_count;
+    simulation.kernel_isa = isa;
+    simulation.precision = options.precision;
+    simulation.backend = SimulationBackend::StateVector;
+    simulation.basis_probabilities_omitted = false;
+    simulation.registers = plan.registers;
+    simulation.basis_probabilities.clear();
+    simulation.shot_counts.clear();
+    simulation.shots = options.shots;
+    simulation.seed = options.shots == 0 ? 0 : options.seed;
+    if (options.shots == 0) {
+        for (std::size_t basis = 0; basis < final_probabilities.size(); ++basis) {
+            const double probability = final_probabilities[basis];
+            if (probability > kProbabilityEpsilon) simulation.basis_probabilities.push_back({basis, probability});
+        }
+    } else {
+        workspace.support_.clear();
+        workspace.weights_.clear();
+        for (std::size_t basis = 0; basis < final_probabilities.size(); ++basis) {
+            const double probability = final_probabilities[basis];
+            if (probability <= kProbabilityEpsilon) continue;
+            workspace.support_.push_back(basis);
+            workspace.weights_.push_back(probability);
+        }
+        workspace.alias_.assign(workspace.weights_);
+        sample_shot_histogram(workspace.alias_, workspace.support_, options.shots, options.seed,
+                              workspace.shot_scratch_, simulation.shot_counts);
+    }
+    simulation.measurements.resize(plan.measurements.size() + (plan.has_feedback ? 1 : 0));
+    for (std::size_t index = 0; index < plan.measurements.size(); ++index) {
+        write_measurement(plan, plan.measurements[index], workspace.marginals_[index], simulation.measurements[index]);
+    }
+    if (plan.has_feedback) {
+        write_measurement(plan, plan.feedback_measurement, workspace.marginals_.back(), simulation.measurements.back());
+    }
+    return true;
+}
+
+std::size_t count_sweep_parameters(const ResolvedHybridProgram& program) {
+    std::size_t count = 0;
+    for (const auto& node : program.nodes) {
+        const auto* gate = std::get_if<HybridQuantumGate>(&node);
+        if (gate != nullptr && is_rotation_gate(gate->kind)) ++count;
+    }
+    return count;
+}
+
+ParameterSweepResult simulate_parameter_sweep(const ResolvedHybridProgram& program, const AngleBindings& bindings,
+                                              const BoundedSimulationOptions& options) {
+    ParameterSweepResult result;
+    BoundedSimulationOptions run_options = options;
+    run_options.shots = 0;
+    run_options.allow_stabilizer_simulation = false;
+    std::vector<ElementaryGate> elementary;
+    std::vector<RotationSlot> rotations;
+    SimulationPlanResult lowered = lower_program(program, run_options, elementary, rotations);
+    if (!lowered.ok()) {
+        result.diagnostics = std::move(lowered.diagnostics);
+        return result;
     }
+    const std::size_t binding_count = bindings.binding_count;
+    const bool shaped = bindings.parameter_count == rotations.size() &&
+                        (bindings.parameter_count == 0 ||
+                         binding_count <= std::numeric_limits<std::size_t>::max() / bindings.parameter_count) &&
+                        bindings.angles.size() == binding_count * bindings.parameter_count;
+    if (!shaped || !std::all_of(bindings.angles.begin(), bindings.angles.end(),
+                                [](double angle) { return std::isfinite(angle); })) {
+        result.diagnostics.push_back(error("SYNQ-SIM008", {}, "angle bindings do not match the program's rotation gates",
+                                           "supply one finite angle per rx, ry, rz, or p gate for every binding"));
+        return result;
+    }
+
+    const SimulationPlan& structure = *lowered.plan;
+    ParameterSweep sweep;
+    sweep.qubit_count = structure.qubit_count;
+    sweep.binding_count = binding_count;
+    sweep.registers = structure.registers;
+    sweep.measurements.resize(structure.measurements.size() + (structure.has_feedback ? 1 : 0));
+    for (std::size_t index = 0; index < structure.measurements.size(); ++index) {
+        write_measurement(structure, structure.measurements[index], 0.0, sweep.measurements[index]);
+    }
+    if (structure.has_feedback) {
+        write_measurement(structure, structure.feedback_measurement, 0.0, sweep.measurements.back());
+    }
+    sweep.probability_one.assign(sweep.measurements.size() * binding_count, 0.0);
+
+    // Bindings are striped over workers; each owns a plan copy, gate list, and
+    // workspace, so the only shared writes are disjoint result cells.
+    struct Worker {
+        SimulationPlan plan;
+        std::vector<ElementaryGate> gates;
+        SimulationWorkspace workspace;
+        BoundedSimulation simulation;
+        std::vector<Diagnostic> diagnostics;
+    };
+    const std::size_t worker_count = std::max<std::size_t>(1, std::min(options.threads, binding_count));
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (std::size_t index = 0; index < worker_count; ++index) workers.push_back(std::make_unique<Worker>());
+    SweepPool pool(worker_count);
+    pool.run(binding_count == 0 ? 0 : worker_count, [&](std::size_t worker_index) {
+        Worker& worker = *workers[worker_index];
+        worker.plan = structure;
+        worker.gates = elementary;
+        for (std::size_t binding = worker_index; binding < binding_count; binding += worker_count) {
+            const double* angles = bindings.angles.data() + binding * bindings.parameter_count;
+            for (std::size_t parameter = 0; parameter < rotations.size(); ++parameter) {
+                worker.gates[rotations[parameter].elementary_index].matrix =
+                    rotation_matrix(rotations[parameter].kind, angles[parameter]);
+            }
+            worker.plan.operations.clear();
+            fuse_operations(worker.gates, structure.qubit_count, worker.plan.operations);
+            if (!run_bounded_simulation(worker.plan, run_options, worker.workspace, worker.simulation,
+                                        worker.diagnostics)) {
+                return;
+            }
+            for (std::size_t measurement = 0; measurement < sweep.measurements.size(); ++measurement) {
+                sweep.probability_one[measurement * binding_count + binding] =
+                    worker.simulation.measurements[measurement].probability_one;
+            }
+        }
+    });
+    for (const auto& worker : workers) {
+        if (worker->diagnostics.empty()) continue;
+        result.diagnostics = worker->diagnostics;
+        return result;
+    }
+    result.sweep = std::move(sweep);
+    return result;
+}
+
+BoundedSimulationResult simulate_bounded_quantum(const ResolvedHybridProgram& program,
+                                                  const BoundedSimulationOptions& options) {
+    BoundedSimulationResult result;
+    auto prepared = prepare_bounded_simulation(program, options);
+    if (!prepared.ok()) {
+        result.diagnostics = std::move(prepared.diagnostics);
+        return result;
+    }
+    SimulationWorkspace workspace(options.threads);
+    BoundedSimulation simulation;
+    if (!run_bounded_simulation(*prepared.plan, options, workspace, simulation, result.diagnostics)) return result;
     result.simulation = std::move(simulation);
     return result;
 }
@@ -4,15 +4,27 @@
 #define SYNQ_COMPILER_BOUNDED_SIMULATOR_H
 
 #include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <vector>
 
 #include "diagnostic.h"
 #include "name_resolution.h"
+#include "shot_sampler.h"
+#include "stabilizer_tableau.h"
+#include "statevector_kernels.h"
+#include "sweep_pool.h"
 
 namespace synq::compiler {
 
+enum class SimulationBackend {
+    StateVector,
+    Stabilizer,
+};
+
+const char* simulation_backend_name(SimulationBackend backend);
+
 struct BasisProbability {
     std::size_t basis_index = 0;
     double probability = 0.0;
@@ -34,14 +46,52 @@ struct SimulatedRegister {
 struct BoundedSimulation {
     std::size_t qubit_count = 0;
     std::vector<SimulatedRegister> registers;
+    // Dense nonzero distribution; left empty when shots were requested.
     std::vector<BasisProbability> basis_probabilities;
+    // Sampled histogram over the same distribution when shots > 0.
+    std::size_t shots = 0;
+    std::uint64_t seed = 0;
+    std::vector<ShotCount> shot_counts;
     std::vector<MeasurementProbability> measurements;
+    // Amplitude-sweep instruction set used for this result.
+    SimulationKernelIsa kernel_isa = SimulationKernelIsa::Scalar;
+    SimulationPrecision precision = SimulationPrecision::F64;
+    SimulationBackend backend = SimulationBackend::StateVector;
+    // Set by the stabilizer backend when the register is wider than 63 qubits
+    // or the support has more than 2^max_qubits outcomes; only `measurements`
+    // (and no basis list) are reported then.
+    bool basis_probabilities_omitted = false;
 };
 
 struct BoundedSimulationOptions {
     bool allow_experimental_local_simulation = false;
     std::size_t max_qubits = 10;
     std::size_t max_operations = 1024;
+    // Bypasses runtime SIMD dispatch so results can be checked against the
+    // scalar reference kernels.
+    bool force_scalar_kernels = false;
+    // Threads sharing each amplitude sweep and probability reduction. Work is
+    // split into fixed cache-sized chunks, so every thread count produces the
+    // same result; one thread keeps the simulation on the calling thread.
+    std::size_t threads = 1;
+    // Applies each run of consecutive operations on the low qubits block by
+    // block rather than sweeping the whole state once per operation. Results
+    // are bitwise identical; disabling it keeps the per-operation sweeps for
+    // comparison.
+    bool cache_block_sweeps = true;
+    // When nonzero, draws this many outcomes from the final distribution and
+    // returns `shot_counts` instead of `basis_probabilities`.
+    std::size_t shots = 0;
+    std::uint64_t seed = 0;
+    // Amplitude storage precision. F32 halves state memory and is accurate to
+    // about 1e-6 in probabilities; its normalization check allows 1e-4 instead
+    // of 1e-9.
+    SimulationPrecision precision = SimulationPrecision::F64;
+    // Opts into the stabilizer backend for programs that use only h, x, y, z,
+    // cx, and bell_pair and have no measurement feedback. Such programs are
+    // bounded by max_stabilizer_qubits instead of max_qubits.
+    bool allow_stabilizer_simulation = false;
+    std::size_t max_stabilizer_qubits = 1024;
 };
 
 struct BoundedSimulationResult {
@@ -51,16 +101,148 @@ struct BoundedSimulationResult {
     bool ok() const;
 };
 
+// A measurement resolved to a position in `SimulationPlan::registers`, its
+// source index within that register, and its physical qubit.
+struct PlannedMeasurement {
+    std::size_t register_position = 0;
+    std::size_t register_index = 0;
+    std::size_t qubit_index = 0;
+};
+
+// A validated program lowered once to physical indices and fused kernel
+// operations. Running a plan performs no register-name lookup, angle parsing,
+// gate lowering, or fusion. Stabilizer plans hold Clifford generators instead
+// of kernel operations and never carry feedback.
+struct SimulationPlan {
+    SimulationBackend backend = SimulationBackend::StateVector;
+    std::size_t qubit_count = 0;
+    // Source gates counted against max_operations, including a feedback pair.
+    std::size_t source_operation_count = 0;
+    std::vector<SimulatedRegister> registers;
+    std::vector<KernelOperation> operations;
+    std::vector<CliffordOperation> clifford_operations;
+    std::vector<PlannedMeasurement> measurements;
+    // The optional U4 pair: the measured qubit and the single-qubit correction
+    // applied to the branch that observed one.
+    bool has_feedback = false;
+    PlannedMeasurement feedback_measurement;
+    KernelOperation feedback_correction;
+};
+
+struct SimulationPlanResult {
+    std::optional<SimulationPlan> plan;
+    std::vector<Diagnostic> diagnostics;
+
+    bool ok() const;
+};
+
+// Buffers and worker threads reused across plan runs. After the first run of
+// a plan, later runs of plans no larger than it allocate no heap memory when
+// they write into the same `BoundedSimulation`.
+class SimulationWorkspace {
+public:
+    explicit SimulationWorkspace(std::size_t threads = 1);
+
+    SimulationWorkspace(const SimulationWorkspace&) = delete;
+    SimulationWorkspace& operator=(const SimulationWorkspace&) = delete;
+
+    std::size_t thread_count() const { return pool_.thread_count(); }
+
+private:
+    friend bool run_bounded_simulation(const SimulationPlan&, const BoundedSimulationOptions&, SimulationWorkspace&,
+                                       BoundedSimulation&, std::vector<Diagnostic>&);
+
+    SweepPool pool_;
+    AmplitudeBuffer state_;
+    AmplitudeBufferOf<float> single_state_;
+    std::vector<double> probabilities_;
+    std::vector<double> partial_sums_;
+    std::vector<double> marginals_;
+    std::vector<std::size_t> support_;
+    std::vector<double> weights_;
+    std::vector<std::size_t> shot_scratch_;
+    AliasTable alias_;
+    StabilizerTableau tableau_;
+    StabilizerSupport stabilizer_support_;
+};
+
+// Applies the opt-in, register, operation-limit, and shape checks of
+// `simulate_bounded_quantum` and lowers the program into a reusable plan.
+SimulationPlanResult prepare_bounded_simulation(const ResolvedHybridProgram& program,
+                                                const BoundedSimulationOptions& options);
+
+// Runs a prepared plan, overwriting `simulation` in place. Only
+// `force_scalar_kernels`, `cache_block_sweeps`, `shots`, `seed`, and
+// `precision` are read from `options`, plus `max_qubits` for stabilizer plans,
+// where it bounds the rank of a support that is listed outcome by outcome; the
+// workspace fixes the thread count. Returns false after appending a diagnostic
+// if the normalization check fails or shots are requested from a stabilizer
+// plan wider than 63 qubits.
+bool run_bounded_simulation(const SimulationPlan& plan, const BoundedSimulationOptions& options,
+                            SimulationWorkspace& workspace, BoundedSimulation& simulation,
+                            std::vector<Diagnostic>& diagnostics);
+
 // Simulates a pure state prepared from |0...0> by one or more explicit
 // `qubit name[n]` declarations. Registers retain their source identity in the
 // result and are flattened internally in declaration order for the bounded state
 // vector. Supported gates and optional trailing unnamed measurements are then
 // applied to the mapped physical indices. Measurements report marginal
-// probabilities and do not sample or collapse the state. Every other typed node
-// is rejected rather than ignored.
+// probabilities and do not collapse the state; requested shots are drawn from
+// the final distribution with a seeded, reproducible sampler. Every other typed
+// node is rejected rather than ignored. This prepares a plan and runs it once in
+// a fresh workspace.
 BoundedSimulationResult simulate_bounded_quantum(const ResolvedHybridProgram& program,
                                                   const BoundedSimulationOptions& options);
 
+// Angle bindings for a parameter sweep: `binding_count` rows of
+// `parameter_count` angles, one column per rx, ry, rz, or p gate in source
+// order, stored row-major. Each column replaces that gate's literal angle, in
+// radians.
+struct AngleBindings {
+    std::size_t binding_count = 0;
+    std::size_t parameter_count = 0;
+    std::vector<double> angles;
+};
+
+// Columnar sweep output. `measurements` describes each measured operand once
+// (its `probability_one` is unused); `probability_one` holds one contiguous
+// column per measurement, so binding b of measurement m is at
+// m * binding_count + b.
+struct ParameterSweep {
+    std::size_t qubit_count = 0;
+    std::size_t binding_count = 0;
+    std::vector<SimulatedRegister> registers;
+    std::vector<MeasurementProbability> measurements;
+    std::vector<double> probability_one;
+
+    double probability(std::size_t measurement, std::size_t binding) const {
+        return probability_one[measurement * binding_count + binding];
+    }
+};
+
+struct ParameterSweepResult {
+    std::optional<ParameterSweep> sweep;
+    std::vector<Diagnostic> diagnostics;
+
+    bool ok() const;
+};
+
+// Number of rx, ry, rz, and p gates, i.e. the columns a binding matrix for
+// `program` must have.
+std::size_t count_sweep_parameters(const ResolvedHybridProgram& program);
+
+// Simulates `program` once per row of `bindings`. The program is validated and
+// lowered once; each binding only recomputes its rotation matrices and fusion.
+// `options.threads` bindings run concurrently, each worker reusing its own
+// single-threaded workspace, and results do not depend on the thread count.
+// Sweeps use the state-vector backend and report marginals only, so `shots`
+// and `allow_stabilizer_simulation` are ignored. A binding matrix whose width
+// differs from the program's rotation count, whose size is not
+// binding_count * parameter_count, or that holds a non-finite angle is
+// rejected with SYNQ-SIM008.
+ParameterSweepResult simulate_parameter_sweep(const ResolvedHybridProgram& program, const AngleBindings& bindings,
+                                              const BoundedSimulationOptions& options);
+
 }  // namespace synq::compiler
 
 #endif
@@ -0,0 +1,765 @@
+#include "circuit_optimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace synq::compiler {
+namespace {
+
+constexpr std::uint32_t kNoRecord = static_cast<std::uint32_t>(-1);
+// Bounds pi/n divisors and decimal scales so that every sum below stays within
+// std::int64_t. Larger literals are left as written.
+constexpr std::int64_t kMaxPiDivisor = 1000000000;
+constexpr unsigned kMaxDecimalScale = 18;
+
+struct QubitKey {
+    SymbolId register_id = 0;
+    std::size_t index = 0;
+
+    bool operator==(const QubitKey& other) const {
+        return register_id == other.register_id && index == other.index;
+    }
+};
+
+struct QubitKeyHash {
+    std::size_t operator()(const QubitKey& key) const {
+        return std::hash<std::size_t>{}(key.index * 0x9E3779B97F4A7C15ULL ^ key.register_id);
+    }
+};
+
+// Registers and indices past these bounds live in a hash map instead of the
+// dense arrays.
+constexpr SymbolId kDenseRegisters = 1u << 12;
+constexpr std::size_t kDenseQubitIndices = std::size_t{1} << 16;
+
+// Per-qubit values. Declared registers are small and dense, so lookups index
+// one array per register; clear() is constant time because every entry is
+// stamped with the generation that wrote it.
+template <typename Value>
+class QubitTable {
+public:
+    const Value* find(const QubitKey& key) const {
+        const Entry* entry = lookup(key);
+        return entry != nullptr && entry->generation == generation_ ? &entry->value : nullptr;
+    }
+
+    void set(const QubitKey& key, Value value) {
+        Entry& entry = slot(key);
+        entry.generation = generation_;
+        entry.value = value;
+    }
+
+    void erase(const QubitKey& key) {
+        if (const Entry* entry = lookup(key); entry != nullptr && entry->generation == generation_) {
+            slot(key).generation = 0;
+        }
+    }
+
+    void clear() { ++generation_; }
+
+private:
+    struct Entry {
+        std::uint32_t generation = 0;
+        Value value{};
+    };
+
+    static bool is_dense(const QubitKey& key) {
+        return key.register_id < kDenseRegisters && key.index < kDenseQubitIndices;
+    }
+
+    const Entry* lookup(const QubitKey& key) const {
+        if (is_dense(key)) {
+            if (key.register_id >= dense_.size() || key.index >= dense_[key.register_id].size()) return nullptr;
+            return &dense_[key.register_id][key.index];
+        }
+        const auto found = sparse_.find(key);
+        return found == sparse_.end() ? nullptr : &found->second;
+    }
+
+    Entry& slot(const QubitKey& key) {
+        if (!is_dense(key)) return sparse_[key];
+        if (key.register_id >= dense_.size()) dense_.resize(key.register_id + 1);
+        std::vector<Entry>& entries = dense_[key.register_id];
+        if (key.index >= entries.size()) entries.resize(key.index + 1);
+        return entries[key.index];
+    }
+
+    std::vector<std::vector<Entry>> dense_;
+    std::unordered_map<QubitKey, Entry, QubitKeyHash> sparse_;
+    std::uint32_t generation_ = 1;
+};
+
+// An exact literal angle: numerator * pi / denominator when `pi_multiple`,
+// otherwise the decimal numerator / 10^scale radians.
+struct LiteralAngle {
+    bool pi_multiple = false;
+    std::int64_t numerator = 0;
+    std::int64_t denominator = 1;
+    unsigned scale = 0;
+};
+
+bool parse_unsigned(const std::string& text, std::size_t begin, std::int64_t limit, std::int64_t& value) {
+    if (begin == text.size()) return false;
+    value = 0;
+    for (std::size_t position = begin; position < text.size(); ++position) {
+        if (text[position] < '0' || text[position] > '9') return false;
+        value = value * 10 + (text[position] - '0');
+        if (value > limit) return false;
+    }
+    return true;
+}
+
+// Accepts the spellings the exporter and simulator share: pi, -pi, pi/n,
+// -pi/n, and decimals.
+std::optional<LiteralAngle> parse_literal_angle(const std::string& text) {
+    const bool negative = !text.empty() && text.front() == '-';
+    const std::size_t start = negative ? 1 : 0;
+    LiteralAngle angle;
+    if (text.compare(start, std::string::npos, "pi") == 0) {
+        angle.pi_multiple = true;
+        angle.numerator = negative ? -1 : 1;
+        return angle;
+    }
+    if (text.compare(start, 3, "pi/") == 0) {
+        std::int64_t divisor = 0;
+        if (!parse_unsigned(text, start + 3, kMaxPiDivisor, divisor) || divisor == 0) return std::nullopt;
+        angle.pi_multiple = true;
+        angle.numerator = negative ? -1 : 1;
+        angle.denominator = divisor;
+        return angle;
+    }
+    bool has_digit = false;
+    bool has_point = false;
+    for (std::size_t position = start; position < text.size(); ++position) {
+        const char character = text[position];
+        if (character == '.' && !has_point) {
+            has_point = true;
+            continue;
+        }
+        if (character < '0' || character > '9') return std::nullopt;
+        has_digit = true;
+        if (angle.numerator > (std::numeric_limits<std::int64_t>::max() - 9) / 10) return std::nullopt;
+        angle.numerator = angle.numerator * 10 + (character - '0');
+        if (has_point && ++angle.scale > kMaxDecimalScale) return std::nullopt;
+    }
+    if (!has_digit) return std::nullopt;
+    if (negative) angle.numerator = -angle.numerator;
+    return angle;
+}
+
+bool is_zero(const LiteralAngle& angle) { return !angle.pi_multiple && angle.numerator == 0; }
+
+// The identity period in units of pi: rx, ry, and rz are -I at 2*pi.
+std::int64_t period_in_pi(QuantumGateKind kind) { return kind == QuantumGateKind::Phase ? 2 : 4; }
+
+std::optional<std::int64_t> scale_by_power_of_ten(std::int64_t value, unsigned exponent) {
+    for (; exponent != 0; --exponent) {
+        if (value > std::numeric_limits<std::int64_t>::max() / 10 ||
+            value < std::numeric_limits<std::int64_t>::min() / 10) {
+            return std::nullopt;
+        }
+        value *= 10;
+    }
+    return value;
+}
+
+// Sums two angles of the same form when the result is again a literal. A pi
+// multiple is reduced to (-period/2, period/2], which makes whole periods zero.
+std::optional<LiteralAngle> add_angles(const LiteralAngle& first, const LiteralAngle& second, QuantumGateKind kind) {
+    if (first.pi_multiple != second.pi_multiple) return std::nullopt;
+    LiteralAngle sum;
+    if (first.pi_multiple) {
+        // Parsed and merged pi multiples keep |numerator| <= 1 and
+        // denominator <= kMaxPiDivisor, so neither product overflows.
+        sum.pi_multiple = true;
+        sum.numerator = first.numerator * second.denominator + second.numerator * first.denominator;
+        sum.denominator = first.denominator * second.denominator;
+        const std::int64_t divisor = std::gcd(sum.numerator, sum.denominator);
+        if (divisor > 1) {
+            sum.numerator /= divisor;
+            sum.denominator /= divisor;
+        }
+        const std::int64_t period = period_in_pi(kind) * sum.denominator;
+        sum.numerator %= period;
+        if (sum.numerator > period / 2) sum.numerator -= period;
+        if (sum.numerator <= -period / 2) sum.numerator += period;
+        if (sum.numerator == 0) return LiteralAngle{};
+        if ((sum.numerator != 1 && sum.numerator != -1) || sum.denominator > kMaxPiDivisor) return std::nullopt;
+        return sum;
+    }
+    sum.scale = std::max(first.scale, second.scale);
+    const auto left = scale_by_power_of_ten(first.numerator, sum.scale - first.scale);
+    const auto right = scale_by_power_of_ten(second.numerator, sum.scale - second.scale);
+    if (!left.has_value() || !right.has_value()) return std::nullopt;
+    if ((*right > 0 && *left > std::numeric_limits<std::int64_t>::max() - *right) ||
+        (*right < 0 && *left < std::numeric_limits<std::int64_t>::min() - *right)) {
+        return std::nullopt;
+    }
+    sum.numerator = *left + *right;
+    while (sum.scale != 0 && sum.numerator % 10 == 0) {
+        sum.numerator /= 10;
+        --sum.scale;
+    }
+    return sum;
+}
+
+std::string render_angle(const LiteralAngle& angle) {
+    const bool negative = angle.numerator < 0;
+    if (angle.pi_multiple) {
+        std::string text = negative ? "-pi" : "pi";
+        if (angle.denominator != 1) text += "/" + std::to_string(angle.denominator);
+        return text;
+    }
+    std::string digits = std::to_string(angle.numerator);
+    if (negative) digits.erase(0, 1);
+    if (angle.scale != 0) {
+        if (digits.size() <= angle.scale) digits.insert(0, angle.scale - digits.size() + 1, '0');
+        digits.insert(digits.size() - angle.scale, 1, '.');
+    }
+    return negative ? "-" + digits : digits;
+}
+
+bool is_self_inverse(QuantumGateKind kind) {
+    return kind == QuantumGateKind::H || kind == QuantumGateKind::X || kind == QuantumGateKind::Y ||
+           kind == QuantumGateKind::Z || kind == QuantumGateKind::Cx;
+}
+
+bool is_rotation(QuantumGateKind kind) {
+    return kind == QuantumGateKind::Rx || kind == QuantumGateKind::Ry || kind == QuantumGateKind::Rz ||
+           kind == QuantumGateKind::Phase;
+}
+
+QubitKey operand_key(const HybridQuantumGate& gate, std::size_t operand) {
+    return QubitKey{operand < gate.qubit_registers.size() ? gate.qubit_registers[operand] : kNoSymbol,
+                    gate.qubit_indices[operand]};
+}
+
+// One kept top-level gate the pass can still rewrite. `previous` holds, per
+// operand, the record that was that qubit's frontier before this gate.
+struct GateRecord {
+    std::size_t node = 0;
+    QuantumGateKind kind = QuantumGateKind::Unknown;
+    QubitKey qubits[2];
+    std::uint32_t previous[2] = {kNoRecord, kNoRecord};
+    std::size_t arity = 0;
+    LiteralAngle angle;
+    bool removed = false;
+};
+
+class PeepholePass {
+public:
+    PeepholePass(HybridProgram& program, const CircuitOptimizationOptions& options,
+                 CircuitOptimizationReport& report)
+        : program_(program), options_(options), report_(report), removed_(program.nodes.size(), false) {}
+
+    void run() {
+        for (std::size_t index = 0; index < program_.nodes.size(); ++index) {
+            HybridNode& node = program_.nodes[index];
+            if (auto* gate = std::get_if<HybridQuantumGate>(&node)) {
+                visit_gate(index, *gate);
+            } else if (const auto* measurement = std::get_if<HybridMeasurement>(&node)) {
+                frontier_.erase(QubitKey{measurement->qubit_register, measurement->qubit_index});
+            } else if (std::holds_alternative<HybridControlFlow>(node) ||
+                       std::holds_alternative<HybridCallableCall>(node)) {
+                frontier_.clear();
+            }
+        }
+        std::size_t kept = 0;
+        for (std::size_t index = 0; index < program_.nodes.size(); ++index) {
+            if (removed_[index]) continue;
+            if (kept != index) program_.nodes[kept] = std::move(program_.nodes[index]);
+            ++kept;
+        }
+        program_.nodes.resize(kept);
+    }
+
+private:
+    // Builds the record for a gate the pass understands, or nothing for one it
+    // must treat as opaque.
+    std::optional<GateRecord> describe(std::size_t index, const HybridQuantumGate& gate) const {
+        GateRecord record;
+        record.node = index;
+        record.kind = gate.kind;
+        record.arity = gate.qubit_indices.size();
+        if (gate.qubit_registers.size() != record.arity) return std::nullopt;
+        if (is_self_inverse(gate.kind)) {
+            if (gate.literal_angle.has_value()) return std::nullopt;
+            if (record.arity != (gate.kind == QuantumGateKind::Cx ? 2u : 1u)) return std::nullopt;
+        } else if (is_rotation(gate.kind)) {
+            if (record.arity != 1 || !gate.literal_angle.has_value()) return std::nullopt;
+            const auto angle = parse_literal_angle(*gate.literal_angle);
+            if (!angle.has_value()) return std::nullopt;
+            record.angle = *angle;
+        } else {
+            return std::nullopt;
+        }
+        for (std::size_t operand = 0; operand < record.arity; ++operand) {
+            record.qubits[operand] = QubitKey{gate.qubit_registers[operand], gate.qubit_indices[operand]};
+        }
+        if (record.arity == 2 && record.qubits[0] == record.qubits[1]) return std::nullopt;
+        return record;
+    }
+
+    // The last kept gate on `qubit`, skipping records removed since.
+    std::uint32_t last_gate_on(const QubitKey& qubit) {
+        const std::uint32_t* frontier = frontier_.find(qubit);
+        std::uint32_t current = frontier == nullptr ? kNoRecord : *frontier;
+        while (current != kNoRecord && records_[current].removed) {
+            const GateRecord& record = records_[current];
+            current = record.qubits[0] == qubit ? record.previous[0] : record.previous[1];
+        }
+        return current;
+    }
+
+    void remove_node(std::size_t index) { removed_[index] = true; }
+
+    void remove_record(std::uint32_t id) {
+        GateRecord& record = records_[id];
+        record.removed = true;
+        remove_node(record.node);
+        for (std::size_t operand = 0; operand < record.arity; ++operand) {
+            frontier_.set(record.qubits[operand], record.previous[operand]);
+        }
+    }
+
+    void visit_gate(std::size_t index, HybridQuantumGate& gate) {
+        std::optional<GateRecord> record = describe(index, gate);
+        if (!record.has_value()) {
+            // Nothing rewrites across an opaque gate on the qubits it names;
+            // one without a full operand list might touch any of them.
+            if (!gate.qubit_indices.empty() && gate.qubit_registers.size() == gate.qubit_indices.size()) {
+                for (std::size_t operand = 0; operand < gate.qubit_indices.size(); ++operand) {
+                    frontier_.erase(operand_key(gate, operand));
+                }
+            } else {
+                frontier_.clear();
+            }
+            return;
+        }
+        if (options_.remove_identity_rotations && is_rotation(record->kind) && is_zero(record->angle)) {
+            remove_node(index);
+            ++report_.removed_identities;
+            return;
+        }
+        const std::uint32_t previous = last_gate_on(record->qubits[0]);
+        bool adjacent = previous != kNoRecord && records_[previous].kind == record->kind;
+        for (std::size_t operand = 0; adjacent && operand < record->arity; ++operand) {
+            adjacent = records_[previous].qubits[operand] == record->qubits[operand] &&
+                       (operand == 0 || last_gate_on(record->qubits[operand]) == previous);
+        }
+        if (adjacent && is_self_inverse(record->kind) && options_.cancel_self_inverse_pairs) {
+            remove_record(previous);
+            remove_node(index);
+            ++report_.cancelled_pairs;
+            return;
+        }
+        if (adjacent && is_rotation(record->kind) && options_.merge_rotations) {
+            const auto sum = add_angles(records_[previous].angle, record->angle, record->kind);
+            if (sum.has_value() && (!is_zero(*sum) || options_.remove_identity_rotations)) {
+                remove_node(index);
+                ++report_.merged_rotations;
+                if (is_zero(*sum)) {
+                    remove_record(previous);
+                    ++report_.removed_identities;
+                } else {
+                    records_[previous].angle = *sum;
+                    std::get<HybridQuantumGate>(program_.nodes[records_[previous].node]).literal_angle =
+                        render_angle(*sum);
+                }
+                return;
+            }
+        }
+        const auto id = static_cast<std::uint32_t>(records_.size());
+        for (std::size_t operand = 0; operand < record->arity; ++operand) {
+            record->previous[operand] = last_gate_on(record->qubits[operand]);
+            frontier_.set(record->qubits[operand], id);
+        }
+        records_.push_back(*record);
+    }
+
+    HybridProgram& program_;
+    const CircuitOptimizationOptions& options_;
+    CircuitOptimizationReport& report_;
+    std::vector<bool> removed_;
+    std::vector<GateRecord> records_;
+    // The record each qubit's next gate would be adjacent to. A qubit absent
+    // from the map follows a measurement, control, call, or opaque gate.
+    QubitTable<std::uint32_t> frontier_;
+};
+
+// Depth bookkeeping: each qubit's layer count, raised to `floor` by the calls
+// that occupy every qubit.
+class DepthCounter {
+public:
+    void occupy(const QubitKey& qubit) {
+        const std::size_t layer = layer_of(qubit) + 1;
+        layers_.set(qubit, layer);
+        depth_ = std::max(depth_, layer);
+    }
+
+    void occupy(const HybridQuantumGate& gate) {
+        std::size_t layer = floor_;
+        for (std::size_t operand = 0; operand < gate.qubit_indices.size(); ++operand) {
+            layer = std::max(layer, layer_of(operand_key(gate, operand)));
+        }
+        ++layer;
+        for (std::size_t operand = 0; operand < gate.qubit_indices.size(); ++operand) {
+            layers_.set(operand_key(gate, operand), layer);
+        }
+        depth_ = std::max(depth_, layer);
+    }
+
+    void occupy_all() {
+        floor_ = ++depth_;
+        layers_.clear();
+    }
+
+    std::size_t depth() const { return depth_; }
+
+private:
+    std::size_t layer_of(const QubitKey& qubit) const {
+        const std::size_t* layer = layers_.find(qubit);
+        return layer == nullptr ? floor_ : *layer;
+    }
+
+    QubitTable<std::size_t> layers_;
+    std::size_t floor_ = 0;
+    std::size_t depth_ = 0;
+};
+
+// How a gate acts on one of its qubits. Gates acting the same way on a shared
+// qubit commute there: each class spans a commutative algebra. General
+// commutes with nothing.
+enum class QubitAction : std::uint8_t {
+    Diagonal,
+    BitFlip,
+    YAxis,
+    Hadamard,
+    General,
+};
+
+constexpr std::size_t kQubitActions = 5;
+
+bool conflicts(QubitAction first, QubitAction second) {
+    return first == QubitAction::General || first != second;
+}
+
+// Fills the action of `gate` on each operand, or returns false for a gate the
+// scheduler treats as a barrier.
+bool describe_actions(const HybridQuantumGate& gate, QubitAction actions[2]) {
+    const std::size_t arity = gate.qubit_indices.size();
+    if (gate.qubit_registers.size() != arity) return false;
+    if (gate.literal_angle.has_value() != is_rotation(gate.kind)) return false;
+    switch (gate.kind) {
+        case QuantumGateKind::H:
+            actions[0] = QubitAction::Hadamard;
+            return arity == 1;
+        case QuantumGateKind::X:
+        case QuantumGateKind::Rx:
+            actions[0] = QubitAction::BitFlip;
+            return arity == 1;
+        case QuantumGateKind::Y:
+        case QuantumGateKind::Ry:
+            actions[0] = QubitAction::YAxis;
+            return arity == 1;
+        case QuantumGateKind::Z:
+        case QuantumGateKind::Rz:
+        case QuantumGateKind::Phase:
+            actions[0] = QubitAction::Diagonal;
+            return arity == 1;
+        case QuantumGateKind::Cx:
+            actions[0] = QubitAction::Diagonal;
+            actions[1] = QubitAction::BitFlip;
+            return arity == 2 && !(operand_key(gate, 0) == operand_key(gate, 1));
+        case QuantumGateKind::BellPair:
+            actions[0] = QubitAction::General;
+            actions[1] = QubitAction::General;
+            return arity == 2 && !(operand_key(gate, 0) == operand_key(gate, 1));
+        case QuantumGateKind::Unknown:
+            return false;
+    }
+    return false;
+}
+
+// Per-qubit layer occupancy over a sliding window. Layers below the window
+// count as occupied, which bounds the search for a free layer by the window
+// instead of by the circuit's depth.
+constexpr std::size_t kOccupancyWords = 4;
+constexpr std::size_t kOccupancyLayers = kOccupancyWords * 64;
+
+struct QubitLayers {
+    // The deepest layer holding a gate with each action on this qubit.
+    std::size_t action_layer[kQubitActions] = {};
+    // Layer of bit 0 of `occupied`; a multiple of 64.
+    std::size_t window_base = 0;
+    std::uint64_t occupied[kOccupancyWords] = {};
+
+    bool is_free(std::size_t layer) const {
+        if (layer < window_base) return false;
+        const std::size_t offset = layer - window_base;
+        if (offset >= kOccupancyLayers) return true;
+        return ((occupied[offset / 64] >> (offset % 64)) & 1) == 0;
+    }
+
+    void occupy(std::size_t layer) {
+        std::size_t offset = layer - window_base;
+        if (offset >= kOccupancyLayers) {
+            const std::size_t shift = (offset - kOccupancyLayers) / 64 + 1;
+            for (std::size_t word = 0; word < kOccupancyWords; ++word) {
+                occupied[word] = word + shift < kOccupancyWords ? occupied[word + shift] : 0;
+            }
+            window_base += shift * 64;
+            offset -= shift * 64;
+        }
+        occupied[offset / 64] |= std::uint64_t{1} << (offset % 64);
+    }
+};
+
+struct PlacedGate {
+    std::size_t node = 0;
+    std::size_t segment = 0;
+    std::size_t asap_layer = 0;
+    std::size_t arity = 0;
+    QubitKey qubits[2];
+    QubitAction actions[2] = {QubitAction::General, QubitAction::General};
+};
+
+// Places each gate at the earliest layer after every earlier gate it does not
+// commute with that is free on all its qubits, then derives ALAP layers in
+// one reverse pass.
+class LayerScheduler {
+public:
+    explicit LayerScheduler(const HybridProgram& program) : program_(program) {}
+
+    CircuitSchedule run() {
+        for (std::size_t index = 0; index < program_.nodes.size(); ++index) {
+            const auto* gate = std::get_if<HybridQuantumGate>(&program_.nodes[index]);
+            QubitAction actions[2];
+            if (gate != nullptr && describe_actions(*gate, actions)) {
+                place(index, *gate, actions);
+            } else {
+                barrier();
+            }
+        }
+        segment_depth_.push_back(depth_);
+        return build();
+    }
+
+private:
+    void barrier() {
+        if (qubits_.empty()) return;
+        segment_depth_.push_back(depth_);
+        floor_ = depth_;
+        slots_.clear();
+        qubits_.clear();
+    }
+
+    std::size_t qubit_slot(const QubitKey& key) {
+        if (const std::uint32_t* slot = slots_.find(key)) return *slot;
+        const auto slot = static_cast<std::uint32_t>(qubits_.size());
+        slots_.set(key, slot);
+        qubits_.emplace_back();
+        qubits_.back().window_base = floor_ / 64 * 64;
+        return slot;
+    }
+
+    void place(std::size_t index, const HybridQuantumGate& gate, const QubitAction actions[2]) {
+        PlacedGate placed;
+        placed.node = index;
+        placed.segment = segment_depth_.size();
+        placed.arity = gate.qubit_indices.size();
+        std::size_t slots[2] = {0, 0};
+        for (std::size_t operand = 0; operand < placed.arity; ++operand) {
+            placed.qubits[operand] = operand_key(gate, operand);
+            placed.actions[operand] = actions[operand];
+            slots[operand] = qubit_slot(placed.qubits[operand]);
+        }
+        std::size_t bound = floor_;
+        for (std::size_t operand = 0; operand < placed.arity; ++operand) {
+            const QubitLayers& layers = qubits_[slots[operand]];
+            for (std::size_t action = 0; action < kQubitActions; ++action) {
+                if (conflicts(actions[operand], static_cast<QubitAction>(action))) {
+                    bound = std::max(bound, layers.action_layer[action]);
+                }
+            }
+        }
+        std::size_t layer = bound + 1;
+        for (;;) {
+            bool free = true;
+            for (std::size_t operand = 0; free && operand < placed.arity; ++operand) {
+                free = qubits_[slots[operand]].is_free(layer);
+            }
+            if (free) break;
+            ++layer;
+        }
+        for (std::size_t operand = 0; operand < placed.arity; ++operand) {
+            QubitLayers& layers = qubits_[slots[operand]];
+            std::size_t& action_layer = layers.action_layer[static_cast<std::size_t>(actions[operand])];
+            action_layer = std::max(action_layer, layer);
+            layers.occupy(layer);
+        }
+        placed.asap_layer = layer;
+        depth_ = std::max(depth_, layer);
+        placed_.push_back(placed);
+    }
+
+    // A gate's ALAP layer is one below the earliest ALAP layer of any later
+    // gate in its segment it does not commute with, capped at the segment's
+    // deepest ASAP layer.
+    std::vector<std::size_t> alap_layers() const {
+        constexpr std::size_t kUnbounded = std::numeric_limits<std::size_t>::max();
+        std::vector<std::size_t> alap(placed_.size(), 0);
+        QubitTable<std::uint32_t> slots;
+        std::vector<std::array<std::size_t, kQubitActions>> earliest;
+        std::size_t segment = kUnbounded;
+        for (std::size_t position = placed_.size(); position-- > 0;) {
+            const PlacedGate& placed = placed_[position];
+            if (placed.segment != segment) {
+                segment = placed.segment;
+                slots.clear();
+                earliest.clear();
+            }
+            std::size_t operand_slots[2] = {0, 0};
+            std::size_t layer = segment_depth_[segment];
+            for (std::size_t operand = 0; operand < placed.arity; ++operand) {
+                const std::uint32_t* slot = slots.find(placed.qubits[operand]);
+                if (slot == nullptr) {
+                    slots.set(placed.qubits[operand], static_cast<std::uint32_t>(earliest.size()));
+                    earliest.emplace_back();
+                    earliest.back().fill(kUnbounded);
+                    operand_slots[operand] = earliest.size() - 1;
+                    continue;
+                }
+                operand_slots[operand] = *slot;
+                for (std::size_t action = 0; action < kQubitActions; ++action) {
+                    const std::size_t later = earliest[*slot][action];
+                    if (later != kUnbounded && conflicts(placed.actions[operand], static_cast<QubitAction>(action))) {
+                        layer = std::min(layer, later - 1);
+                    }
+                }
+            }
+            for (std::size_t operand = 0; operand < placed.arity; ++operand) {
+                std::size_t& own = earliest[operand_slots[operand]][static_cast<std::size_t>(placed.actions[operand])];
+                own = std::min(own, layer);
+            }
+            alap[position] = layer;
+        }
+        return alap;
+    }
+
+    // Orders gates by layer with a counting sort, which keeps program order
+    // within a layer.
+    CircuitSchedule build() const {
+        CircuitSchedule schedule;
+        schedule.depth = depth_;
+        schedule.layer_begin.assign(depth_ + 1, 0);
+        for (const PlacedGate& placed : placed_) ++schedule.layer_begin[placed.asap_layer];
+        for (std::size_t layer = 1; layer <= depth_; ++layer) {
+            schedule.layer_begin[layer] += schedule.layer_begin[layer - 1];
+        }
+        const std::vector<std::size_t> alap = alap_layers();
+        std::vector<std::size_t> next(schedule.layer_begin.begin(), schedule.layer_begin.end() - 1);
+        schedule.gates.resize(placed_.size());
+        for (std::size_t position = 0; position < placed_.size(); ++position) {
+            const PlacedGate& placed = placed_[position];
+            schedule.gates[next[placed.asap_layer - 1]++] =
+                ScheduledGate{placed.node, placed.asap_layer, alap[position]};
+        }
+        return schedule;
+    }
+
+    const HybridProgram& program_;
+    std::vector<PlacedGate> placed_;
+    // The deepest ASAP layer of each finished segment.
+    std::vector<std::size_t> segment_depth_;
+    QubitTable<std::uint32_t> slots_;
+    std::vector<QubitLayers> qubits_;
+    std::size_t floor_ = 0;
+    std::size_t depth_ = 0;
+};
+
+}  // namespace
+
+CircuitMetrics measure_hybrid_circuit(const HybridProgram& program) {
+    CircuitMetrics metrics;
+    DepthCounter depth;
+    const auto measure = [&](const HybridMeasurement& measurement) {
+        depth.occupy(QubitKey{measurement.qubit_register, measurement.qubit_index});
+    };
+    const auto gate = [&](const HybridQuantumGate& quantum_gate) {
+        ++metrics.gate_count;
+        if (quantum_gate.qubit_indices.empty()) {
+            depth.occupy_all();
+        } else {
+            depth.occupy(quantum_gate);
+        }
+    };
+    for (const HybridNode& node : program.nodes) {
+        if (const auto* quantum_gate = std::get_if<HybridQuantumGate>(&node)) {
+            gate(*quantum_gate);
+        } else if (const auto* measurement = std::get_if<HybridMeasurement>(&node)) {
+            measure(*measurement);
+        } else if (const auto* control = std::get_if<HybridControlFlow>(&node)) {
+            if (const auto* body = std::get_if<HybridQuantumGate>(&control->body)) {
+                gate(*body);
+            } else {
+                measure(std::get<HybridMeasurement>(control->body));
+            }
+        } else if (std::holds_alternative<HybridCallableCall>(node)) {
+            ++metrics.gate_count;
+            depth.occupy_all();
+        }
+    }
+    metrics.depth = depth.depth();
+    return metrics;
+}
+
+CircuitOptimizationReport optimize_hybrid_circuit(HybridProgram& program, const CircuitOptimizationOptions& options) {
+    CircuitOptimizationReport report;
+    report.before = measure_hybrid_circuit(program);
+    PeepholePass(program, options, report).run();
+    report.after = measure_hybrid_circuit(program);
+    return report;
+}
+
+CircuitSchedule schedule_hybrid_circuit(const HybridProgram& program) { return LayerScheduler(program).run(); }
+
+CircuitSchedulingReport reorder_hybrid_circuit(HybridProgram& program) {
+    CircuitSchedulingReport report;
+    report.before = measure_hybrid_circuit(program);
+    const CircuitSchedule schedule = schedule_hybrid_circuit(program);
+    report.layers = schedule.depth;
+    // Runs occupy consecutive nodes and their layers never interleave, so the
+    // k-th scheduled gate takes the k-th gate position in program order. The
+    // permutation is applied by swapping gates along its cycles, which needs
+    // no copy of the nodes.
+    std::vector<std::size_t> positions;
+    positions.reserve(schedule.gates.size());
+    for (const ScheduledGate& gate : schedule.gates) positions.push_back(gate.node);
+    std::sort(positions.begin(), positions.end());
+    std::vector<std::size_t> destination(program.nodes.size());
+    for (std::size_t rank = 0; rank < positions.size(); ++rank) {
+        destination[schedule.gates[rank].node] = positions[rank];
+        if (schedule.gates[rank].node != positions[rank]) ++report.moved_gates;
+    }
+    for (const std::size_t position : positions) {
+        while (destination[position] != position) {
+            const std::size_t target = destination[position];
+            std::swap(std::get<HybridQuantumGate>(program.nodes[position]),
+                      std::get<HybridQuantumGate>(program.nodes[target]));
+            std::swap(destination[position], destination[target]);
+        }
+    }
+    report.after = measure_hybrid_circuit(program);
+    return report;
+}
+
+}  // namespace synq::compiler
@@ -0,0 +1,101 @@
+// Opt-in peephole optimization and layer scheduling of the quantum gates in a
+// HybridProgram. Rewrites are exact: each replaces adjacent gates on the same
+// operands with a gate sequence of the same unitary, global phase included.
+// The scheduler only reorders gates that commute. Gates inside controls,
+// routine calls, and measurements are left untouched and block both across
+// them.
+#ifndef SYNQ_COMPILER_CIRCUIT_OPTIMIZER_H
+#define SYNQ_COMPILER_CIRCUIT_OPTIMIZER_H
+
+#include <cstddef>
+#include <vector>
+
+#include "hybrid_ir.h"
+
+namespace synq::compiler {
+
+struct CircuitOptimizationOptions {
+    // Removes `h`, `x`, `y`, `z`, or `cx` directly followed by the same gate
+    // on the same operands.
+    bool cancel_self_inverse_pairs = true;
+    // Folds consecutive `rx`, `ry`, `rz`, or `p` on one qubit into one gate
+    // when the sum of their literal angles has a literal form: `pi/n` and
+    // `-pi/n` multiples, or two decimals.
+    bool merge_rotations = true;
+    // Removes rotations whose angle is the identity: a zero decimal, or a
+    // merged sum that is a whole period (4*pi for rx/ry/rz, 2*pi for p).
+    bool remove_identity_rotations = true;
+};
+
+struct CircuitMetrics {
+    // Top-level gates, gates in control bodies, and routine calls, one each.
+    std::size_t gate_count = 0;
+    // The longest chain of those gates and measurements in which each shares
+    // a qubit with the next. A routine call's operands are resolved only at
+    // export, so it counts as occupying every qubit.
+    std::size_t depth = 0;
+};
+
+struct CircuitOptimizationReport {
+    CircuitMetrics before;
+    CircuitMetrics after;
+    std::size_t cancelled_pairs = 0;
+    std::size_t merged_rotations = 0;
+    std::size_t removed_identities = 0;
+};
+
+CircuitMetrics measure_hybrid_circuit(const HybridProgram& program);
+
+// Rewrites `program` in place and reports what changed. Run it on a program
+// that has already resolved: a removed gate takes any diagnostic it would have
+// produced with it. Resolution tables built before the call no longer match
+// the program's node indices.
+CircuitOptimizationReport optimize_hybrid_circuit(HybridProgram& program,
+                                                  const CircuitOptimizationOptions& options = {});
+
+// One scheduled gate. Layers count from 1 across the whole program.
+struct ScheduledGate {
+    std::size_t node = 0;
+    // The earliest layer the gate fits in given the gates before it.
+    std::size_t asap_layer = 0;
+    // The latest layer it can move to without deepening the circuit or
+    // crossing a gate it does not commute with. Always >= asap_layer.
+    std::size_t alap_layer = 0;
+};
+
+// Layers of the top-level gates the scheduler understands: h, x, y, z, cx,
+// bell_pair, rx, ry, rz, and p with well-formed operands. Every other node is
+// a barrier that stays in place: measurements, controls, calls, classical
+// nodes, and unknown or malformed gates. Gates after a barrier start below
+// the deepest layer so far.
+struct CircuitSchedule {
+    // Ordered by asap_layer, then by position in the program.
+    std::vector<ScheduledGate> gates;
+    // Layer n holds gates[layer_begin[n - 1], layer_begin[n]); layer_begin[0]
+    // is 0 and the vector has depth + 1 entries.
+    std::vector<std::size_t> layer_begin;
+    std::size_t depth = 0;
+};
+
+struct CircuitSchedulingReport {
+    CircuitMetrics before;
+    CircuitMetrics after;
+    std::size_t layers = 0;
+    std::size_t moved_gates = 0;
+};
+
+// Builds ASAP and ALAP layers. Two gates commute when, on every qubit they
+// share, both act diagonally (z, rz, p, or a cx control), both as bit flips
+// (x, rx, or a cx target), both as y or ry, or both as h. A commuting gate can
+// fill a free layer below a gate it would otherwise follow.
+CircuitSchedule schedule_hybrid_circuit(const HybridProgram& program);
+
+// Reorders each run of gates between barriers into ASAP layer order. No gate
+// moves past one it does not commute with or across a barrier, so the program
+// computes the same state. Like optimize_hybrid_circuit, run it on a resolved
+// program and resolve again before reusing node indices.
+CircuitSchedulingReport reorder_hybrid_circuit(HybridProgram& program);
+
+}  // namespace synq::compiler
+
+#endif
@@ -19,7 +19,7 @@ Diagnostic unsupported_node_diagnostic(const ASTNode* node) {
     SourceSpan span;
     std::string name = "unknown AST node";
 
-    if (const auto* instruction = dynamic_cast<const InstructionNode*>(node)) {
+    if (const auto* instruction = node_cast<InstructionNode>(node)) {
         span = instruction->span;
         name = "legacy instruction `" + instruction->op + "`";
     }
@@ -43,16 +43,21 @@ Diagnostic unsupported_control_body_diagnostic(const ClassicalControlNode& contr
     };
 }
 
-}  // namespace
+std::vector<SymbolId> intern_registers(const std::vector<std::string>& names, SymbolTable& symbols) {
+    std::vector<SymbolId> ids;
+    ids.reserve(names.size());
+    for (const std::string& name : names) ids.push_back(symbols.intern(name));
+    return ids;
+}
 
-HybridLoweringResult lower_to_hybrid_ir(const ProgramNode& program) {
-    HybridProgram lowered;
-    lowered.nodes.reserve(program.statements.size());
+}  // namespace
 
-    for (const ASTNode* statement : program.statements) {
-        if (const auto* declaration = dynamic_cast<const DeclarationNode*>(statement)) {
-            ClassicalExpression initializer = make_classical_expression(declaration->value, declaration->literal_kind,
-                                                                         declaration->span);
+bool lower_statement_to_hybrid_ir(const ASTNode& statement, HybridProgram& program, Diagnostic& error) {
+    switch (statement.node_kind()) {
+        case ASTNodeKind::Declaration: {
+            const auto* declaration = static_cast<const DeclarationNode*>(&statement);
+            ClassicalExpression initializer =
+                make_classical_expression(declaration->value, declaration->literal_kind, declaration->span);
             if (declaration->classical_callable_invocation.has_value()) {
                 initializer.kind = ClassicalExpressionKind::ClassicalCallableInvocation;
                 initializer.static_type = ClassicalStaticType::Unknown;
@@ -62,7 +67,7 @@ HybridLoweringResult lower_to_hybrid_ir(const ProgramNode& program) {
                 initializer.kind = ClassicalExpressionKind::ClassicalCallableInvocation;
                 initializer.static_type = ClassicalStaticType::Unknown;
             }
-            lowered.nodes.emplace_back(HybridDeclaration{
+            program.nodes.emplace_back(HybridDeclaration{
                 declaration->name,
                 declaration->value,
                 declaration->literal_kind,
@@ -71,46 +76,52 @@ HybridLoweringResult lower_to_hybrid_ir(const ProgramNode& program) {
                 declaration->classical_callable_invocation,
                 declaration->binary_classical_callable_invocation,
             });
-            continue;
+            return true;
         }
 
-        if (const auto* declaration = dynamic_cast<const MutableDeclarationNode*>(statement)) {
-            lowered.nodes.emplace_back(HybridMutableDeclaration{
+        case ASTNodeKind::MutableDeclaration: {
+            const auto* declaration = static_cast<const MutableDeclarationNode*>(&statement);
+            program.nodes.emplace_back(HybridMutableDeclaration{
                 declaration->name,
                 declaration->value,
                 declaration->literal_kind,
                 make_classical_expression(declaration->value, declaration->literal_kind, declaration->span),
                 declaration->span,
             });
-            continue;
+            return true;
         }
 
-        if (const auto* assignment = dynamic_cast<const AssignmentNode*>(statement)) {
-            lowered.nodes.emplace_back(HybridAssignment{
+        case ASTNodeKind::Assignment: {
+            const auto* assignment = static_cast<const AssignmentNode*>(&statement);
+            program.nodes.emplace_back(HybridAssignment{
                 assignment->target,
                 assignment->value,
                 assignment->literal_kind,
                 make_classical_expression(assignment->value, assignment->literal_kind, assignment->span),
                 assignment->span,
             });
-            continue;
+            return true;
         }
 
-        if (const auto* qubits = dynamic_cast<const QubitDeclarationNode*>(statement)) {
-            lowered.nodes.emplace_back(HybridQubitDeclaration{
-                qubits->name,
+        case ASTNodeKind::QubitDeclaration: {
+            const auto* qubits = static_cast<const QubitDeclarationNode*>(&statement);
+            program.nodes.emplace_back(HybridQubitDeclaration{
+                program.symbols.intern(qubits->name),
                 qubits->qubit_count,
                 qubits->span,
             });
-            continue;
+            return true;
         }
 
-        if (const auto* callable = dynamic_cast<const CallableDeclarationNode*>(statement)) {
+        case ASTNodeKind::CallableDeclaration: {
+            const auto* callable = static_cast<const CallableDeclarationNode*>(&statement);
             std::optional<HybridQuantumGate> body;
             if (callable->body != nullptr) {
                 body.emplace(HybridQuantumGate{callable->body->kind, callable->body->source_name,
                                                 callable->body->literal_angle, callable->body->qubit_indices,
-                                                callable->body->qubit_register_names, callable->body->span});
+                                                intern_registers(callable->body->qubit_register_names,
+                                                                 program.symbols),
+                                                callable->body->span});
             }
             std::vector<HybridRoutineFormal> formals;
             formals.reserve(callable->formals.size());
@@ -123,7 +134,7 @@ HybridLoweringResult lower_to_hybrid_ir(const ProgramNode& program) {
                 parameterized_body.emplace(HybridParameterizedRoutineBody{
                     source.kind, source.source_name, source.angle_formal, source.qubit_formals, source.span});
             }
-            lowered.nodes.emplace_back(HybridCallableDeclaration{
+            program.nodes.emplace_back(HybridCallableDeclaration{
                 callable->kind,
                 callable->name,
                 std::move(body),
@@ -133,68 +144,89 @@ HybridLoweringResult lower_to_hybrid_ir(const ProgramNode& program) {
                 callable->classical_body,
                 callable->binary_classical_body,
             });
-            continue;
+            return true;
         }
 
-        if (const auto* call = dynamic_cast<const CallableCallNode*>(statement)) {
-            lowered.nodes.emplace_back(HybridCallableCall{call->name, call->arguments, call->span});
-            continue;
+        case ASTNodeKind::CallableCall: {
+            const auto* call = static_cast<const CallableCallNode*>(&statement);
+            program.nodes.emplace_back(HybridCallableCall{call->name, call->arguments, call->span});
+            return true;
         }
 
-        if (const auto* gate = dynamic_cast<const QuantumGateNode*>(statement)) {
-            lowered.nodes.emplace_back(HybridQuantumGate{
+        case ASTNodeKind::QuantumGate: {
+            const auto* gate = static_cast<const QuantumGateNode*>(&statement);
+            program.nodes.emplace_back(HybridQuantumGate{
                 gate->kind,
                 gate->source_name,
                 gate->literal_angle,
                 gate->qubit_indices,
-                gate->qubit_register_names,
+                intern_registers(gate->qubit_register_names, program.symbols),
                 gate->span,
             });
-            continue;
+            return true;
         }
 
-        if (const auto* measurement = dynamic_cast<const MeasurementNode*>(statement)) {
-            lowered.nodes.emplace_back(HybridMeasurement{
+        case ASTNodeKind::Measurement: {
+            const auto* measurement = static_cast<const MeasurementNode*>(&statement);
+            program.nodes.emplace_back(HybridMeasurement{
                 measurement->qubit_index,
-                measurement->qubit_register_name,
+                program.symbols.intern(measurement->qubit_register_name),
                 measurement->result_name,
                 measurement->span,
                 measurement->feedback_enabled,
             });
-            continue;
+            return true;
         }
 
-        if (const auto* control = dynamic_cast<const ClassicalControlNode*>(statement)) {
-            if (const auto* gate = dynamic_cast<const QuantumGateNode*>(control->body)) {
-                lowered.nodes.emplace_back(HybridControlFlow{
+        case ASTNodeKind::ClassicalControl: {
+            const auto* control = static_cast<const ClassicalControlNode*>(&statement);
+            if (const auto* gate = node_cast<QuantumGateNode>(control->body)) {
+                program.nodes.emplace_back(HybridControlFlow{
                     control->kind,
                     control->condition,
                     HybridQuantumGate{gate->kind, gate->source_name, gate->literal_angle, gate->qubit_indices,
-                                      gate->qubit_register_names, gate->span},
+                                      intern_registers(gate->qubit_register_names, program.symbols),
+                                      gate->span},
                     control->span,
                     control->feedback_enabled,
                 });
-                continue;
+                return true;
             }
-            if (const auto* measurement = dynamic_cast<const MeasurementNode*>(control->body)) {
-                lowered.nodes.emplace_back(HybridControlFlow{
+            if (const auto* measurement = node_cast<MeasurementNode>(control->body)) {
+                program.nodes.emplace_back(HybridControlFlow{
                     control->kind,
                     control->condition,
-                    HybridMeasurement{measurement->qubit_index, measurement->qubit_register_name,
+                    HybridMeasurement{measurement->qubit_index,
+                                      program.symbols.intern(measurement->qubit_register_name),
                                       measurement->result_name, measurement->span, measurement->feedback_enabled},
                     control->span,
                     control->feedback_enabled,
                 });
-                continue;
+                return true;
             }
+            error = unsupported_control_body_diagnostic(*control);
+            return false;
+        }
+
+        default:
+            break;
+    }
+
+    error = unsupported_node_diagnostic(&statement);
+    return false;
+}
+
+HybridLoweringResult lower_to_hybrid_ir(const ProgramNode& program) {
+    HybridProgram lowered;
+    lowered.nodes.reserve(program.statements.size());
+
+    for (const ASTNode* statement : program.statements) {
+        Diagnostic error;
+        if (!lower_statement_to_hybrid_ir(*statement, lowered, error)) {
             HybridLoweringResult result;
-            result.diagnostics.push_back(unsupported_control_body_diagnostic(*control));
+            result.diagnostics.push_back(std::move(error));
             return result;
         }
-
-        HybridLoweringResult result;
-        result.diagnostics.push_back(unsupported_node_diagnostic(statement));
-        return result;
     }
 
     HybridLoweringResult result;
@@ -12,6 +12,7 @@
 
 #include "classical_expression.h"
 #include "diagnostic.h"
+#include "symbol_table.h"
 
 namespace synq::compiler {
 
@@ -42,7 +43,7 @@ struct HybridAssignment {
 };
 
 struct HybridQubitDeclaration {
-    std::string name;
+    SymbolId name = 0;
     std::size_t qubit_count = 0;
     SourceSpan span;
 };
@@ -52,7 +53,7 @@ struct HybridQuantumGate {
     std::string source_name;
     std::optional<std::string> literal_angle;
     std::vector<std::size_t> qubit_indices;
-    std::vector<std::string> qubit_register_names;
+    std::vector<SymbolId> qubit_registers;
     SourceSpan span;
 };
 
@@ -88,7 +89,7 @@ struct HybridCallableCall {
 
 struct HybridMeasurement {
     std::size_t qubit_index = 0;
-    std::string qubit_register_name = "q";
+    SymbolId qubit_register = 0;
     std::optional<std::string> result_name;
     SourceSpan span;
     bool feedback_enabled = false;
@@ -110,6 +111,8 @@ using HybridNode = std::variant<HybridDeclaration, HybridMutableDeclaration, Hyb
 
 struct HybridProgram {
     std::vector<HybridNode> nodes;
+    // Spellings of every SymbolId held by `nodes`.
+    SymbolTable symbols;
 };
 
 struct HybridLoweringResult {
@@ -124,6 +127,11 @@ struct HybridLoweringResult {
 // silently dropped or assigned invented semantics.
 HybridLoweringResult lower_to_hybrid_ir(const ProgramNode& program);
 
+// Appends the Hybrid node for one typed recovery statement to `program`,
+// interning its register names in `program.symbols`. Returns false with `error`
+// set, leaving `program` unchanged, when the statement has no Hybrid form.
+bool lower_statement_to_hybrid_ir(const ASTNode& statement, HybridProgram& program, Diagnostic& error);
+
 }  // namespace synq::compiler
 
 #endif
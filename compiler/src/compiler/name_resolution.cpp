@@ -6,12 +6,21 @@
 #include <limits>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
 namespace synq::compiler {
 
+bool NameResolutionTableResult::ok() const {
+    if (!table.has_value()) return false;
+    for (const Diagnostic& diagnostic : diagnostics) {
+        if (diagnostic.severity == DiagnosticSeverity::Error) return false;
+    }
+    return true;
+}
+
 bool NameResolutionResult::ok() const {
     if (!program.has_value()) return false;
     for (const Diagnostic& diagnostic : diagnostics) {
@@ -172,41 +181,63 @@ Diagnostic mutable_assignment_type_diagnostic(const SourceSpan& span, const std:
 struct BindingInfo {
     std::size_t index = 0;
     ClassicalStaticType static_type = ClassicalStaticType::Unknown;
-    std::string name;
+    std::string_view name;
     SemanticBindingKind kind = SemanticBindingKind::Value;
 };
 
+// Top-level bindings visible to later statements, in one dense vector. A name
+// is found with one hash lookup, and the node index that declared a binding,
+// which is how dependency lists refer to it, maps straight back to it. Names
+// view the strings of the HybridProgram being resolved.
+class BindingTable {
+public:
+    explicit BindingTable(std::size_t node_count) : by_node_(node_count, kNoBinding) {}
+
+    const BindingInfo* find(std::string_view name) const {
+        const auto found = by_name_.find(name);
+        return found == by_name_.end() ? nullptr : &bindings_[found->second];
+    }
+
+    // `node_index` must be the index of a node that declared a binding.
+    const BindingInfo& declared_by(std::size_t node_index) const { return bindings_[by_node_[node_index]]; }
+
+    // A later declaration of an existing name is ignored, as in source order.
+    void declare(std::string_view name, std::size_t node_index, ClassicalStaticType static_type,
+                 SemanticBindingKind kind) {
+        if (!by_name_.emplace(name, bindings_.size()).second) return;
+        by_node_[node_index] = bindings_.size();
+        bindings_.push_back({node_index, static_type, name, kind});
+    }
+
+private:
+    static constexpr std::size_t kNoBinding = static_cast<std::size_t>(-1);
+
+    std::vector<BindingInfo> bindings_;
+    std::vector<std::size_t> by_node_;
+    std::unordered_map<std::string_view, std::size_t> by_name_;
+};
+
 bool is_state_value_type(ClassicalStaticType type) {
     return type == ClassicalStaticType::Boolean || type == ClassicalStaticType::Integer ||
            type == ClassicalStaticType::String;
 }
 
-void append_binding_names(const std::unordered_map<std::string, BindingInfo>& bindings,
-                          const std::vector<std::size_t>& binding_indices,
-                          std::vector<std::string>& binding_names) {
-    for (const std::size_t binding_index : binding_indices) {
-        for (const auto& entry : bindings) {
-            if (entry.second.index == binding_index) binding_names.push_back(entry.second.name);
-        }
-    }
-}
-
 bool resolve_boolean_expression(const ClassicalBooleanExpression& expression,
-                                const std::unordered_map<std::string, BindingInfo>& bindings,
+                                const BindingTable& bindings,
                                 std::vector<std::size_t>& binding_indices,
                                 Diagnostic& error) {
     if (expression.kind == ClassicalBooleanExpressionKind::BooleanLiteral) return true;
     if (expression.kind == ClassicalBooleanExpressionKind::IdentifierReference) {
-        const auto binding = bindings.find(expression.source_text);
-        if (binding == bindings.end()) {
+        const BindingInfo* binding = bindings.find(expression.source_text);
+        if (binding == nullptr) {
             error = unresolved_control_condition_diagnostic(expression);
             return false;
         }
-        if (binding->second.static_type != ClassicalStaticType::Boolean) {
-            error = non_boolean_control_condition_diagnostic(expression, binding->second.static_type);
+        if (binding->static_type != ClassicalStaticType::Boolean) {
+            error = non_boolean_control_condition_diagnostic(expression, binding->static_type);
             return false;
         }
-        binding_indices.push_back(binding->second.index);
+        binding_indices.push_back(binding->index);
         return true;
     }
 
@@ -244,27 +275,25 @@ bool is_direct_measurement_feedback_condition(const HybridControlFlow& control,
 bool is_direct_measurement_feedback_correction(const HybridControlFlow& control) {
     const auto* gate = std::get_if<HybridQuantumGate>(&control.body);
     return gate != nullptr && gate->kind == QuantumGateKind::X && !gate->literal_angle.has_value() &&
-           gate->qubit_indices.size() == 1 && gate->qubit_register_names.size() == 1;
+           gate->qubit_indices.size() == 1 && gate->qubit_registers.size() == 1;
 }
 
 bool resolve_integer_arithmetic_expression(const ClassicalIntegerArithmeticExpression& expression,
-                                           const std::unordered_map<std::string, BindingInfo>& bindings,
+                                           const BindingTable& bindings,
                                            std::vector<std::size_t>& binding_indices,
-                                           std::vector<std::string>& binding_names,
                                            Diagnostic& error) {
     if (expression.kind == ClassicalIntegerArithmeticExpressionKind::IntegerLiteral) return true;
     if (expression.kind == ClassicalIntegerArithmeticExpressionKind::IdentifierReference) {
-        const auto binding = bindings.find(expression.source_text);
-        if (binding == bindings.end()) {
+        const BindingInfo* binding = bindings.find(expression.source_text);
+        if (binding == nullptr) {
             error = unresolved_integer_arithmetic_diagnostic(expression);
             return false;
         }
-        if (binding->second.static_type != ClassicalStaticType::Integer) {
-            error = non_integer_arithmetic_diagnostic(expression, binding->second.static_type);
+        if (binding->static_type != ClassicalStaticType::Integer) {
+            error = non_integer_arithmetic_diagnostic(expression, binding->static_type);
             return false;
         }
-        binding_indices.push_back(binding->second.index);
-        binding_names.push_back(binding->second.name);
+        binding_indices.push_back(binding->index);
         return true;
     }
     if ((expression.kind != ClassicalIntegerArithmeticExpressionKind::Add &&
@@ -275,7 +304,7 @@ bool resolve_integer_arithmetic_expression(const ClassicalIntegerArithmeticExpre
         return false;
     }
     for (const ClassicalIntegerArithmeticExpression& operand : expression.operands) {
-        if (!resolve_integer_arithmetic_expression(operand, bindings, binding_indices, binding_names, error)) return false;
+        if (!resolve_integer_arithmetic_expression(operand, bindings, binding_indices, error)) return false;
     }
     return true;
 }
@@ -305,28 +334,37 @@ Diagnostic qubit_index_range_diagnostic(const SourceSpan& span, const std::strin
     };
 }
 
-bool validate_qubit_operands(const std::vector<std::string>& register_names,
+// Declared size per register SymbolId; ids interned after the table was sized
+// and ids without a declaration read as undeclared.
+using QubitCounts = std::vector<std::optional<std::size_t>>;
+
+std::optional<std::size_t> declared_qubit_count(const QubitCounts& qubit_counts, SymbolId id) {
+    return id < qubit_counts.size() ? qubit_counts[id] : std::nullopt;
+}
+
+bool validate_qubit_operands(const std::vector<SymbolId>& registers,
                              const std::vector<std::size_t>& indices,
                              const SourceSpan& span,
-                             const std::unordered_map<std::string, std::size_t>& qubit_counts,
-                             bool contains_explicit_default_register,
+                             const SymbolTable& symbols,
+                             const QubitCounts& qubit_counts,
+                             SymbolId implicit_default_register,
                              Diagnostic& error) {
-    if (register_names.size() != indices.size()) {
+    if (registers.size() != indices.size()) {
         error = {"SYNQ-Q003", DiagnosticSeverity::Error, span,
                  "quantum operand register metadata does not match operand indices",
                  "use parser-produced bounded quantum operands"};
         return false;
     }
     for (std::size_t position = 0; position < indices.size(); ++position) {
-        const std::string& register_name = register_names[position];
-        const auto declaration = qubit_counts.find(register_name);
-        if (declaration == qubit_counts.end()) {
-            if (register_name == "q" && !contains_explicit_default_register) continue;
-            error = qubit_declaration_order_diagnostic(span, register_name);
+        const SymbolId register_id = registers[position];
+        const std::optional<std::size_t> declared = declared_qubit_count(qubit_counts, register_id);
+        if (!declared.has_value()) {
+            if (register_id == implicit_default_register) continue;
+            error = qubit_declaration_order_diagnostic(span, symbols.name(register_id));
             return false;
         }
-        if (indices[position] >= declaration->second) {
-            error = qubit_index_range_diagnostic(span, register_name, indices[position], declaration->second);
+        if (indices[position] >= *declared) {
+            error = qubit_index_range_diagnostic(span, symbols.name(register_id), indices[position], *declared);
             return false;
         }
     }
@@ -334,11 +372,12 @@ bool validate_qubit_operands(const std::vector<std::string>& register_names,
 }
 
 bool validate_qubit_measurement(const HybridMeasurement& measurement,
-                                const std::unordered_map<std::string, std::size_t>& qubit_counts,
-                                bool contains_explicit_default_register,
+                                const SymbolTable& symbols,
+                                const QubitCounts& qubit_counts,
+                                SymbolId implicit_default_register,
                                 Diagnostic& error) {
-    return validate_qubit_operands({measurement.qubit_register_name}, {measurement.qubit_index}, measurement.span,
-                                   qubit_counts, contains_explicit_default_register, error);
+    return validate_qubit_operands({measurement.qubit_register}, {measurement.qubit_index}, measurement.span,
+                                   symbols, qubit_counts, implicit_default_register, error);
 }
 
 bool is_literal_angle_parameter(const std::string& value) {
@@ -567,30 +606,126 @@ Diagnostic binary_classical_callable_type_diagnostic(const SourceSpan& span, Cla
             "use an ordered literal or earlier immutable binding with each formal's exact static type"};
 }
 
+std::uint32_t table_index(std::size_t index) {
+    return static_cast<std::uint32_t>(index);
+}
+
+std::optional<std::size_t> optional_index(std::uint32_t index) {
+    if (index == kNoResolvedIndex) return std::nullopt;
+    return index;
+}
+
+std::vector<std::size_t> operand_indices(const HybridResolutionTable& table, const HybridNodeResolution& annotation) {
+    return {table.operand_binding_indices.begin() + annotation.operands_begin,
+            table.operand_binding_indices.begin() + annotation.operands_end};
+}
+
+// The name a binding node declares: a let, a var, or a named measurement.
+const std::string& binding_name(const HybridNode& node) {
+    if (const auto* declaration = std::get_if<HybridDeclaration>(&node)) return declaration->name;
+    if (const auto* declaration = std::get_if<HybridMutableDeclaration>(&node)) return declaration->name;
+    return *std::get<HybridMeasurement>(node).result_name;
+}
+
+SemanticBinding semantic_binding(const HybridProgram& program, const HybridResolutionTable& table,
+                                 std::size_t node_index) {
+    const HybridNode& node = program.nodes[node_index];
+    const HybridNodeResolution& annotation = table.nodes[node_index];
+    SemanticBinding binding;
+    binding.name = binding_name(node);
+    binding.static_type = annotation.static_type;
+    binding.node_index = node_index;
+    if (const auto* measurement = std::get_if<HybridMeasurement>(&node)) {
+        binding.kind = SemanticBindingKind::MeasurementResult;
+        binding.span = measurement->span;
+        return binding;
+    }
+    if (const auto* declaration = std::get_if<HybridMutableDeclaration>(&node)) {
+        binding.kind = SemanticBindingKind::MutableCell;
+        binding.span = declaration->span;
+    } else {
+        binding.span = std::get<HybridDeclaration>(node).span;
+    }
+    // Dependencies in the order resolution meets them: callable actuals, a
+    // whole-identifier initializer, then expression operands.
+    const auto depend_on = [&program, &binding](std::uint32_t index) {
+        if (index != kNoResolvedIndex) binding.dependency_names.push_back(binding_name(program.nodes[index]));
+    };
+    depend_on(annotation.first_actual_binding_index);
+    depend_on(annotation.second_actual_binding_index);
+    depend_on(annotation.binding_index);
+    for (std::uint32_t operand = annotation.operands_begin; operand < annotation.operands_end; ++operand) {
+        depend_on(table.operand_binding_indices[operand]);
+    }
+    return binding;
+}
+
+void render_semantic_binding(std::ostringstream& output, const SemanticBinding& binding) {
+    output << "binding " << binding.name << " | " << semantic_binding_kind_name(binding.kind)
+           << " | " << classical_static_type_name(binding.static_type)
+           << " | line " << binding.span.line;
+    if (!binding.dependency_names.empty()) {
+        output << " | depends-on ";
+        for (std::size_t index = 0; index < binding.dependency_names.size(); ++index) {
+            if (index != 0) output << ", ";
+            output << binding.dependency_names[index];
+        }
+    }
+    output << "\n";
+}
+
 }  // namespace
 
 NameResolutionResult resolve_hybrid_names(const HybridProgram& program) {
-    ResolvedHybridProgram resolved;
-    resolved.nodes.reserve(program.nodes.size());
-    std::unordered_map<std::string, BindingInfo> bindings;
-    bool contains_explicit_default_register = false;
+    NameResolutionTableResult resolution = resolve_hybrid_name_table(program);
+    NameResolutionResult result;
+    result.diagnostics = std::move(resolution.diagnostics);
+    if (resolution.table.has_value()) result.program = materialize_resolved_program(program, *resolution.table);
+    return result;
+}
+
+NameResolutionTableResult resolve_hybrid_name_table(const HybridProgram& program) {
+    HybridResolutionTable table;
+    table.nodes.resize(program.nodes.size());
+    table.symbols = program.symbols;
+    BindingTable bindings(program.nodes.size());
+    // Operands on an undeclared default `q` register stay accepted unless the
+    // program declares `q` explicitly.
+    SymbolId implicit_default_register = table.symbols.find("q").value_or(kNoSymbol);
     for (const HybridNode& node : program.nodes) {
         const auto* qubits = std::get_if<HybridQubitDeclaration>(&node);
-        if (qubits != nullptr && qubits->name == "q") {
-            contains_explicit_default_register = true;
+        if (qubits != nullptr && qubits->name == implicit_default_register) {
+            implicit_default_register = kNoSymbol;
             break;
         }
     }
-    std::unordered_map<std::string, std::size_t> qubit_counts;
-    std::unordered_map<std::string, HybridCallableDeclaration> callable_definitions;
-    std::unordered_map<std::string, std::size_t> callable_definition_indices;
+    QubitCounts qubit_counts(table.symbols.size());
+    // Callable name to the index of its defining node; first definition wins.
+    std::unordered_map<std::string_view, std::size_t> callable_definitions;
+    // Returns the earlier definition of `name`, or null, and its node index.
+    const auto find_callable = [&](const std::string& name,
+                                   std::size_t& definition_index) -> const HybridCallableDeclaration* {
+        const auto found = callable_definitions.find(name);
+        if (found == callable_definitions.end()) return nullptr;
+        definition_index = found->second;
+        return &std::get<HybridCallableDeclaration>(program.nodes[definition_index]);
+    };
+    // Expression operands of the current node, before they join the table.
+    std::vector<std::size_t> operand_indices;
+    const auto record_operands = [&table, &operand_indices](HybridNodeResolution& annotation) {
+        annotation.operands_begin = table_index(table.operand_binding_indices.size());
+        for (const std::size_t index : operand_indices) table.operand_binding_indices.push_back(table_index(index));
+        annotation.operands_end = table_index(table.operand_binding_indices.size());
+    };
     std::unordered_set<std::string> consumed_measurement_results;
     bool terminal_feedback_seen = false;
 
     for (std::size_t node_index = 0; node_index < program.nodes.size(); ++node_index) {
         const HybridNode& node = program.nodes[node_index];
+        HybridNodeResolution& annotation = table.nodes[node_index];
+        operand_indices.clear();
         if (terminal_feedback_seen) {
-            NameResolutionResult result;
+            NameResolutionTableResult result;
             result.diagnostics.push_back(invalid_measurement_feedback_result_diagnostic(
                 {},
                 "feedback result"));
@@ -598,248 +733,206 @@ NameResolutionResult resolve_hybrid_names(const HybridProgram& program) {
         }
 
         if (const auto* declaration = std::get_if<HybridDeclaration>(&node)) {
-            std::optional<std::size_t> initializer_binding_index;
-            std::vector<std::size_t> initializer_binding_indices;
-            std::vector<std::string> initializer_binding_names;
-            ClassicalStaticType initializer_static_type = declaration->initializer.static_type;
-            std::optional<std::size_t> classical_callable_declaration_index;
-            std::optional<std::size_t> classical_callable_actual_binding_index;
-            std::optional<std::size_t> binary_classical_callable_declaration_index;
-            std::optional<std::size_t> binary_classical_callable_first_actual_binding_index;
-            std::optional<std::size_t> binary_classical_callable_second_actual_binding_index;
+            annotation.static_type = declaration->initializer.static_type;
             if (declaration->classical_callable_invocation.has_value()) {
                 const ClassicalCallableInvocation& invocation = *declaration->classical_callable_invocation;
-                const auto target = callable_definitions.find(invocation.function_name);
-                const auto target_index = callable_definition_indices.find(invocation.function_name);
-                if (target == callable_definitions.end() || target_index == callable_definition_indices.end() ||
-                    !is_valid_classical_callable(target->second)) {
-                    NameResolutionResult result;
+                std::size_t definition_index = 0;
+                const HybridCallableDeclaration* callable = find_callable(invocation.function_name, definition_index);
+                if (callable == nullptr || !is_valid_classical_callable(*callable)) {
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(classical_callable_invocation_diagnostic(declaration->span,
                                                                                            invocation.function_name));
                     return result;
                 }
-                const ClassicalStaticType expected = classical_callable_static_type(target->second.classical_body->parameter_type);
+                const ClassicalStaticType expected = classical_callable_static_type(callable->classical_body->parameter_type);
                 ClassicalStaticType actual = ClassicalStaticType::Unknown;
                 if (invocation.actual_kind == ClassicalLiteralKind::Integer) actual = ClassicalStaticType::Integer;
                 if (invocation.actual_kind == ClassicalLiteralKind::Boolean) actual = ClassicalStaticType::Boolean;
                 if (invocation.actual_kind == ClassicalLiteralKind::QuotedString) actual = ClassicalStaticType::String;
                 if (invocation.actual_kind == ClassicalLiteralKind::SourceText) {
-                    const auto binding = bindings.find(invocation.actual_source);
-                    if (binding != bindings.end() && binding->second.kind == SemanticBindingKind::Value) {
-                        actual = binding->second.static_type;
-                        classical_callable_actual_binding_index = binding->second.index;
-                        initializer_binding_names.push_back(binding->second.name);
+                    const BindingInfo* binding = bindings.find(invocation.actual_source);
+                    if (binding != nullptr && binding->kind == SemanticBindingKind::Value) {
+                        actual = binding->static_type;
+                        annotation.first_actual_binding_index = table_index(binding->index);
                     }
                 }
                 if (actual != expected) {
-                    NameResolutionResult result;
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(classical_callable_type_diagnostic(declaration->span, expected, actual));
                     return result;
                 }
-                initializer_static_type = expected;
-                classical_callable_declaration_index = target_index->second;
+                annotation.static_type = expected;
+                annotation.callable_index = table_index(definition_index);
             }
             if (declaration->binary_classical_callable_invocation.has_value()) {
                 const BinaryClassicalCallableInvocation& invocation = *declaration->binary_classical_callable_invocation;
-                const auto target = callable_definitions.find(invocation.function_name);
-                const auto target_index = callable_definition_indices.find(invocation.function_name);
-                if (target == callable_definitions.end() || target_index == callable_definition_indices.end() ||
-                    !is_valid_binary_classical_callable(target->second)) {
-                    NameResolutionResult result;
+                std::size_t definition_index = 0;
+                const HybridCallableDeclaration* callable = find_callable(invocation.function_name, definition_index);
+                if (callable == nullptr || !is_valid_binary_classical_callable(*callable)) {
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(binary_classical_callable_invocation_diagnostic(
                         declaration->span, invocation.function_name));
                     return result;
                 }
                 const ClassicalStaticType expected =
-                    classical_callable_static_type(target->second.binary_classical_body->parameter_type);
-                const auto resolve_actual = [&bindings, &initializer_binding_names](
-                                                const std::string& source, ClassicalLiteralKind kind,
-                                                ClassicalStaticType& actual,
-                                                std::optional<std::size_t>& binding_index) {
+                    classical_callable_static_type(callable->binary_classical_body->parameter_type);
+                const auto resolve_actual = [&bindings](const std::string& source, ClassicalLiteralKind kind,
+                                                        ClassicalStaticType& actual, std::uint32_t& binding_index) {
                     actual = ClassicalStaticType::Unknown;
                     if (kind == ClassicalLiteralKind::Integer) actual = ClassicalStaticType::Integer;
                     if (kind == ClassicalLiteralKind::Boolean) actual = ClassicalStaticType::Boolean;
                     if (kind == ClassicalLiteralKind::QuotedString) actual = ClassicalStaticType::String;
                     if (kind == ClassicalLiteralKind::SourceText) {
-                        const auto binding = bindings.find(source);
-                        if (binding != bindings.end() && binding->second.kind == SemanticBindingKind::Value) {
-                            actual = binding->second.static_type;
-                            binding_index = binding->second.index;
-                            initializer_binding_names.push_back(binding->second.name);
+                        const BindingInfo* binding = bindings.find(source);
+                        if (binding != nullptr && binding->kind == SemanticBindingKind::Value) {
+                            actual = binding->static_type;
+                            binding_index = table_index(binding->index);
                         }
                     }
                 };
                 ClassicalStaticType first_actual;
                 ClassicalStaticType second_actual;
                 resolve_actual(invocation.first_actual_source, invocation.first_actual_kind, first_actual,
-                               binary_classical_callable_first_actual_binding_index);
+                               annotation.first_actual_binding_index);
                 resolve_actual(invocation.second_actual_source, invocation.second_actual_kind, second_actual,
-                               binary_classical_callable_second_actual_binding_index);
+                               annotation.second_actual_binding_index);
                 if (first_actual != expected) {
-                    NameResolutionResult result;
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(binary_classical_callable_type_diagnostic(
                         declaration->span, expected, first_actual, "first"));
                     return result;
                 }
                 if (second_actual != expected) {
-                    NameResolutionResult result;
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(binary_classical_callable_type_diagnostic(
                         declaration->span, expected, second_actual, "second"));
                     return result;
                 }
-                initializer_static_type = expected;
-                binary_classical_callable_declaration_index = target_index->second;
+                annotation.static_type = expected;
+                annotation.callable_index = table_index(definition_index);
             }
             if (declaration->initializer.kind == ClassicalExpressionKind::IdentifierReference &&
                 is_identifier(declaration->source_value)) {
-                const auto binding = bindings.find(declaration->source_value);
-                if (binding == bindings.end()) {
-                    NameResolutionResult result;
+                const BindingInfo* binding = bindings.find(declaration->source_value);
+                if (binding == nullptr) {
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(unresolved_binding_diagnostic(*declaration));
                     return result;
                 }
-                if (binding->second.kind == SemanticBindingKind::MutableCell) {
-                    NameResolutionResult result;
+                if (binding->kind == SemanticBindingKind::MutableCell) {
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back({"SYNQ-S005", DiagnosticSeverity::Error, declaration->span,
                                                   "immutable declaration `" + declaration->name +
                                                       "` cannot read mutable cell `" + declaration->source_value + "`",
                                                   "use var for a time-dependent value or keep let initializers immutable"});
                     return result;
                 }
-                initializer_binding_index = binding->second.index;
-                initializer_static_type = binding->second.static_type;
-                initializer_binding_names.push_back(binding->second.name);
+                annotation.binding_index = table_index(binding->index);
+                annotation.static_type = binding->static_type;
             }
             if (declaration->initializer.kind == ClassicalExpressionKind::IntegerArithmeticExpression) {
                 Diagnostic arithmetic_error;
                 if (!declaration->initializer.integer_arithmetic.has_value() ||
                     !resolve_integer_arithmetic_expression(*declaration->initializer.integer_arithmetic, bindings,
-                                                           initializer_binding_indices, initializer_binding_names,
-                                                           arithmetic_error)) {
-                    NameResolutionResult result;
+                                                           operand_indices, arithmetic_error)) {
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(std::move(arithmetic_error));
                     return result;
                 }
-                initializer_static_type = ClassicalStaticType::Integer;
+                annotation.static_type = ClassicalStaticType::Integer;
             }
             if (declaration->initializer.kind == ClassicalExpressionKind::BooleanExpression) {
                 Diagnostic boolean_error;
                 if (!declaration->initializer.boolean_expression.has_value() ||
                     !resolve_boolean_expression(*declaration->initializer.boolean_expression, bindings,
-                                                initializer_binding_indices, boolean_error)) {
-                    NameResolutionResult result;
+                                                operand_indices, boolean_error)) {
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(std::move(boolean_error));
                     return result;
                 }
-                initializer_static_type = ClassicalStaticType::Boolean;
-                append_binding_names(bindings, initializer_binding_indices, initializer_binding_names);
+                annotation.static_type = ClassicalStaticType::Boolean;
             }
 
-            resolved.nodes.emplace_back(ResolvedHybridDeclaration{*declaration, initializer_binding_index,
-                                                                   initializer_static_type,
-                                                                   std::move(initializer_binding_indices),
-                                                                   classical_callable_declaration_index,
-                                                                   classical_callable_actual_binding_index,
-                                                                   binary_classical_callable_declaration_index,
-                                                                   binary_classical_callable_first_actual_binding_index,
-                                                                   binary_classical_callable_second_actual_binding_index});
-            resolved.semantic_bindings.push_back({declaration->name, SemanticBindingKind::Value,
-                                                  initializer_static_type, node_index, declaration->span,
-                                                  std::move(initializer_binding_names)});
-            bindings.emplace(declaration->name, BindingInfo{node_index, initializer_static_type,
-                                                            declaration->name, SemanticBindingKind::Value});
+            record_operands(annotation);
+            table.binding_nodes.push_back(table_index(node_index));
+            bindings.declare(declaration->name, node_index, annotation.static_type, SemanticBindingKind::Value);
             continue;
         }
 
         if (const auto* declaration = std::get_if<HybridMutableDeclaration>(&node)) {
-            std::optional<std::size_t> initializer_binding_index;
-            std::vector<std::size_t> initializer_binding_indices;
-            std::vector<std::string> initializer_binding_names;
-            ClassicalStaticType initializer_static_type = declaration->initializer.static_type;
+            annotation.static_type = declaration->initializer.static_type;
             if (declaration->initializer.kind == ClassicalExpressionKind::IdentifierReference &&
                 is_identifier(declaration->source_value)) {
-                const auto binding = bindings.find(declaration->source_value);
-                if (binding == bindings.end()) {
-                    NameResolutionResult result;
+                const BindingInfo* binding = bindings.find(declaration->source_value);
+                if (binding == nullptr) {
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(invalid_mutable_initializer_diagnostic(declaration->span, declaration->name));
                     return result;
                 }
-                initializer_binding_index = binding->second.index;
-                initializer_static_type = binding->second.static_type;
-                initializer_binding_names.push_back(binding->second.name);
+                annotation.binding_index = table_index(binding->index);
+                annotation.static_type = binding->static_type;
             }
             if (declaration->initializer.kind == ClassicalExpressionKind::IntegerArithmeticExpression) {
                 Diagnostic arithmetic_error;
                 if (!declaration->initializer.integer_arithmetic.has_value() ||
                     !resolve_integer_arithmetic_expression(*declaration->initializer.integer_arithmetic, bindings,
-                                                           initializer_binding_indices, initializer_binding_names,
-                                                           arithmetic_error)) {
-                    NameResolutionResult result;
+                                                           operand_indices, arithmetic_error)) {
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(std::move(arithmetic_error));
                     return result;
                 }
-                initializer_static_type = ClassicalStaticType::Integer;
+                annotation.static_type = ClassicalStaticType::Integer;
             }
             if (declaration->initializer.kind == ClassicalExpressionKind::BooleanExpression) {
                 Diagnostic boolean_error;
                 if (!declaration->initializer.boolean_expression.has_value() ||
                     !resolve_boolean_expression(*declaration->initializer.boolean_expression, bindings,
-                                                initializer_binding_indices, boolean_error)) {
-                    NameResolutionResult result;
+                                                operand_indices, boolean_error)) {
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(std::move(boolean_error));
                     return result;
                 }
-                initializer_static_type = ClassicalStaticType::Boolean;
-                append_binding_names(bindings, initializer_binding_indices, initializer_binding_names);
+                annotation.static_type = ClassicalStaticType::Boolean;
             }
-            if (!is_state_value_type(initializer_static_type)) {
-                NameResolutionResult result;
+            if (!is_state_value_type(annotation.static_type)) {
+                NameResolutionTableResult result;
                 result.diagnostics.push_back(invalid_mutable_initializer_diagnostic(declaration->span, declaration->name));
                 return result;
             }
-            resolved.nodes.emplace_back(ResolvedHybridMutableDeclaration{*declaration, initializer_binding_index,
-                                                                          initializer_static_type,
-                                                                          std::move(initializer_binding_indices)});
-            resolved.semantic_bindings.push_back({declaration->name, SemanticBindingKind::MutableCell,
-                                                  initializer_static_type, node_index, declaration->span,
-                                                  std::move(initializer_binding_names)});
-            bindings.emplace(declaration->name, BindingInfo{node_index, initializer_static_type,
-                                                            declaration->name, SemanticBindingKind::MutableCell});
+            record_operands(annotation);
+            table.binding_nodes.push_back(table_index(node_index));
+            bindings.declare(declaration->name, node_index, annotation.static_type, SemanticBindingKind::MutableCell);
             continue;
         }
 
         if (const auto* assignment = std::get_if<HybridAssignment>(&node)) {
-            const auto target = bindings.find(assignment->target_name);
-            if (target == bindings.end() || target->second.kind != SemanticBindingKind::MutableCell) {
-                NameResolutionResult result;
+            const BindingInfo* target = bindings.find(assignment->target_name);
+            if (target == nullptr || target->kind != SemanticBindingKind::MutableCell) {
+                NameResolutionTableResult result;
                 result.diagnostics.push_back(invalid_mutable_assignment_target_diagnostic(assignment->span,
                                                                                             assignment->target_name));
                 return result;
             }
-            std::optional<std::size_t> value_binding_index;
-            std::vector<std::size_t> value_binding_indices;
-            std::vector<std::string> ignored_binding_names;
             ClassicalStaticType value_static_type = assignment->value.static_type;
             if (assignment->value.kind == ClassicalExpressionKind::IdentifierReference &&
                 is_identifier(assignment->source_value)) {
-                const auto binding = bindings.find(assignment->source_value);
-                if (binding == bindings.end()) {
-                    NameResolutionResult result;
+                const BindingInfo* binding = bindings.find(assignment->source_value);
+                if (binding == nullptr) {
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(mutable_assignment_type_diagnostic(
-                        assignment->span, assignment->target_name, target->second.static_type,
+                        assignment->span, assignment->target_name, target->static_type,
                         ClassicalStaticType::Unknown));
                     return result;
                 }
-                value_binding_index = binding->second.index;
-                value_static_type = binding->second.static_type;
+                annotation.binding_index = table_index(binding->index);
+                value_static_type = binding->static_type;
             }
             if (assignment->value.kind == ClassicalExpressionKind::IntegerArithmeticExpression) {
                 Diagnostic arithmetic_error;
                 if (!assignment->value.integer_arithmetic.has_value() ||
                     !resolve_integer_arithmetic_expression(*assignment->value.integer_arithmetic, bindings,
-                                                           value_binding_indices, ignored_binding_names,
-                                                           arithmetic_error)) {
-                    NameResolutionResult result;
+                                                           operand_indices, arithmetic_error)) {
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(std::move(arithmetic_error));
                     return result;
                 }
@@ -849,105 +942,98 @@ NameResolutionResult resolve_hybrid_names(const HybridProgram& program) {
                 Diagnostic boolean_error;
                 if (!assignment->value.boolean_expression.has_value() ||
                     !resolve_boolean_expression(*assignment->value.boolean_expression, bindings,
-                                                value_binding_indices, boolean_error)) {
-                    NameResolutionResult result;
+                                                operand_indices, boolean_error)) {
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(std::move(boolean_error));
                     return result;
                 }
                 value_static_type = ClassicalStaticType::Boolean;
             }
-            if (!is_state_value_type(value_static_type) || value_static_type != target->second.static_type) {
-                NameResolutionResult result;
+            if (!is_state_value_type(value_static_type) || value_static_type != target->static_type) {
+                NameResolutionTableResult result;
                 result.diagnostics.push_back(mutable_assignment_type_diagnostic(
-                    assignment->span, assignment->target_name, target->second.static_type, value_static_type));
+                    assignment->span, assignment->target_name, target->static_type, value_static_type));
                 return result;
             }
-            resolved.nodes.emplace_back(ResolvedHybridAssignment{*assignment, target->second.index,
-                                                                  target->second.static_type, value_binding_index,
-                                                                  value_static_type,
-                                                                  std::move(value_binding_indices)});
+            annotation.target_binding_index = table_index(target->index);
+            annotation.static_type = target->static_type;
+            annotation.value_static_type = value_static_type;
+            record_operands(annotation);
             continue;
         }
 
         if (const auto* qubits = std::get_if<HybridQubitDeclaration>(&node)) {
-            qubit_counts.emplace(qubits->name, qubits->qubit_count);
-            resolved.nodes.emplace_back(*qubits);
+            if (!qubit_counts[qubits->name].has_value()) qubit_counts[qubits->name] = qubits->qubit_count;
             continue;
         }
 
         if (const auto* callable = std::get_if<HybridCallableDeclaration>(&node)) {
             if (callable->binary_classical_body.has_value()) {
                 if (!is_valid_binary_classical_callable(*callable)) {
-                    NameResolutionResult result;
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(binary_classical_callable_definition_diagnostic(
                         callable->span, callable->name));
                     return result;
                 }
-                callable_definitions.emplace(callable->name, *callable);
-                callable_definition_indices.emplace(callable->name, node_index);
-                resolved.nodes.emplace_back(*callable);
+                callable_definitions.emplace(callable->name, node_index);
                 continue;
             }
             if (callable->classical_body.has_value()) {
                 if (!is_valid_classical_callable(*callable)) {
-                    NameResolutionResult result;
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(classical_callable_definition_diagnostic(callable->span, callable->name));
                     return result;
                 }
-                callable_definitions.emplace(callable->name, *callable);
-                callable_definition_indices.emplace(callable->name, node_index);
-                resolved.nodes.emplace_back(*callable);
+                callable_definitions.emplace(callable->name, node_index);
                 continue;
             }
             if (!callable->formals.empty() || callable->parameterized_body.has_value()) {
                 if (!is_valid_parameterized_routine(*callable)) {
-                    NameResolutionResult result;
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(invalid_parameterized_routine_diagnostic(callable->span));
                     return result;
                 }
-                callable_definitions.emplace(callable->name, *callable);
-                callable_definition_indices.emplace(callable->name, node_index);
-                resolved.nodes.emplace_back(*callable);
+                callable_definitions.emplace(callable->name, node_index);
                 continue;
             }
             if (callable->body.has_value()) {
                 Diagnostic qubit_error;
-                if (!validate_qubit_operands(callable->body->qubit_register_names,
+                if (!validate_qubit_operands(callable->body->qubit_registers,
                                              callable->body->qubit_indices, callable->body->span,
-                                             qubit_counts, contains_explicit_default_register, qubit_error)) {
-                    NameResolutionResult result;
+                                             table.symbols, qubit_counts, implicit_default_register,
+                                             qubit_error)) {
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(std::move(qubit_error));
                     return result;
                 }
             }
-            callable_definitions.emplace(callable->name, *callable);
-            callable_definition_indices.emplace(callable->name, node_index);
-            resolved.nodes.emplace_back(*callable);
+            callable_definitions.emplace(callable->name, node_index);
             continue;
         }
 
         if (const auto* call = std::get_if<HybridCallableCall>(&node)) {
-            const auto target = callable_definitions.find(call->name);
+            std::size_t definition_index = 0;
+            const HybridCallableDeclaration* target = find_callable(call->name, definition_index);
             if (!call->arguments.empty()) {
-                if (target == callable_definitions.end() || !is_valid_parameterized_routine(target->second)) {
-                    NameResolutionResult result;
+                if (target == nullptr || !is_valid_parameterized_routine(*target)) {
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(parameterized_routine_call_diagnostic(call->span, call->name));
                     return result;
                 }
-                const HybridCallableDeclaration& routine = target->second;
+                const HybridCallableDeclaration& routine = *target;
                 if (call->arguments.size() != routine.formals.size()) {
-                    NameResolutionResult result;
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(parameterized_routine_call_shape_diagnostic(call->span));
                     return result;
                 }
-                std::vector<std::string> register_names;
+                std::vector<SymbolId> registers;
                 std::vector<std::size_t> qubit_indices;
                 for (std::size_t position = 0; position < routine.formals.size(); ++position) {
                     const HybridRoutineFormal& formal = routine.formals[position];
                     const std::string& actual = call->arguments[position];
                     if (formal.kind == RoutineFormalKind::Angle) {
                         if (!is_literal_angle_parameter(actual)) {
-                            NameResolutionResult result;
+                            NameResolutionTableResult result;
                             result.diagnostics.push_back(parameterized_routine_call_shape_diagnostic(call->span));
                             return result;
                         }
@@ -956,151 +1042,144 @@ NameResolutionResult resolve_hybrid_names(const HybridProgram& program) {
                     std::string register_name;
                     std::size_t qubit_index = 0;
                     if (!parse_routine_actual_qubit(actual, register_name, qubit_index)) {
-                        NameResolutionResult result;
+                        NameResolutionTableResult result;
                         result.diagnostics.push_back(parameterized_routine_call_shape_diagnostic(call->span));
                         return result;
                     }
-                    register_names.push_back(std::move(register_name));
+                    registers.push_back(table.symbols.intern(register_name));
                     qubit_indices.push_back(qubit_index);
                 }
                 Diagnostic qubit_error;
-                if (!validate_qubit_operands(register_names, qubit_indices, call->span, qubit_counts,
-                                             contains_explicit_default_register, qubit_error)) {
-                    NameResolutionResult result;
+                if (!validate_qubit_operands(registers, qubit_indices, call->span, table.symbols, qubit_counts,
+                                             implicit_default_register, qubit_error)) {
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(std::move(qubit_error));
                     return result;
                 }
-                if (qubit_indices.size() == 2 && register_names[0] == register_names[1] &&
+                if (qubit_indices.size() == 2 && registers[0] == registers[1] &&
                     qubit_indices[0] == qubit_indices[1]) {
-                    NameResolutionResult result;
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back({"SYNQ-R006", DiagnosticSeverity::Error, call->span,
                                                   "two-qubit parameterized routine call aliases one physical source qubit",
                                                   "use two distinct declared register[index] operands"});
                     return result;
                 }
-                resolved.nodes.emplace_back(*call);
                 continue;
             }
-            if (target != callable_definitions.end() && target->second.parameterized_body.has_value()) {
-                NameResolutionResult result;
+            if (target != nullptr && target->parameterized_body.has_value()) {
+                NameResolutionTableResult result;
                 result.diagnostics.push_back(parameterized_routine_call_shape_diagnostic(call->span));
                 return result;
             }
-            if (target == callable_definitions.end() || !target->second.body.has_value() ||
-                target->second.kind != CallableDeclarationKind::Kernel) {
-                NameResolutionResult result;
+            if (target == nullptr || !target->body.has_value() || target->kind != CallableDeclarationKind::Kernel) {
+                NameResolutionTableResult result;
                 result.diagnostics.push_back({"SYNQ-R003", DiagnosticSeverity::Error, call->span,
                                               "bounded callable call requires an earlier one-gate kernel definition",
                                               "declare kernel <name>() { quantum <gate> q[index] } before call <name>()"});
                 return result;
             }
-            resolved.nodes.emplace_back(*call);
             continue;
         }
 
         if (const auto* gate = std::get_if<HybridQuantumGate>(&node)) {
             Diagnostic qubit_error;
-            if (!validate_qubit_operands(gate->qubit_register_names, gate->qubit_indices, gate->span, qubit_counts,
-                                         contains_explicit_default_register, qubit_error)) {
-                NameResolutionResult result;
+            if (!validate_qubit_operands(gate->qubit_registers, gate->qubit_indices, gate->span, table.symbols,
+                                         qubit_counts, implicit_default_register, qubit_error)) {
+                NameResolutionTableResult result;
                 result.diagnostics.push_back(std::move(qubit_error));
                 return result;
             }
-            resolved.nodes.emplace_back(*gate);
             continue;
         }
 
         if (const auto* control = std::get_if<HybridControlFlow>(&node)) {
             if (control->feedback_enabled && control->condition.kind == ClassicalConditionKind::IdentifierReference) {
-                const auto binding = bindings.find(control->condition.source_text);
-                if (binding != bindings.end() && binding->second.kind == SemanticBindingKind::MeasurementResult &&
+                const BindingInfo* binding = bindings.find(control->condition.source_text);
+                if (binding != nullptr && binding->kind == SemanticBindingKind::MeasurementResult &&
                     consumed_measurement_results.find(control->condition.source_text) != consumed_measurement_results.end()) {
-                    NameResolutionResult result;
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(invalid_measurement_feedback_result_diagnostic(
                         control->span, control->condition.source_text));
                     return result;
                 }
-                if (binding != bindings.end() && binding->second.kind == SemanticBindingKind::MeasurementResult) {
-                    NameResolutionResult result;
+                if (binding != nullptr && binding->kind == SemanticBindingKind::MeasurementResult) {
+                    NameResolutionTableResult result;
                     result.diagnostics.push_back(invalid_measurement_feedback_result_diagnostic(
                         control->span, control->condition.source_text));
                     return result;
                 }
             }
-            std::optional<std::size_t> condition_binding_index;
-            std::vector<std::size_t> condition_binding_indices;
             Diagnostic condition_error;
-            if (!resolve_boolean_expression(control->condition.expression, bindings, condition_binding_indices,
+            if (!resolve_boolean_expression(control->condition.expression, bindings, operand_indices,
                                             condition_error)) {
-                NameResolutionResult result;
+                NameResolutionTableResult result;
                 result.diagnostics.push_back(std::move(condition_error));
                 return result;
             }
             Diagnostic qubit_error;
             bool qubits_valid = false;
             if (const auto* gate = std::get_if<HybridQuantumGate>(&control->body)) {
-                qubits_valid = validate_qubit_operands(gate->qubit_register_names, gate->qubit_indices, gate->span,
-                                                        qubit_counts, contains_explicit_default_register, qubit_error);
+                qubits_valid = validate_qubit_operands(gate->qubit_registers, gate->qubit_indices, gate->span,
+                                                        table.symbols, qubit_counts, implicit_default_register,
+                                                        qubit_error);
             } else {
                 const auto& measurement = std::get<HybridMeasurement>(control->body);
-                qubits_valid = validate_qubit_measurement(measurement, qubit_counts,
-                                                           contains_explicit_default_register, qubit_error);
+                qubits_valid = validate_qubit_measurement(measurement, table.symbols, qubit_counts,
+                                                           implicit_default_register, qubit_error);
             }
             if (!qubits_valid) {
-                NameResolutionResult result;
+                NameResolutionTableResult result;
                 result.diagnostics.push_back(std::move(qubit_error));
                 return result;
             }
             if (control->condition.kind == ClassicalConditionKind::IdentifierReference &&
-                condition_binding_indices.size() == 1) {
-                condition_binding_index = condition_binding_indices.front();
+                operand_indices.size() == 1) {
+                annotation.binding_index = table_index(operand_indices.front());
             }
-            resolved.nodes.emplace_back(ResolvedHybridControlFlow{*control, condition_binding_index,
-                                                                    std::move(condition_binding_indices)});
+            record_operands(annotation);
             continue;
         }
 
         const auto& measurement = std::get<HybridMeasurement>(node);
         Diagnostic qubit_error;
-        if (!validate_qubit_measurement(measurement, qubit_counts, contains_explicit_default_register, qubit_error)) {
-            NameResolutionResult result;
+        if (!validate_qubit_measurement(measurement, table.symbols, qubit_counts, implicit_default_register,
+                                        qubit_error)) {
+            NameResolutionTableResult result;
             result.diagnostics.push_back(std::move(qubit_error));
             return result;
         }
         if (measurement.result_name.has_value()) {
             const std::string& result_name = *measurement.result_name;
-            resolved.semantic_bindings.push_back({*measurement.result_name, SemanticBindingKind::MeasurementResult,
-                                                  ClassicalStaticType::Boolean, node_index, measurement.span, {}});
-            bindings.emplace(*measurement.result_name, BindingInfo{node_index, ClassicalStaticType::Boolean,
-                                                                    *measurement.result_name,
-                                                                    SemanticBindingKind::MeasurementResult});
+            annotation.static_type = ClassicalStaticType::Boolean;
+            table.binding_nodes.push_back(table_index(node_index));
+            bindings.declare(result_name, node_index, ClassicalStaticType::Boolean,
+                             SemanticBindingKind::MeasurementResult);
 
             if (measurement.feedback_enabled && node_index + 1 < program.nodes.size()) {
                 const auto* next_control = std::get_if<HybridControlFlow>(&program.nodes[node_index + 1]);
                 if (next_control != nullptr && next_control->feedback_enabled &&
                     expression_references_identifier(next_control->condition.expression, result_name)) {
                     if (!is_direct_measurement_feedback_condition(*next_control, result_name)) {
-                        NameResolutionResult result;
+                        NameResolutionTableResult result;
                         result.diagnostics.push_back(invalid_measurement_feedback_result_diagnostic(
                             next_control->span, result_name));
                         return result;
                     }
                     if (!is_direct_measurement_feedback_correction(*next_control)) {
-                        NameResolutionResult result;
+                        NameResolutionTableResult result;
                         result.diagnostics.push_back(invalid_measurement_feedback_correction_diagnostic(
                             next_control->span));
                         return result;
                     }
                     const auto& correction = std::get<HybridQuantumGate>(next_control->body);
-                    if (!validate_qubit_operands(correction.qubit_register_names, correction.qubit_indices,
-                                                 correction.span, qubit_counts,
-                                                 contains_explicit_default_register, qubit_error)) {
-                        NameResolutionResult result;
+                    if (!validate_qubit_operands(correction.qubit_registers, correction.qubit_indices,
+                                                 correction.span, table.symbols, qubit_counts,
+                                                 implicit_default_register, qubit_error)) {
+                        NameResolutionTableResult result;
                         result.diagnostics.push_back(std::move(qubit_error));
                         return result;
                     }
-                    resolved.nodes.emplace_back(ResolvedHybridMeasurementFeedback{
-                        measurement, *next_control, node_index});
+                    annotation.feedback = true;
                     consumed_measurement_results.insert(result_name);
                     terminal_feedback_seen = true;
                     ++node_index;
@@ -1108,14 +1187,77 @@ NameResolutionResult resolve_hybrid_names(const HybridProgram& program) {
                 }
             }
         }
-        resolved.nodes.emplace_back(measurement);
     }
 
-    NameResolutionResult result;
-    result.program = std::move(resolved);
+    NameResolutionTableResult result;
+    result.table = std::move(table);
     return result;
 }
 
+ResolvedHybridProgram materialize_resolved_program(const HybridProgram& program,
+                                                   const HybridResolutionTable& table) {
+    ResolvedHybridProgram resolved;
+    resolved.nodes.reserve(program.nodes.size());
+    for (std::size_t node_index = 0; node_index < program.nodes.size(); ++node_index) {
+        const HybridNode& node = program.nodes[node_index];
+        const HybridNodeResolution& annotation = table.nodes[node_index];
+        if (const auto* declaration = std::get_if<HybridDeclaration>(&node)) {
+            std::optional<std::size_t> callable_declaration_index;
+            std::optional<std::size_t> callable_actual_binding_index;
+            std::optional<std::size_t> binary_callable_declaration_index;
+            std::optional<std::size_t> binary_callable_first_actual_binding_index;
+            std::optional<std::size_t> binary_callable_second_actual_binding_index;
+            if (declaration->classical_callable_invocation.has_value()) {
+                callable_declaration_index = optional_index(annotation.callable_index);
+                callable_actual_binding_index = optional_index(annotation.first_actual_binding_index);
+            } else if (declaration->binary_classical_callable_invocation.has_value()) {
+                binary_callable_declaration_index = optional_index(annotation.callable_index);
+                binary_callable_first_actual_binding_index = optional_index(annotation.first_actual_binding_index);
+                binary_callable_second_actual_binding_index = optional_index(annotation.second_actual_binding_index);
+            }
+            resolved.nodes.emplace_back(ResolvedHybridDeclaration{
+                *declaration, optional_index(annotation.binding_index), annotation.static_type,
+                operand_indices(table, annotation), callable_declaration_index, callable_actual_binding_index,
+                binary_callable_declaration_index, binary_callable_first_actual_binding_index,
+                binary_callable_second_actual_binding_index});
+        } else if (const auto* declaration = std::get_if<HybridMutableDeclaration>(&node)) {
+            resolved.nodes.emplace_back(ResolvedHybridMutableDeclaration{
+                *declaration, optional_index(annotation.binding_index), annotation.static_type,
+                operand_indices(table, annotation)});
+        } else if (const auto* assignment = std::get_if<HybridAssignment>(&node)) {
+            resolved.nodes.emplace_back(ResolvedHybridAssignment{
+                *assignment, annotation.target_binding_index, annotation.static_type,
+                optional_index(annotation.binding_index), annotation.value_static_type,
+                operand_indices(table, annotation)});
+        } else if (const auto* control = std::get_if<HybridControlFlow>(&node)) {
+            resolved.nodes.emplace_back(ResolvedHybridControlFlow{
+                *control, optional_index(annotation.binding_index), operand_indices(table, annotation)});
+        } else if (const auto* measurement = std::get_if<HybridMeasurement>(&node)) {
+            if (annotation.feedback) {
+                resolved.nodes.emplace_back(ResolvedHybridMeasurementFeedback{
+                    *measurement, std::get<HybridControlFlow>(program.nodes[node_index + 1]), node_index});
+                ++node_index;
+            } else {
+                resolved.nodes.emplace_back(*measurement);
+            }
+        } else if (const auto* qubits = std::get_if<HybridQubitDeclaration>(&node)) {
+            resolved.nodes.emplace_back(*qubits);
+        } else if (const auto* callable = std::get_if<HybridCallableDeclaration>(&node)) {
+            resolved.nodes.emplace_back(*callable);
+        } else if (const auto* call = std::get_if<HybridCallableCall>(&node)) {
+            resolved.nodes.emplace_back(*call);
+        } else {
+            resolved.nodes.emplace_back(std::get<HybridQuantumGate>(node));
+        }
+    }
+    resolved.semantic_bindings.reserve(table.binding_nodes.size());
+    for (const std::uint32_t node_index : table.binding_nodes) {
+        resolved.semantic_bindings.push_back(semantic_binding(program, table, node_index));
+    }
+    resolved.symbols = table.symbols;
+    return resolved;
+}
+
 std::string render_semantic_environment(const ResolvedHybridProgram& program) {
     std::ostringstream output;
     output << "semantic environment: top-level classical bindings\n";
@@ -1123,18 +1265,19 @@ std::string render_semantic_environment(const ResolvedHybridProgram& program) {
         output << "(no classical bindings)\n";
         return output.str();
     }
-    for (const SemanticBinding& binding : program.semantic_bindings) {
-        output << "binding " << binding.name << " | " << semantic_binding_kind_name(binding.kind)
-               << " | " << classical_static_type_name(binding.static_type)
-               << " | line " << binding.span.line;
-        if (!binding.dependency_names.empty()) {
-            output << " | depends-on ";
-            for (std::size_t index = 0; index < binding.dependency_names.size(); ++index) {
-                if (index != 0) output << ", ";
-                output << binding.dependency_names[index];
-            }
-        }
-        output << "\n";
+    for (const SemanticBinding& binding : program.semantic_bindings) render_semantic_binding(output, binding);
+    return output.str();
+}
+
+std::string render_semantic_environment(const HybridProgram& program, const HybridResolutionTable& table) {
+    std::ostringstream output;
+    output << "semantic environment: top-level classical bindings\n";
+    if (table.binding_nodes.empty()) {
+        output << "(no classical bindings)\n";
+        return output.str();
+    }
+    for (const std::uint32_t node_index : table.binding_nodes) {
+        render_semantic_binding(output, semantic_binding(program, table, node_index));
     }
     return output.str();
 }
@@ -6,7 +6,9 @@
 #define SYNQ_COMPILER_NAME_RESOLUTION_H
 
 #include <cstddef>
+#include <cstdint>
 #include <optional>
+#include <string>
 #include <variant>
 #include <vector>
 
@@ -95,6 +97,58 @@ using ResolvedHybridNode = std::variant<ResolvedHybridDeclaration, ResolvedHybri
 struct ResolvedHybridProgram {
     std::vector<ResolvedHybridNode> nodes;
     std::vector<SemanticBinding> semantic_bindings;
+    // The lowered program's register symbols, plus any register named only by
+    // a parameterized routine call actual.
+    SymbolTable symbols;
+};
+
+// Marks an absent index in a HybridResolutionTable.
+constexpr std::uint32_t kNoResolvedIndex = static_cast<std::uint32_t>(-1);
+
+// The resolution of one HybridProgram node, kept beside the node rather than in
+// a copy of it. Fields mirror the matching ResolvedHybrid* record; those that do
+// not apply to the node's kind keep their defaults.
+struct HybridNodeResolution {
+    // Declarations: the initializer's static type; assignments: the target's;
+    // named measurements: Boolean.
+    ClassicalStaticType static_type = ClassicalStaticType::Unknown;
+    // Assignments: the value's static type.
+    ClassicalStaticType value_static_type = ClassicalStaticType::Unknown;
+    // The whole-identifier initializer, assignment value, or control condition.
+    std::uint32_t binding_index = kNoResolvedIndex;
+    // Assignments: the mutable cell written.
+    std::uint32_t target_binding_index = kNoResolvedIndex;
+    // U5 and U6 declarations: the local function and its actual bindings. U5
+    // has only a first actual.
+    std::uint32_t callable_index = kNoResolvedIndex;
+    std::uint32_t first_actual_binding_index = kNoResolvedIndex;
+    std::uint32_t second_actual_binding_index = kNoResolvedIndex;
+    // Boolean or integer expression operands, as the range [operands_begin,
+    // operands_end) of HybridResolutionTable::operand_binding_indices.
+    std::uint32_t operands_begin = 0;
+    std::uint32_t operands_end = 0;
+    // Named measurements: the next node is this result's U4 correction and the
+    // two resolve as one ResolvedHybridMeasurementFeedback.
+    bool feedback = false;
+};
+
+// Name resolution as side arrays indexed like the HybridProgram it was run on,
+// which must outlive the table unchanged. No node is copied, so a large program
+// resolves in a small fraction of the memory ResolvedHybridProgram takes.
+struct HybridResolutionTable {
+    std::vector<HybridNodeResolution> nodes;
+    std::vector<std::uint32_t> operand_binding_indices;
+    // Nodes that declared a top-level binding, in source order; one per
+    // ResolvedHybridProgram::semantic_bindings entry.
+    std::vector<std::uint32_t> binding_nodes;
+    SymbolTable symbols;
+};
+
+struct NameResolutionTableResult {
+    std::optional<HybridResolutionTable> table;
+    std::vector<Diagnostic> diagnostics;
+
+    bool ok() const;
 };
 
 struct NameResolutionResult {
@@ -109,9 +163,20 @@ struct NameResolutionResult {
 // create nested scopes, or assign types.
 NameResolutionResult resolve_hybrid_names(const HybridProgram& program);
 
+// The same resolution and diagnostics as resolve_hybrid_names, as a side table
+// over `program`. Consumers that need only validity or the semantic environment
+// can stop here; the others expand it with materialize_resolved_program.
+NameResolutionTableResult resolve_hybrid_name_table(const HybridProgram& program);
+
+// Builds the self-contained ResolvedHybridProgram that resolve_hybrid_names
+// returns from `program` and its resolution table.
+ResolvedHybridProgram materialize_resolved_program(const HybridProgram& program,
+                                                   const HybridResolutionTable& table);
+
 // Renders the resolved top-level semantic environment for inspection. The output
 // intentionally reports static types and dependency names, not evaluated values.
 std::string render_semantic_environment(const ResolvedHybridProgram& program);
+std::string render_semantic_environment(const HybridProgram& program, const HybridResolutionTable& table);
 
 }  // namespace synq::compiler
 
@@ -2,11 +2,14 @@
 
 #include <algorithm>
 #include <cctype>
+#include <charconv>
+#include <cstring>
 #include <limits>
 #include <memory>
-#include <sstream>
+#include <optional>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 namespace synq::compiler {
 namespace {
@@ -15,6 +18,112 @@ void add_diagnostic(OpenQasm3ExportResult& result, std::size_t line, const std::
     result.diagnostics.push_back("line " + std::to_string(line) + ": " + message);
 }
 
+constexpr std::string_view kOpenQasm3Preamble = "OPENQASM 3.0;\ninclude \"stdgates.inc\";\n";
+
+// Formats export text into a fixed-size chunk that goes to the sink each time
+// it fills, so the text itself needs no more memory than the chunk. With no
+// sink the writer discards everything, which is how the validation pass runs
+// the lowering code without formatting any text. Once the sink refuses a write
+// the writer drops everything after it, and lowering stops at the next node.
+class QasmWriter {
+public:
+    explicit QasmWriter(OpenQasm3Sink* sink)
+        : sink_(sink), chunk_(sink == nullptr ? nullptr : std::make_unique<char[]>(kChunkBytes)) {}
+
+    QasmWriter& operator<<(std::string_view text) {
+        if (sink_ != nullptr) append(text);
+        return *this;
+    }
+
+    QasmWriter& operator<<(std::size_t value) {
+        if (sink_ != nullptr && !failed_) {
+            char digits[std::numeric_limits<std::size_t>::digits10 + 1];
+            const auto converted = std::to_chars(digits, digits + sizeof(digits), value);
+            append(std::string_view(digits, static_cast<std::size_t>(converted.ptr - digits)));
+        }
+        return *this;
+    }
+
+    // Hands any buffered text to the sink.
+    void flush() {
+        if (used_ != 0 && !failed_) deliver(std::string_view(chunk_.get(), used_));
+        used_ = 0;
+    }
+
+    std::size_t bytes_written() const { return bytes_written_; }
+    bool failed() const { return failed_; }
+
+private:
+    static constexpr std::size_t kChunkBytes = 64 * 1024;
+
+    void append(std::string_view text) {
+        if (failed_) return;
+        if (text.size() > kChunkBytes - used_) {
+            flush();
+            if (text.size() >= kChunkBytes) {
+                if (!failed_) deliver(text);
+                return;
+            }
+        }
+        std::memcpy(chunk_.get() + used_, text.data(), text.size());
+        used_ += text.size();
+    }
+
+    void deliver(std::string_view text) {
+        if (sink_->write(text)) {
+            bytes_written_ += text.size();
+        } else {
+            failed_ = true;
+        }
+    }
+
+    OpenQasm3Sink* sink_;
+    std::unique_ptr<char[]> chunk_;
+    std::size_t used_ = 0;
+    std::size_t bytes_written_ = 0;
+    bool failed_ = false;
+};
+
+// Runs `lower(writer, header, result)` twice. The first run writes nothing and
+// only collects diagnostics and the facts `header` needs; when it succeeds,
+// `write_header` and a second run stream the program into `sink`. Lowering is
+// deterministic, so the second run accepts exactly what the first did.
+template <typename Header, typename Lower, typename WriteHeader>
+OpenQasm3StreamResult stream_openqasm3(OpenQasm3Sink& sink, const Lower& lower, const WriteHeader& write_header) {
+    OpenQasm3StreamResult streamed;
+    Header header;
+    {
+        OpenQasm3ExportResult validation;
+        QasmWriter discard(nullptr);
+        lower(discard, header, validation);
+        if (!validation.ok()) {
+            streamed.diagnostics = std::move(validation.diagnostics);
+            return streamed;
+        }
+    }
+    QasmWriter writer(&sink);
+    writer << kOpenQasm3Preamble;
+    write_header(writer, header);
+    Header replayed_header;
+    OpenQasm3ExportResult replayed;
+    lower(writer, replayed_header, replayed);
+    writer.flush();
+    streamed.bytes_written = writer.bytes_written();
+    if (writer.failed()) {
+        streamed.sink_failed = true;
+        streamed.diagnostics.push_back("line 0: the OpenQASM 3 output sink rejected a write after " +
+                                       std::to_string(streamed.bytes_written) + " bytes");
+    }
+    return streamed;
+}
+
+OpenQasm3ExportResult collect_openqasm3(OpenQasm3StreamResult streamed, std::string program) {
+    OpenQasm3ExportResult result;
+    result.diagnostics = std::move(streamed.diagnostics);
+    if (result.ok()) result.program = std::move(program);
+    return result;
+}
+
 bool parse_qubit_operand(const std::string& operand, std::size_t& index) {
     if (operand.size() <= 3 || operand.rfind("q[", 0) != 0 || operand.back() != ']') return false;
     index = 0;
@@ -38,8 +147,8 @@ bool parse_operands(const std::vector<std::string>& arguments, std::vector<std::
     return true;
 }
 
-void write_single_qubit_gate(std::ostringstream& body, const std::string& gate,
-                             const std::string& register_name, std::size_t qubit) {
+void write_single_qubit_gate(QasmWriter& body, std::string_view gate, std::string_view register_name,
+                             std::size_t qubit) {
     body << gate << " " << register_name << "[" << qubit << "];\n";
 }
 
@@ -142,7 +251,40 @@ bool is_direct_measurement_feedback_condition(const HybridControlFlow& control,
 bool is_direct_measurement_feedback_correction(const HybridControlFlow& control) {
     const auto* gate = std::get_if<HybridQuantumGate>(&control.body);
     return gate != nullptr && gate->kind == QuantumGateKind::X && !gate->literal_angle.has_value() &&
-           gate->qubit_indices.size() == 1 && gate->qubit_register_names.size() == 1;
+           gate->qubit_indices.size() == 1 && gate->qubit_registers.size() == 1;
+}
+
+// The fields of a typed AST or Hybrid gate that lowering reads, borrowed so a
+// gate is lowered without copying it.
+struct GateView {
+    QuantumGateKind kind;
+    const std::string& source_name;
+    const std::optional<std::string>& literal_angle;
+    const std::vector<std::size_t>& qubit_indices;
+    std::size_t line;
+    // Operand registers by name (AST) or by symbol (Hybrid); an operand past
+    // the end of both is in the default register `q`.
+    const std::vector<std::string>* register_names = nullptr;
+    const std::vector<SymbolId>* registers = nullptr;
+    const SymbolTable* symbols = nullptr;
+
+    const std::string& register_name(std::size_t position) const {
+        static const std::string default_register = "q";
+        if (registers != nullptr && position < registers->size()) return symbols->name((*registers)[position]);
+        if (register_names != nullptr && position < register_names->size()) return (*register_names)[position];
+        return default_register;
+    }
+};
+
+GateView view_of(const QuantumGateNode& gate) {
+    return {gate.kind, gate.source_name, gate.literal_angle, gate.qubit_indices, gate.line,
+            &gate.qubit_register_names};
+}
+
+// Without `symbols` every operand is in the default register.
+GateView view_of(const HybridQuantumGate& gate, const SymbolTable* symbols) {
+    return {gate.kind, gate.source_name, gate.literal_angle, gate.qubit_indices, gate.span.line,
+            nullptr, symbols == nullptr ? nullptr : &gate.qubit_registers, symbols};
 }
 
 bool split_parameterized_kernel(const std::string& kernel, std::string& gate, std::string& parameter) {
@@ -154,8 +296,8 @@ bool split_parameterized_kernel(const std::string& kernel, std::string& gate, st
 }
 
 void write_parameterized_single_qubit_gate(
-    std::ostringstream& body, const std::string& gate, const std::string& parameter,
-    const std::string& register_name, std::size_t qubit) {
+    QasmWriter& body, std::string_view gate, std::string_view parameter,
+    std::string_view register_name, std::size_t qubit) {
     body << gate << "(" << parameter << ") " << register_name << "[" << qubit << "];\n";
 }
 
@@ -189,11 +331,10 @@ std::unique_ptr<QuantumGateNode> typed_legacy_instruction(const InstructionNode&
                                              std::move(operands), instruction.line);
 }
 
-void lower_quantum_gate(const QuantumGateNode& gate, std::ostringstream& body,
+void lower_quantum_gate(const GateView& gate, QasmWriter& body,
                         std::size_t& qubit_count, OpenQasm3ExportResult& result) {
     const auto register_name = [&gate](std::size_t position) -> const std::string& {
-        static const std::string default_register = "q";
-        return position < gate.qubit_register_names.size() ? gate.qubit_register_names[position] : default_register;
+        return gate.register_name(position);
     };
     if (gate.kind == QuantumGateKind::H || gate.kind == QuantumGateKind::X ||
         gate.kind == QuantumGateKind::Y || gate.kind == QuantumGateKind::Z) {
@@ -259,61 +400,73 @@ void lower_quantum_gate(const QuantumGateNode& gate, std::ostringstream& body,
     }
 }
 
-OpenQasm3ExportResult export_extended_hybrid_openqasm3(const HybridProgram& program) {
-    OpenQasm3ExportResult result;
-    std::ostringstream body;
-    std::unordered_map<std::string, std::size_t> declared_qubit_counts;
-    std::vector<std::string> declaration_order;
-    std::unordered_map<std::string, bool> measured_registers;
-    std::vector<std::string> measurement_order;
+// What the header of an extended Hybrid export declares.
+struct ExtendedHybridHeader {
+    // Indexed by SymbolId; an unset count is undeclared.
+    std::vector<std::optional<std::size_t>> declared_qubit_counts;
+    std::vector<SymbolId> declaration_order;
+    std::vector<SymbolId> measurement_order;
+    // The bit that stores the U4 feedback measurement, when there is one.
+    std::string feedback_storage;
+    bool has_feedback_storage = false;
+};
+
+void lower_extended_hybrid_openqasm3(const HybridProgram& program, QasmWriter& body,
+                                     ExtendedHybridHeader& header, OpenQasm3ExportResult& result) {
+    const SymbolTable& symbols = program.symbols;
+    std::vector<std::optional<std::size_t>>& declared_qubit_counts = header.declared_qubit_counts;
+    declared_qubit_counts.assign(symbols.size(), std::nullopt);
+    std::vector<SymbolId>& declaration_order = header.declaration_order;
+    std::vector<bool> measured_registers(symbols.size(), false);
+    std::vector<SymbolId>& measurement_order = header.measurement_order;
+    const auto declared_count = [&declared_qubit_counts](SymbolId id) -> std::optional<std::size_t> {
+        return id < declared_qubit_counts.size() ? declared_qubit_counts[id] : std::nullopt;
+    };
     std::unordered_map<std::string, std::string> declared_boolean_storage;
     std::unordered_map<std::string, HybridQuantumGate> callable_bodies;
     std::unordered_map<std::string, HybridCallableDeclaration> parameterized_callable_definitions;
     std::size_t parameterized_declaration_count = 0;
     std::size_t parameterized_call_count = 0;
     std::optional<HybridMeasurement> pending_feedback_measurement;
-    std::string pending_feedback_storage;
-    bool emitted_feedback_storage = false;
+    std::string& pending_feedback_storage = header.feedback_storage;
+    bool& emitted_feedback_storage = header.has_feedback_storage;
 
     for (const HybridNode& node : program.nodes) {
+        if (body.failed()) return;
         if (pending_feedback_measurement.has_value()) {
             const auto* control = std::get_if<HybridControlFlow>(&node);
             if (control == nullptr || !control->feedback_enabled ||
                 !is_direct_measurement_feedback_condition(*control, *pending_feedback_measurement->result_name)) {
                 add_diagnostic(result, pending_feedback_measurement->span.line,
                                "SYNQ-H004: strict Hybrid export requires an immediate direct conditional x correction after a named U4 measurement");
-                return result;
+                return;
             }
             if (!is_direct_measurement_feedback_correction(*control)) {
                 add_diagnostic(result, control->span.line,
                                "SYNQ-H004: strict Hybrid export accepts only one direct conditional x correction for a U4 measurement result");
-                return result;
+                return;
             }
             const auto& correction = std::get<HybridQuantumGate>(control->body);
-            const auto declaration = declared_qubit_counts.find(correction.qubit_register_names.front());
-            if (declaration == declared_qubit_counts.end() || correction.qubit_indices.front() >= declaration->second) {
+            const auto declaration = declared_count(correction.qubit_registers.front());
+            if (!declaration.has_value() || correction.qubit_indices.front() >= *declaration) {
                 add_diagnostic(result, correction.span.line,
                                "SYNQ-H004: U4 conditional correction requires an earlier declared in-range qubit operand");
-                return result;
+                return;
             }
-            QuantumGateNode typed_gate(correction.kind, correction.source_name, correction.literal_angle,
-                                       correction.qubit_indices, correction.span.line, correction.span,
-                                       correction.qubit_register_names);
-            std::ostringstream lowered_body;
+            body << "if (" << pending_feedback_storage << ") ";
             std::size_t inferred_qubit_count = 0;
-            lower_quantum_gate(typed_gate, lowered_body, inferred_qubit_count, result);
-            if (!result.ok()) return result;
-            body << "if (" << pending_feedback_storage << ") " << lowered_body.str();
+            lower_quantum_gate(view_of(correction, &symbols), body, inferred_qubit_count, result);
+            if (!result.ok()) return;
             pending_feedback_measurement.reset();
             continue;
         }
         if (const auto* qubits = std::get_if<HybridQubitDeclaration>(&node)) {
-            if (declared_qubit_counts.find(qubits->name) != declared_qubit_counts.end()) {
+            if (declared_count(qubits->name).has_value()) {
                 add_diagnostic(result, qubits->span.line,
                                "Hybrid OpenQASM 3 export accepts each qubit register declaration only once");
                 continue;
             }
-            declared_qubit_counts.emplace(qubits->name, qubits->qubit_count);
+            declared_qubit_counts[qubits->name] = qubits->qubit_count;
             declaration_order.push_back(qubits->name);
             continue;
         }
@@ -383,7 +536,7 @@ OpenQasm3ExportResult export_extended_hybrid_openqasm3(const HybridProgram& prog
                 }
                 std::optional<std::string> literal_angle;
                 std::vector<std::size_t> qubit_indices;
-                std::vector<std::string> register_names;
+                std::vector<SymbolId> registers;
                 bool actuals_valid = true;
                 for (std::size_t position = 0; position < routine.formals.size(); ++position) {
                     const HybridRoutineFormal& formal = routine.formals[position];
@@ -402,15 +555,16 @@ OpenQasm3ExportResult export_extended_hybrid_openqasm3(const HybridProgram& prog
                         actuals_valid = false;
                         break;
                     }
-                    const auto declaration = declared_qubit_counts.find(register_name);
-                    if (declaration == declared_qubit_counts.end() || index >= declaration->second) {
+                    const std::optional<SymbolId> register_id = symbols.find(register_name);
+                    const auto declaration = register_id.has_value() ? declared_count(*register_id) : std::nullopt;
+                    if (!declaration.has_value() || index >= *declaration) {
                         actuals_valid = false;
                         break;
                     }
-                    register_names.push_back(std::move(register_name));
+                    registers.push_back(*register_id);
                     qubit_indices.push_back(index);
                 }
-                if (qubit_indices.size() == 2 && register_names[0] == register_names[1] &&
+                if (qubit_indices.size() == 2 && registers[0] == registers[1] &&
                     qubit_indices[0] == qubit_indices[1]) {
                     actuals_valid = false;
                 }
@@ -421,12 +575,9 @@ OpenQasm3ExportResult export_extended_hybrid_openqasm3(const HybridProgram& prog
                 }
                 const HybridParameterizedRoutineBody& routine_body = *routine.parameterized_body;
                 HybridQuantumGate expanded{routine_body.kind, routine_body.source_name, literal_angle,
-                                           std::move(qubit_indices), std::move(register_names), call->span};
-                QuantumGateNode typed_gate(expanded.kind, expanded.source_name, expanded.literal_angle,
-                                           expanded.qubit_indices, expanded.span.line, expanded.span,
-                                           expanded.qubit_register_names);
+                                           std::move(qubit_indices), std::move(registers), call->span};
                 std::size_t inferred_qubit_count = 0;
-                lower_quantum_gate(typed_gate, body, inferred_qubit_count, result);
+                lower_quantum_gate(view_of(expanded, &symbols), body, inferred_qubit_count, result);
                 continue;
             }
             if (parameterized_callable_definitions.find(call->name) != parameterized_callable_definitions.end()) {
@@ -441,41 +592,37 @@ OpenQasm3ExportResult export_extended_hybrid_openqasm3(const HybridProgram& prog
                 continue;
             }
             const HybridQuantumGate& gate = target->second;
-            bool operands_valid = gate.qubit_register_names.size() == gate.qubit_indices.size();
+            bool operands_valid = gate.qubit_registers.size() == gate.qubit_indices.size();
             for (std::size_t position = 0; operands_valid && position < gate.qubit_indices.size(); ++position) {
-                const auto declaration = declared_qubit_counts.find(gate.qubit_register_names[position]);
-                operands_valid = declaration != declared_qubit_counts.end() &&
-                    gate.qubit_indices[position] < declaration->second;
+                const auto declaration = declared_count(gate.qubit_registers[position]);
+                operands_valid = declaration.has_value() && gate.qubit_indices[position] < *declaration;
             }
             if (!operands_valid) {
                 add_diagnostic(result, call->span.line,
                                "bounded kernel call requires an earlier declared register and an in-range body operand");
                 continue;
             }
-            QuantumGateNode typed_gate(gate.kind, gate.source_name, gate.literal_angle,
-                                       gate.qubit_indices, gate.span.line, gate.span,
-                                       gate.qubit_register_names);
             std::size_t inferred_qubit_count = 0;
-            lower_quantum_gate(typed_gate, body, inferred_qubit_count, result);
+            lower_quantum_gate(view_of(gate, &symbols), body, inferred_qubit_count, result);
             continue;
         }
 
         if (const auto* gate = std::get_if<HybridQuantumGate>(&node)) {
-            if (gate->qubit_register_names.size() != gate->qubit_indices.size()) {
+            if (gate->qubit_registers.size() != gate->qubit_indices.size()) {
                 add_diagnostic(result, gate->span.line,
                                "Hybrid OpenQASM 3 export received mismatched quantum register metadata");
                 continue;
             }
             bool operands_valid = true;
             for (std::size_t position = 0; position < gate->qubit_indices.size(); ++position) {
-                const auto declaration = declared_qubit_counts.find(gate->qubit_register_names[position]);
-                if (declaration == declared_qubit_counts.end()) {
+                const auto declaration = declared_count(gate->qubit_registers[position]);
+                if (!declaration.has_value()) {
                     add_diagnostic(result, gate->span.line,
                                    "Hybrid OpenQASM 3 export requires each declared qubit register before use");
                     operands_valid = false;
                     break;
                 }
-                if (gate->qubit_indices[position] >= declaration->second) {
+                if (gate->qubit_indices[position] >= *declaration) {
                     add_diagnostic(result, gate->span.line,
                                    "quantum operand is outside its explicit qubit declaration range");
                     operands_valid = false;
@@ -483,17 +630,14 @@ OpenQasm3ExportResult export_extended_hybrid_openqasm3(const HybridProgram& prog
                 }
             }
             if (!operands_valid) continue;
-            QuantumGateNode typed_gate(gate->kind, gate->source_name, gate->literal_angle,
-                                       gate->qubit_indices, gate->span.line, gate->span,
-                                       gate->qubit_register_names);
             std::size_t inferred_qubit_count = 0;
-            lower_quantum_gate(typed_gate, body, inferred_qubit_count, result);
+            lower_quantum_gate(view_of(*gate, &symbols), body, inferred_qubit_count, result);
             continue;
         }
 
         if (const auto* measurement = std::get_if<HybridMeasurement>(&node)) {
-            const auto declaration = declared_qubit_counts.find(measurement->qubit_register_name);
-            if (declaration == declared_qubit_counts.end()) {
+            const auto declaration = declared_count(measurement->qubit_register);
+            if (!declaration.has_value()) {
                 add_diagnostic(result, measurement->span.line,
                                "Hybrid OpenQASM 3 export requires each declared qubit register before measurement");
                 continue;
@@ -507,31 +651,32 @@ OpenQasm3ExportResult export_extended_hybrid_openqasm3(const HybridProgram& prog
                 if (emitted_feedback_storage) {
                     add_diagnostic(result, measurement->span.line,
                                    "SYNQ-H004: strict Hybrid export accepts at most one U4 named measurement-feedback pair");
-                    return result;
+                    return;
                 }
-                if (measurement->qubit_index >= declaration->second) {
+                if (measurement->qubit_index >= *declaration) {
                     add_diagnostic(result, measurement->span.line,
                                    "measurement operand is outside its explicit qubit declaration range");
                     continue;
                 }
                 pending_feedback_storage = "synq_measure_" + *measurement->result_name;
-                body << pending_feedback_storage << " = measure " << measurement->qubit_register_name << "["
+                body << pending_feedback_storage << " = measure " << symbols.name(measurement->qubit_register) << "["
                      << measurement->qubit_index << "];\n";
                 pending_feedback_measurement = *measurement;
                 emitted_feedback_storage = true;
                 continue;
             }
-            if (measurement->qubit_index >= declaration->second) {
+            if (measurement->qubit_index >= *declaration) {
                 add_diagnostic(result, measurement->span.line,
                                "measurement operand is outside its explicit qubit declaration range");
                 continue;
             }
-            body << "c_" << measurement->qubit_register_name << "[" << measurement->qubit_index
-                 << "] = measure " << measurement->qubit_register_name << "["
+            const std::string& register_name = symbols.name(measurement->qubit_register);
+            body << "c_" << register_name << "[" << measurement->qubit_index
+                 << "] = measure " << register_name << "["
                  << measurement->qubit_index << "];\n";
-            if (!measured_registers[measurement->qubit_register_name]) {
-                measured_registers[measurement->qubit_register_name] = true;
-                measurement_order.push_back(measurement->qubit_register_name);
+            if (!measured_registers[measurement->qubit_register]) {
+                measured_registers[measurement->qubit_register] = true;
+                measurement_order.push_back(measurement->qubit_register);
             }
             continue;
         }
@@ -615,15 +760,15 @@ OpenQasm3ExportResult export_extended_hybrid_openqasm3(const HybridProgram& prog
                                "Hybrid OpenQASM 3 if lowering supports one typed quantum gate body only");
                 continue;
             }
-            if (gate->qubit_register_names.size() != gate->qubit_indices.size()) {
+            if (gate->qubit_registers.size() != gate->qubit_indices.size()) {
                 add_diagnostic(result, gate->span.line,
                                "Hybrid OpenQASM 3 export received mismatched quantum register metadata");
                 continue;
             }
             bool operands_valid = true;
             for (std::size_t position = 0; position < gate->qubit_indices.size(); ++position) {
-                const auto declaration = declared_qubit_counts.find(gate->qubit_register_names[position]);
-                if (declaration == declared_qubit_counts.end() || gate->qubit_indices[position] >= declaration->second) {
+                const auto declaration = declared_count(gate->qubit_registers[position]);
+                if (!declaration.has_value() || gate->qubit_indices[position] >= *declaration) {
                     add_diagnostic(result, gate->span.line,
                                    "if quantum operand requires an earlier declared register and an in-range index");
                     operands_valid = false;
@@ -631,14 +776,9 @@ OpenQasm3ExportResult export_extended_hybrid_openqasm3(const HybridProgram& prog
                 }
             }
             if (!operands_valid) continue;
-            QuantumGateNode typed_gate(gate->kind, gate->source_name, gate->literal_angle,
-                                       gate->qubit_indices, gate->span.line, gate->span,
-                                       gate->qubit_register_names);
-            std::ostringstream lowered_body;
+            body << "if (" << lowered_condition << ") ";
             std::size_t inferred_qubit_count = 0;
-            lower_quantum_gate(typed_gate, lowered_body, inferred_qubit_count, result);
-            if (!result.ok()) continue;
-            body << "if (" << lowered_condition << ") " << lowered_body.str();
+            lower_quantum_gate(view_of(*gate, &symbols), body, inferred_qubit_count, result);
             continue;
         }
 
@@ -650,39 +790,45 @@ OpenQasm3ExportResult export_extended_hybrid_openqasm3(const HybridProgram& prog
     if (pending_feedback_measurement.has_value()) {
         add_diagnostic(result, pending_feedback_measurement->span.line,
                        "SYNQ-H004: strict Hybrid export requires an immediate direct conditional x correction after a named U4 measurement");
-        return result;
+        return;
     }
-    if (!result.ok()) return result;
+    if (!result.ok()) return;
     if (declaration_order.empty()) {
         add_diagnostic(result, 0, "Hybrid OpenQASM 3 export requires at least one explicit qubit declaration");
-        return result;
     }
+}
 
-    std::ostringstream output;
-    output << "OPENQASM 3.0;\n";
-    output << "include \"stdgates.inc\";\n";
-    for (const std::string& name : declaration_order) {
-        output << "qubit[" << declared_qubit_counts.at(name) << "] " << name << ";\n";
+void write_extended_hybrid_header(QasmWriter& output, const ExtendedHybridHeader& header,
+                                  const SymbolTable& symbols) {
+    for (SymbolId id : header.declaration_order) {
+        output << "qubit[" << *header.declared_qubit_counts[id] << "] " << symbols.name(id) << ";\n";
     }
-    if (emitted_feedback_storage) output << "bit " << pending_feedback_storage << ";\n";
-    for (const std::string& name : measurement_order) {
-        output << "bit[" << declared_qubit_counts.at(name) << "] c_" << name << ";\n";
+    if (header.has_feedback_storage) output << "bit " << header.feedback_storage << ";\n";
+    for (SymbolId id : header.measurement_order) {
+        output << "bit[" << *header.declared_qubit_counts[id] << "] c_" << symbols.name(id) << ";\n";
     }
-    output << body.str();
-    result.program = output.str();
-    return result;
 }
 
-}  // namespace
-
-OpenQasm3ExportResult export_openqasm3(const ProgramNode& program) {
-    OpenQasm3ExportResult result;
-    std::ostringstream body;
+// The AST export header: one `q` register sized by the highest operand, and
+// `c` when anything is measured.
+struct InferredRegisterHeader {
     std::size_t qubit_count = 0;
     bool has_measurements = false;
+};
+
+void write_inferred_register_header(QasmWriter& output, const InferredRegisterHeader& header) {
+    output << "qubit[" << header.qubit_count << "] q;\n";
+    if (header.has_measurements) output << "bit[" << header.qubit_count << "] c;\n";
+}
+
+void lower_openqasm3(const ProgramNode& program, QasmWriter& body, InferredRegisterHeader& header,
+                     OpenQasm3ExportResult& result) {
+    std::size_t& qubit_count = header.qubit_count;
+    bool& has_measurements = header.has_measurements;
 
     for (const ASTNode* statement : program.statements) {
-        const auto* measurement = dynamic_cast<const MeasurementNode*>(statement);
+        if (body.failed()) return;
+        const auto* measurement = node_cast<MeasurementNode>(statement);
         if (measurement != nullptr) {
             if (measurement->result_name.has_value()) {
                 add_diagnostic(result, measurement->line,
@@ -694,10 +840,10 @@ OpenQasm3ExportResult export_openqasm3(const ProgramNode& program) {
             has_measurements = true;
             continue;
         }
-        const auto* typed_gate = dynamic_cast<const QuantumGateNode*>(statement);
+        const auto* typed_gate = node_cast<QuantumGateNode>(statement);
         std::unique_ptr<QuantumGateNode> legacy_gate;
         if (typed_gate == nullptr) {
-            const auto* instruction = dynamic_cast<const InstructionNode*>(statement);
+            const auto* instruction = node_cast<InstructionNode>(statement);
             if (instruction != nullptr) {
                 if (instruction->op != "quantum" || instruction->args.empty()) {
                     add_diagnostic(result, instruction->line,
@@ -714,39 +860,30 @@ OpenQasm3ExportResult export_openqasm3(const ProgramNode& program) {
             }
         }
         if (typed_gate == nullptr) {
-            const auto* declaration = dynamic_cast<const DeclarationNode*>(statement);
+            const auto* declaration = node_cast<DeclarationNode>(statement);
             add_diagnostic(result, declaration == nullptr ? 0 : declaration->line,
                            "only supported quantum instructions can be exported to OpenQASM 3");
             continue;
         }
-        lower_quantum_gate(*typed_gate, body, qubit_count, result);
+        lower_quantum_gate(view_of(*typed_gate), body, qubit_count, result);
     }
 
     if (!result.ok()) {
-        return result;
+        return;
     }
     if (qubit_count == 0) {
         add_diagnostic(result, 0, "no supported quantum instructions were available for OpenQASM 3 export");
-        return result;
     }
-
-    std::ostringstream output;
-    output << "OPENQASM 3.0;\n";
-    output << "include \"stdgates.inc\";\n";
-    output << "qubit[" << qubit_count << "] q;\n";
-    if (has_measurements) output << "bit[" << qubit_count << "] c;\n";
-    output << body.str();
-    result.program = output.str();
-    return result;
 }
 
-OpenQasm3ExportResult export_hybrid_openqasm3(const HybridProgram& program) {
-    const bool requires_extended_lowering = std::any_of(program.nodes.begin(), program.nodes.end(),
-        [](const HybridNode& node) {
+bool requires_extended_lowering(const HybridProgram& program) {
+    const std::optional<SymbolId> default_register = program.symbols.find("q");
+    return std::any_of(program.nodes.begin(), program.nodes.end(),
+        [&default_register](const HybridNode& node) {
             const auto* qubits = std::get_if<HybridQubitDeclaration>(&node);
             const auto* callable = std::get_if<HybridCallableDeclaration>(&node);
             const auto* declaration = std::get_if<HybridDeclaration>(&node);
-            return (qubits != nullptr && qubits->name != "q") || std::holds_alternative<HybridControlFlow>(node) ||
+            return (qubits != nullptr && qubits->name != default_register) || std::holds_alternative<HybridControlFlow>(node) ||
                 std::holds_alternative<HybridCallableCall>(node) ||
                 (callable != nullptr && (callable->body.has_value() || callable->parameterized_body.has_value() ||
                                          callable->classical_body.has_value() ||
@@ -754,16 +891,25 @@ OpenQasm3ExportResult export_hybrid_openqasm3(const HybridProgram& program) {
                 (declaration != nullptr && (declaration->classical_callable_invocation.has_value() ||
                                              declaration->binary_classical_callable_invocation.has_value()));
         });
-    if (requires_extended_lowering) return export_extended_hybrid_openqasm3(program);
+}
 
-    OpenQasm3ExportResult result;
-    std::ostringstream body;
+// The default-register Hybrid header: `qubit q[n]` as declared, and `c` when
+// anything is measured.
+struct DeclaredRegisterHeader {
     std::optional<std::size_t> declared_qubit_count;
     bool has_measurements = false;
+};
+
+void lower_default_register_hybrid_openqasm3(const HybridProgram& program, QasmWriter& body,
+                                             DeclaredRegisterHeader& header, OpenQasm3ExportResult& result) {
+    const std::optional<SymbolId> default_register = program.symbols.find("q");
+    std::optional<std::size_t>& declared_qubit_count = header.declared_qubit_count;
+    bool& has_measurements = header.has_measurements;
 
     for (const HybridNode& node : program.nodes) {
+        if (body.failed()) return;
         if (const auto* qubits = std::get_if<HybridQubitDeclaration>(&node)) {
-            if (qubits->name != "q") {
+            if (qubits->name != default_register) {
                 add_diagnostic(result, qubits->span.line,
                                "Hybrid OpenQASM 3 export supports only the default qubit declaration qubit q[n]");
                 continue;
@@ -791,10 +937,8 @@ OpenQasm3ExportResult export_hybrid_openqasm3(const HybridProgram& program) {
                 }
             }
             if (!result.ok()) continue;
-            QuantumGateNode typed_gate(gate->kind, gate->source_name, gate->literal_angle,
-                                       gate->qubit_indices, gate->span.line, gate->span);
             std::size_t inferred_qubit_count = 0;
-            lower_quantum_gate(typed_gate, body, inferred_qubit_count, result);
+            lower_quantum_gate(view_of(*gate, nullptr), body, inferred_qubit_count, result);
             if (inferred_qubit_count > *declared_qubit_count) {
                 add_diagnostic(result, gate->span.line,
                                "quantum kernel requires operands outside the explicit qubit q[n] declaration range");
@@ -846,20 +990,68 @@ OpenQasm3ExportResult export_hybrid_openqasm3(const HybridProgram& program) {
                        "Hybrid OpenQASM 3 export supports only qubit declarations, typed quantum gates, and unnamed measurements");
     }
 
-    if (!result.ok()) return result;
+    if (!result.ok()) return;
     if (!declared_qubit_count.has_value()) {
         add_diagnostic(result, 0, "Hybrid OpenQASM 3 export requires exactly one explicit qubit q[n] declaration");
-        return result;
     }
+}
 
-    std::ostringstream output;
-    output << "OPENQASM 3.0;\n";
-    output << "include \"stdgates.inc\";\n";
-    output << "qubit[" << *declared_qubit_count << "] q;\n";
-    if (has_measurements) output << "bit[" << *declared_qubit_count << "] c;\n";
-    output << body.str();
-    result.program = output.str();
-    return result;
+void write_declared_register_header(QasmWriter& output, const DeclaredRegisterHeader& header) {
+    output << "qubit[" << *header.declared_qubit_count << "] q;\n";
+    if (header.has_measurements) output << "bit[" << *header.declared_qubit_count << "] c;\n";
+}
+
+}  // namespace
+
+bool StringOpenQasm3Sink::write(std::string_view text) {
+    output_.append(text.data(), text.size());
+    return true;
+}
+
+bool FileOpenQasm3Sink::write(std::string_view text) {
+    return std::fwrite(text.data(), 1, text.size(), file_) == text.size();
+}
+
+OpenQasm3StreamResult export_openqasm3(const ProgramNode& program, OpenQasm3Sink& sink) {
+    return stream_openqasm3<InferredRegisterHeader>(
+        sink,
+        [&program](QasmWriter& body, InferredRegisterHeader& header, OpenQasm3ExportResult& result) {
+            lower_openqasm3(program, body, header, result);
+        },
+        write_inferred_register_header);
+}
+
+OpenQasm3ExportResult export_openqasm3(const ProgramNode& program) {
+    std::string output;
+    StringOpenQasm3Sink sink(output);
+    OpenQasm3StreamResult streamed = export_openqasm3(program, sink);
+    return collect_openqasm3(std::move(streamed), std::move(output));
+}
+
+OpenQasm3StreamResult export_hybrid_openqasm3(const HybridProgram& program, OpenQasm3Sink& sink) {
+    if (requires_extended_lowering(program)) {
+        return stream_openqasm3<ExtendedHybridHeader>(
+            sink,
+            [&program](QasmWriter& body, ExtendedHybridHeader& header, OpenQasm3ExportResult& result) {
+                lower_extended_hybrid_openqasm3(program, body, header, result);
+            },
+            [&program](QasmWriter& output, const ExtendedHybridHeader& header) {
+                write_extended_hybrid_header(output, header, program.symbols);
+            });
+    }
+    return stream_openqasm3<DeclaredRegisterHeader>(
+        sink,
+        [&program](QasmWriter& body, DeclaredRegisterHeader& header, OpenQasm3ExportResult& result) {
+            lower_default_register_hybrid_openqasm3(program, body, header, result);
+        },
+        write_declared_register_header);
+}
+
+OpenQasm3ExportResult export_hybrid_openqasm3(const HybridProgram& program) {
+    std::string output;
+    StringOpenQasm3Sink sink(output);
+    OpenQasm3StreamResult streamed = export_hybrid_openqasm3(program, sink);
+    return collect_openqasm3(std::move(streamed), std::move(output));
 }
 
 }  // namespace synq::compiler
@@ -1,7 +1,10 @@
 #ifndef SYNQ_COMPILER_OPENQASM3_EXPORTER_H
 #define SYNQ_COMPILER_OPENQASM3_EXPORTER_H
 
+#include <cstddef>
+#include <cstdio>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "compiler/ast.h"
@@ -18,11 +21,60 @@ struct OpenQasm3ExportResult {
     bool ok() const { return diagnostics.empty(); }
 };
 
+// Receives exported OpenQASM 3 text in order, in pieces of any size. The
+// exporter validates the whole program before its first write, so a sink sees
+// nothing for a program that is rejected.
+class OpenQasm3Sink {
+public:
+    virtual ~OpenQasm3Sink() = default;
+    // Returns false to stop the export; nothing further is written.
+    virtual bool write(std::string_view text) = 0;
+};
+
+// Appends to a caller-owned string, which may be reserved up front.
+class StringOpenQasm3Sink final : public OpenQasm3Sink {
+public:
+    explicit StringOpenQasm3Sink(std::string& output) : output_(output) {}
+    bool write(std::string_view text) override;
+
+private:
+    std::string& output_;
+};
+
+// Writes to an open stdio stream, which stays owned by the caller. A short
+// write stops the export.
+class FileOpenQasm3Sink final : public OpenQasm3Sink {
+public:
+    explicit FileOpenQasm3Sink(std::FILE* file) : file_(file) {}
+    bool write(std::string_view text) override;
+
+private:
+    std::FILE* file_;
+};
+
+// Result of exporting into a sink. The text itself went to the sink.
+struct OpenQasm3StreamResult {
+    std::vector<std::string> diagnostics;
+    std::size_t bytes_written = 0;
+    // The sink refused a write after accepting `bytes_written` bytes, so the
+    // output it holds is incomplete. A diagnostic says so too.
+    bool sink_failed = false;
+
+    bool ok() const { return diagnostics.empty(); }
+};
+
 // Export only `quantum h`, `quantum x`, `quantum y`, `quantum z`, and
 // `quantum bell_pair` instructions from a ProgramNode. Every other recovery
 // statement is rejected instead of being ignored or guessed at.
 OpenQasm3ExportResult export_openqasm3(const ProgramNode& program);
 
+// The same export written through `sink` as it is produced, with no
+// whole-program text buffer: one pass validates the program and sizes the
+// header, a second streams the text in fixed-size chunks and stops at the first
+// refused write. Gates and measurements add no memory; the lookup tables for
+// registers, Boolean declarations, and callables still grow with their count.
+OpenQasm3StreamResult export_openqasm3(const ProgramNode& program, OpenQasm3Sink& sink);
+
 // Export the typed Hybrid IR bounded source subset with explicit qubit
 // declarations, supported gates, unnamed measurements, top-level Boolean-literal
 // declarations, literal if gate bodies, compile-time `not` over a Boolean
@@ -32,6 +84,9 @@ OpenQasm3ExportResult export_openqasm3(const ProgramNode& program);
 // expressions are rejected rather than assigned runtime semantics.
 OpenQasm3ExportResult export_hybrid_openqasm3(const HybridProgram& program);
 
+// The same Hybrid export streamed through `sink`, as for export_openqasm3.
+OpenQasm3StreamResult export_hybrid_openqasm3(const HybridProgram& program, OpenQasm3Sink& sink);
+
 }  // namespace synq::compiler
 
 #endif
@@ -0,0 +1,223 @@
+#include "parse_session.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace synq::compiler {
+
+struct ParseSession::Line {
+    explicit Line(std::string_view source) : text(source) {}
+
+    std::string text;
+    // True when the last parse of `text` was accepted; `effect`, `statement`,
+    // and `line_number` then describe it and `entry_mask` is the feature mask
+    // it was parsed under.
+    bool parsed = false;
+    std::uint32_t entry_mask = 0;
+    RecoveryLineEffect effect;
+    ASTNode* statement = nullptr;
+    std::size_t line_number = 0;
+    // Grammar state after this line, to rewind to when a later line changes.
+    std::shared_ptr<const FeatureRegistry> exit_features;
+    std::optional<std::string_view> exit_measurement_result;
+};
+
+namespace {
+
+// An edit that replaces a few lines leaves their old nodes in the arena; once
+// the garbage outweighs the live program the next edit reparses in full.
+constexpr std::size_t kArenaSlackNodes = 4096;
+
+void set_span_line(SourceSpan& span, std::size_t line_number) {
+    if (span.line != 0) span.line = line_number;
+}
+
+void set_expression_line(ClassicalBooleanExpression& expression, std::size_t line_number) {
+    set_span_line(expression.span, line_number);
+    for (ClassicalBooleanExpression& operand : expression.operands) set_expression_line(operand, line_number);
+}
+
+// Every statement lies on one line, so moving it rewrites each line field and
+// span it carries, nested bodies included.
+void set_statement_line(ASTNode& node, std::size_t line_number) {
+    const auto relocate = [line_number](auto& statement) {
+        statement.line = line_number;
+        set_span_line(statement.span, line_number);
+    };
+    switch (node.node_kind()) {
+    case ASTNodeKind::Instruction: relocate(static_cast<InstructionNode&>(node)); break;
+    case ASTNodeKind::QuantumGate: relocate(static_cast<QuantumGateNode&>(node)); break;
+    case ASTNodeKind::Measurement: relocate(static_cast<MeasurementNode&>(node)); break;
+    case ASTNodeKind::QubitDeclaration: relocate(static_cast<QubitDeclarationNode&>(node)); break;
+    case ASTNodeKind::CallableCall: relocate(static_cast<CallableCallNode&>(node)); break;
+    case ASTNodeKind::MutableDeclaration: relocate(static_cast<MutableDeclarationNode&>(node)); break;
+    case ASTNodeKind::Assignment: relocate(static_cast<AssignmentNode&>(node)); break;
+    case ASTNodeKind::Declaration: {
+        auto& declaration = static_cast<DeclarationNode&>(node);
+        relocate(declaration);
+        if (declaration.classical_callable_invocation.has_value()) {
+            set_span_line(declaration.classical_callable_invocation->span, line_number);
+        }
+        if (declaration.binary_classical_callable_invocation.has_value()) {
+            set_span_line(declaration.binary_classical_callable_invocation->span, line_number);
+        }
+        break;
+    }
+    case ASTNodeKind::CallableDeclaration: {
+        auto& callable = static_cast<CallableDeclarationNode&>(node);
+        relocate(callable);
+        if (callable.body != nullptr) set_statement_line(*callable.body, line_number);
+        if (callable.parameterized_body.has_value()) set_span_line(callable.parameterized_body->span, line_number);
+        if (callable.classical_body.has_value()) set_span_line(callable.classical_body->span, line_number);
+        if (callable.binary_classical_body.has_value()) {
+            set_span_line(callable.binary_classical_body->span, line_number);
+        }
+        break;
+    }
+    case ASTNodeKind::ClassicalControl: {
+        auto& control = static_cast<ClassicalControlNode&>(node);
+        relocate(control);
+        set_span_line(control.condition.span, line_number);
+        set_expression_line(control.condition.expression, line_number);
+        if (control.body != nullptr) set_statement_line(*control.body, line_number);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+}  // namespace
+
+ParseSession::ParseSession(FeatureRegistry configured_features)
+    : configured_features_(std::move(configured_features)), grammar_(configured_features_) {
+    open({});
+}
+
+ParseSession::~ParseSession() = default;
+
+bool ParseSession::enableExperimentalFeature(const std::string& feature_name) {
+    return configured_features_.enable(feature_name);
+}
+
+void ParseSession::open(std::string_view text) {
+    lines_.clear();
+    split_lines(text, lines_);
+    grammar_ = RecoveryGrammar(configured_features_);
+    base_features_ = std::make_shared<const FeatureRegistry>(configured_features_);
+    program_ = std::make_unique<ProgramNode>();
+    accepted_ = 0;
+    stats_ = {};
+    revalidate_from(0);
+}
+
+bool ParseSession::apply_edit(const TextEdit& edit) {
+    const TextPosition& start = edit.start;
+    const TextPosition& end = edit.end;
+    if (end.line >= lines_.size() || start.line > end.line ||
+        (start.line == end.line && start.column > end.column) ||
+        start.column > lines_[start.line]->text.size() || end.column > lines_[end.line]->text.size()) {
+        return false;
+    }
+    const std::string replaced = lines_[start.line]->text.substr(0, start.column) + edit.text +
+                                 lines_[end.line]->text.substr(end.column);
+    stats_ = {};
+    // Names the grammar holds view the text of the lines about to go.
+    forget_from(std::min(start.line, accepted_));
+    std::vector<std::unique_ptr<Line>> inserted;
+    split_lines(replaced, inserted);
+    const auto first = lines_.begin() + static_cast<std::ptrdiff_t>(start.line);
+    lines_.erase(first, first + static_cast<std::ptrdiff_t>(end.line - start.line + 1));
+    lines_.insert(lines_.begin() + static_cast<std::ptrdiff_t>(start.line),
+                  std::make_move_iterator(inserted.begin()), std::make_move_iterator(inserted.end()));
+    if (program_->arena.node_count() > 4 * lines_.size() + kArenaSlackNodes) {
+        open(text());
+        return true;
+    }
+    revalidate_from(accepted_);
+    return true;
+}
+
+const ProgramNode* ParseSession::program() const {
+    return accepted_ == lines_.size() ? program_.get() : nullptr;
+}
+
+std::string ParseSession::text() const {
+    std::string text;
+    for (std::size_t index = 0; index < lines_.size(); ++index) {
+        if (index != 0) text.push_back('\n');
+        text += lines_[index]->text;
+    }
+    return text;
+}
+
+void ParseSession::forget_from(std::size_t first) {
+    for (std::size_t index = first; index < accepted_; ++index) {
+        const RecoveryLineEffect& effect = lines_[index]->effect;
+        if (effect.declared_name.has_value()) grammar_.forget(*effect.declared_name);
+    }
+    accepted_ = first;
+}
+
+void ParseSession::revalidate_from(std::size_t first) {
+    if (first == 0) {
+        grammar_.rewind(*base_features_, std::nullopt);
+    } else {
+        const Line& previous = *lines_[first - 1];
+        grammar_.rewind(*previous.exit_features, previous.exit_measurement_result);
+    }
+    diagnostics_.clear();
+    program_->statements.clear();
+    Diagnostic error;
+    for (std::size_t index = first; index < lines_.size(); ++index) {
+        Line& line = *lines_[index];
+        const std::size_t line_number = index + 1;
+        const std::uint32_t mask = grammar_.feature_mask();
+        if (line.parsed && line.entry_mask == mask && grammar_.replay(line.effect, line_number)) {
+            ++stats_.replayed_lines;
+            if (line.statement != nullptr && line.line_number != line_number) {
+                set_statement_line(*line.statement, line_number);
+            }
+            line.line_number = line_number;
+        } else {
+            ++stats_.reparsed_lines;
+            line.entry_mask = mask;
+            line.line_number = line_number;
+            line.statement = nullptr;
+            line.parsed = grammar_.parse_line(line.text, line_number, *program_, error, line.effect);
+            if (!program_->statements.empty()) {
+                line.statement = program_->statements.back();
+                program_->statements.clear();
+            }
+            if (!line.parsed) {
+                if (line.effect.declared_name.has_value()) grammar_.forget(*line.effect.declared_name);
+                diagnostics_.push_back(std::move(error));
+                accepted_ = index;
+                return;
+            }
+        }
+        if (line.effect.enabled_feature.has_value()) {
+            line.exit_features = std::make_shared<const FeatureRegistry>(grammar_.features());
+        } else {
+            line.exit_features = index == 0 ? base_features_ : lines_[index - 1]->exit_features;
+        }
+        line.exit_measurement_result = grammar_.last_measurement_result();
+    }
+    accepted_ = lines_.size();
+    for (const std::unique_ptr<Line>& line : lines_) {
+        if (line->statement != nullptr) program_->statements.push_back(line->statement);
+    }
+}
+
+void ParseSession::split_lines(std::string_view text, std::vector<std::unique_ptr<Line>>& lines) {
+    std::size_t begin = 0;
+    for (;;) {
+        const std::size_t newline = text.find('\n', begin);
+        if (newline == std::string_view::npos) break;
+        lines.push_back(std::make_unique<Line>(text.substr(begin, newline - begin)));
+        begin = newline + 1;
+    }
+    lines.push_back(std::make_unique<Line>(text.substr(begin)));
+}
+
+}  // namespace synq::compiler
@@ -0,0 +1,98 @@
+// Incremental recovery-profile parsing for editor and REPL callers. A session
+// owns one document as a list of lines. An edit reparses only the lines it
+// replaced; every later line is revalidated by replaying its recorded effect
+// on the order-dependent grammar state (declared names, feature annotations,
+// the last measurement result) and is reparsed only when that state could
+// change its outcome. The result always matches a full parse of `text()`.
+#ifndef SYNQ_COMPILER_PARSE_SESSION_H
+#define SYNQ_COMPILER_PARSE_SESSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ast.h"
+#include "diagnostic.h"
+#include "feature_gate.h"
+#include "recovery_grammar.h"
+
+namespace synq::compiler {
+
+// Zero-based, as editor protocols send them. Columns count bytes.
+struct TextPosition {
+    std::size_t line = 0;
+    std::size_t column = 0;
+};
+
+// Replaces the text between `start` and `end` (end-exclusive) with `text`.
+struct TextEdit {
+    TextPosition start;
+    TextPosition end;
+    std::string text;
+};
+
+struct ParseSessionStats {
+    // Lines run through the grammar by the last open or edit.
+    std::size_t reparsed_lines = 0;
+    // Later lines whose earlier result was kept after replaying its effect.
+    std::size_t replayed_lines = 0;
+};
+
+class ParseSession {
+public:
+    explicit ParseSession(FeatureRegistry configured_features = make_default_feature_registry());
+    ~ParseSession();
+    ParseSession(const ParseSession&) = delete;
+    ParseSession& operator=(const ParseSession&) = delete;
+
+    // Same contract as Parser::enableExperimentalFeature. Takes effect at the
+    // next `open`.
+    bool enableExperimentalFeature(const std::string& feature_name);
+
+    // Replaces the document and parses it in full.
+    void open(std::string_view text);
+
+    // Applies one edit and revalidates from its first line. Returns false,
+    // leaving the document untouched, when the range is outside it.
+    bool apply_edit(const TextEdit& edit);
+
+    // Present only when the document parses, like ParseResult::program. Owned
+    // by the session and valid until the next open or edit.
+    const ProgramNode* program() const;
+    const std::vector<Diagnostic>& diagnostics() const { return diagnostics_; }
+    bool ok() const { return program() != nullptr; }
+
+    std::string text() const;
+    std::size_t line_count() const { return lines_.size(); }
+    const ParseSessionStats& last_stats() const { return stats_; }
+
+private:
+    struct Line;
+
+    // Splits on '\n' only, like the grammar; text ending in a newline ends in
+    // an empty line.
+    static void split_lines(std::string_view text, std::vector<std::unique_ptr<Line>>& lines);
+    void revalidate_from(std::size_t first);
+    void forget_from(std::size_t first);
+
+    FeatureRegistry configured_features_;
+    std::shared_ptr<const FeatureRegistry> base_features_;
+    RecoveryGrammar grammar_;
+    // Lines are heap-allocated so the views the grammar keeps into their text
+    // survive insertions and removals around them.
+    std::vector<std::unique_ptr<Line>> lines_;
+    // Lines [0, accepted_) are accepted in order and their names are declared
+    // in `grammar_`; the parse stopped at line `accepted_` otherwise.
+    std::size_t accepted_ = 0;
+    std::unique_ptr<ProgramNode> program_;
+    std::vector<Diagnostic> diagnostics_;
+    ParseSessionStats stats_;
+};
+
+}  // namespace synq::compiler
+
+#endif
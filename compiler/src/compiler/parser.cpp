@@ -20,36 +20,82 @@
 // SOFTWARE.
 #include <algorithm>
 #include <cctype>
-#include <fstream>
+#include <cstdint>
 #include <iostream>
 #include <memory>
-#include <sstream>
+#include <optional>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 
 #include "classical_expression.h"
 #include "gate_validation.h"
 #include "parser.h"
+#include "recovery_grammar.h"
+#include "source_buffer.h"
+
+// The recovery grammar scans one contiguous source buffer. Lines, tokens, and
+// operands are `std::string_view`s into that buffer; strings are materialized
+// only for the fields an AST node or diagnostic keeps.
 
 namespace {
 
-std::string trim(const std::string& value) {
-    const auto first = std::find_if_not(value.begin(), value.end(), [](unsigned char ch) {
-        return std::isspace(ch) != 0;
-    });
-    const auto last = std::find_if_not(value.rbegin(), value.rend(), [](unsigned char ch) {
-        return std::isspace(ch) != 0;
-    }).base();
-    return first >= last ? "" : std::string(first, last);
+bool is_space(char character) { return std::isspace(static_cast<unsigned char>(character)) != 0; }
+
+std::string_view trim(std::string_view value) {
+    std::size_t first = 0;
+    while (first < value.size() && is_space(value[first])) ++first;
+    std::size_t last = value.size();
+    while (last > first && is_space(value[last - 1])) --last;
+    return value.substr(first, last - first);
+}
+
+bool starts_with(std::string_view value, std::string_view prefix) {
+    return value.size() >= prefix.size() && value.compare(0, prefix.size(), prefix) == 0;
+}
+
+bool ends_with(std::string_view value, std::string_view suffix) {
+    return value.size() >= suffix.size() && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// True when `text` is exactly `left`, `middle`, and `right` concatenated.
+bool is_joined(std::string_view text, std::string_view left, std::string_view middle, std::string_view right) {
+    return text.size() == left.size() + middle.size() + right.size() && starts_with(text, left) &&
+           text.substr(left.size(), middle.size()) == middle && ends_with(text, right);
+}
+
+// Splits `source` at whitespace runs, as repeated `stream >> word` would,
+// storing at most `capacity` words and returning the total word count.
+std::size_t split_words(std::string_view source, std::string_view* words, std::size_t capacity) {
+    std::size_t count = 0;
+    std::size_t position = 0;
+    while (true) {
+        while (position < source.size() && is_space(source[position])) ++position;
+        if (position == source.size()) return count;
+        const std::size_t start = position;
+        while (position < source.size() && !is_space(source[position])) ++position;
+        if (count < capacity) words[count] = source.substr(start, position - start);
+        ++count;
+    }
+}
+
+// Splits off the first word and the trimmed remainder of `source`.
+void split_first_word(std::string_view source, std::string_view& word, std::string_view& rest) {
+    std::size_t start = 0;
+    while (start < source.size() && is_space(source[start])) ++start;
+    std::size_t end = start;
+    while (end < source.size() && !is_space(source[end])) ++end;
+    word = source.substr(start, end - start);
+    rest = trim(source.substr(end));
 }
 
-bool is_non_negative_integer(const std::string& value) {
+bool is_non_negative_integer(std::string_view value) {
     return !value.empty() && std::all_of(value.begin(), value.end(), [](unsigned char ch) {
         return std::isdigit(ch) != 0;
     });
 }
 
-bool is_identifier(const std::string& value) {
+bool is_identifier(std::string_view value) {
     if (value.empty() || !(std::isalpha(static_cast<unsigned char>(value.front())) != 0 || value.front() == '_')) {
         return false;
     }
@@ -58,15 +104,15 @@ bool is_identifier(const std::string& value) {
     });
 }
 
-bool is_qubit_operand(const std::string& value) {
+bool is_qubit_operand(std::string_view value) {
     const std::size_t open = value.find('[');
-    return open != std::string::npos && open > 0 && value.back() == ']' &&
-           value.find('[', open + 1) == std::string::npos &&
+    return open != std::string_view::npos && open > 0 && value.back() == ']' &&
+           value.find('[', open + 1) == std::string_view::npos &&
            is_identifier(value.substr(0, open)) &&
            is_non_negative_integer(value.substr(open + 1, value.size() - open - 2));
 }
 
-bool is_decimal_parameter(const std::string& value) {
+bool is_decimal_parameter(std::string_view value) {
     std::size_t position = !value.empty() && value.front() == '-' ? 1 : 0;
     if (position == value.size()) return false;
     bool has_digit = false;
@@ -84,14 +130,14 @@ bool is_decimal_parameter(const std::string& value) {
     return has_digit;
 }
 
-bool is_parameter_expression(const std::string& value) {
+bool is_parameter_expression(std::string_view value) {
     if (value == "pi" || value == "-pi" || is_decimal_parameter(value)) return true;
-    const std::string prefix = value.rfind("-pi/", 0) == 0 ? "-pi/" : "pi/";
-    return value.rfind(prefix, 0) == 0 && is_non_negative_integer(value.substr(prefix.size())) &&
+    const std::string_view prefix = starts_with(value, "-pi/") ? "-pi/" : "pi/";
+    return starts_with(value, prefix) && is_non_negative_integer(value.substr(prefix.size())) &&
            value.substr(prefix.size()) != "0";
 }
 
-bool is_integer_literal(const std::string& value) {
+bool is_integer_literal(std::string_view value) {
     const std::size_t start = !value.empty() && value.front() == '-' ? 1 : 0;
     if (start == value.size()) return false;
     return std::all_of(value.begin() + start, value.end(), [](unsigned char character) {
@@ -99,37 +145,72 @@ bool is_integer_literal(const std::string& value) {
     });
 }
 
-ClassicalLiteralKind classify_declaration_literal(const std::string& value) {
+bool is_quoted_string(std::string_view value) {
+    return value.size() >= 2 && value.front() == '"' && value.back() == '"';
+}
+
+ClassicalLiteralKind classify_declaration_literal(std::string_view value) {
     if (is_integer_literal(value)) return ClassicalLiteralKind::Integer;
-    if (value.find('.') != std::string::npos && is_decimal_parameter(value)) return ClassicalLiteralKind::Decimal;
+    if (value.find('.') != std::string_view::npos && is_decimal_parameter(value)) return ClassicalLiteralKind::Decimal;
     if (value == "true" || value == "false") return ClassicalLiteralKind::Boolean;
-    if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
-        return ClassicalLiteralKind::QuotedString;
-    }
+    if (is_quoted_string(value)) return ClassicalLiteralKind::QuotedString;
     return ClassicalLiteralKind::SourceText;
 }
 
-bool classify_bounded_classical_value(const std::string& value,
-                                      const synq::compiler::FeatureRegistry& active_features,
+// The feature gates the grammar consults, re-read from the registry whenever
+// an annotation enables one so per-line checks are plain flag reads.
+struct GrammarFeatures {
+    bool parameterized_quantum_gates = false;
+    bool named_qubit_register_operands = false;
+    bool qubit_declarations = false;
+    bool integer_arithmetic_expressions = false;
+    bool classical_control_flow = false;
+    bool measurement_feedback = false;
+    bool mutable_classical_state = false;
+    bool callable_declarations = false;
+    bool classical_callable_execution = false;
+    bool multi_formal_classical_callables = false;
+    bool parameterized_quantum_routines = false;
+
+    explicit GrammarFeatures(const synq::compiler::FeatureRegistry& registry) { refresh(registry); }
+
+    void refresh(const synq::compiler::FeatureRegistry& registry) {
+        parameterized_quantum_gates = registry.is_enabled("parameterized-quantum-gates");
+        named_qubit_register_operands = registry.is_enabled("named-qubit-register-operands");
+        qubit_declarations = registry.is_enabled("qubit-declarations");
+        integer_arithmetic_expressions = registry.is_enabled("integer-arithmetic-expressions");
+        classical_control_flow = registry.is_enabled("classical-control-flow");
+        measurement_feedback = registry.is_enabled("measurement-feedback");
+        mutable_classical_state = registry.is_enabled("mutable-classical-state");
+        callable_declarations = registry.is_enabled("callable-declarations");
+        classical_callable_execution = registry.is_enabled("classical-callable-execution");
+        multi_formal_classical_callables = registry.is_enabled("multi-formal-classical-callables");
+        parameterized_quantum_routines = registry.is_enabled("parameterized-quantum-routines");
+    }
+};
+
+bool classify_bounded_classical_value(std::string_view value,
+                                      const GrammarFeatures& features,
                                       const synq::compiler::SourceSpan& span,
                                       ClassicalLiteralKind& declaration_kind,
                                       std::string& message,
                                       std::string& help) {
     declaration_kind = classify_declaration_literal(value);
-    if (active_features.is_enabled("integer-arithmetic-expressions") &&
-        synq::compiler::looks_like_integer_arithmetic_expression(value)) {
+    if (!features.integer_arithmetic_expressions && !features.classical_control_flow) return true;
+    const std::string source(value);
+    if (features.integer_arithmetic_expressions &&
+        synq::compiler::looks_like_integer_arithmetic_expression(source)) {
         ClassicalIntegerArithmeticExpression arithmetic;
-        if (!synq::compiler::parse_bounded_integer_arithmetic_expression(value, span, arithmetic)) {
+        if (!synq::compiler::parse_bounded_integer_arithmetic_expression(source, span, arithmetic)) {
             message = "malformed bounded integer arithmetic expression";
             help = "use exactly <integer-literal-or-identifier> +, -, or * <integer-literal-or-identifier>";
             return false;
         }
         declaration_kind = ClassicalLiteralKind::IntegerArithmeticExpression;
     }
-    if (active_features.is_enabled("classical-control-flow") &&
-        synq::compiler::looks_like_boolean_expression(value)) {
+    if (features.classical_control_flow && synq::compiler::looks_like_boolean_expression(source)) {
         ClassicalBooleanExpression boolean_expression;
-        if (!synq::compiler::parse_bounded_boolean_declaration_expression(value, span, boolean_expression)) {
+        if (!synq::compiler::parse_bounded_boolean_declaration_expression(source, span, boolean_expression)) {
             message = "malformed bounded Boolean expression";
             help = "use exactly not <Boolean-literal-or-identifier> or <Boolean-literal-or-identifier> and/or <Boolean-literal-or-identifier>";
             return false;
@@ -139,55 +220,58 @@ bool classify_bounded_classical_value(const std::string& value,
     return true;
 }
 
-bool is_parameterized_kernel(const std::string& kernel) {
+bool is_parameterized_kernel(std::string_view kernel) {
     const std::size_t open = kernel.find('(');
-    if (open == std::string::npos) return is_identifier(kernel);
-    if (kernel.back() != ')' || kernel.find('(', open + 1) != std::string::npos) return false;
+    if (open == std::string_view::npos) return is_identifier(kernel);
+    if (kernel.back() != ')' || kernel.find('(', open + 1) != std::string_view::npos) return false;
     return is_identifier(kernel.substr(0, open)) && is_parameter_expression(kernel.substr(open + 1, kernel.size() - open - 2));
 }
 
-bool is_feature_name(const std::string& value) {
+bool is_feature_name(std::string_view value) {
     if (value.empty()) return false;
     return std::all_of(value.begin(), value.end(), [](unsigned char character) {
         return std::islower(character) != 0 || std::isdigit(character) != 0 || character == '-';
     });
 }
 
-bool parse_experimental_feature_annotation(const std::string& line, std::string& feature_name) {
-    const std::string prefix = "#[experimental(feature = \"";
-    const std::string suffix = "\")]";
-    if (line.rfind(prefix, 0) != 0 || line.size() <= prefix.size() + suffix.size() ||
-        line.substr(line.size() - suffix.size()) != suffix) {
+bool parse_experimental_feature_annotation(std::string_view line, std::string_view& feature_name) {
+    constexpr std::string_view prefix = "#[experimental(feature = \"";
+    constexpr std::string_view suffix = "\")]";
+    if (!starts_with(line, prefix) || line.size() <= prefix.size() + suffix.size() || !ends_with(line, suffix)) {
         return false;
     }
     feature_name = line.substr(prefix.size(), line.size() - prefix.size() - suffix.size());
     return is_feature_name(feature_name);
 }
 
-bool parse_quantum_arguments(const std::string& source, std::vector<std::string>& arguments) {
-    std::istringstream tokens(source);
-    std::string kernel;
-    tokens >> kernel;
+// `source` must already be trimmed: the kernel is its first word and the
+// operands follow it. `arguments` receives the kernel, then each operand.
+bool parse_quantum_arguments(std::string_view source, std::vector<std::string_view>& arguments) {
+    std::string_view kernel;
+    std::string_view ignored;
+    split_first_word(source, kernel, ignored);
     if (kernel.empty() || !is_parameterized_kernel(kernel)) return false;
-    arguments = {kernel};
+    arguments.clear();
+    arguments.push_back(kernel);
 
-    const bool has_parameter = kernel.find('(') != std::string::npos;
-    std::string operands = trim(source.substr(kernel.size()));
+    const bool has_parameter = kernel.find('(') != std::string_view::npos;
+    const std::string_view operands = trim(source.substr(kernel.size()));
     if (operands.empty()) return !has_parameter;  // Preserve only the documented legacy kernel form.
 
     std::size_t start = 0;
     while (start <= operands.size()) {
         const std::size_t comma = operands.find(',', start);
-        const std::string operand = trim(operands.substr(start, comma == std::string::npos ? std::string::npos : comma - start));
+        const std::string_view operand =
+            trim(operands.substr(start, comma == std::string_view::npos ? std::string_view::npos : comma - start));
         if (!is_qubit_operand(operand)) return false;
         arguments.push_back(operand);
-        if (comma == std::string::npos) return !has_parameter || arguments.size() == 2;
+        if (comma == std::string_view::npos) return !has_parameter || arguments.size() == 2;
         start = comma + 1;
     }
     return false;
 }
 
-bool parse_qubit_operand(const std::string& operand, std::string& register_name, std::size_t& index) {
+bool parse_qubit_operand(std::string_view operand, std::string_view& register_name, std::size_t& index) {
     if (!is_qubit_operand(operand)) return false;
     const std::size_t open = operand.find('[');
     register_name = operand.substr(0, open);
@@ -198,31 +282,31 @@ bool parse_qubit_operand(const std::string& operand, std::string& register_name,
     return true;
 }
 
-bool parse_measurement_arguments(const std::string& source,
-                                 std::string& register_name,
+bool parse_measurement_arguments(std::string_view source,
+                                 std::string_view& register_name,
                                  std::size_t& qubit_index,
-                                 std::optional<std::string>& result_name) {
-    const std::string separator = " as ";
+                                 std::optional<std::string_view>& result_name) {
+    constexpr std::string_view separator = " as ";
     const std::size_t boundary = source.find(separator);
-    if (boundary == std::string::npos) {
+    if (boundary == std::string_view::npos) {
         result_name = std::nullopt;
         return parse_qubit_operand(source, register_name, qubit_index);
     }
-    if (source.find(separator, boundary + separator.size()) != std::string::npos) return false;
-    const std::string operand = trim(source.substr(0, boundary));
-    const std::string name = trim(source.substr(boundary + separator.size()));
+    if (source.find(separator, boundary + separator.size()) != std::string_view::npos) return false;
+    const std::string_view operand = trim(source.substr(0, boundary));
+    const std::string_view name = trim(source.substr(boundary + separator.size()));
     if (!parse_qubit_operand(operand, register_name, qubit_index) || !is_identifier(name)) return false;
     result_name = name;
     return true;
 }
 
-bool parse_qubit_declaration(const std::string& source, std::string& name, std::size_t& qubit_count) {
+bool parse_qubit_declaration(std::string_view source, std::string_view& name, std::size_t& qubit_count) {
     const std::size_t open = source.find('[');
-    if (open == std::string::npos || source.empty() || source.back() != ']' ||
-        source.find('[', open + 1) != std::string::npos) {
+    if (open == std::string_view::npos || source.empty() || source.back() != ']' ||
+        source.find('[', open + 1) != std::string_view::npos) {
         return false;
     }
-    const std::string size_text = source.substr(open + 1, source.size() - open - 2);
+    const std::string_view size_text = source.substr(open + 1, source.size() - open - 2);
     name = source.substr(0, open);
     if (!is_identifier(name) || !is_non_negative_integer(size_text) || size_text == "0") return false;
 
@@ -233,13 +317,13 @@ bool parse_qubit_declaration(const std::string& source, std::string& name, std::
     return true;
 }
 
-bool parse_callable_declaration(const std::string& source, std::string& name) {
-    if (source.size() < 3 || source.substr(source.size() - 2) != "()") return false;
+bool parse_callable_declaration(std::string_view source, std::string_view& name) {
+    if (source.size() < 3 || !ends_with(source, "()")) return false;
     name = source.substr(0, source.size() - 2);
     return is_identifier(name);
 }
 
-bool parse_classical_callable_type(const std::string& source, ClassicalCallableValueType& type) {
+bool parse_classical_callable_type(std::string_view source, ClassicalCallableValueType& type) {
     if (source == "Integer") {
         type = ClassicalCallableValueType::Integer;
         return true;
@@ -255,37 +339,43 @@ bool parse_classical_callable_type(const std::string& source, ClassicalCallableV
     return false;
 }
 
-bool parse_classical_callable_declaration(const std::string& source, std::string& name,
+bool is_arithmetic_operator(std::string_view operation) {
+    return operation == "+" || operation == "-" || operation == "*";
+}
+
+bool parse_classical_callable_declaration(std::string_view source, std::string_view& name,
                                           ClassicalCallableBody& body,
                                           const synq::compiler::SourceSpan& span) {
-    const std::string separator = " -> ";
+    constexpr std::string_view separator = " -> ";
     const std::size_t arrow = source.find(separator);
-    if (arrow == std::string::npos || source.find(separator, arrow + separator.size()) != std::string::npos) return false;
-    const std::string signature = trim(source.substr(0, arrow));
-    const std::string expression = trim(source.substr(arrow + separator.size()));
+    if (arrow == std::string_view::npos ||
+        source.find(separator, arrow + separator.size()) != std::string_view::npos) {
+        return false;
+    }
+    const std::string_view signature = trim(source.substr(0, arrow));
+    const std::string_view expression = trim(source.substr(arrow + separator.size()));
     const std::size_t open = signature.find('(');
-    if (open == std::string::npos || signature.empty() || signature.back() != ')' ||
-        signature.find('(', open + 1) != std::string::npos || expression.empty()) {
+    if (open == std::string_view::npos || signature.empty() || signature.back() != ')' ||
+        signature.find('(', open + 1) != std::string_view::npos || expression.empty()) {
         return false;
     }
     name = trim(signature.substr(0, open));
-    const std::string formal = trim(signature.substr(open + 1, signature.size() - open - 2));
+    const std::string_view formal = trim(signature.substr(open + 1, signature.size() - open - 2));
     const std::size_t colon = formal.find(':');
-    if (!is_identifier(name) || colon == std::string::npos || formal.find(':', colon + 1) != std::string::npos) return false;
-    const std::string parameter = trim(formal.substr(0, colon));
+    if (!is_identifier(name) || colon == std::string_view::npos ||
+        formal.find(':', colon + 1) != std::string_view::npos) {
+        return false;
+    }
+    const std::string_view parameter = trim(formal.substr(0, colon));
     ClassicalCallableValueType parameter_type;
     if (!is_identifier(parameter) || !parse_classical_callable_type(trim(formal.substr(colon + 1)), parameter_type)) return false;
 
     ClassicalLiteralKind expression_kind = ClassicalLiteralKind::SourceText;
     if (parameter_type == ClassicalCallableValueType::Integer) {
         if (expression != parameter) {
-            std::istringstream words(expression);
-            std::string left;
-            std::string operation;
-            std::string right;
-            std::string extra;
-            if (!(words >> left >> operation >> right) || (words >> extra) || left != parameter ||
-                (operation != "+" && operation != "-" && operation != "*") || !is_integer_literal(right)) {
+            std::string_view words[3];
+            if (split_words(expression, words, 3) != 3 || words[0] != parameter ||
+                !is_arithmetic_operator(words[1]) || !is_integer_literal(words[2])) {
                 return false;
             }
             expression_kind = ClassicalLiteralKind::IntegerArithmeticExpression;
@@ -293,7 +383,7 @@ bool parse_classical_callable_declaration(const std::string& source, std::string
     } else if (parameter_type == ClassicalCallableValueType::Boolean) {
         if (expression == parameter) {
             expression_kind = ClassicalLiteralKind::SourceText;
-        } else if (expression == "not " + parameter) {
+        } else if (is_joined(expression, "not ", parameter, "")) {
             expression_kind = ClassicalLiteralKind::BooleanExpression;
         } else {
             return false;
@@ -302,43 +392,49 @@ bool parse_classical_callable_declaration(const std::string& source, std::string
         return false;
     }
 
-    body = {parameter, parameter_type, expression, expression_kind, span};
+    body = {std::string(parameter), parameter_type, std::string(expression), expression_kind, span};
     return true;
 }
 
-bool looks_like_classical_callable_declaration(const std::string& source) {
-    return source.find("->") != std::string::npos;
+bool looks_like_classical_callable_declaration(std::string_view source) {
+    return source.find("->") != std::string_view::npos;
 }
 
-bool parse_binary_classical_callable_declaration(const std::string& source, std::string& name,
+bool parse_binary_classical_callable_declaration(std::string_view source, std::string_view& name,
                                                  BinaryClassicalCallableBody& body,
                                                  const synq::compiler::SourceSpan& span) {
-    const std::string separator = " -> ";
+    constexpr std::string_view separator = " -> ";
     const std::size_t arrow = source.find(separator);
-    if (arrow == std::string::npos || source.find(separator, arrow + separator.size()) != std::string::npos) return false;
-    const std::string signature = trim(source.substr(0, arrow));
-    const std::string expression = trim(source.substr(arrow + separator.size()));
+    if (arrow == std::string_view::npos ||
+        source.find(separator, arrow + separator.size()) != std::string_view::npos) {
+        return false;
+    }
+    const std::string_view signature = trim(source.substr(0, arrow));
+    const std::string_view expression = trim(source.substr(arrow + separator.size()));
     const std::size_t open = signature.find('(');
-    if (open == std::string::npos || signature.empty() || signature.back() != ')' ||
-        signature.find('(', open + 1) != std::string::npos || expression.empty()) {
+    if (open == std::string_view::npos || signature.empty() || signature.back() != ')' ||
+        signature.find('(', open + 1) != std::string_view::npos || expression.empty()) {
         return false;
     }
     name = trim(signature.substr(0, open));
-    const std::string formals = trim(signature.substr(open + 1, signature.size() - open - 2));
+    const std::string_view formals = trim(signature.substr(open + 1, signature.size() - open - 2));
     const std::size_t comma = formals.find(',');
-    if (!is_identifier(name) || comma == std::string::npos || formals.find(',', comma + 1) != std::string::npos) return false;
-    const std::string first_formal = trim(formals.substr(0, comma));
-    const std::string second_formal = trim(formals.substr(comma + 1));
-    const auto parse_formal = [](const std::string& formal, std::string& parameter,
+    if (!is_identifier(name) || comma == std::string_view::npos ||
+        formals.find(',', comma + 1) != std::string_view::npos) {
+        return false;
+    }
+    const std::string_view first_formal = trim(formals.substr(0, comma));
+    const std::string_view second_formal = trim(formals.substr(comma + 1));
+    const auto parse_formal = [](std::string_view formal, std::string_view& parameter,
                                  ClassicalCallableValueType& parameter_type) {
         const std::size_t colon = formal.find(':');
-        if (colon == std::string::npos || formal.find(':', colon + 1) != std::string::npos) return false;
+        if (colon == std::string_view::npos || formal.find(':', colon + 1) != std::string_view::npos) return false;
         parameter = trim(formal.substr(0, colon));
         return is_identifier(parameter) &&
                parse_classical_callable_type(trim(formal.substr(colon + 1)), parameter_type);
     };
-    std::string first_parameter;
-    std::string second_parameter;
+    std::string_view first_parameter;
+    std::string_view second_parameter;
     ClassicalCallableValueType first_type;
     ClassicalCallableValueType second_type;
     if (!parse_formal(first_formal, first_parameter, first_type) ||
@@ -350,181 +446,183 @@ bool parse_binary_classical_callable_declaration(const std::string& source, std:
 
     ClassicalLiteralKind expression_kind = ClassicalLiteralKind::SourceText;
     if (first_type == ClassicalCallableValueType::Integer) {
-        std::istringstream words(expression);
-        std::string left;
-        std::string operation;
-        std::string right;
-        std::string extra;
-        if (!(words >> left >> operation >> right) || (words >> extra) || left != first_parameter ||
-            right != second_parameter || (operation != "+" && operation != "-" && operation != "*")) {
+        std::string_view words[3];
+        if (split_words(expression, words, 3) != 3 || words[0] != first_parameter ||
+            words[2] != second_parameter || !is_arithmetic_operator(words[1])) {
             return false;
         }
         expression_kind = ClassicalLiteralKind::IntegerArithmeticExpression;
-    } else if (expression == first_parameter + " and " + second_parameter ||
-               expression == first_parameter + " or " + second_parameter) {
+    } else if (is_joined(expression, first_parameter, " and ", second_parameter) ||
+               is_joined(expression, first_parameter, " or ", second_parameter)) {
         expression_kind = ClassicalLiteralKind::BooleanExpression;
     } else {
         return false;
     }
 
-    body = {first_parameter, second_parameter, first_type, expression, expression_kind, span};
+    body = {std::string(first_parameter), std::string(second_parameter), first_type, std::string(expression),
+            expression_kind, span};
     return true;
 }
 
-bool looks_like_binary_classical_callable_declaration(const std::string& source) {
+bool looks_like_binary_classical_callable_declaration(std::string_view source) {
     const std::size_t arrow = source.find("->");
     const std::size_t open = source.find('(');
-    return arrow != std::string::npos && open != std::string::npos && open < arrow &&
-           source.find(',', open) != std::string::npos;
+    return arrow != std::string_view::npos && open != std::string_view::npos && open < arrow &&
+           source.find(',', open) != std::string_view::npos;
+}
+
+bool is_callable_actual(std::string_view actual) {
+    return !actual.empty() && (is_identifier(actual) || is_integer_literal(actual) || actual == "true" ||
+                               actual == "false" || is_quoted_string(actual));
 }
 
-bool parse_classical_callable_invocation(const std::string& source,
+bool parse_classical_callable_invocation(std::string_view source,
                                          ClassicalCallableInvocation& invocation,
                                          const synq::compiler::SourceSpan& span) {
     const std::size_t open = source.find('(');
-    if (open == std::string::npos || source.empty() || source.back() != ')' ||
-        source.find('(', open + 1) != std::string::npos || source.find(',', open + 1) != std::string::npos) {
+    if (open == std::string_view::npos || source.empty() || source.back() != ')' ||
+        source.find('(', open + 1) != std::string_view::npos ||
+        source.find(',', open + 1) != std::string_view::npos) {
         return false;
     }
-    const std::string name = trim(source.substr(0, open));
-    const std::string actual = trim(source.substr(open + 1, source.size() - open - 2));
-    if (!is_identifier(name) || actual.empty() || (!is_identifier(actual) && !is_integer_literal(actual) &&
-        actual != "true" && actual != "false" && !(actual.size() >= 2 && actual.front() == '"' && actual.back() == '"'))) {
-        return false;
-    }
-    invocation = {name, actual, classify_declaration_literal(actual), span};
+    const std::string_view name = trim(source.substr(0, open));
+    const std::string_view actual = trim(source.substr(open + 1, source.size() - open - 2));
+    if (!is_identifier(name) || !is_callable_actual(actual)) return false;
+    invocation = {std::string(name), std::string(actual), classify_declaration_literal(actual), span};
     return true;
 }
 
-bool looks_like_classical_callable_invocation(const std::string& source) {
-    return source.find('(') != std::string::npos || source.find(')') != std::string::npos;
+bool looks_like_classical_callable_invocation(std::string_view source) {
+    return source.find('(') != std::string_view::npos || source.find(')') != std::string_view::npos;
 }
 
-bool parse_binary_classical_callable_invocation(const std::string& source,
+bool parse_binary_classical_callable_invocation(std::string_view source,
                                                 BinaryClassicalCallableInvocation& invocation,
                                                 const synq::compiler::SourceSpan& span) {
     const std::size_t open = source.find('(');
-    if (open == std::string::npos || source.empty() || source.back() != ')' ||
-        source.find('(', open + 1) != std::string::npos) {
+    if (open == std::string_view::npos || source.empty() || source.back() != ')' ||
+        source.find('(', open + 1) != std::string_view::npos) {
         return false;
     }
-    const std::string name = trim(source.substr(0, open));
-    const std::string actuals = trim(source.substr(open + 1, source.size() - open - 2));
+    const std::string_view name = trim(source.substr(0, open));
+    const std::string_view actuals = trim(source.substr(open + 1, source.size() - open - 2));
     const std::size_t comma = actuals.find(',');
-    if (!is_identifier(name) || comma == std::string::npos || actuals.find(',', comma + 1) != std::string::npos) return false;
-    const std::string first_actual = trim(actuals.substr(0, comma));
-    const std::string second_actual = trim(actuals.substr(comma + 1));
-    const auto is_actual = [](const std::string& actual) {
-        return !actual.empty() && (is_identifier(actual) || is_integer_literal(actual) || actual == "true" ||
-            actual == "false" || (actual.size() >= 2 && actual.front() == '"' && actual.back() == '"'));
-    };
-    if (!is_actual(first_actual) || !is_actual(second_actual)) return false;
-    invocation = {name, first_actual, classify_declaration_literal(first_actual),
-                  second_actual, classify_declaration_literal(second_actual), span};
+    if (!is_identifier(name) || comma == std::string_view::npos ||
+        actuals.find(',', comma + 1) != std::string_view::npos) {
+        return false;
+    }
+    const std::string_view first_actual = trim(actuals.substr(0, comma));
+    const std::string_view second_actual = trim(actuals.substr(comma + 1));
+    if (!is_callable_actual(first_actual) || !is_callable_actual(second_actual)) return false;
+    invocation = {std::string(name), std::string(first_actual), classify_declaration_literal(first_actual),
+                  std::string(second_actual), classify_declaration_literal(second_actual), span};
     return true;
 }
 
-bool looks_like_binary_classical_callable_invocation(const std::string& source) {
+bool looks_like_binary_classical_callable_invocation(std::string_view source) {
     const std::size_t open = source.find('(');
-    return open != std::string::npos && source.find(',', open) != std::string::npos;
+    return open != std::string_view::npos && source.find(',', open) != std::string_view::npos;
 }
 
-QuantumGateKind quantum_gate_kind(const std::string& source_name);
+QuantumGateKind quantum_gate_kind(std::string_view source_name);
 
-bool parse_bounded_kernel_body(const std::string& source, std::string& name, std::string& body) {
+bool parse_bounded_kernel_body(std::string_view source, std::string_view& name, std::string_view& body) {
     const std::size_t open = source.find("() {");
-    if (open == std::string::npos || source.size() <= open + 6 || source.back() != '}') return false;
+    if (open == std::string_view::npos || source.size() <= open + 6 || source.back() != '}') return false;
     name = trim(source.substr(0, open));
     body = trim(source.substr(open + 4, source.size() - open - 5));
-    return is_identifier(name) && body.rfind("quantum ", 0) == 0 && body.find(';') == std::string::npos;
+    return is_identifier(name) && starts_with(body, "quantum ") && body.find(';') == std::string_view::npos;
 }
 
-bool split_comma_list(const std::string& source, std::vector<std::string>& values) {
+bool split_comma_list(std::string_view source, std::vector<std::string_view>& values) {
     values.clear();
     std::size_t start = 0;
     while (start <= source.size()) {
         const std::size_t comma = source.find(',', start);
-        const std::string value = trim(source.substr(start, comma == std::string::npos ? std::string::npos : comma - start));
+        const std::string_view value =
+            trim(source.substr(start, comma == std::string_view::npos ? std::string_view::npos : comma - start));
         if (value.empty()) return false;
         values.push_back(value);
-        if (comma == std::string::npos) return true;
+        if (comma == std::string_view::npos) return true;
         start = comma + 1;
     }
     return false;
 }
 
-bool parse_parameterized_routine_call(const std::string& source, std::string& name,
-                                      std::vector<std::string>& actuals) {
+std::vector<std::string> to_strings(const std::vector<std::string_view>& views) {
+    return std::vector<std::string>(views.begin(), views.end());
+}
+
+bool parse_parameterized_routine_call(std::string_view source, std::string_view& name,
+                                      std::vector<std::string_view>& actuals) {
     const std::size_t open = source.find('(');
-    if (open == std::string::npos || source.back() != ')' || open == 0) return false;
+    if (open == std::string_view::npos || source.back() != ')' || open == 0) return false;
     name = trim(source.substr(0, open));
     return is_identifier(name) && split_comma_list(source.substr(open + 1, source.size() - open - 2), actuals);
 }
 
-bool looks_like_parameterized_routine_call(const std::string& source) {
+bool looks_like_parameterized_routine_call(std::string_view source) {
     const std::size_t open = source.find('(');
-    return open != std::string::npos && source.back() == ')' &&
+    return open != std::string_view::npos && source.back() == ')' &&
            !trim(source.substr(open + 1, source.size() - open - 2)).empty();
 }
 
-bool looks_like_parameterized_routine_declaration(const std::string& source) {
+bool looks_like_parameterized_routine_declaration(std::string_view source) {
     const std::size_t open = source.find('(');
-    const std::size_t close = source.find(')', open == std::string::npos ? 0 : open + 1);
-    return open != std::string::npos && close != std::string::npos && close > open &&
+    const std::size_t close = source.find(')', open == std::string_view::npos ? 0 : open + 1);
+    return open != std::string_view::npos && close != std::string_view::npos && close > open &&
            !trim(source.substr(open + 1, close - open - 1)).empty();
 }
 
-bool parse_parameterized_routine(const std::string& source, std::string& name,
+bool parse_parameterized_routine(std::string_view source, std::string_view& name,
                                  std::vector<RoutineFormal>& formals,
                                  ParameterizedRoutineBody& body,
                                  const synq::compiler::SourceSpan& span) {
     const std::size_t open = source.find('(');
-    const std::size_t close = source.find(')', open == std::string::npos ? 0 : open + 1);
-    if (open == std::string::npos || close == std::string::npos || close <= open || source.back() != '}') return false;
+    const std::size_t close = source.find(')', open == std::string_view::npos ? 0 : open + 1);
+    if (open == std::string_view::npos || close == std::string_view::npos || close <= open || source.back() != '}') {
+        return false;
+    }
     name = trim(source.substr(0, open));
-    const std::string suffix = trim(source.substr(close + 1));
-    if (!is_identifier(name) || suffix.rfind("{ quantum ", 0) != 0) return false;
-    std::vector<std::string> formal_tokens;
+    const std::string_view suffix = trim(source.substr(close + 1));
+    if (!is_identifier(name) || !starts_with(suffix, "{ quantum ")) return false;
+    std::vector<std::string_view> formal_tokens;
     if (!split_comma_list(source.substr(open + 1, close - open - 1), formal_tokens)) return false;
     formals.clear();
-    for (const std::string& token : formal_tokens) {
-        std::istringstream words(token);
-        std::string type;
-        std::string identifier;
-        std::string extra;
-        words >> type >> identifier >> extra;
-        if (!extra.empty() || !is_identifier(identifier) ||
-            std::any_of(formals.begin(), formals.end(), [&identifier](const RoutineFormal& formal) { return formal.name == identifier; })) return false;
+    for (const std::string_view token : formal_tokens) {
+        std::string_view words[2];
+        const std::size_t count = split_words(token, words, 2);
+        const std::string_view type = words[0];
+        const std::string_view identifier = words[1];
+        if (count > 2 || !is_identifier(identifier) ||
+            std::any_of(formals.begin(), formals.end(), [identifier](const RoutineFormal& formal) { return formal.name == identifier; })) return false;
         if (type == "angle") {
             if (std::any_of(formals.begin(), formals.end(), [](const RoutineFormal& formal) { return formal.kind == RoutineFormalKind::Angle; })) return false;
-            formals.push_back({RoutineFormalKind::Angle, identifier});
+            formals.push_back({RoutineFormalKind::Angle, std::string(identifier)});
         } else if (type == "qubit") {
-            formals.push_back({RoutineFormalKind::Qubit, identifier});
+            formals.push_back({RoutineFormalKind::Qubit, std::string(identifier)});
         } else {
             return false;
         }
     }
-    const std::string gate_source = trim(suffix.substr(10, suffix.size() - 11));
-    std::istringstream gate_words(gate_source);
-    std::string kernel;
-    gate_words >> kernel;
-    std::string operands;
-    std::getline(gate_words, operands);
-    operands = trim(operands);
+    const std::string_view gate_source = trim(suffix.substr(10, suffix.size() - 11));
+    std::string_view kernel;
+    std::string_view operands;
+    split_first_word(gate_source, kernel, operands);
     if (kernel.empty() || operands.empty()) return false;
     const std::size_t angle_open = kernel.find('(');
-    const bool has_angle = angle_open != std::string::npos;
-    const std::string gate_name = has_angle ? kernel.substr(0, angle_open) : kernel;
-    std::optional<std::string> angle;
+    const bool has_angle = angle_open != std::string_view::npos;
+    const std::string_view gate_name = has_angle ? kernel.substr(0, angle_open) : kernel;
+    std::optional<std::string_view> angle;
     if (has_angle) {
-        if (kernel.back() != ')' || kernel.find('(', angle_open + 1) != std::string::npos) return false;
+        if (kernel.back() != ')' || kernel.find('(', angle_open + 1) != std::string_view::npos) return false;
         angle = kernel.substr(angle_open + 1, kernel.size() - angle_open - 2);
         if (!is_identifier(*angle)) return false;
     }
-    std::vector<std::string> qubits;
+    std::vector<std::string_view> qubits;
     if (!split_comma_list(operands, qubits)) return false;
-    const auto formal_named = [&formals](const std::string& candidate, RoutineFormalKind kind) {
-        return std::any_of(formals.begin(), formals.end(), [&candidate, kind](const RoutineFormal& formal) {
+    const auto formal_named = [&formals](std::string_view candidate, RoutineFormalKind kind) {
+        return std::any_of(formals.begin(), formals.end(), [candidate, kind](const RoutineFormal& formal) {
             return formal.kind == kind && formal.name == candidate;
         });
     };
@@ -538,11 +636,12 @@ bool parse_parameterized_routine(const std::string& source, std::string& name,
     const bool valid_cx = !has_angle && kind == QuantumGateKind::Cx && qubits.size() == 2 && qubits[0] != qubits[1] &&
         formal_named(qubits[0], RoutineFormalKind::Qubit) && formal_named(qubits[1], RoutineFormalKind::Qubit);
     if (!valid_parameterized && !valid_fixed && !valid_cx) return false;
-    body = {kind, gate_name, angle, qubits, span};
+    body = {kind, std::string(gate_name),
+            angle.has_value() ? std::optional<std::string>(std::string(*angle)) : std::nullopt, to_strings(qubits), span};
     return true;
 }
 
-QuantumGateKind quantum_gate_kind(const std::string& source_name) {
+QuantumGateKind quantum_gate_kind(std::string_view source_name) {
     if (source_name == "h") return QuantumGateKind::H;
     if (source_name == "x") return QuantumGateKind::X;
     if (source_name == "y") return QuantumGateKind::Y;
@@ -556,29 +655,30 @@ QuantumGateKind quantum_gate_kind(const std::string& source_name) {
     return QuantumGateKind::Unknown;
 }
 
-QuantumGateNode* make_quantum_gate_node(const std::vector<std::string>& arguments,
+QuantumGateNode* make_quantum_gate_node(ASTArena& arena, const std::vector<std::string_view>& arguments,
                                         std::size_t line_number,
                                         const synq::compiler::SourceSpan& span) {
-    const std::string& kernel = arguments.front();
+    const std::string_view kernel = arguments.front();
     const std::size_t open = kernel.find('(');
-    const bool parameterized = open != std::string::npos;
-    const std::string source_name = parameterized ? kernel.substr(0, open) : kernel;
-    const std::optional<std::string> literal_angle = parameterized
-        ? std::optional<std::string>(kernel.substr(open + 1, kernel.size() - open - 2))
-        : std::nullopt;
+    const bool parameterized = open != std::string_view::npos;
+    const std::string_view source_name = parameterized ? kernel.substr(0, open) : kernel;
+    std::optional<std::string> literal_angle;
+    if (parameterized) literal_angle.emplace(kernel.substr(open + 1, kernel.size() - open - 2));
 
     std::vector<std::size_t> operands;
     std::vector<std::string> register_names;
     operands.reserve(arguments.size() - 1);
+    register_names.reserve(arguments.size() - 1);
     for (std::size_t position = 1; position < arguments.size(); ++position) {
         std::size_t index = 0;
-        std::string register_name;
+        std::string_view register_name;
         if (!parse_qubit_operand(arguments[position], register_name, index)) return nullptr;
         operands.push_back(index);
-        register_names.push_back(std::move(register_name));
+        register_names.emplace_back(register_name);
     }
-    return new QuantumGateNode(quantum_gate_kind(source_name), source_name, literal_angle,
-                               std::move(operands), line_number, span, std::move(register_names));
+    return arena.make<QuantumGateNode>(quantum_gate_kind(source_name), std::string(source_name),
+                                       std::move(literal_angle), std::move(operands), line_number, span,
+                                       std::move(register_names));
 }
 
 bool uses_named_register_operand(const QuantumGateNode& gate) {
@@ -586,38 +686,36 @@ bool uses_named_register_operand(const QuantumGateNode& gate) {
                        [](const std::string& name) { return name != "q"; });
 }
 
-bool parse_boolean_expression_atom(const std::string& source,
+bool parse_boolean_expression_atom(std::string_view source,
                                    const synq::compiler::SourceSpan& span,
                                    ClassicalBooleanExpression& expression) {
     if (source == "true" || source == "false") {
-        expression = {ClassicalBooleanExpressionKind::BooleanLiteral, source == "true", source, span, {}};
+        expression = {ClassicalBooleanExpressionKind::BooleanLiteral, source == "true", std::string(source), span, {}};
         return true;
     }
     if (is_identifier(source)) {
-        expression = {ClassicalBooleanExpressionKind::IdentifierReference, false, source, span, {}};
+        expression = {ClassicalBooleanExpressionKind::IdentifierReference, false, std::string(source), span, {}};
         return true;
     }
     return false;
 }
 
-bool parse_bounded_boolean_expression(const std::string& source,
+bool parse_bounded_boolean_expression(std::string_view source,
                                       const synq::compiler::SourceSpan& span,
                                       ClassicalBooleanExpression& expression) {
-    std::istringstream tokens(source);
-    std::vector<std::string> words;
-    std::string word;
-    while (tokens >> word) words.push_back(word);
+    std::string_view words[3];
+    const std::size_t count = split_words(source, words, 3);
 
-    if (words.size() == 1) return parse_boolean_expression_atom(words.front(), span, expression);
+    if (count == 1) return parse_boolean_expression_atom(words[0], span, expression);
 
-    if (words.size() == 2 && words.front() == "not") {
+    if (count == 2 && words[0] == "not") {
         ClassicalBooleanExpression operand;
         if (!parse_boolean_expression_atom(words[1], span, operand)) return false;
-        expression = {ClassicalBooleanExpressionKind::Not, false, source, span, {std::move(operand)}};
+        expression = {ClassicalBooleanExpressionKind::Not, false, std::string(source), span, {std::move(operand)}};
         return true;
     }
 
-    if (words.size() == 3 && (words[1] == "and" || words[1] == "or")) {
+    if (count == 3 && (words[1] == "and" || words[1] == "or")) {
         ClassicalBooleanExpression left;
         ClassicalBooleanExpression right;
         if (!parse_boolean_expression_atom(words[0], span, left) ||
@@ -625,24 +723,25 @@ bool parse_bounded_boolean_expression(const std::string& source,
             return false;
         }
         expression = {words[1] == "and" ? ClassicalBooleanExpressionKind::And
-                                          : ClassicalBooleanExpressionKind::Or,
-                      false, source, span, {std::move(left), std::move(right)}};
+                                        : ClassicalBooleanExpressionKind::Or,
+                      false, std::string(source), span, {std::move(left), std::move(right)}};
         return true;
     }
 
     return false;
 }
 
-bool parse_control_flow_arguments(const std::string& source, const std::string& connector,
+// `separator` is the connector with its surrounding spaces, " then " or " do ".
+bool parse_control_flow_arguments(std::string_view source, std::string_view separator,
                                   ClassicalCondition& condition, const synq::compiler::SourceSpan& span,
-                                  std::string& body_operation, std::string& body_argument) {
-    const std::string separator = " " + connector + " ";
+                                  std::string_view& body_operation, std::string_view& body_argument) {
     const std::size_t boundary = source.find(separator);
-    if (boundary == std::string::npos || source.find(separator, boundary + separator.size()) != std::string::npos) {
+    if (boundary == std::string_view::npos ||
+        source.find(separator, boundary + separator.size()) != std::string_view::npos) {
         return false;
     }
 
-    const std::string condition_text = trim(source.substr(0, boundary));
+    const std::string_view condition_text = trim(source.substr(0, boundary));
     ClassicalBooleanExpression expression;
     if (!parse_bounded_boolean_expression(condition_text, span, expression)) return false;
     ClassicalConditionKind condition_kind = ClassicalConditionKind::BooleanExpression;
@@ -651,28 +750,25 @@ bool parse_control_flow_arguments(const std::string& source, const std::string&
     } else if (expression.kind == ClassicalBooleanExpressionKind::IdentifierReference) {
         condition_kind = ClassicalConditionKind::IdentifierReference;
     }
-    condition = {condition_kind, expression.boolean_value, condition_text, span, std::move(expression)};
+    condition = {condition_kind, expression.boolean_value, std::string(condition_text), span, std::move(expression)};
 
-    std::istringstream body_tokens(trim(source.substr(boundary + separator.size())));
-    body_tokens >> body_operation;
-    std::getline(body_tokens, body_argument);
-    body_argument = trim(body_argument);
+    split_first_word(trim(source.substr(boundary + separator.size())), body_operation, body_argument);
     return !body_operation.empty() && !body_argument.empty();
 }
 
-ASTNode* make_control_body_node(const std::string& operation, const std::string& argument,
-                                const synq::compiler::FeatureRegistry& active_features,
+ASTNode* make_control_body_node(ASTArena& arena, std::string_view operation, std::string_view argument,
+                                const GrammarFeatures& features,
                                 std::size_t line_number, const synq::compiler::SourceSpan& span,
                                 synq::compiler::Diagnostic& error) {
     if (operation == "quantum") {
-        std::vector<std::string> quantum_arguments;
+        std::vector<std::string_view> quantum_arguments;
         if (!parse_quantum_arguments(argument, quantum_arguments)) {
             error = {"SYNQ-P010", synq::compiler::DiagnosticSeverity::Error, span,
                      "classical control-flow body has malformed quantum syntax",
                      "use one bounded quantum statement such as quantum h q[0]"};
             return nullptr;
         }
-        QuantumGateNode* gate = make_quantum_gate_node(quantum_arguments, line_number, span);
+        QuantumGateNode* gate = make_quantum_gate_node(arena, quantum_arguments, line_number, span);
         if (gate == nullptr) {
             error = {"SYNQ-P010", synq::compiler::DiagnosticSeverity::Error, span,
                      "classical control-flow body could not construct typed quantum operands",
@@ -683,28 +779,25 @@ ASTNode* make_control_body_node(const std::string& operation, const std::string&
         if (validation_error.has_value()) {
             error = {validation_error->code, synq::compiler::DiagnosticSeverity::Error, span,
                      validation_error->message, validation_error->help};
-            delete gate;
             return nullptr;
         }
-        if (gate->literal_angle.has_value() && !active_features.is_enabled("parameterized-quantum-gates")) {
+        if (gate->literal_angle.has_value() && !features.parameterized_quantum_gates) {
             error = {"SYNQ-P007", synq::compiler::DiagnosticSeverity::Error, span,
                      "parameterized quantum gates require an alpha feature opt-in",
                      "add #[experimental(feature = \"parameterized-quantum-gates\")] before the gated construct"};
-            delete gate;
             return nullptr;
         }
-        if (uses_named_register_operand(*gate) && !active_features.is_enabled("named-qubit-register-operands")) {
+        if (uses_named_register_operand(*gate) && !features.named_qubit_register_operands) {
             error = {"SYNQ-P007", synq::compiler::DiagnosticSeverity::Error, span,
                      "named qubit register operands require an alpha feature opt-in",
                      "add #[experimental(feature = \"named-qubit-register-operands\")] before the gated construct"};
-            delete gate;
             return nullptr;
         }
         return gate;
     }
 
     if (operation == "measure") {
-        std::string register_name;
+        std::string_view register_name;
         std::size_t qubit_index = 0;
         if (!parse_qubit_operand(argument, register_name, qubit_index)) {
             error = {"SYNQ-P008", synq::compiler::DiagnosticSeverity::Error, span,
@@ -712,13 +805,13 @@ ASTNode* make_control_body_node(const std::string& operation, const std::string&
                      "use measure q[index], for example measure q[0]"};
             return nullptr;
         }
-        if (register_name != "q" && !active_features.is_enabled("named-qubit-register-operands")) {
+        if (register_name != "q" && !features.named_qubit_register_operands) {
             error = {"SYNQ-P007", synq::compiler::DiagnosticSeverity::Error, span,
                      "named qubit register operands require an alpha feature opt-in",
                      "add #[experimental(feature = \"named-qubit-register-operands\")] before the gated construct"};
             return nullptr;
         }
-        return new MeasurementNode(qubit_index, line_number, span, std::nullopt, std::move(register_name));
+        return arena.make<MeasurementNode>(qubit_index, line_number, span, std::nullopt, std::string(register_name));
     }
 
     error = {"SYNQ-P010", synq::compiler::DiagnosticSeverity::Error, span,
@@ -727,26 +820,26 @@ ASTNode* make_control_body_node(const std::string& operation, const std::string&
     return nullptr;
 }
 
-std::string strip_comment(const std::string& value) {
+std::string_view strip_comment(std::string_view value) {
     // Recovery-profile rule: `//` begins a comment only at the start of a
     // trimmed line or when preceded by whitespace. This preserves source text
     // such as `https://example.invalid`.
     std::size_t marker = value.find("//");
-    while (marker != std::string::npos) {
-        if (marker == 0 || std::isspace(static_cast<unsigned char>(value[marker - 1])) != 0) {
-            return trim(value.substr(0, marker));
-        }
+    while (marker != std::string_view::npos) {
+        if (marker == 0 || is_space(value[marker - 1])) return trim(value.substr(0, marker));
         marker = value.find("//", marker + 2);
     }
     return trim(value);
 }
 
-synq::compiler::SourceSpan span_for_line(const std::string& raw_line,
-                                         const std::string& trimmed_line,
+// Columns come from offsets into the raw line: the statement starts at the
+// first byte that is not a space, tab, or line terminator.
+synq::compiler::SourceSpan span_for_line(std::string_view raw_line,
+                                         std::string_view statement,
                                          std::size_t line_number) {
     const std::size_t first = raw_line.find_first_not_of(" \t\r\n");
-    const std::size_t column_start = first == std::string::npos ? 1 : first + 1;
-    return {line_number, column_start, column_start + trimmed_line.size()};
+    const std::size_t column_start = first == std::string_view::npos ? 1 : first + 1;
+    return {line_number, column_start, column_start + statement.size()};
 }
 
 synq::compiler::ParseResult fail_parse(const std::string& code,
@@ -758,451 +851,624 @@ synq::compiler::ParseResult fail_parse(const std::string& code,
     return result;
 }
 
-}  // namespace
-
-Parser::Parser()
-    : configured_features_(synq::compiler::make_default_feature_registry()) {}
+std::string duplicate_declaration_message(std::string_view name, const synq::compiler::SourceSpan& first) {
+    return "duplicate top-level declaration `" + std::string(name) + "`; first declared on line " +
+           std::to_string(first.line);
+}
 
-bool Parser::enableExperimentalFeature(const std::string& feature_name) {
-    return configured_features_.enable(feature_name);
+bool reject(synq::compiler::Diagnostic& error,
+            const std::string& code,
+            const synq::compiler::SourceSpan& span,
+            const std::string& message,
+            const std::string& help) {
+    error = {code, synq::compiler::DiagnosticSeverity::Error, span, message, help};
+    return false;
 }
 
-synq::compiler::ParseResult Parser::parseStreamWithDiagnostics(std::istream& input) {
-    auto root = std::make_unique<ProgramNode>();
-    synq::compiler::FeatureRegistry active_features = configured_features_;
-    std::unordered_map<std::string, synq::compiler::SourceSpan> declared_names;
-    std::string raw_line;
-    std::size_t line_number = 0;
-    while (std::getline(input, raw_line)) {
-        ++line_number;
-        std::string line = strip_comment(trim(raw_line));
-        if (line.empty()) continue;
-        if (line.back() == ';') line = trim(line.substr(0, line.size() - 1));
-        const synq::compiler::SourceSpan span = span_for_line(raw_line, line, line_number);
-
-        if (line.rfind("#[", 0) == 0) {
-            std::string feature_name;
-            if (!parse_experimental_feature_annotation(line, feature_name) || !active_features.enable(feature_name)) {
-                return fail_parse("SYNQ-P006", span, "unknown or malformed experimental feature annotation",
-                                  "use a registered annotation such as #[experimental(feature = \"parameterized-quantum-gates\")]" );
-            }
-            continue;
+// State the recovery grammar carries from one line to the next.
+struct RecoveryLineState {
+    synq::compiler::FeatureRegistry active_features;
+    GrammarFeatures features;
+    // Keys view the text of the line that declared each name.
+    std::unordered_map<std::string_view, synq::compiler::SourceSpan> declared_names;
+    // Result name of the statement appended last when it is a named measurement;
+    // consumers may already have taken that statement out of the program.
+    std::optional<std::string_view> last_measurement_result;
+    std::vector<std::string_view> quantum_arguments;
+
+    explicit RecoveryLineState(const synq::compiler::FeatureRegistry& configured_features)
+        : active_features(configured_features), features(active_features) {}
+};
+
+bool parse_recovery_line(RecoveryLineState& state,
+                         std::string_view raw_line,
+                         std::size_t line_number,
+                         ProgramNode& program,
+                         synq::compiler::Diagnostic& error,
+                         synq::compiler::RecoveryLineEffect& effect) {
+    synq::compiler::FeatureRegistry& active_features = state.active_features;
+    GrammarFeatures& features = state.features;
+    std::vector<std::string_view>& quantum_arguments = state.quantum_arguments;
+    std::optional<std::string_view>& last_measurement_result = state.last_measurement_result;
+    effect = {};
+    const auto declare = [&](std::string_view name) {
+        const auto inserted = state.declared_names.emplace(name, effect.span);
+        if (inserted.second) effect.declared_name = name;
+        return inserted;
+    };
+    std::string_view line = strip_comment(trim(raw_line));
+    if (line.empty()) return true;
+    if (line.back() == ';') line = trim(line.substr(0, line.size() - 1));
+    const synq::compiler::SourceSpan span = span_for_line(raw_line, line, line_number);
+    effect.span = span;
+
+    if (starts_with(line, "#[")) {
+        std::string_view feature_name;
+        if (!parse_experimental_feature_annotation(line, feature_name) ||
+            !active_features.enable(std::string(feature_name))) {
+            return reject(error, "SYNQ-P006", span, "unknown or malformed experimental feature annotation",
+                          "use a registered annotation such as #[experimental(feature = \"parameterized-quantum-gates\")]" );
         }
+        features.refresh(active_features);
+        effect.enabled_feature = feature_name;
+        return true;
+    }
 
-        std::istringstream tokens(line);
-        std::string operation;
-        tokens >> operation;
-        std::string argument;
-        std::getline(tokens, argument);
-        argument = trim(argument);
-
-        if (operation == "let") {
-            const auto assignment = argument.find('=');
-            const std::string identifier = assignment == std::string::npos ? "" : trim(argument.substr(0, assignment));
-            const std::string value = assignment == std::string::npos ? "" : trim(argument.substr(assignment + 1));
-            if (!is_identifier(identifier) || value.empty()) {
-                return fail_parse("SYNQ-P002", span, "malformed declaration", "use let <identifier> = <value>");
+    // Every other line either appends exactly one statement or fails.
+    const std::optional<std::string_view> prior_measurement_result =
+        std::exchange(last_measurement_result, std::nullopt);
+    effect.statement = true;
+    std::string_view operation;
+    std::string_view argument;
+    split_first_word(line, operation, argument);
+
+    if (operation == "let") {
+        const auto assignment = argument.find('=');
+        const std::string_view identifier = assignment == std::string_view::npos ? "" : trim(argument.substr(0, assignment));
+        const std::string_view value = assignment == std::string_view::npos ? "" : trim(argument.substr(assignment + 1));
+        if (!is_identifier(identifier) || value.empty()) {
+            return reject(error, "SYNQ-P002", span, "malformed declaration", "use let <identifier> = <value>");
+        }
+        ClassicalCallableInvocation invocation;
+        BinaryClassicalCallableInvocation binary_invocation;
+        const bool looks_like_binary_invocation = looks_like_binary_classical_callable_invocation(value);
+        const bool looks_like_invocation = !looks_like_binary_invocation &&
+                                           looks_like_classical_callable_invocation(value);
+        if (looks_like_binary_invocation) {
+            if (!features.classical_callable_execution || !features.multi_formal_classical_callables) {
+                return reject(error, "SYNQ-P007", span, "binary classical callable execution requires explicit alpha feature opt-ins",
+                              "add classical-callable-execution and multi-formal-classical-callables annotations before the invocation");
             }
-            ClassicalCallableInvocation invocation;
-            BinaryClassicalCallableInvocation binary_invocation;
-            const bool looks_like_binary_invocation = looks_like_binary_classical_callable_invocation(value);
-            const bool looks_like_invocation = !looks_like_binary_invocation &&
-                                               looks_like_classical_callable_invocation(value);
-            if (looks_like_binary_invocation) {
-                if (!active_features.is_enabled("classical-callable-execution") ||
-                    !active_features.is_enabled("multi-formal-classical-callables")) {
-                    return fail_parse("SYNQ-P007", span, "binary classical callable execution requires explicit alpha feature opt-ins",
-                                      "add classical-callable-execution and multi-formal-classical-callables annotations before the invocation");
-                }
-                if (!parse_binary_classical_callable_invocation(value, binary_invocation, span)) {
-                    return fail_parse("SYNQ-P022", span, "malformed bounded binary classical callable invocation",
-                                      "use let <binding> = <earlier-function>(<first literal or immutable binding>, <second literal or immutable binding>)");
-                }
-            } else if (looks_like_invocation) {
-                if (!active_features.is_enabled("classical-callable-execution")) {
-                    return fail_parse("SYNQ-P007", span, "classical callable execution requires an alpha feature opt-in",
-                                      "add #[experimental(feature = \"classical-callable-execution\")] before the invocation");
-                }
-                if (!parse_classical_callable_invocation(value, invocation, span)) {
-                    return fail_parse("SYNQ-P020", span, "malformed classical callable invocation",
-                                      "use let <binding> = <earlier-function>(<one literal or earlier immutable binding>)");
-                }
+            if (!parse_binary_classical_callable_invocation(value, binary_invocation, span)) {
+                return reject(error, "SYNQ-P022", span, "malformed bounded binary classical callable invocation",
+                              "use let <binding> = <earlier-function>(<first literal or immutable binding>, <second literal or immutable binding>)");
             }
-            ClassicalLiteralKind declaration_kind;
-            std::string message;
-            std::string help;
-            if (!looks_like_invocation && !looks_like_binary_invocation &&
-                !classify_bounded_classical_value(value, active_features, span, declaration_kind, message, help)) {
-                return fail_parse("SYNQ-P011", span, message, help);
+        } else if (looks_like_invocation) {
+            if (!features.classical_callable_execution) {
+                return reject(error, "SYNQ-P007", span, "classical callable execution requires an alpha feature opt-in",
+                              "add #[experimental(feature = \"classical-callable-execution\")] before the invocation");
             }
-            if (looks_like_invocation || looks_like_binary_invocation) declaration_kind = ClassicalLiteralKind::SourceText;
-            const auto inserted = declared_names.emplace(identifier, span);
-            if (!inserted.second) {
-                return fail_parse("SYNQ-S004", span,
-                                  "duplicate top-level declaration `" + identifier +
-                                      "`; first declared on line " + std::to_string(inserted.first->second.line),
-                                  "rename the later binding or reuse the existing declaration according to future language semantics");
+            if (!parse_classical_callable_invocation(value, invocation, span)) {
+                return reject(error, "SYNQ-P020", span, "malformed classical callable invocation",
+                              "use let <binding> = <earlier-function>(<one literal or earlier immutable binding>)");
             }
-            auto* declaration = new DeclarationNode(identifier, value, line_number, declaration_kind, span);
-            if (looks_like_invocation) declaration->classical_callable_invocation = std::move(invocation);
-            if (looks_like_binary_invocation) declaration->binary_classical_callable_invocation = std::move(binary_invocation);
-            root->statements.push_back(declaration);
-            continue;
         }
+        ClassicalLiteralKind declaration_kind;
+        std::string message;
+        std::string help;
+        if (!looks_like_invocation && !looks_like_binary_invocation &&
+            !classify_bounded_classical_value(value, features, span, declaration_kind, message, help)) {
+            return reject(error, "SYNQ-P011", span, message, help);
+        }
+        if (looks_like_invocation || looks_like_binary_invocation) declaration_kind = ClassicalLiteralKind::SourceText;
+        const auto inserted = declare(identifier);
+        if (!inserted.second) {
+            return reject(error, "SYNQ-S004", span, duplicate_declaration_message(identifier, inserted.first->second),
+                          "rename the later binding or reuse the existing declaration according to future language semantics");
+        }
+        auto* declaration = program.append<DeclarationNode>(std::string(identifier), std::string(value),
+                                                          line_number, declaration_kind, span);
+        if (looks_like_invocation) declaration->classical_callable_invocation = std::move(invocation);
+        if (looks_like_binary_invocation) declaration->binary_classical_callable_invocation = std::move(binary_invocation);
+        return true;
+    }
 
-        if (operation == "var") {
-            if (!active_features.is_enabled("mutable-classical-state")) {
-                return fail_parse("SYNQ-P014", span, "mutable declarations require an alpha feature opt-in",
-                                  "add #[experimental(feature = \"mutable-classical-state\")] before var or set");
-            }
-            const auto assignment = argument.find('=');
-            const std::string identifier = assignment == std::string::npos ? "" : trim(argument.substr(0, assignment));
-            const std::string value = assignment == std::string::npos ? "" : trim(argument.substr(assignment + 1));
-            if (!is_identifier(identifier) || value.empty()) {
-                return fail_parse("SYNQ-P015", span, "malformed mutable declaration",
-                                  "use var <identifier> = <supported-expression>");
-            }
-            ClassicalLiteralKind declaration_kind;
-            std::string message;
-            std::string help;
-            if (!classify_bounded_classical_value(value, active_features, span, declaration_kind, message, help)) {
-                return fail_parse("SYNQ-P011", span, message, help);
-            }
-            const auto inserted = declared_names.emplace(identifier, span);
-            if (!inserted.second) {
-                return fail_parse("SYNQ-S004", span,
-                                  "duplicate top-level declaration `" + identifier +
-                                      "`; first declared on line " + std::to_string(inserted.first->second.line),
-                                  "rename the mutable cell or reuse the existing declaration according to the bounded state contract");
-            }
-            root->statements.push_back(new MutableDeclarationNode(identifier, value, line_number, declaration_kind, span));
-            continue;
+    if (operation == "var") {
+        if (!features.mutable_classical_state) {
+            return reject(error, "SYNQ-P014", span, "mutable declarations require an alpha feature opt-in",
+                          "add #[experimental(feature = \"mutable-classical-state\")] before var or set");
+        }
+        const auto assignment = argument.find('=');
+        const std::string_view identifier = assignment == std::string_view::npos ? "" : trim(argument.substr(0, assignment));
+        const std::string_view value = assignment == std::string_view::npos ? "" : trim(argument.substr(assignment + 1));
+        if (!is_identifier(identifier) || value.empty()) {
+            return reject(error, "SYNQ-P015", span, "malformed mutable declaration",
+                          "use var <identifier> = <supported-expression>");
+        }
+        ClassicalLiteralKind declaration_kind;
+        std::string message;
+        std::string help;
+        if (!classify_bounded_classical_value(value, features, span, declaration_kind, message, help)) {
+            return reject(error, "SYNQ-P011", span, message, help);
         }
+        const auto inserted = declare(identifier);
+        if (!inserted.second) {
+            return reject(error, "SYNQ-S004", span, duplicate_declaration_message(identifier, inserted.first->second),
+                          "rename the mutable cell or reuse the existing declaration according to the bounded state contract");
+        }
+        program.append<MutableDeclarationNode>(std::string(identifier), std::string(value), line_number,
+                                             declaration_kind, span);
+        return true;
+    }
 
-        if (operation == "set") {
-            if (!active_features.is_enabled("mutable-classical-state")) {
-                return fail_parse("SYNQ-P014", span, "mutable assignments require an alpha feature opt-in",
-                                  "add #[experimental(feature = \"mutable-classical-state\")] before var or set");
-            }
-            const auto assignment = argument.find('=');
-            const std::string identifier = assignment == std::string::npos ? "" : trim(argument.substr(0, assignment));
-            const std::string value = assignment == std::string::npos ? "" : trim(argument.substr(assignment + 1));
-            if (!is_identifier(identifier) || value.empty()) {
-                return fail_parse("SYNQ-P016", span, "malformed mutable assignment",
-                                  "use set <earlier-mutable-identifier> = <supported-expression>");
-            }
-            ClassicalLiteralKind declaration_kind;
-            std::string message;
-            std::string help;
-            if (!classify_bounded_classical_value(value, active_features, span, declaration_kind, message, help)) {
-                return fail_parse("SYNQ-P011", span, message, help);
-            }
-            root->statements.push_back(new AssignmentNode(identifier, value, line_number, declaration_kind, span));
-            continue;
+    if (operation == "set") {
+        if (!features.mutable_classical_state) {
+            return reject(error, "SYNQ-P014", span, "mutable assignments require an alpha feature opt-in",
+                          "add #[experimental(feature = \"mutable-classical-state\")] before var or set");
+        }
+        const auto assignment = argument.find('=');
+        const std::string_view identifier = assignment == std::string_view::npos ? "" : trim(argument.substr(0, assignment));
+        const std::string_view value = assignment == std::string_view::npos ? "" : trim(argument.substr(assignment + 1));
+        if (!is_identifier(identifier) || value.empty()) {
+            return reject(error, "SYNQ-P016", span, "malformed mutable assignment",
+                          "use set <earlier-mutable-identifier> = <supported-expression>");
+        }
+        ClassicalLiteralKind declaration_kind;
+        std::string message;
+        std::string help;
+        if (!classify_bounded_classical_value(value, features, span, declaration_kind, message, help)) {
+            return reject(error, "SYNQ-P011", span, message, help);
+        }
+        program.append<AssignmentNode>(std::string(identifier), std::string(value), line_number,
+                                     declaration_kind, span);
+        return true;
+    }
+
+    if (operation == "qubit") {
+        if (!features.qubit_declarations) {
+            return reject(error, "SYNQ-P007", span, "qubit declarations require an alpha feature opt-in",
+                          "add #[experimental(feature = \"qubit-declarations\")] before the gated construct");
+        }
+        std::string_view name;
+        std::size_t qubit_count = 0;
+        if (!parse_qubit_declaration(argument, name, qubit_count)) {
+            return reject(error, "SYNQ-P012", span, "malformed bounded qubit declaration",
+                          "use qubit <identifier>[positive-size], for example qubit q[2]");
+        }
+        const auto inserted = declare(name);
+        if (!inserted.second) {
+            return reject(error, "SYNQ-S004", span, duplicate_declaration_message(name, inserted.first->second),
+                          "rename the later declaration or reuse the existing binding according to future language semantics");
         }
+        program.append<QubitDeclarationNode>(std::string(name), qubit_count, line_number, span);
+        return true;
+    }
 
-        if (operation == "qubit") {
-            if (!active_features.is_enabled("qubit-declarations")) {
-                return fail_parse("SYNQ-P007", span, "qubit declarations require an alpha feature opt-in",
-                                  "add #[experimental(feature = \"qubit-declarations\")] before the gated construct");
-            }
-            std::string name;
-            std::size_t qubit_count = 0;
-            if (!parse_qubit_declaration(argument, name, qubit_count)) {
-                return fail_parse("SYNQ-P012", span, "malformed bounded qubit declaration",
-                                  "use qubit <identifier>[positive-size], for example qubit q[2]");
+    if (operation == "fn" || operation == "kernel") {
+        const bool looks_like_u6_declaration = operation == "fn" && looks_like_binary_classical_callable_declaration(argument);
+        const bool looks_like_u5_declaration = operation == "fn" && !looks_like_u6_declaration &&
+                                               looks_like_classical_callable_declaration(argument);
+        if (looks_like_u6_declaration &&
+            (!features.classical_callable_execution || !features.multi_formal_classical_callables)) {
+            return reject(error, "SYNQ-P007", span, "binary classical callable execution requires explicit alpha feature opt-ins",
+                          "add classical-callable-execution and multi-formal-classical-callables annotations before the function declaration");
+        }
+        if (looks_like_u5_declaration && !features.classical_callable_execution) {
+            return reject(error, "SYNQ-P007", span, "classical callable execution requires an alpha feature opt-in",
+                          "add #[experimental(feature = \"classical-callable-execution\")] before the function declaration");
+        }
+        if (!looks_like_u5_declaration && !looks_like_u6_declaration && !features.callable_declarations) {
+            return reject(error, "SYNQ-P007", span, "callable declarations require an alpha feature opt-in",
+                          "add #[experimental(feature = \"callable-declarations\")] before the gated construct");
+        }
+        if (looks_like_u6_declaration) {
+            std::string_view name;
+            BinaryClassicalCallableBody binary_classical_body;
+            if (!parse_binary_classical_callable_declaration(argument, name, binary_classical_body, span)) {
+                return reject(error, "SYNQ-P021", span, "malformed bounded binary classical callable declaration",
+                              "use fn <name>(<first>: Integer|Boolean, <second>: same-type) -> one documented binary expression");
             }
-            const auto inserted = declared_names.emplace(name, span);
+            const auto inserted = declare(name);
             if (!inserted.second) {
-                return fail_parse("SYNQ-S004", span,
-                                  "duplicate top-level declaration `" + name +
-                                      "`; first declared on line " + std::to_string(inserted.first->second.line),
-                                  "rename the later declaration or reuse the existing binding according to future language semantics");
+                return reject(error, "SYNQ-S004", span, duplicate_declaration_message(name, inserted.first->second),
+                              "rename the later callable or reuse the existing declaration");
             }
-            root->statements.push_back(new QubitDeclarationNode(name, qubit_count, line_number, span));
-            continue;
+            auto* callable = program.append<CallableDeclarationNode>(CallableDeclarationKind::Function,
+                                                                   std::string(name), line_number, span);
+            callable->binary_classical_body = std::move(binary_classical_body);
+            return true;
         }
-
-        if (operation == "fn" || operation == "kernel") {
-            const bool looks_like_u6_declaration = operation == "fn" && looks_like_binary_classical_callable_declaration(argument);
-            const bool looks_like_u5_declaration = operation == "fn" && !looks_like_u6_declaration &&
-                                                   looks_like_classical_callable_declaration(argument);
-            if (looks_like_u6_declaration && (!active_features.is_enabled("classical-callable-execution") ||
-                                              !active_features.is_enabled("multi-formal-classical-callables"))) {
-                return fail_parse("SYNQ-P007", span, "binary classical callable execution requires explicit alpha feature opt-ins",
-                                  "add classical-callable-execution and multi-formal-classical-callables annotations before the function declaration");
-            }
-            if (looks_like_u5_declaration && !active_features.is_enabled("classical-callable-execution")) {
-                return fail_parse("SYNQ-P007", span, "classical callable execution requires an alpha feature opt-in",
-                                  "add #[experimental(feature = \"classical-callable-execution\")] before the function declaration");
-            }
-            if (!looks_like_u5_declaration && !looks_like_u6_declaration &&
-                !active_features.is_enabled("callable-declarations")) {
-                return fail_parse("SYNQ-P007", span, "callable declarations require an alpha feature opt-in",
-                                  "add #[experimental(feature = \"callable-declarations\")] before the gated construct");
-            }
-            if (looks_like_u6_declaration) {
-                std::string name;
-                BinaryClassicalCallableBody binary_classical_body;
-                if (!parse_binary_classical_callable_declaration(argument, name, binary_classical_body, span)) {
-                    return fail_parse("SYNQ-P021", span, "malformed bounded binary classical callable declaration",
-                                      "use fn <name>(<first>: Integer|Boolean, <second>: same-type) -> one documented binary expression");
-                }
-                const auto inserted = declared_names.emplace(name, span);
-                if (!inserted.second) {
-                    return fail_parse("SYNQ-S004", span, "duplicate top-level declaration `" + name +
-                                      "`; first declared on line " + std::to_string(inserted.first->second.line),
-                                      "rename the later callable or reuse the existing declaration");
-                }
-                auto* callable = new CallableDeclarationNode(CallableDeclarationKind::Function, name, line_number, span);
-                callable->binary_classical_body = std::move(binary_classical_body);
-                root->statements.push_back(callable);
-                continue;
-            }
-            if (looks_like_u5_declaration) {
-                std::string name;
-                ClassicalCallableBody classical_body;
-                if (!parse_classical_callable_declaration(argument, name, classical_body, span)) {
-                    return fail_parse("SYNQ-P019", span, "malformed bounded classical callable declaration",
-                                      "use fn <name>(<parameter>: Integer|Boolean|String) -> one documented parameter-only expression");
-                }
-                const auto inserted = declared_names.emplace(name, span);
-                if (!inserted.second) {
-                    return fail_parse("SYNQ-S004", span, "duplicate top-level declaration `" + name +
-                                      "`; first declared on line " + std::to_string(inserted.first->second.line),
-                                      "rename the later callable or reuse the existing declaration");
-                }
-                auto* callable = new CallableDeclarationNode(CallableDeclarationKind::Function, name, line_number, span);
-                callable->classical_body = std::move(classical_body);
-                root->statements.push_back(callable);
-                continue;
-            }
-            std::string name;
-            std::vector<RoutineFormal> routine_formals;
-            ParameterizedRoutineBody routine_body;
-            if (operation == "kernel" && parse_parameterized_routine(argument, name, routine_formals, routine_body, span)) {
-                if (!active_features.is_enabled("parameterized-quantum-routines") ||
-                    !active_features.is_enabled("parameterized-quantum-gates")) {
-                    return fail_parse("SYNQ-P007", span, "parameterized quantum routines require explicit Alpha opt-ins",
-                                      "add parameterized-quantum-routines and parameterized-quantum-gates annotations before the routine");
-                }
-                const auto inserted = declared_names.emplace(name, span);
-                if (!inserted.second) {
-                    return fail_parse("SYNQ-S004", span, "duplicate top-level declaration `" + name +
-                                      "`; first declared on line " + std::to_string(inserted.first->second.line),
-                                      "rename the later routine or reuse the existing declaration");
-                }
-                auto* routine = new CallableDeclarationNode(CallableDeclarationKind::Kernel, name, line_number, span);
-                routine->formals = std::move(routine_formals);
-                routine->parameterized_body = std::move(routine_body);
-                root->statements.push_back(routine);
-                continue;
-            }
-            std::string body_source;
-            const bool has_body = operation == "kernel" && parse_bounded_kernel_body(argument, name, body_source);
-            if (!has_body && !parse_callable_declaration(argument, name)) {
-                if (operation == "kernel" && looks_like_parameterized_routine_declaration(argument)) {
-                    return fail_parse("SYNQ-P017", span, "malformed parameterized quantum routine declaration",
-                                      "use one documented typed signature with one formal-only supported gate body");
-                }
-                return fail_parse("SYNQ-P013", span, "malformed bounded callable declaration",
-                                  "use fn <identifier>(), kernel <identifier>(), or kernel <identifier>() { quantum <gate> <register[index]> }");
+        if (looks_like_u5_declaration) {
+            std::string_view name;
+            ClassicalCallableBody classical_body;
+            if (!parse_classical_callable_declaration(argument, name, classical_body, span)) {
+                return reject(error, "SYNQ-P019", span, "malformed bounded classical callable declaration",
+                              "use fn <name>(<parameter>: Integer|Boolean|String) -> one documented parameter-only expression");
             }
-            const auto inserted = declared_names.emplace(name, span);
+            const auto inserted = declare(name);
             if (!inserted.second) {
-                return fail_parse("SYNQ-S004", span,
-                                  "duplicate top-level declaration `" + name +
-                                      "`; first declared on line " + std::to_string(inserted.first->second.line),
-                                  "rename the callable or reuse the existing binding according to future language semantics");
-            }
-            const CallableDeclarationKind kind = operation == "fn" ? CallableDeclarationKind::Function
-                                                                     : CallableDeclarationKind::Kernel;
-            if (!has_body) {
-                root->statements.push_back(new CallableDeclarationNode(kind, name, line_number, span));
-                continue;
+                return reject(error, "SYNQ-S004", span, duplicate_declaration_message(name, inserted.first->second),
+                              "rename the later callable or reuse the existing declaration");
             }
-            std::vector<std::string> quantum_arguments;
-            if (!parse_quantum_arguments(trim(body_source.substr(std::string("quantum ").size())), quantum_arguments)) {
-                return fail_parse("SYNQ-P013", span, "malformed bounded kernel body",
-                                  "use exactly one supported quantum gate with explicit register operands");
-            }
-            QuantumGateNode* gate = make_quantum_gate_node(quantum_arguments, line_number, span);
-            if (gate == nullptr) {
-                return fail_parse("SYNQ-P013", span, "malformed bounded kernel body",
-                                  "use exactly one supported quantum gate with explicit register operands");
+            auto* callable = program.append<CallableDeclarationNode>(CallableDeclarationKind::Function,
+                                                                   std::string(name), line_number, span);
+            callable->classical_body = std::move(classical_body);
+            return true;
+        }
+        std::string_view name;
+        std::vector<RoutineFormal> routine_formals;
+        ParameterizedRoutineBody routine_body;
+        if (operation == "kernel" && parse_parameterized_routine(argument, name, routine_formals, routine_body, span)) {
+            if (!features.parameterized_quantum_routines || !features.parameterized_quantum_gates) {
+                return reject(error, "SYNQ-P007", span, "parameterized quantum routines require explicit Alpha opt-ins",
+                              "add parameterized-quantum-routines and parameterized-quantum-gates annotations before the routine");
             }
-            const auto validation_error = synq::compiler::validate_quantum_gate_shape(*gate);
-            if (validation_error.has_value()) {
-                delete gate;
-                return fail_parse("SYNQ-P013", span, "malformed bounded kernel body",
-                                  "use exactly one supported quantum gate with explicit register operands");
+            const auto inserted = declare(name);
+            if (!inserted.second) {
+                return reject(error, "SYNQ-S004", span, duplicate_declaration_message(name, inserted.first->second),
+                              "rename the later routine or reuse the existing declaration");
             }
-            if (gate->literal_angle.has_value() || uses_named_register_operand(*gate)) {
-                delete gate;
-                return fail_parse("SYNQ-P013", span, "bounded kernel bodies reject parameterized and named-register operands",
-                                  "use one non-parameterized gate over the earlier default register until callable resource rules expand");
+            auto* routine = program.append<CallableDeclarationNode>(CallableDeclarationKind::Kernel,
+                                                                  std::string(name), line_number, span);
+            routine->formals = std::move(routine_formals);
+            routine->parameterized_body = std::move(routine_body);
+            return true;
+        }
+        std::string_view body_source;
+        const bool has_body = operation == "kernel" && parse_bounded_kernel_body(argument, name, body_source);
+        if (!has_body && !parse_callable_declaration(argument, name)) {
+            if (operation == "kernel" && looks_like_parameterized_routine_declaration(argument)) {
+                return reject(error, "SYNQ-P017", span, "malformed parameterized quantum routine declaration",
+                              "use one documented typed signature with one formal-only supported gate body");
             }
-            root->statements.push_back(new CallableDeclarationNode(kind, name, gate, line_number, span));
-            continue;
+            return reject(error, "SYNQ-P013", span, "malformed bounded callable declaration",
+                          "use fn <identifier>(), kernel <identifier>(), or kernel <identifier>() { quantum <gate> <register[index]> }");
+        }
+        const auto inserted = declare(name);
+        if (!inserted.second) {
+            return reject(error, "SYNQ-S004", span, duplicate_declaration_message(name, inserted.first->second),
+                          "rename the callable or reuse the existing binding according to future language semantics");
+        }
+        const CallableDeclarationKind kind = operation == "fn" ? CallableDeclarationKind::Function
+                                                                 : CallableDeclarationKind::Kernel;
+        if (!has_body) {
+            program.append<CallableDeclarationNode>(kind, std::string(name), line_number, span);
+            return true;
+        }
+        if (!parse_quantum_arguments(trim(body_source.substr(std::string_view("quantum ").size())), quantum_arguments)) {
+            return reject(error, "SYNQ-P013", span, "malformed bounded kernel body",
+                          "use exactly one supported quantum gate with explicit register operands");
+        }
+        QuantumGateNode* gate = make_quantum_gate_node(program.arena, quantum_arguments, line_number, span);
+        if (gate == nullptr) {
+            return reject(error, "SYNQ-P013", span, "malformed bounded kernel body",
+                          "use exactly one supported quantum gate with explicit register operands");
+        }
+        const auto validation_error = synq::compiler::validate_quantum_gate_shape(*gate);
+        if (validation_error.has_value()) {
+            return reject(error, "SYNQ-P013", span, "malformed bounded kernel body",
+                          "use exactly one supported quantum gate with explicit register operands");
         }
+        if (gate->literal_angle.has_value() || uses_named_register_operand(*gate)) {
+            return reject(error, "SYNQ-P013", span, "bounded kernel bodies reject parameterized and named-register operands",
+                          "use one non-parameterized gate over the earlier default register until callable resource rules expand");
+        }
+        program.append<CallableDeclarationNode>(kind, std::string(name), gate, line_number, span);
+        return true;
+    }
 
-        if (operation == "call") {
-            if (!active_features.is_enabled("callable-declarations")) {
-                return fail_parse("SYNQ-P007", span, "callable calls require an alpha feature opt-in",
-                                  "add #[experimental(feature = \"callable-declarations\")] before the gated construct");
-            }
-            std::string name;
-            std::vector<std::string> actuals;
-            if (parse_parameterized_routine_call(argument, name, actuals)) {
-                if (!active_features.is_enabled("parameterized-quantum-routines")) {
-                    return fail_parse("SYNQ-P007", span, "parameterized routine calls require an Alpha feature opt-in",
-                                      "add #[experimental(feature = \"parameterized-quantum-routines\")] before the call");
-                }
-                root->statements.push_back(new CallableCallNode(name, std::move(actuals), line_number, span));
-                continue;
+    if (operation == "call") {
+        if (!features.callable_declarations) {
+            return reject(error, "SYNQ-P007", span, "callable calls require an alpha feature opt-in",
+                          "add #[experimental(feature = \"callable-declarations\")] before the gated construct");
+        }
+        std::string_view name;
+        std::vector<std::string_view> actuals;
+        if (parse_parameterized_routine_call(argument, name, actuals)) {
+            if (!features.parameterized_quantum_routines) {
+                return reject(error, "SYNQ-P007", span, "parameterized routine calls require an Alpha feature opt-in",
+                              "add #[experimental(feature = \"parameterized-quantum-routines\")] before the call");
             }
-            if (!parse_callable_declaration(argument, name)) {
-                if (looks_like_parameterized_routine_call(argument)) {
-                    return fail_parse("SYNQ-P018", span, "malformed parameterized quantum routine call",
-                                      "use call <earlier-routine>(<matching-literal-angle-and-or-register[index]-actuals>)");
-                }
-                return fail_parse("SYNQ-P013", span, "malformed bounded callable call",
-                                  "use call <earlier-kernel-name>() with no arguments");
+            program.append<CallableCallNode>(std::string(name), to_strings(actuals), line_number, span);
+            return true;
+        }
+        if (!parse_callable_declaration(argument, name)) {
+            if (looks_like_parameterized_routine_call(argument)) {
+                return reject(error, "SYNQ-P018", span, "malformed parameterized quantum routine call",
+                              "use call <earlier-routine>(<matching-literal-angle-and-or-register[index]-actuals>)");
             }
-            root->statements.push_back(new CallableCallNode(name, line_number, span));
-            continue;
+            return reject(error, "SYNQ-P013", span, "malformed bounded callable call",
+                          "use call <earlier-kernel-name>() with no arguments");
         }
+        program.append<CallableCallNode>(std::string(name), line_number, span);
+        return true;
+    }
+
+    const bool known_instruction = operation == "print" || operation == "delay" ||
+                                   operation == "quantum" || operation == "measure" || operation == "ai" ||
+                                   operation == "if" || operation == "while" || operation == "qubit" ||
+                                   operation == "fn" || operation == "kernel" || operation == "call";
+    if (!known_instruction || argument.empty()) {
+        return reject(error, "SYNQ-P003", span, "unsupported or incomplete recovery-profile instruction",
+                      "use let, qubit, fn, kernel, call, print, delay, quantum, measure, ai, if, or while with the documented argument form");
+    }
+    if (operation == "delay" && !is_non_negative_integer(argument)) {
+        return reject(error, "SYNQ-P004", span, "delay requires a non-negative integer number of milliseconds",
+                      "use a non-negative whole number, such as delay 0");
+    }
 
-        const bool known_instruction = operation == "print" || operation == "delay" ||
-                                       operation == "quantum" || operation == "measure" || operation == "ai" ||
-                                       operation == "if" || operation == "while" || operation == "qubit" ||
-                                       operation == "fn" || operation == "kernel" || operation == "call";
-        if (!known_instruction || argument.empty()) {
-            return fail_parse("SYNQ-P003", span, "unsupported or incomplete recovery-profile instruction",
-                              "use let, qubit, fn, kernel, call, print, delay, quantum, measure, ai, if, or while with the documented argument form");
+    if (operation == "if" || operation == "while") {
+        effect.reads_prior_measurement = operation == "if";
+        if (!features.classical_control_flow) {
+            return reject(error, "SYNQ-P007", span, "classical control flow requires an alpha feature opt-in",
+                          "add #[experimental(feature = \"classical-control-flow\")] before the gated construct");
         }
-        if (operation == "delay" && !is_non_negative_integer(argument)) {
-            return fail_parse("SYNQ-P004", span, "delay requires a non-negative integer number of milliseconds",
-                              "use a non-negative whole number, such as delay 0");
+        ClassicalCondition condition;
+        std::string_view body_operation;
+        std::string_view body_argument;
+        const std::string_view separator = operation == "if" ? " then " : " do ";
+        if (!parse_control_flow_arguments(argument, separator, condition, span, body_operation, body_argument)) {
+            return reject(error, "SYNQ-P009", span, "malformed bounded classical control-flow syntax",
+                          operation == "if" ? "use if true then quantum h q[0], if not ready then quantum h q[0], or if ready and enabled then quantum h q[0]" :
+                                              "use while false do measure q[0], while not ready do measure q[0], or while ready or fallback do measure q[0]");
         }
-
-        if (operation == "if" || operation == "while") {
-            if (!active_features.is_enabled("classical-control-flow")) {
-                return fail_parse("SYNQ-P007", span, "classical control flow requires an alpha feature opt-in",
-                                  "add #[experimental(feature = \"classical-control-flow\")] before the gated construct");
-            }
-            ClassicalCondition condition;
-            std::string body_operation;
-            std::string body_argument;
-            const std::string connector = operation == "if" ? "then" : "do";
-            if (!parse_control_flow_arguments(argument, connector, condition, span, body_operation, body_argument)) {
-                return fail_parse("SYNQ-P009", span, "malformed bounded classical control-flow syntax",
-                                  operation == "if" ? "use if true then quantum h q[0], if not ready then quantum h q[0], or if ready and enabled then quantum h q[0]" :
-                                                      "use while false do measure q[0], while not ready do measure q[0], or while ready or fallback do measure q[0]");
-            }
-            synq::compiler::Diagnostic body_error;
-            ASTNode* body = make_control_body_node(body_operation, body_argument, active_features,
-                                                   line_number, span, body_error);
-            if (body == nullptr) {
-                synq::compiler::ParseResult result;
-                result.diagnostics.push_back(std::move(body_error));
-                return result;
-            }
-            const auto* candidate_gate = dynamic_cast<const QuantumGateNode*>(body);
-            const auto* prior_measurement = root->statements.empty()
-                ? nullptr : dynamic_cast<const MeasurementNode*>(root->statements.back());
-            const bool direct_feedback_candidate = operation == "if" &&
-                condition.kind == ClassicalConditionKind::IdentifierReference &&
-                condition.expression.kind == ClassicalBooleanExpressionKind::IdentifierReference &&
-                condition.expression.operands.empty() && candidate_gate != nullptr &&
-                candidate_gate->kind == QuantumGateKind::X && !candidate_gate->literal_angle.has_value() &&
-                candidate_gate->qubit_indices.size() == 1 && candidate_gate->qubit_register_names.size() == 1 &&
-                prior_measurement != nullptr && prior_measurement->result_name.has_value() &&
-                *prior_measurement->result_name == condition.expression.source_text;
-            if (direct_feedback_candidate && !active_features.is_enabled("measurement-feedback")) {
-                delete body;
-                return fail_parse("SYNQ-P007", span, "measurement feedback requires an alpha feature opt-in",
-                                  "add #[experimental(feature = \"measurement-feedback\")] before the named measurement and conditional x correction");
-            }
-            root->statements.push_back(new ClassicalControlNode(
-                operation == "if" ? ClassicalControlKind::If : ClassicalControlKind::While,
-                condition, body, line_number, span,
-                active_features.is_enabled("measurement-feedback")));
-        } else if (operation == "quantum") {
-            std::vector<std::string> quantum_arguments;
-            if (!parse_quantum_arguments(argument, quantum_arguments)) {
-                return fail_parse("SYNQ-P005", span, "malformed quantum kernel, operands, or literal-angle parameter",
-                                  "use explicit operands such as q[0] or q[0], q[1]");
-            }
-            QuantumGateNode* gate = make_quantum_gate_node(quantum_arguments, line_number, span);
-            if (gate == nullptr) {
-                return fail_parse("SYNQ-P005", span, "could not construct typed quantum operands",
-                                  "use explicit operands such as q[0] or q[0], q[1]");
-            }
-            const auto validation_error = synq::compiler::validate_quantum_gate_shape(*gate);
-            if (validation_error.has_value()) {
-                delete gate;
-                return fail_parse(validation_error->code, span, validation_error->message, validation_error->help);
-            }
-            if (gate->literal_angle.has_value() &&
-                !active_features.is_enabled("parameterized-quantum-gates")) {
-                delete gate;
-                return fail_parse("SYNQ-P007", span, "parameterized quantum gates require an alpha feature opt-in",
-                                  "add #[experimental(feature = \"parameterized-quantum-gates\")] before the gated construct");
-            }
-            if (uses_named_register_operand(*gate) &&
-                !active_features.is_enabled("named-qubit-register-operands")) {
-                delete gate;
-                return fail_parse("SYNQ-P007", span, "named qubit register operands require an alpha feature opt-in",
-                                  "add #[experimental(feature = \"named-qubit-register-operands\")] before the gated construct");
-            }
-            root->statements.push_back(gate);
-        } else if (operation == "measure") {
-            std::string register_name;
-            std::size_t qubit_index = 0;
-            std::optional<std::string> result_name;
-            if (!parse_measurement_arguments(argument, register_name, qubit_index, result_name)) {
-                return fail_parse("SYNQ-P008", span,
-                                  "measurement requires one explicit qubit operand and an optional result identifier",
-                                  "use measure q[index] or measure q[index] as <identifier>, for example measure q[0] as observed");
-            }
-            if (result_name.has_value()) {
-                const auto inserted = declared_names.emplace(*result_name, span);
-                if (!inserted.second) {
-                    return fail_parse("SYNQ-S004", span,
-                                      "duplicate top-level declaration `" + *result_name +
-                                          "`; first declared on line " + std::to_string(inserted.first->second.line),
-                                      "rename the measurement result or reuse the existing binding according to future language semantics");
-                }
-            }
-            if (register_name != "q" && !active_features.is_enabled("named-qubit-register-operands")) {
-                return fail_parse("SYNQ-P007", span, "named qubit register operands require an alpha feature opt-in",
-                                  "add #[experimental(feature = \"named-qubit-register-operands\")] before the gated construct");
+        synq::compiler::Diagnostic body_error;
+        ASTNode* body = make_control_body_node(program.arena, body_operation, body_argument, features,
+                                               line_number, span, body_error);
+        if (body == nullptr) {
+            error = std::move(body_error);
+            return false;
+        }
+        const auto* candidate_gate = node_cast<QuantumGateNode>(body);
+        const bool direct_feedback_candidate = operation == "if" &&
+            condition.kind == ClassicalConditionKind::IdentifierReference &&
+            condition.expression.kind == ClassicalBooleanExpressionKind::IdentifierReference &&
+            condition.expression.operands.empty() && candidate_gate != nullptr &&
+            candidate_gate->kind == QuantumGateKind::X && !candidate_gate->literal_angle.has_value() &&
+            candidate_gate->qubit_indices.size() == 1 && candidate_gate->qubit_register_names.size() == 1 &&
+            prior_measurement_result.has_value() && *prior_measurement_result == condition.expression.source_text;
+        if (direct_feedback_candidate && !features.measurement_feedback) {
+            return reject(error, "SYNQ-P007", span, "measurement feedback requires an alpha feature opt-in",
+                          "add #[experimental(feature = \"measurement-feedback\")] before the named measurement and conditional x correction");
+        }
+        program.append<ClassicalControlNode>(
+            operation == "if" ? ClassicalControlKind::If : ClassicalControlKind::While,
+            condition, body, line_number, span, features.measurement_feedback);
+    } else if (operation == "quantum") {
+        if (!parse_quantum_arguments(argument, quantum_arguments)) {
+            return reject(error, "SYNQ-P005", span, "malformed quantum kernel, operands, or literal-angle parameter",
+                          "use explicit operands such as q[0] or q[0], q[1]");
+        }
+        QuantumGateNode* gate = make_quantum_gate_node(program.arena, quantum_arguments, line_number, span);
+        if (gate == nullptr) {
+            return reject(error, "SYNQ-P005", span, "could not construct typed quantum operands",
+                          "use explicit operands such as q[0] or q[0], q[1]");
+        }
+        const auto validation_error = synq::compiler::validate_quantum_gate_shape(*gate);
+        if (validation_error.has_value()) {
+            return reject(error, validation_error->code, span, validation_error->message, validation_error->help);
+        }
+        if (gate->literal_angle.has_value() && !features.parameterized_quantum_gates) {
+            return reject(error, "SYNQ-P007", span, "parameterized quantum gates require an alpha feature opt-in",
+                          "add #[experimental(feature = \"parameterized-quantum-gates\")] before the gated construct");
+        }
+        if (uses_named_register_operand(*gate) && !features.named_qubit_register_operands) {
+            return reject(error, "SYNQ-P007", span, "named qubit register operands require an alpha feature opt-in",
+                          "add #[experimental(feature = \"named-qubit-register-operands\")] before the gated construct");
+        }
+        program.statements.push_back(gate);
+    } else if (operation == "measure") {
+        std::string_view register_name;
+        std::size_t qubit_index = 0;
+        std::optional<std::string_view> result_name;
+        if (!parse_measurement_arguments(argument, register_name, qubit_index, result_name)) {
+            return reject(error, "SYNQ-P008", span,
+                          "measurement requires one explicit qubit operand and an optional result identifier",
+                          "use measure q[index] or measure q[index] as <identifier>, for example measure q[0] as observed");
+        }
+        if (result_name.has_value()) {
+            const auto inserted = declare(*result_name);
+            if (!inserted.second) {
+                return reject(error, "SYNQ-S004", span, duplicate_declaration_message(*result_name, inserted.first->second),
+                              "rename the measurement result or reuse the existing binding according to future language semantics");
             }
-            root->statements.push_back(new MeasurementNode(qubit_index, line_number, span,
-                                                           std::move(result_name), std::move(register_name),
-                                                           active_features.is_enabled("measurement-feedback")));
-        } else {
-            root->statements.push_back(new InstructionNode(operation, {argument}, line_number, span));
         }
+        if (register_name != "q" && !features.named_qubit_register_operands) {
+            return reject(error, "SYNQ-P007", span, "named qubit register operands require an alpha feature opt-in",
+                          "add #[experimental(feature = \"named-qubit-register-operands\")] before the gated construct");
+        }
+        std::optional<std::string> result;
+        if (result_name.has_value()) result.emplace(*result_name);
+        last_measurement_result = result_name;
+        effect.measurement_result = result_name;
+        program.append<MeasurementNode>(qubit_index, line_number, span, std::move(result),
+                                      std::string(register_name), features.measurement_feedback);
+    } else {
+        program.append<InstructionNode>(std::string(operation), std::vector<std::string>{std::string(argument)},
+                                      line_number, span);
     }
+    return true;
+}
 
+}  // namespace
+namespace synq::compiler {
+
+struct RecoveryGrammar::State : RecoveryLineState {
+    using RecoveryLineState::RecoveryLineState;
+};
+
+RecoveryGrammar::RecoveryGrammar(const FeatureRegistry& configured_features)
+    : state_(std::make_unique<State>(configured_features)) {}
+
+RecoveryGrammar::~RecoveryGrammar() = default;
+RecoveryGrammar::RecoveryGrammar(RecoveryGrammar&& other) noexcept = default;
+RecoveryGrammar& RecoveryGrammar::operator=(RecoveryGrammar&& other) noexcept = default;
+
+bool RecoveryGrammar::parse_line(std::string_view raw_line, std::size_t line_number, ProgramNode& program,
+                                 Diagnostic& error, RecoveryLineEffect& effect) {
+    return parse_recovery_line(*state_, raw_line, line_number, program, error, effect);
+}
+
+bool RecoveryGrammar::replay(const RecoveryLineEffect& effect, std::size_t line_number) {
+    if (effect.enabled_feature.has_value()) {
+        state_->active_features.enable(std::string(*effect.enabled_feature));
+        state_->features.refresh(state_->active_features);
+        return true;
+    }
+    if (!effect.statement) return true;
+    if (effect.reads_prior_measurement && state_->last_measurement_result.has_value()) return false;
+    if (effect.declared_name.has_value()) {
+        SourceSpan span = effect.span;
+        span.line = line_number;
+        if (!state_->declared_names.emplace(*effect.declared_name, span).second) return false;
+    }
+    state_->last_measurement_result = effect.measurement_result;
+    return true;
+}
+
+void RecoveryGrammar::forget(std::string_view name) { state_->declared_names.erase(name); }
+
+void RecoveryGrammar::rewind(const FeatureRegistry& features,
+                             std::optional<std::string_view> last_measurement_result) {
+    state_->active_features = features;
+    state_->features.refresh(state_->active_features);
+    state_->last_measurement_result = last_measurement_result;
+}
+
+const FeatureRegistry& RecoveryGrammar::features() const { return state_->active_features; }
+
+std::optional<std::string_view> RecoveryGrammar::last_measurement_result() const {
+    return state_->last_measurement_result;
+}
+
+std::uint32_t RecoveryGrammar::feature_mask() const {
+    const GrammarFeatures& features = state_->features;
+    const bool flags[] = {
+        features.parameterized_quantum_gates,    features.named_qubit_register_operands,
+        features.qubit_declarations,             features.integer_arithmetic_expressions,
+        features.classical_control_flow,         features.measurement_feedback,
+        features.mutable_classical_state,        features.callable_declarations,
+        features.classical_callable_execution,   features.multi_formal_classical_callables,
+        features.parameterized_quantum_routines,
+    };
+    std::uint32_t mask = 0;
+    for (std::size_t bit = 0; bit < sizeof(flags) / sizeof(flags[0]); ++bit) {
+        if (flags[bit]) mask |= std::uint32_t{1} << bit;
+    }
+    return mask;
+}
+
+}  // namespace synq::compiler
+
+namespace {
+
+// The recovery grammar over one contiguous buffer. Lines and tokens are views
+// into `source`; only AST and diagnostic fields are copied out. Before each
+// line and once at the end, `consume` sees the program built so far and may
+// take its statements; returning false stops the parse with its diagnostic.
+template <typename Consume>
+synq::compiler::ParseResult parse_recovery_grammar(std::string_view source,
+                                                   const synq::compiler::FeatureRegistry& configured_features,
+                                                   Consume&& consume) {
+    // Every node, including one rejected mid-statement, lives in root->arena and
+    // is released with it when the parse fails.
+    auto root = std::make_unique<ProgramNode>();
+    synq::compiler::RecoveryGrammar grammar(configured_features);
+    synq::compiler::RecoveryLineEffect effect;
+    synq::compiler::Diagnostic error;
+    std::size_t line_number = 0;
+    std::size_t line_begin = 0;
+    const auto fail = [&]() {
+        synq::compiler::ParseResult result;
+        result.diagnostics.push_back(std::move(error));
+        return result;
+    };
+    while (line_begin < source.size()) {
+        if (!consume(*root, error)) return fail();
+        const std::size_t newline = source.find('\n', line_begin);
+        const std::size_t line_end = newline == std::string_view::npos ? source.size() : newline;
+        const std::string_view raw_line = source.substr(line_begin, line_end - line_begin);
+        line_begin = line_end + 1;
+        ++line_number;
+        if (!grammar.parse_line(raw_line, line_number, *root, error, effect)) return fail();
+    }
+
+    if (!consume(*root, error)) return fail();
     synq::compiler::ParseResult result;
     result.program = std::move(root);
     return result;
 }
 
+}  // namespace
+
+Parser::Parser()
+    : configured_features_(synq::compiler::make_default_feature_registry()) {}
+
+bool Parser::enableExperimentalFeature(const std::string& feature_name) {
+    return configured_features_.enable(feature_name);
+}
+
+synq::compiler::ParseResult Parser::parseBufferWithDiagnostics(std::string_view source) {
+    return parse_recovery_grammar(source, configured_features_,
+                                  [](ProgramNode&, synq::compiler::Diagnostic&) { return true; });
+}
+
+synq::compiler::HybridLoweringResult Parser::parseBufferToHybridIR(std::string_view source) {
+    synq::compiler::HybridProgram lowered;
+    std::optional<synq::compiler::Diagnostic> lowering_error;
+    // Lower each statement as soon as it is parsed, then drop its AST node so
+    // the arena never holds more than one statement. A lowering error stops
+    // lowering but not parsing: as on the AST path, a later parse error wins.
+    synq::compiler::ParseResult parsed = parse_recovery_grammar(
+        source, configured_features_, [&lowered, &lowering_error](ProgramNode& pending, synq::compiler::Diagnostic&) {
+            if (pending.statements.empty()) return true;
+            for (const ASTNode* statement : pending.statements) {
+                if (lowering_error.has_value()) break;
+                synq::compiler::Diagnostic error;
+                if (!synq::compiler::lower_statement_to_hybrid_ir(*statement, lowered, error)) {
+                    lowering_error = std::move(error);
+                }
+            }
+            pending.statements.clear();
+            pending.arena.reset();
+            return true;
+        });
+    synq::compiler::HybridLoweringResult result;
+    if (!parsed.ok()) {
+        result.diagnostics = std::move(parsed.diagnostics);
+    } else if (lowering_error.has_value()) {
+        result.diagnostics.push_back(std::move(*lowering_error));
+    } else {
+        result.program = std::move(lowered);
+    }
+    return result;
+}
+
 synq::compiler::ParseResult Parser::parseFileWithDiagnostics(const std::string& filename) {
-    std::ifstream infile(filename);
-    if (!infile) {
+    synq::compiler::SourceBuffer source;
+    if (!source.open(filename)) {
         return fail_parse("SYNQ-P001", {}, "could not open source file", "verify the file path and read permission");
     }
-    return parseStreamWithDiagnostics(infile);
+    return parseBufferWithDiagnostics(source.text());
 }
 
 synq::compiler::ParseResult Parser::parseSourceWithDiagnostics(const std::string& source) {
-    std::istringstream input(source);
-    return parseStreamWithDiagnostics(input);
+    return parseBufferWithDiagnostics(source);
+}
+
+synq::compiler::HybridLoweringResult Parser::parseFileToHybridIR(const std::string& filename) {
+    synq::compiler::SourceBuffer source;
+    if (!source.open(filename)) {
+        synq::compiler::HybridLoweringResult result;
+        result.diagnostics = fail_parse("SYNQ-P001", {}, "could not open source file",
+                                        "verify the file path and read permission").diagnostics;
+        return result;
+    }
+    return parseBufferToHybridIR(source.text());
+}
+
+synq::compiler::HybridLoweringResult Parser::parseSourceToHybridIR(const std::string& source) {
+    return parseBufferToHybridIR(source);
 }
 
 ASTNode* Parser::parseFile(const std::string& filename) {
@@ -23,14 +23,15 @@
 #define SYNQ_COMPILER_PARSER_H
 
 #include <memory>
-#include <istream>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 #include "ast.h"
 #include "diagnostic.h"
 #include "feature_gate.h"
+#include "hybrid_ir.h"
 
 namespace synq::compiler {
 
@@ -63,18 +64,33 @@ public:
 
     // Parses a source file and retains structured errors for C ABI and future
     // editor/binding callers. The program is present only when `ok()` is true.
+    // Regular files are scanned from a read-only mapping and pipes are
+    // streamed; the AST owns its strings, so nothing refers to the file after
+    // this returns.
     synq::compiler::ParseResult parseFileWithDiagnostics(const std::string& filename);
 
     // Parses one NUL-free in-memory source string using the same bounded
-    // recovery grammar as file parsing. It does not retain source storage.
+    // recovery grammar as file parsing. It scans `source` in place and does
+    // not retain source storage.
     synq::compiler::ParseResult parseSourceWithDiagnostics(const std::string& source);
 
+    // Single-pass front end for callers that never inspect the AST. Each
+    // statement is lowered to Hybrid IR as soon as it parses and its AST node
+    // is dropped, so no whole-program AST is built. The result, including its
+    // diagnostics, matches lower_to_hybrid_ir over parseSourceWithDiagnostics:
+    // a parse error anywhere is reported ahead of an earlier lowering error.
+    synq::compiler::HybridLoweringResult parseSourceToHybridIR(const std::string& source);
+    synq::compiler::HybridLoweringResult parseFileToHybridIR(const std::string& filename);
+
     // Parse a source file and return the AST root node (or nullptr on error).
     // This compatibility wrapper renders structured diagnostics to stderr.
     ASTNode* parseFile(const std::string& filename);
 
 private:
-    synq::compiler::ParseResult parseStreamWithDiagnostics(std::istream& input);
+    // The recovery grammar over one contiguous buffer. Lines and tokens are
+    // views into `source`; only AST and diagnostic fields are copied out.
+    synq::compiler::ParseResult parseBufferWithDiagnostics(std::string_view source);
+    synq::compiler::HybridLoweringResult parseBufferToHybridIR(std::string_view source);
     synq::compiler::FeatureRegistry configured_features_;
 };
 
@@ -0,0 +1,82 @@
+// The recovery grammar one source line at a time. Parser drives it across a
+// whole buffer; ParseSession drives it again over the lines an edit touched.
+// Everything one line can leave behind for later lines is held here, so a
+// caller that keeps a line's earlier result can replay that line's effect
+// instead of reparsing it. Implemented in parser.cpp next to the grammar.
+#ifndef SYNQ_COMPILER_RECOVERY_GRAMMAR_H
+#define SYNQ_COMPILER_RECOVERY_GRAMMAR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+#include "ast.h"
+#include "diagnostic.h"
+#include "feature_gate.h"
+
+namespace synq::compiler {
+
+// What one accepted line contributed to the grammar state. Views refer to the
+// line's own text.
+struct RecoveryLineEffect {
+    // The feature an annotation line enabled.
+    std::optional<std::string_view> enabled_feature;
+    // True when the line appended a statement; such a line also replaces the
+    // last measurement result with `measurement_result`.
+    bool statement = false;
+    std::optional<std::string_view> measurement_result;
+    // A top-level name the line declared, and where. Also set on a rejected
+    // line whose name was declared before the rejection, so it can be forgotten.
+    std::optional<std::string_view> declared_name;
+    SourceSpan span;
+    // True for `if` lines, whose feedback gate reads the previous line's
+    // measurement result.
+    bool reads_prior_measurement = false;
+};
+
+class RecoveryGrammar {
+public:
+    explicit RecoveryGrammar(const FeatureRegistry& configured_features);
+    ~RecoveryGrammar();
+    RecoveryGrammar(RecoveryGrammar&& other) noexcept;
+    RecoveryGrammar& operator=(RecoveryGrammar&& other) noexcept;
+    RecoveryGrammar(const RecoveryGrammar&) = delete;
+    RecoveryGrammar& operator=(const RecoveryGrammar&) = delete;
+
+    // Parses `raw_line`, without its terminator, as line `line_number`. An
+    // accepted line appends at most one statement to `program` and describes
+    // itself in `effect`; a rejected line fills `error` and returns false. The
+    // grammar keeps views into `raw_line` until they are forgotten or rewound.
+    bool parse_line(std::string_view raw_line, std::size_t line_number, ProgramNode& program,
+                    Diagnostic& error, RecoveryLineEffect& effect);
+
+    // Re-applies the effect of a line accepted earlier under the same feature
+    // mask, now at `line_number`. Returns false, changing nothing, when the
+    // outcome could differ: its name is already declared or it reads a
+    // measurement result. The caller reparses such a line instead.
+    bool replay(const RecoveryLineEffect& effect, std::size_t line_number);
+
+    // Removes a name declared by an accepted line that is being reconsidered.
+    void forget(std::string_view name);
+
+    // Restores the feature registry and last measurement result in force
+    // after some earlier line. Declared names are left to `forget`.
+    void rewind(const FeatureRegistry& features, std::optional<std::string_view> last_measurement_result);
+
+    const FeatureRegistry& features() const;
+    std::optional<std::string_view> last_measurement_result() const;
+
+    // One bit per feature gate the grammar consults. Equal masks mean a line
+    // parses identically apart from names and measurement results.
+    std::uint32_t feature_mask() const;
+
+private:
+    struct State;
+    std::unique_ptr<State> state_;
+};
+
+}  // namespace synq::compiler
+
+#endif
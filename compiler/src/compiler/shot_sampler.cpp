@@ -0,0 +1,74 @@
+#include "shot_sampler.h"
+
+namespace synq::compiler {
+namespace {
+
+// Top 53 bits of one engine output as a double in [0, 1).
+double uniform(std::mt19937_64& engine) { return static_cast<double>(engine() >> 11) * 0x1.0p-53; }
+
+}  // namespace
+
+void AliasTable::assign(const std::vector<double>& weights) {
+    threshold_.assign(weights.size(), 1.0);
+    alias_.resize(weights.size());
+    for (std::size_t index = 0; index < weights.size(); ++index) alias_[index] = index;
+    double total = 0.0;
+    for (const double weight : weights) total += weight;
+    if (weights.empty() || !(total > 0.0)) return;
+
+    // Vose's construction: scale weights to mean one, then pair each
+    // under-full column with an over-full donor until every column is full.
+    const double scale = static_cast<double>(weights.size()) / total;
+    scaled_.resize(weights.size());
+    small_.clear();
+    large_.clear();
+    for (std::size_t index = 0; index < weights.size(); ++index) {
+        scaled_[index] = weights[index] * scale;
+        (scaled_[index] < 1.0 ? small_ : large_).push_back(index);
+    }
+    while (!small_.empty() && !large_.empty()) {
+        const std::size_t under = small_.back();
+        small_.pop_back();
+        const std::size_t donor = large_.back();
+        threshold_[under] = scaled_[under];
+        alias_[under] = donor;
+        scaled_[donor] -= 1.0 - scaled_[under];
+        if (scaled_[donor] < 1.0) {
+            large_.pop_back();
+            small_.push_back(donor);
+        }
+    }
+    // Whatever remains is full up to rounding error; thresholds are already one.
+}
+
+std::size_t AliasTable::sample(std::mt19937_64& engine) const {
+    std::size_t column = static_cast<std::size_t>(uniform(engine) * static_cast<double>(threshold_.size()));
+    if (column >= threshold_.size()) column = threshold_.size() - 1;
+    return uniform(engine) < threshold_[column] ? column : alias_[column];
+}
+
+void sample_shot_histogram(const AliasTable& table, const std::vector<std::size_t>& basis_indices,
+                           std::size_t shots, std::uint64_t seed, std::vector<std::size_t>& counts,
+                           std::vector<ShotCount>& histogram) {
+    histogram.clear();
+    if (table.size() == 0 || table.size() != basis_indices.size()) return;
+    std::mt19937_64 engine(seed);
+    counts.assign(table.size(), 0);
+    for (std::size_t shot = 0; shot < shots; ++shot) ++counts[table.sample(engine)];
+    for (std::size_t index = 0; index < counts.size(); ++index) {
+        if (counts[index] != 0) histogram.push_back({basis_indices[index], counts[index]});
+    }
+}
+
+std::vector<ShotCount> sample_shots(const std::vector<std::size_t>& basis_indices,
+                                    const std::vector<double>& probabilities, std::size_t shots,
+                                    std::uint64_t seed) {
+    std::vector<ShotCount> histogram;
+    if (basis_indices.size() != probabilities.size()) return histogram;
+    const AliasTable table(probabilities);
+    std::vector<std::size_t> counts;
+    sample_shot_histogram(table, basis_indices, shots, seed, counts, histogram);
+    return histogram;
+}
+
+}  // namespace synq::compiler
@@ -0,0 +1,58 @@
+// Seeded measurement-shot sampling for the bounded local simulator. Shots are
+// drawn from a Walker alias table, so sampling costs O(1) per shot after a
+// linear build over the nonzero support, and the result is a sparse histogram.
+#ifndef SYNQ_COMPILER_SHOT_SAMPLER_H
+#define SYNQ_COMPILER_SHOT_SAMPLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace synq::compiler {
+
+struct ShotCount {
+    std::size_t basis_index = 0;
+    std::size_t count = 0;
+};
+
+class AliasTable {
+public:
+    AliasTable() = default;
+    explicit AliasTable(const std::vector<double>& weights) { assign(weights); }
+
+    // Rebuilds the table over `weights`, which need not be normalized, reusing
+    // existing storage. Entries with zero weight are never drawn.
+    void assign(const std::vector<double>& weights);
+
+    std::size_t size() const { return threshold_.size(); }
+
+    // Draws one index using two 64-bit engine outputs.
+    std::size_t sample(std::mt19937_64& engine) const;
+
+private:
+    std::vector<double> threshold_;
+    std::vector<std::size_t> alias_;
+    std::vector<double> scaled_;
+    std::vector<std::size_t> small_;
+    std::vector<std::size_t> large_;
+};
+
+// Draws `shots` outcomes from `table`, whose entries correspond to
+// `basis_indices`, into `histogram`. `counts` is scratch storage; both vectors
+// are cleared first and keep their capacity across calls.
+void sample_shot_histogram(const AliasTable& table, const std::vector<std::size_t>& basis_indices,
+                           std::size_t shots, std::uint64_t seed, std::vector<std::size_t>& counts,
+                           std::vector<ShotCount>& histogram);
+
+// Draws `shots` outcomes over `basis_indices` weighted by `probabilities` and
+// returns the outcomes that occurred, in `basis_indices` order. Equal seeds
+// yield equal histograms on every platform because the engine sequence is
+// standardized and uniform conversion does not use library distributions.
+std::vector<ShotCount> sample_shots(const std::vector<std::size_t>& basis_indices,
+                                    const std::vector<double>& probabilities, std::size_t shots,
+                                    std::uint64_t seed);
+
+}  // namespace synq::compiler
+
+#endif
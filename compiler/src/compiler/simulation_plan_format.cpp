@@ -0,0 +1,326 @@
+#include "simulation_plan_format.h"
+
+#include <openssl/sha.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace synq::compiler {
+namespace {
+
+// Layout, all integers little-endian: magic, u32 version, source digest, u8
+// backend, u64 qubit and source-operation counts, registers, the operation
+// list, measurements, an optional feedback measurement plus correction, and the
+// Clifford operation list. Version 2 added the backend and Clifford list.
+constexpr char kMagic[8] = {'S', 'Y', 'N', 'Q', 'P', 'L', 'A', 'N'};
+constexpr std::uint32_t kVersion = 2;
+// The state vector is indexed by std::size_t, so a plan can never address more.
+constexpr std::uint64_t kMaxPlanQubits = 62;
+
+Diagnostic error(const std::string& code, std::string message, std::string help) {
+    return Diagnostic{code, DiagnosticSeverity::Error, {}, std::move(message), std::move(help)};
+}
+
+std::size_t coefficient_count(KernelOpcode opcode) {
+    switch (opcode) {
+        case KernelOpcode::Single:
+        case KernelOpcode::Diagonal:
+        case KernelOpcode::PauliX: return 8;
+        case KernelOpcode::Pair: return 32;
+        case KernelOpcode::ControlledX: return 0;
+    }
+    return 0;
+}
+
+class Writer {
+public:
+    void bytes(const void* data, std::size_t size) { output_.append(static_cast<const char*>(data), size); }
+    void u8(std::uint8_t value) { output_.push_back(static_cast<char>(value)); }
+    void u32(std::uint32_t value) {
+        for (int shift = 0; shift < 32; shift += 8) u8(static_cast<std::uint8_t>(value >> shift));
+    }
+    void u64(std::uint64_t value) {
+        for (int shift = 0; shift < 64; shift += 8) u8(static_cast<std::uint8_t>(value >> shift));
+    }
+    void f64(double value) {
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        u64(bits);
+    }
+    void text(const std::string& value) {
+        u64(value.size());
+        bytes(value.data(), value.size());
+    }
+    void operation(const KernelOperation& operation) {
+        u8(static_cast<std::uint8_t>(operation.opcode));
+        u64(operation.first);
+        u64(operation.second);
+        for (std::size_t index = 0; index < coefficient_count(operation.opcode); ++index) f64(operation.matrix[index]);
+    }
+    void clifford(const CliffordOperation& operation) {
+        u8(static_cast<std::uint8_t>(operation.opcode));
+        u64(operation.first);
+        u64(operation.second);
+    }
+    void measurement(const PlannedMeasurement& measurement) {
+        u64(measurement.register_position);
+        u64(measurement.register_index);
+        u64(measurement.qubit_index);
+    }
+    std::string take() { return std::move(output_); }
+
+private:
+    std::string output_;
+};
+
+// Bounds-checked reader. Every failure latches `ok_`, so callers check once
+// after a group of reads instead of after each field.
+class Reader {
+public:
+    explicit Reader(const std::string& input) : input_(input) {}
+
+    bool ok() const { return ok_; }
+    bool at_end() const { return position_ == input_.size(); }
+
+    bool bytes(void* data, std::size_t size) {
+        if (!ok_ || input_.size() - position_ < size) return ok_ = false;
+        std::memcpy(data, input_.data() + position_, size);
+        position_ += size;
+        return true;
+    }
+    std::uint8_t u8() {
+        std::uint8_t value = 0;
+        bytes(&value, 1);
+        return value;
+    }
+    std::uint32_t u32() {
+        std::uint32_t value = 0;
+        for (int shift = 0; shift < 32; shift += 8) value |= static_cast<std::uint32_t>(u8()) << shift;
+        return value;
+    }
+    std::uint64_t u64() {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 8) value |= static_cast<std::uint64_t>(u8()) << shift;
+        return value;
+    }
+    double f64() {
+        const std::uint64_t bits = u64();
+        double value = 0.0;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    // Reads an element count and rejects counts that could not fit in the
+    // remaining input, so a corrupt count never drives a large allocation.
+    std::uint64_t count(std::size_t minimum_element_size) {
+        const std::uint64_t value = u64();
+        if (ok_ && value > (input_.size() - position_) / minimum_element_size) ok_ = false;
+        return ok_ ? value : 0;
+    }
+    std::string text() {
+        const std::uint64_t size = count(1);
+        std::string value(static_cast<std::size_t>(size), '\0');
+        if (size != 0) bytes(value.data(), value.size());
+        return value;
+    }
+    bool operation(std::size_t qubit_count, KernelOperation& operation) {
+        const std::uint8_t opcode = u8();
+        const std::uint64_t first = u64();
+        const std::uint64_t second = u64();
+        if (!ok_ || opcode > static_cast<std::uint8_t>(KernelOpcode::ControlledX) || first >= qubit_count ||
+            second >= qubit_count) {
+            return ok_ = false;
+        }
+        operation.opcode = static_cast<KernelOpcode>(opcode);
+        operation.first = static_cast<std::size_t>(first);
+        operation.second = static_cast<std::size_t>(second);
+        const bool pair = operation.opcode == KernelOpcode::Pair || operation.opcode == KernelOpcode::ControlledX;
+        if (pair ? first == second || (operation.opcode == KernelOpcode::Pair && first > second) : first != second) {
+            return ok_ = false;
+        }
+        for (std::size_t index = 0; index < coefficient_count(operation.opcode); ++index) {
+            operation.matrix[index] = f64();
+            if (!std::isfinite(operation.matrix[index])) return ok_ = false;
+        }
+        return ok_;
+    }
+    bool clifford(std::size_t qubit_count, CliffordOperation& operation) {
+        const std::uint8_t opcode = u8();
+        const std::uint64_t first = u64();
+        const std::uint64_t second = u64();
+        if (!ok_ || opcode > static_cast<std::uint8_t>(CliffordOpcode::ControlledX) || first >= qubit_count ||
+            second >= qubit_count) {
+            return ok_ = false;
+        }
+        operation.opcode = static_cast<CliffordOpcode>(opcode);
+        operation.first = static_cast<std::size_t>(first);
+        operation.second = static_cast<std::size_t>(second);
+        if ((operation.opcode == CliffordOpcode::ControlledX) == (first == second)) return ok_ = false;
+        return ok_;
+    }
+    bool measurement(const SimulationPlan& plan, PlannedMeasurement& measurement) {
+        const std::uint64_t position = u64();
+        const std::uint64_t index = u64();
+        const std::uint64_t qubit = u64();
+        if (!ok_ || position >= plan.registers.size()) return ok_ = false;
+        const auto& owner = plan.registers[static_cast<std::size_t>(position)];
+        if (index >= owner.qubit_count || qubit != owner.physical_offset + index) return ok_ = false;
+        measurement = {static_cast<std::size_t>(position), static_cast<std::size_t>(index),
+                       static_cast<std::size_t>(qubit)};
+        return true;
+    }
+
+private:
+    const std::string& input_;
+    std::size_t position_ = 0;
+    bool ok_ = true;
+};
+
+constexpr std::size_t kMinimumOperationSize = 17;
+constexpr std::size_t kMinimumCliffordSize = 17;
+constexpr std::size_t kMinimumMeasurementSize = 24;
+constexpr std::size_t kMinimumRegisterSize = 24;
+
+}  // namespace
+
+SimulationSourceDigest simulation_source_digest(const std::string& source) {
+    SimulationSourceDigest digest{};
+    SHA256(reinterpret_cast<const unsigned char*>(source.data()), source.size(), digest.data());
+    return digest;
+}
+
+std::string serialize_simulation_plan(const SimulationPlan& plan, const SimulationSourceDigest& source) {
+    Writer writer;
+    writer.bytes(kMagic, sizeof(kMagic));
+    writer.u32(kVersion);
+    writer.bytes(source.data(), source.size());
+    writer.u8(static_cast<std::uint8_t>(plan.backend));
+    writer.u64(plan.qubit_count);
+    writer.u64(plan.source_operation_count);
+    writer.u64(plan.registers.size());
+    for (const auto& register_info : plan.registers) {
+        writer.text(register_info.name);
+        writer.u64(register_info.qubit_count);
+        writer.u64(register_info.physical_offset);
+    }
+    writer.u64(plan.operations.size());
+    for (const auto& operation : plan.operations) writer.operation(operation);
+    writer.u64(plan.measurements.size());
+    for (const auto& measurement : plan.measurements) writer.measurement(measurement);
+    writer.u8(plan.has_feedback ? 1 : 0);
+    if (plan.has_feedback) {
+        writer.measurement(plan.feedback_measurement);
+        writer.operation(plan.feedback_correction);
+    }
+    writer.u64(plan.clifford_operations.size());
+    for (const auto& operation : plan.clifford_operations) writer.clifford(operation);
+    return writer.take();
+}
+
+SimulationPlanResult deserialize_simulation_plan(const std::string& bytes, const BoundedSimulationOptions& options,
+                                                 const SimulationSourceDigest* expected_source) {
+    SimulationPlanResult result;
+    if (!options.allow_experimental_local_simulation) {
+        result.diagnostics.push_back(error("SYNQ-SIM000", "bounded local simulation requires explicit opt-in",
+                                           "set allow_experimental_local_simulation to true after reviewing the limits"));
+        return result;
+    }
+    const auto malformed = [&result]() {
+        result.diagnostics.push_back(error("SYNQ-SIM007", "stored simulation plan is malformed or from an incompatible version",
+                                           "prepare the plan again from its source program"));
+        return std::move(result);
+    };
+
+    Reader reader(bytes);
+    char magic[sizeof(kMagic)] = {};
+    SimulationSourceDigest digest{};
+    reader.bytes(magic, sizeof(magic));
+    const std::uint32_t version = reader.u32();
+    reader.bytes(digest.data(), digest.size());
+    if (!reader.ok() || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || version != kVersion) return malformed();
+    if (expected_source != nullptr && digest != *expected_source) {
+        result.diagnostics.push_back(error("SYNQ-SIM007", "stored simulation plan was prepared from different source",
+                                           "prepare the plan again from the current source program"));
+        return result;
+    }
+
+    SimulationPlan plan;
+    const std::uint8_t backend = reader.u8();
+    const std::uint64_t qubit_count = reader.u64();
+    const std::uint64_t source_operations = reader.u64();
+    if (!reader.ok() || backend > static_cast<std::uint8_t>(SimulationBackend::Stabilizer)) return malformed();
+    plan.backend = static_cast<SimulationBackend>(backend);
+    const bool stabilizer = plan.backend == SimulationBackend::Stabilizer;
+    if (qubit_count == 0 || (!stabilizer && qubit_count > kMaxPlanQubits)) return malformed();
+    if (stabilizer && !options.allow_stabilizer_simulation) {
+        result.diagnostics.push_back(error("SYNQ-SIM000", "stored simulation plan requires the stabilizer backend opt-in",
+                                           "set allow_stabilizer_simulation or prepare the plan again from source"));
+        return result;
+    }
+    if (qubit_count > (stabilizer ? options.max_stabilizer_qubits : options.max_qubits)) {
+        result.diagnostics.push_back(error("SYNQ-SIM001", "stored simulation plan exceeds the configured qubit limit",
+                                           "choose a larger documented max_qubits or prepare a smaller program"));
+        return result;
+    }
+    if (source_operations > options.max_operations) {
+        result.diagnostics.push_back(error("SYNQ-SIM004", "stored simulation plan exceeds the configured gate-operation limit",
+                                           "reduce the circuit or explicitly choose a larger documented limit"));
+        return result;
+    }
+    plan.qubit_count = static_cast<std::size_t>(qubit_count);
+    plan.source_operation_count = static_cast<std::size_t>(source_operations);
+
+    const std::uint64_t register_count = reader.count(kMinimumRegisterSize);
+    std::uint64_t next_offset = 0;
+    for (std::uint64_t index = 0; reader.ok() && index < register_count; ++index) {
+        SimulatedRegister register_info;
+        register_info.name = reader.text();
+        const std::uint64_t size = reader.u64();
+        const std::uint64_t offset = reader.u64();
+        if (!reader.ok() || register_info.name.empty() || size == 0 || offset != next_offset ||
+            size > qubit_count - offset) {
+            return malformed();
+        }
+        register_info.qubit_count = static_cast<std::size_t>(size);
+        register_info.physical_offset = static_cast<std::size_t>(offset);
+        next_offset += size;
+        plan.registers.push_back(std::move(register_info));
+    }
+    if (!reader.ok() || next_offset != qubit_count) return malformed();
+
+    const std::uint64_t operation_count = reader.count(kMinimumOperationSize);
+    plan.operations.resize(static_cast<std::size_t>(operation_count));
+    for (auto& operation : plan.operations) {
+        if (!reader.operation(plan.qubit_count, operation)) return malformed();
+    }
+    const std::uint64_t measurement_count = reader.count(kMinimumMeasurementSize);
+    plan.measurements.resize(static_cast<std::size_t>(measurement_count));
+    for (auto& measurement : plan.measurements) {
+        if (!reader.measurement(plan, measurement)) return malformed();
+    }
+    const std::uint8_t has_feedback = reader.u8();
+    if (!reader.ok() || has_feedback > 1) return malformed();
+    if (has_feedback == 1) {
+        plan.has_feedback = true;
+        if (!reader.measurement(plan, plan.feedback_measurement)) return malformed();
+        if (!reader.operation(plan.qubit_count, plan.feedback_correction) ||
+            plan.feedback_correction.first != plan.feedback_correction.second) {
+            return malformed();
+        }
+    }
+    const std::uint64_t clifford_count = reader.count(kMinimumCliffordSize);
+    plan.clifford_operations.resize(static_cast<std::size_t>(clifford_count));
+    for (auto& operation : plan.clifford_operations) {
+        if (!reader.clifford(plan.qubit_count, operation)) return malformed();
+    }
+    // Each backend carries only its own operation list.
+    if (stabilizer ? !plan.operations.empty() || plan.has_feedback : !plan.clifford_operations.empty()) {
+        return malformed();
+    }
+    if (!reader.ok() || !reader.at_end()) return malformed();
+    result.plan = std::move(plan);
+    return result;
+}
+
+}  // namespace synq::compiler
@@ -0,0 +1,33 @@
+// Versioned binary encoding of prepared bounded-simulation plans. A stored plan
+// carries fused kernel coefficients and physical indices only, so replaying it
+// skips parsing, lowering, angle parsing, trigonometry, and fusion. Loading
+// re-validates every index and the caller's opt-in and limits.
+#ifndef SYNQ_COMPILER_SIMULATION_PLAN_FORMAT_H
+#define SYNQ_COMPILER_SIMULATION_PLAN_FORMAT_H
+
+#include <array>
+#include <string>
+
+#include "bounded_simulator.h"
+
+namespace synq::compiler {
+
+// SHA-256 of the source text a plan was prepared from.
+using SimulationSourceDigest = std::array<unsigned char, 32>;
+
+SimulationSourceDigest simulation_source_digest(const std::string& source);
+
+std::string serialize_simulation_plan(const SimulationPlan& plan, const SimulationSourceDigest& source);
+
+// Decodes a plan written by `serialize_simulation_plan`. Malformed or
+// incompatible bytes, and a recorded digest different from `expected_source`
+// when one is given, produce SYNQ-SIM007. The plan must also satisfy the
+// opt-in (SYNQ-SIM000), qubit limit (SYNQ-SIM001), and operation limit
+// (SYNQ-SIM004) of `options`; stabilizer plans need the stabilizer opt-in and
+// are bounded by max_stabilizer_qubits.
+SimulationPlanResult deserialize_simulation_plan(const std::string& bytes, const BoundedSimulationOptions& options,
+                                                 const SimulationSourceDigest* expected_source = nullptr);
+
+}  // namespace synq::compiler
+
+#endif
@@ -0,0 +1,106 @@
+#include "source_buffer.h"
+
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SYNQ_SOURCE_BUFFER_MMAP 1
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+namespace synq::compiler {
+namespace {
+
+constexpr std::size_t kReadChunkBytes = std::size_t{1} << 16;
+
+#if SYNQ_SOURCE_BUFFER_MMAP
+bool read_descriptor(int descriptor, std::string& out) {
+    char chunk[kReadChunkBytes];
+    for (;;) {
+        const ssize_t count = ::read(descriptor, chunk, sizeof(chunk));
+        if (count == 0) return true;
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        out.append(chunk, static_cast<std::size_t>(count));
+    }
+}
+#endif
+
+}  // namespace
+
+SourceBuffer::~SourceBuffer() { release(); }
+
+SourceBuffer::SourceBuffer(SourceBuffer&& other) noexcept { *this = std::move(other); }
+
+SourceBuffer& SourceBuffer::operator=(SourceBuffer&& other) noexcept {
+    if (this == &other) return *this;
+    release();
+    mapped_ = other.mapped_;
+    size_ = other.size_;
+    owned_ = std::move(other.owned_);
+    // Owned text may live in the small-string buffer, so re-point at our copy.
+    data_ = mapped_ ? other.data_ : owned_.data();
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.mapped_ = false;
+    other.owned_.clear();
+    return *this;
+}
+
+bool SourceBuffer::open(const std::string& path) {
+    release();
+#if SYNQ_SOURCE_BUFFER_MMAP
+    const int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0) return false;
+    struct stat status {};
+    if (::fstat(descriptor, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0) {
+        const std::size_t size = static_cast<std::size_t>(status.st_size);
+        void* pages = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (pages != MAP_FAILED) {
+            ::madvise(pages, size, MADV_SEQUENTIAL);
+            ::close(descriptor);
+            data_ = static_cast<const char*>(pages);
+            size_ = size;
+            mapped_ = true;
+            return true;
+        }
+    }
+    // Pipes, devices, empty files, and mmap failures take the streaming path.
+    const bool read = read_descriptor(descriptor, owned_);
+    ::close(descriptor);
+#else
+    std::ifstream input(path, std::ios::binary);
+    if (!input) return false;
+    char chunk[kReadChunkBytes];
+    while (input.read(chunk, sizeof(chunk)) || input.gcount() > 0) {
+        owned_.append(chunk, static_cast<std::size_t>(input.gcount()));
+    }
+    const bool read = !input.bad();
+#endif
+    if (!read) {
+        owned_.clear();
+        return false;
+    }
+    data_ = owned_.data();
+    size_ = owned_.size();
+    return true;
+}
+
+void SourceBuffer::release() {
+#if SYNQ_SOURCE_BUFFER_MMAP
+    if (mapped_) ::munmap(const_cast<char*>(data_), size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    owned_.clear();
+}
+
+}  // namespace synq::compiler
@@ -0,0 +1,44 @@
+// Read-only bytes of one source file for the parser. Regular files are mapped
+// into memory where the platform supports it, so a large generated source is
+// scanned straight from the page cache; pipes, character devices, and files
+// that cannot be mapped are streamed into owned storage instead.
+#ifndef SYNQ_COMPILER_SOURCE_BUFFER_H
+#define SYNQ_COMPILER_SOURCE_BUFFER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace synq::compiler {
+
+class SourceBuffer {
+public:
+    SourceBuffer() = default;
+    ~SourceBuffer();
+    SourceBuffer(SourceBuffer&& other) noexcept;
+    SourceBuffer& operator=(SourceBuffer&& other) noexcept;
+    SourceBuffer(const SourceBuffer&) = delete;
+    SourceBuffer& operator=(const SourceBuffer&) = delete;
+
+    // Replaces the current contents with the file at `path`. Returns false,
+    // leaving the buffer empty, when the file cannot be opened or read.
+    bool open(const std::string& path);
+
+    // Valid until the next `open` or the buffer is destroyed.
+    std::string_view text() const { return {data_, size_}; }
+
+    // True when `text()` refers to mapped pages rather than owned storage.
+    bool mapped() const { return mapped_; }
+
+private:
+    void release();
+
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool mapped_ = false;
+    std::string owned_;
+};
+
+}  // namespace synq::compiler
+
+#endif
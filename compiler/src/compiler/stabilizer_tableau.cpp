@@ -0,0 +1,149 @@
+#include "stabilizer_tableau.h"
+
+#include <bitset>
+#include <utility>
+
+namespace synq::compiler {
+namespace {
+
+std::uint64_t bit_of(std::size_t qubit) { return std::uint64_t{1} << (qubit & 63); }
+
+long long count_bits(std::uint64_t word) { return static_cast<long long>(std::bitset<64>(word).count()); }
+
+}  // namespace
+
+double StabilizerSupport::probability_one(std::size_t qubit) const {
+    const std::size_t word = qubit >> 6;
+    for (std::size_t row = 0; row < rank; ++row) {
+        if ((directions[row * words_per_row + word] & bit_of(qubit)) != 0) return 0.5;
+    }
+    return (offset[word] & bit_of(qubit)) != 0 ? 1.0 : 0.0;
+}
+
+void StabilizerTableau::reset(std::size_t qubit_count) {
+    qubit_count_ = qubit_count;
+    words_ = (qubit_count + 63) / 64;
+    x_.assign(qubit_count * words_, 0);
+    z_.assign(qubit_count * words_, 0);
+    sign_.assign(qubit_count, 0);
+    // Generator i of |0...0> is Z on qubit i.
+    for (std::size_t row = 0; row < qubit_count; ++row) z_[row * words_ + (row >> 6)] = bit_of(row);
+}
+
+bool StabilizerTableau::x(std::size_t row, std::size_t qubit) const {
+    return (x_[row * words_ + (qubit >> 6)] & bit_of(qubit)) != 0;
+}
+
+bool StabilizerTableau::z(std::size_t row, std::size_t qubit) const {
+    return (z_[row * words_ + (qubit >> 6)] & bit_of(qubit)) != 0;
+}
+
+void StabilizerTableau::apply(const CliffordOperation& operation) {
+    const std::size_t first_word = operation.first >> 6;
+    const std::size_t second_word = operation.second >> 6;
+    const std::uint64_t first_bit = bit_of(operation.first);
+    const std::uint64_t second_bit = bit_of(operation.second);
+    for (std::size_t row = 0; row < qubit_count_; ++row) {
+        std::uint64_t* row_x = &x_[row * words_];
+        std::uint64_t* row_z = &z_[row * words_];
+        const bool first_x = (row_x[first_word] & first_bit) != 0;
+        const bool first_z = (row_z[first_word] & first_bit) != 0;
+        switch (operation.opcode) {
+            case CliffordOpcode::Hadamard:
+                sign_[row] ^= static_cast<std::uint8_t>(first_x && first_z);
+                if (first_x != first_z) {
+                    row_x[first_word] ^= first_bit;
+                    row_z[first_word] ^= first_bit;
+                }
+                break;
+            case CliffordOpcode::PauliX: sign_[row] ^= static_cast<std::uint8_t>(first_z); break;
+            case CliffordOpcode::PauliY: sign_[row] ^= static_cast<std::uint8_t>(first_x != first_z); break;
+            case CliffordOpcode::PauliZ: sign_[row] ^= static_cast<std::uint8_t>(first_x); break;
+            case CliffordOpcode::ControlledX: {
+                const bool second_x = (row_x[second_word] & second_bit) != 0;
+                const bool second_z = (row_z[second_word] & second_bit) != 0;
+                sign_[row] ^= static_cast<std::uint8_t>(first_x && second_z && second_x == first_z);
+                if (first_x) row_x[second_word] ^= second_bit;
+                if (second_z) row_z[first_word] ^= first_bit;
+                break;
+            }
+        }
+    }
+}
+
+void StabilizerTableau::swap_rows(std::size_t first, std::size_t second) {
+    if (first == second) return;
+    for (std::size_t word = 0; word < words_; ++word) {
+        std::swap(x_[first * words_ + word], x_[second * words_ + word]);
+        std::swap(z_[first * words_ + word], z_[second * words_ + word]);
+    }
+    std::swap(sign_[first], sign_[second]);
+}
+
+void StabilizerTableau::multiply_into(std::size_t target, std::size_t source) {
+    // The product picks up i^g per qubit, g in {-1, 0, 1} by Pauli pair. The
+    // generators commute, so the total exponent is 0 or 2 and only flips the sign.
+    long long exponent = 2 * (sign_[target] + sign_[source]);
+    for (std::size_t word = 0; word < words_; ++word) {
+        const std::uint64_t source_x = x_[source * words_ + word];
+        const std::uint64_t source_z = z_[source * words_ + word];
+        const std::uint64_t target_x = x_[target * words_ + word];
+        const std::uint64_t target_z = z_[target * words_ + word];
+        const std::uint64_t source_y = source_x & source_z;
+        const std::uint64_t source_x_only = source_x & ~source_z;
+        const std::uint64_t source_z_only = source_z & ~source_x;
+        const std::uint64_t target_y = target_x & target_z;
+        const std::uint64_t target_x_only = target_x & ~target_z;
+        const std::uint64_t target_z_only = target_z & ~target_x;
+        exponent += count_bits((source_y & target_z_only) | (source_x_only & target_y) | (source_z_only & target_x_only));
+        exponent -= count_bits((source_y & target_x_only) | (source_x_only & target_z_only) | (source_z_only & target_y));
+        x_[target * words_ + word] = target_x ^ source_x;
+        z_[target * words_ + word] = target_z ^ source_z;
+    }
+    sign_[target] = static_cast<std::uint8_t>(((exponent % 4) + 4) % 4 == 2);
+}
+
+void StabilizerTableau::measurement_support(StabilizerSupport& support) {
+    support.qubit_count = qubit_count_;
+    support.words_per_row = words_;
+    support.offset.assign(words_, 0);
+
+    // X parts of the group span the support's directions: reduce them to
+    // `rank` independent pivot rows.
+    std::size_t rank = 0;
+    for (std::size_t qubit = 0; qubit < qubit_count_ && rank < qubit_count_; ++qubit) {
+        std::size_t pivot = rank;
+        while (pivot < qubit_count_ && !x(pivot, qubit)) ++pivot;
+        if (pivot == qubit_count_) continue;
+        swap_rows(pivot, rank);
+        for (std::size_t row = 0; row < qubit_count_; ++row) {
+            if (row != rank && x(row, qubit)) multiply_into(row, rank);
+        }
+        ++rank;
+    }
+    support.rank = rank;
+    support.directions.assign(x_.begin(), x_.begin() + static_cast<std::ptrdiff_t>(rank * words_));
+
+    // The remaining generators are signed Z products, each fixing the parity
+    // of its qubits. Fully reduced, each has one pivot qubit and otherwise only
+    // free qubits, so setting the free qubits to zero solves for the offset.
+    std::size_t next = rank;
+    for (std::size_t qubit = 0; qubit < qubit_count_ && next < qubit_count_; ++qubit) {
+        std::size_t pivot = next;
+        while (pivot < qubit_count_ && !z(pivot, qubit)) ++pivot;
+        if (pivot == qubit_count_) continue;
+        swap_rows(pivot, next);
+        for (std::size_t row = rank; row < qubit_count_; ++row) {
+            if (row != next && z(row, qubit)) multiply_into(row, next);
+        }
+        ++next;
+    }
+    for (std::size_t row = rank; row < qubit_count_; ++row) {
+        if (sign_[row] == 0) continue;
+        std::size_t pivot = 0;
+        while (!z(row, pivot)) ++pivot;
+        support.offset[pivot >> 6] |= bit_of(pivot);
+    }
+}
+
+}  // namespace synq::compiler
@@ -0,0 +1,75 @@
+// Stabilizer-tableau state for Clifford-only bounded simulation. An n-qubit
+// stabilizer state is held as n Pauli generators of n bits each (X part, Z
+// part, and a sign), following Aaronson and Gottesman's CHP representation, so
+// memory grows as O(n^2) bits instead of 2^n amplitudes.
+#ifndef SYNQ_COMPILER_STABILIZER_TABLEAU_H
+#define SYNQ_COMPILER_STABILIZER_TABLEAU_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace synq::compiler {
+
+enum class CliffordOpcode : std::uint8_t {
+    Hadamard,
+    PauliX,
+    PauliY,
+    PauliZ,
+    ControlledX,
+};
+
+// One Clifford generator on physical qubits. `second` is the target of a
+// controlled X and equals `first` otherwise.
+struct CliffordOperation {
+    CliffordOpcode opcode = CliffordOpcode::Hadamard;
+    std::size_t first = 0;
+    std::size_t second = 0;
+};
+
+// The computational-basis outcome distribution of a stabilizer state: uniform
+// over `offset` xor every combination of the `rank` independent `directions`.
+// Bit sets hold one bit per qubit in `words_per_row` little-endian words.
+struct StabilizerSupport {
+    std::size_t qubit_count = 0;
+    std::size_t words_per_row = 0;
+    std::size_t rank = 0;
+    std::vector<std::uint64_t> offset;
+    std::vector<std::uint64_t> directions;
+
+    // Probability that `qubit` is observed as one: 0, 1/2, or 1.
+    double probability_one(std::size_t qubit) const;
+};
+
+class StabilizerTableau {
+public:
+    // Resets to |0...0> on `qubit_count` qubits, reusing existing storage.
+    void reset(std::size_t qubit_count);
+
+    std::size_t qubit_count() const { return qubit_count_; }
+
+    // Conjugates every generator by one Clifford gate in O(n) time.
+    void apply(const CliffordOperation& operation);
+
+    // Row-reduces the generators in place and writes the outcome distribution
+    // of measuring every qubit in the computational basis. Costs O(n^3 / 64).
+    void measurement_support(StabilizerSupport& support);
+
+private:
+    bool x(std::size_t row, std::size_t qubit) const;
+    bool z(std::size_t row, std::size_t qubit) const;
+    void swap_rows(std::size_t first, std::size_t second);
+    // Replaces generator `target` with the product of `source` and `target`,
+    // tracking the sign of the product.
+    void multiply_into(std::size_t target, std::size_t source);
+
+    std::size_t qubit_count_ = 0;
+    std::size_t words_ = 0;
+    std::vector<std::uint64_t> x_;
+    std::vector<std::uint64_t> z_;
+    std::vector<std::uint8_t> sign_;
+};
+
+}  // namespace synq::compiler
+
+#endif
@@ -0,0 +1,220 @@
+#include "statevector_kernels.h"
+
+#include <utility>
+
+namespace synq::compiler {
+namespace {
+
+using Complex = std::complex<double>;
+
+template <typename Real>
+std::complex<Real> load_as(const double* matrix, std::size_t entry) {
+    return {static_cast<Real>(matrix[2 * entry]), static_cast<Real>(matrix[2 * entry + 1])};
+}
+
+std::size_t insert_zero_bit(std::size_t value, std::size_t bit) {
+    const std::size_t low_mask = (std::size_t{1} << bit) - 1;
+    return ((value >> bit) << (bit + 1)) | (value & low_mask);
+}
+
+void store(double* matrix, std::size_t entry, Complex value) {
+    matrix[2 * entry] = value.real();
+    matrix[2 * entry + 1] = value.imag();
+}
+
+bool is_controlled_x(const Complex* matrix, bool control_is_first) {
+    for (std::size_t column = 0; column < 4; ++column) {
+        const std::size_t image = control_is_first ? (column ^ ((column & 1) << 1)) : (column ^ (column >> 1));
+        for (std::size_t row = 0; row < 4; ++row) {
+            const Complex expected = row == image ? Complex{1.0, 0.0} : Complex{0.0, 0.0};
+            if (matrix[row * 4 + column] != expected) return false;
+        }
+    }
+    return true;
+}
+
+template <typename Real>
+void apply_scalar(std::complex<Real>* state, const KernelOperation& operation, std::size_t group_begin,
+                  std::size_t group_end) {
+    using Value = std::complex<Real>;
+    const double* matrix = operation.matrix;
+    switch (operation.opcode) {
+        case KernelOpcode::Single: {
+            const std::size_t mask = std::size_t{1} << operation.first;
+            const Value a = load_as<Real>(matrix, 0), b = load_as<Real>(matrix, 1);
+            const Value c = load_as<Real>(matrix, 2), d = load_as<Real>(matrix, 3);
+            for (std::size_t group = group_begin; group < group_end; ++group) {
+                const std::size_t basis = insert_zero_bit(group, operation.first);
+                const Value zero = state[basis];
+                const Value one = state[basis | mask];
+                state[basis] = a * zero + b * one;
+                state[basis | mask] = c * zero + d * one;
+            }
+            return;
+        }
+        case KernelOpcode::Diagonal: {
+            const std::size_t mask = std::size_t{1} << operation.first;
+            const Value d0 = load_as<Real>(matrix, 0), d1 = load_as<Real>(matrix, 3);
+            const bool scale_zero = d0 != Value{1, 0};
+            const bool scale_one = d1 != Value{1, 0};
+            for (std::size_t group = group_begin; group < group_end; ++group) {
+                const std::size_t basis = insert_zero_bit(group, operation.first);
+                if (scale_zero) state[basis] *= d0;
+                if (scale_one) state[basis | mask] *= d1;
+            }
+            return;
+        }
+        case KernelOpcode::PauliX: {
+            const std::size_t mask = std::size_t{1} << operation.first;
+            for (std::size_t group = group_begin; group < group_end; ++group) {
+                const std::size_t basis = insert_zero_bit(group, operation.first);
+                std::swap(state[basis], state[basis | mask]);
+            }
+            return;
+        }
+        case KernelOpcode::Pair: {
+            const std::size_t first_mask = std::size_t{1} << operation.first;
+            const std::size_t second_mask = std::size_t{1} << operation.second;
+            Value m[16];
+            for (std::size_t entry = 0; entry < 16; ++entry) m[entry] = load_as<Real>(matrix, entry);
+            for (std::size_t group = group_begin; group < group_end; ++group) {
+                const std::size_t basis = insert_zero_bit(insert_zero_bit(group, operation.first), operation.second);
+                const std::size_t indices[4] = {basis, basis | first_mask, basis | second_mask,
+                                                basis | first_mask | second_mask};
+                const Value input[4] = {state[indices[0]], state[indices[1]], state[indices[2]], state[indices[3]]};
+                for (std::size_t row = 0; row < 4; ++row) {
+                    state[indices[row]] = m[row * 4] * input[0] + m[row * 4 + 1] * input[1] +
+                                          m[row * 4 + 2] * input[2] + m[row * 4 + 3] * input[3];
+                }
+            }
+            return;
+        }
+        case KernelOpcode::ControlledX: {
+            const std::size_t control_mask = std::size_t{1} << operation.first;
+            const std::size_t target_mask = std::size_t{1} << operation.second;
+            const std::size_t low = operation.first < operation.second ? operation.first : operation.second;
+            const std::size_t high = operation.first < operation.second ? operation.second : operation.first;
+            for (std::size_t group = group_begin; group < group_end; ++group) {
+                const std::size_t basis = insert_zero_bit(insert_zero_bit(group, low), high) | control_mask;
+                std::swap(state[basis], state[basis | target_mask]);
+            }
+            return;
+        }
+    }
+}
+
+}  // namespace
+
+const char* simulation_kernel_isa_name(SimulationKernelIsa isa) {
+    switch (isa) {
+        case SimulationKernelIsa::Scalar: return "scalar";
+        case SimulationKernelIsa::Avx2: return "avx2";
+        case SimulationKernelIsa::Avx512: return "avx512";
+    }
+    return "scalar";
+}
+
+const char* simulation_precision_name(SimulationPrecision precision) {
+    return precision == SimulationPrecision::F32 ? "f32" : "f64";
+}
+
+SimulationKernelIsa detect_simulation_kernel_isa() {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    if (statevector_avx512_kernels_compiled() && __builtin_cpu_supports("avx512f") &&
+        __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return SimulationKernelIsa::Avx512;
+    }
+    if (statevector_avx2_kernels_compiled() && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return SimulationKernelIsa::Avx2;
+    }
+#endif
+    return SimulationKernelIsa::Scalar;
+}
+
+KernelOperation make_single_kernel_operation(std::size_t qubit, const std::complex<double>* matrix) {
+    KernelOperation operation;
+    operation.first = qubit;
+    operation.second = qubit;
+    for (std::size_t entry = 0; entry < 4; ++entry) store(operation.matrix, entry, matrix[entry]);
+    const Complex zero{0.0, 0.0};
+    const Complex one{1.0, 0.0};
+    if (matrix[1] == zero && matrix[2] == zero) {
+        operation.opcode = KernelOpcode::Diagonal;
+    } else if (matrix[0] == zero && matrix[3] == zero && matrix[1] == one && matrix[2] == one) {
+        operation.opcode = KernelOpcode::PauliX;
+    } else {
+        operation.opcode = KernelOpcode::Single;
+    }
+    return operation;
+}
+
+KernelOperation make_pair_kernel_operation(std::size_t first, std::size_t second,
+                                           const std::complex<double>* matrix) {
+    KernelOperation operation;
+    if (is_controlled_x(matrix, true) || is_controlled_x(matrix, false)) {
+        const bool control_is_first = is_controlled_x(matrix, true);
+        operation.opcode = KernelOpcode::ControlledX;
+        operation.first = control_is_first ? first : second;
+        operation.second = control_is_first ? second : first;
+        return operation;
+    }
+    operation.opcode = KernelOpcode::Pair;
+    // Kernels expect the lower physical qubit in local bit zero, so a block
+    // recorded as (high, low) swaps the two local bits of every row/column.
+    const bool swap = first > second;
+    operation.first = swap ? second : first;
+    operation.second = swap ? first : second;
+    const auto local = [swap](std::size_t index) {
+        return swap ? (((index & 1) << 1) | (index >> 1)) : index;
+    };
+    for (std::size_t row = 0; row < 4; ++row) {
+        for (std::size_t column = 0; column < 4; ++column) {
+            store(operation.matrix, local(row) * 4 + local(column), matrix[row * 4 + column]);
+        }
+    }
+    return operation;
+}
+
+std::size_t kernel_group_count(const KernelOperation& operation, std::size_t amplitude_count) {
+    const bool pair = operation.opcode == KernelOpcode::Pair || operation.opcode == KernelOpcode::ControlledX;
+    return amplitude_count >> (pair ? 2 : 1);
+}
+
+void apply_kernel_operation(SimulationKernelIsa isa, std::complex<double>* state, const KernelOperation& operation,
+                            std::size_t group_begin, std::size_t group_end) {
+    double* data = reinterpret_cast<double*>(state);
+    switch (isa) {
+        case SimulationKernelIsa::Avx512:
+            apply_kernel_operation_avx512(data, operation, group_begin, group_end);
+            return;
+        case SimulationKernelIsa::Avx2:
+            apply_kernel_operation_avx2(data, operation, group_begin, group_end);
+            return;
+        case SimulationKernelIsa::Scalar:
+            break;
+    }
+    apply_kernel_operation_scalar(data, operation, group_begin, group_end);
+}
+
+void apply_kernel_operation(SimulationKernelIsa isa, std::complex<float>* state, const KernelOperation& operation,
+                            std::size_t group_begin, std::size_t group_end) {
+    float* data = reinterpret_cast<float*>(state);
+    if (isa == SimulationKernelIsa::Scalar) {
+        apply_kernel_operation_scalar_f32(data, operation, group_begin, group_end);
+    } else {
+        apply_kernel_operation_avx2_f32(data, operation, group_begin, group_end);
+    }
+}
+
+void apply_kernel_operation_scalar(double* state, const KernelOperation& operation, std::size_t group_begin,
+                                   std::size_t group_end) {
+    apply_scalar(reinterpret_cast<std::complex<double>*>(state), operation, group_begin, group_end);
+}
+
+void apply_kernel_operation_scalar_f32(float* state, const KernelOperation& operation, std::size_t group_begin,
+                                       std::size_t group_end) {
+    apply_scalar(reinterpret_cast<std::complex<float>*>(state), operation, group_begin, group_end);
+}
+
+}  // namespace synq::compiler
@@ -0,0 +1,124 @@
+// Amplitude-sweep kernels for the bounded local simulator. Each operation is a
+// fused unitary already classified into the cheapest sweep shape; kernels are
+// selected once per simulation by CPU feature detection, and the scalar path
+// remains the reference implementation for verification.
+#ifndef SYNQ_COMPILER_STATEVECTOR_KERNELS_H
+#define SYNQ_COMPILER_STATEVECTOR_KERNELS_H
+
+#include <complex>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace synq::compiler {
+
+// Cache-line-aligned storage for amplitude vectors, so vector loads start on a
+// line boundary and concurrent chunks never share a line.
+template <typename T>
+struct AmplitudeAllocator {
+    using value_type = T;
+    static constexpr std::size_t alignment = 64;
+
+    AmplitudeAllocator() = default;
+    template <typename U>
+    AmplitudeAllocator(const AmplitudeAllocator<U>&) {}
+
+    T* allocate(std::size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{alignment}));
+    }
+    void deallocate(T* pointer, std::size_t) { ::operator delete(pointer, std::align_val_t{alignment}); }
+
+    template <typename U>
+    bool operator==(const AmplitudeAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AmplitudeAllocator<U>&) const { return false; }
+};
+
+template <typename Real>
+using AmplitudeBufferOf = std::vector<std::complex<Real>, AmplitudeAllocator<std::complex<Real>>>;
+using AmplitudeBuffer = AmplitudeBufferOf<double>;
+
+// Amplitude storage precision. Single precision halves memory per amplitude
+// and doubles the amplitudes per vector register at roughly 1e-7 relative
+// rounding per operation; kernel coefficients are always prepared in double.
+enum class SimulationPrecision {
+    F64,
+    F32,
+};
+
+const char* simulation_precision_name(SimulationPrecision precision);
+
+enum class SimulationKernelIsa {
+    Scalar,
+    Avx2,
+    Avx512,
+};
+
+const char* simulation_kernel_isa_name(SimulationKernelIsa isa);
+
+// Returns the widest instruction set that is both compiled into this build and
+// supported by the running processor and operating system.
+SimulationKernelIsa detect_simulation_kernel_isa();
+
+enum class KernelOpcode : unsigned char {
+    // General 2x2 unitary on `first`.
+    Single,
+    // diag(d0, d1) on `first`; a unit entry leaves its half of the vector untouched.
+    Diagonal,
+    // Pure amplitude permutation swapping the halves selected by `first`.
+    PauliX,
+    // General 4x4 unitary with local basis index bit(first) | bit(second) << 1
+    // and first < second.
+    Pair,
+    // Pure permutation with control `first` and target `second`.
+    ControlledX,
+};
+
+// Plain-data operation shared with the instruction-set-specific translation
+// units. Coefficients are row-major complex values stored as interleaved
+// (real, imaginary) doubles; single-qubit shapes use the first four entries.
+struct KernelOperation {
+    KernelOpcode opcode = KernelOpcode::Single;
+    std::size_t first = 0;
+    std::size_t second = 0;
+    double matrix[32] = {};
+};
+
+// Classifies a fused 2x2 or 4x4 unitary. Exact diagonal and permutation
+// matrices select the specialized sweeps; anything else stays general.
+KernelOperation make_single_kernel_operation(std::size_t qubit, const std::complex<double>* matrix);
+KernelOperation make_pair_kernel_operation(std::size_t first, std::size_t second,
+                                           const std::complex<double>* matrix);
+
+// Number of sweep groups an operation visits in a vector of `amplitude_count`
+// amplitudes: pairs for single-qubit opcodes, quadruples for two-qubit ones.
+std::size_t kernel_group_count(const KernelOperation& operation, std::size_t amplitude_count);
+
+// Applies one operation to the groups [group_begin, group_end). Disjoint group
+// ranges touch disjoint amplitudes, so ranges may be swept concurrently.
+void apply_kernel_operation(SimulationKernelIsa isa, std::complex<double>* state, const KernelOperation& operation,
+                            std::size_t group_begin, std::size_t group_end);
+void apply_kernel_operation(SimulationKernelIsa isa, std::complex<float>* state, const KernelOperation& operation,
+                            std::size_t group_begin, std::size_t group_end);
+
+// Instruction-set entry points. Each sweeps the contiguous group range
+// [group_begin, group_end), where a group is one amplitude pair for
+// single-qubit opcodes and one amplitude quadruple for two-qubit opcodes.
+void apply_kernel_operation_scalar(double* state, const KernelOperation& operation, std::size_t group_begin,
+                                   std::size_t group_end);
+bool statevector_avx2_kernels_compiled();
+void apply_kernel_operation_avx2(double* state, const KernelOperation& operation, std::size_t group_begin,
+                                 std::size_t group_end);
+bool statevector_avx512_kernels_compiled();
+void apply_kernel_operation_avx512(double* state, const KernelOperation& operation, std::size_t group_begin,
+                                   std::size_t group_end);
+// Single-precision entry points over interleaved (real, imaginary) floats.
+// AVX-512 processors use the AVX2 single-precision sweeps.
+void apply_kernel_operation_scalar_f32(float* state, const KernelOperation& operation, std::size_t group_begin,
+                                       std::size_t group_end);
+void apply_kernel_operation_avx2_f32(float* state, const KernelOperation& operation, std::size_t group_begin,
+                                     std::size_t group_end);
+
+}  // namespace synq::compiler
+
+#endif
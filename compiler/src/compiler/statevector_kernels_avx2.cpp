@@ -0,0 +1,483 @@
+// AVX2/FMA amplitude kernels. This translation unit is compiled with AVX2 code
+// generation and is only entered after runtime detection. It deliberately uses
+// raw doubles/floats and intrinsics instead of standard-library templates so
+// that no AVX-encoded copy of a shared inline function can be selected by the
+// linker.
+#include "statevector_kernels.h"
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+namespace synq::compiler {
+
+#if defined(__AVX2__) && defined(__FMA__)
+namespace {
+
+std::size_t insert_zero_bit(std::size_t value, std::size_t bit) {
+    const std::size_t low_mask = (std::size_t{1} << bit) - 1;
+    return ((value >> bit) << (bit + 1)) | (value & low_mask);
+}
+
+// A complex coefficient per 128-bit lane: real parts and imaginary parts are
+// each duplicated across the lane so one fmaddsub forms the complex product.
+struct Coefficient {
+    __m256d real;
+    __m256d imag;
+};
+
+Coefficient broadcast(const double* matrix, std::size_t entry) {
+    return {_mm256_set1_pd(matrix[2 * entry]), _mm256_set1_pd(matrix[2 * entry + 1])};
+}
+
+Coefficient lanes(const double* matrix, std::size_t low_entry, std::size_t high_entry) {
+    const double low_real = matrix[2 * low_entry];
+    const double low_imag = matrix[2 * low_entry + 1];
+    const double high_real = matrix[2 * high_entry];
+    const double high_imag = matrix[2 * high_entry + 1];
+    return {_mm256_setr_pd(low_real, low_real, high_real, high_real),
+            _mm256_setr_pd(low_imag, low_imag, high_imag, high_imag)};
+}
+
+__m256d multiply(const Coefficient& coefficient, __m256d value) {
+    return _mm256_fmaddsub_pd(coefficient.real, value,
+                              _mm256_mul_pd(coefficient.imag, _mm256_permute_pd(value, 0x5)));
+}
+
+__m256d swap_halves(__m256d value) { return _mm256_permute2f128_pd(value, value, 0x01); }
+
+__m256d load(const double* state, std::size_t basis) { return _mm256_loadu_pd(state + 2 * basis); }
+
+void store(double* state, std::size_t basis, __m256d value) { _mm256_storeu_pd(state + 2 * basis, value); }
+
+// Calls body(basis) for every two-group vector inside the contiguous runs of
+// [group_begin, group_end) and hands odd run tails to the scalar reference.
+template <typename IndexOf, typename Body>
+void sweep_runs(double* state, const KernelOperation& operation, std::size_t group_begin, std::size_t group_end,
+                std::size_t low_bit, IndexOf index_of, Body body) {
+    const std::size_t stride = std::size_t{1} << low_bit;
+    std::size_t group = group_begin;
+    while (group < group_end) {
+        const std::size_t remaining_in_run = stride - (group & (stride - 1));
+        const std::size_t run = group_end - group < remaining_in_run ? group_end - group : remaining_in_run;
+        const std::size_t basis = index_of(group);
+        std::size_t offset = 0;
+        for (; offset + 2 <= run; offset += 2) body(basis + offset);
+        if (offset < run) apply_kernel_operation_scalar(state, operation, group + offset, group + run);
+        group += run;
+    }
+}
+
+void apply_single(double* state, const KernelOperation& operation, std::size_t group_begin, std::size_t group_end) {
+    const double* matrix = operation.matrix;
+    const std::size_t qubit = operation.first;
+    if (qubit == 0) {
+        const Coefficient direct = lanes(matrix, 0, 3);
+        const Coefficient crossed = lanes(matrix, 1, 2);
+        for (std::size_t group = group_begin; group < group_end; ++group) {
+            const __m256d value = load(state, 2 * group);
+            store(state, 2 * group, _mm256_add_pd(multiply(direct, value), multiply(crossed, swap_halves(value))));
+        }
+        return;
+    }
+    const Coefficient a = broadcast(matrix, 0), b = broadcast(matrix, 1);
+    const Coefficient c = broadcast(matrix, 2), d = broadcast(matrix, 3);
+    const std::size_t stride = std::size_t{1} << qubit;
+    sweep_runs(state, operation, group_begin, group_end, qubit,
+               [qubit](std::size_t group) { return insert_zero_bit(group, qubit); },
+               [&](std::size_t basis) {
+                   const __m256d zero = load(state, basis);
+                   const __m256d one = load(state, basis + stride);
+                   store(state, basis, _mm256_add_pd(multiply(a, zero), multiply(b, one)));
+                   store(state, basis + stride, _mm256_add_pd(multiply(c, zero), multiply(d, one)));
+               });
+}
+
+void apply_diagonal(double* state, const KernelOperation& operation, std::size_t group_begin, std::size_t group_end) {
+    const double* matrix = operation.matrix;
+    const std::size_t qubit = operation.first;
+    if (qubit == 0) {
+        const Coefficient diagonal = lanes(matrix, 0, 3);
+        for (std::size_t group = group_begin; group < group_end; ++group) {
+            store(state, 2 * group, multiply(diagonal, load(state, 2 * group)));
+        }
+        return;
+    }
+    const bool scale_zero = matrix[0] != 1.0 || matrix[1] != 0.0;
+    const bool scale_one = matrix[6] != 1.0 || matrix[7] != 0.0;
+    const Coefficient d0 = broadcast(matrix, 0), d1 = broadcast(matrix, 3);
+    const std::size_t stride = std::size_t{1} << qubit;
+    sweep_runs(state, operation, group_begin, group_end, qubit,
+               [qubit](std::size_t group) { return insert_zero_bit(group, qubit); },
+               [&](std::size_t basis) {
+                   if (scale_zero) store(state, basis, multiply(d0, load(state, basis)));
+                   if (scale_one) store(state, basis + stride, multiply(d1, load(state, basis + stride)));
+               });
+}
+
+void apply_pauli_x(double* state, const KernelOperation& operation, std::size_t group_begin, std::size_t group_end) {
+    const std::size_t qubit = operation.first;
+    if (qubit == 0) {
+        for (std::size_t group = group_begin; group < group_end; ++group) {
+            store(state, 2 * group, swap_halves(load(state, 2 * group)));
+        }
+        return;
+    }
+    const std::size_t stride = std::size_t{1} << qubit;
+    sweep_runs(state, operation, group_begin, group_end, qubit,
+               [qubit](std::size_t group) { return insert_zero_bit(group, qubit); },
+               [&](std::size_t basis) {
+                   const __m256d zero = load(state, basis);
+                   store(state, basis, load(state, basis + stride));
+                   store(state, basis + stride, zero);
+               });
+}
+
+void apply_pair(double* state, const KernelOperation& operation, std::size_t group_begin, std::size_t group_end) {
+    const double* matrix = operation.matrix;
+    const std::size_t low = operation.first;
+    const std::size_t high = operation.second;
+    const std::size_t low_mask = std::size_t{1} << low;
+    const std::size_t high_mask = std::size_t{1} << high;
+    if (low == 0) {
+        // Local amplitudes 0/1 and 2/3 share one register each, so every output
+        // register combines both inputs and their lane-swapped copies.
+        const Coefficient zero_direct = lanes(matrix, 0, 5), zero_crossed = lanes(matrix, 1, 4);
+        const Coefficient zero_other = lanes(matrix, 2, 7), zero_other_crossed = lanes(matrix, 3, 6);
+        const Coefficient one_direct = lanes(matrix, 10, 15), one_crossed = lanes(matrix, 11, 14);
+        const Coefficient one_other = lanes(matrix, 8, 13), one_other_crossed = lanes(matrix, 9, 12);
+        for (std::size_t group = group_begin; group < group_end; ++group) {
+            const std::size_t basis = insert_zero_bit(insert_zero_bit(group, low), high);
+            const __m256d lower = load(state, basis);
+            const __m256d upper = load(state, basis + high_mask);
+            const __m256d lower_swapped = swap_halves(lower);
+            const __m256d upper_swapped = swap_halves(upper);
+            store(state, basis,
+                  _mm256_add_pd(_mm256_add_pd(multiply(zero_direct, lower), multiply(zero_crossed, lower_swapped)),
+                                _mm256_add_pd(multiply(zero_other, upper), multiply(zero_other_crossed, upper_swapped))));
+            store(state, basis + high_mask,
+                  _mm256_add_pd(_mm256_add_pd(multiply(one_direct, upper), multiply(one_crossed, upper_swapped)),
+                                _mm256_add_pd(multiply(one_other, lower), multiply(one_other_crossed, lower_swapped))));
+        }
+        return;
+    }
+    Coefficient m[16];
+    for (std::size_t entry = 0; entry < 16; ++entry) m[entry] = broadcast(matrix, entry);
+    sweep_runs(state, operation, group_begin, group_end, low,
+               [low, high](std::size_t group) { return insert_zero_bit(insert_zero_bit(group, low), high); },
+               [&](std::size_t basis) {
+                   const std::size_t indices[4] = {basis, basis + low_mask, basis + high_mask,
+                                                   basis + low_mask + high_mask};
+                   const __m256d input[4] = {load(state, indices[0]), load(state, indices[1]),
+                                             load(state, indices[2]), load(state, indices[3])};
+                   for (std::size_t row = 0; row < 4; ++row) {
+                       const __m256d left = _mm256_add_pd(multiply(m[row * 4], input[0]), multiply(m[row * 4 + 1], input[1]));
+                       const __m256d right = _mm256_add_pd(multiply(m[row * 4 + 2], input[2]), multiply(m[row * 4 + 3], input[3]));
+                       store(state, indices[row], _mm256_add_pd(left, right));
+                   }
+               });
+}
+
+void apply_controlled_x(double* state, const KernelOperation& operation, std::size_t group_begin,
+                        std::size_t group_end) {
+    const std::size_t control_mask = std::size_t{1} << operation.first;
+    const std::size_t target_mask = std::size_t{1} << operation.second;
+    const std::size_t low = operation.first < operation.second ? operation.first : operation.second;
+    const std::size_t high = operation.first < operation.second ? operation.second : operation.first;
+    if (low == 0) {
+        apply_kernel_operation_scalar(state, operation, group_begin, group_end);
+        return;
+    }
+    sweep_runs(state, operation, group_begin, group_end, low,
+               [=](std::size_t group) { return insert_zero_bit(insert_zero_bit(group, low), high) | control_mask; },
+               [&](std::size_t basis) {
+                   const __m256d unflipped = load(state, basis);
+                   store(state, basis, load(state, basis + target_mask));
+                   store(state, basis + target_mask, unflipped);
+               });
+}
+
+// Single precision: one register holds four complex amplitudes. Operands on
+// qubit 2 or above pair whole registers; operands on qubits 0 and 1 pair lanes
+// inside a register, using per-lane coefficients and lane permutes.
+namespace single_precision {
+
+struct Coefficient {
+    __m256 real;
+    __m256 imag;
+};
+
+Coefficient broadcast(const double* matrix, std::size_t entry) {
+    return {_mm256_set1_ps(static_cast<float>(matrix[2 * entry])),
+            _mm256_set1_ps(static_cast<float>(matrix[2 * entry + 1]))};
+}
+
+__m256 multiply(const Coefficient& coefficient, __m256 value) {
+    return _mm256_fmaddsub_ps(coefficient.real, value,
+                              _mm256_mul_ps(coefficient.imag, _mm256_permute_ps(value, 0xB1)));
+}
+
+// Per-lane coefficients: lane k of the register uses matrix entry entries[k].
+Coefficient lanes(const double* matrix, const std::size_t (&entries)[4]) {
+    float real[8];
+    float imag[8];
+    for (std::size_t lane = 0; lane < 4; ++lane) {
+        real[2 * lane] = real[2 * lane + 1] = static_cast<float>(matrix[2 * entries[lane]]);
+        imag[2 * lane] = imag[2 * lane + 1] = static_cast<float>(matrix[2 * entries[lane] + 1]);
+    }
+    return {_mm256_loadu_ps(real), _mm256_loadu_ps(imag)};
+}
+
+// Exchanges the lanes whose basis indices differ in `bit` (0 or 1).
+__m256 partner(__m256 value, std::size_t bit) {
+    return bit == 0 ? _mm256_permute_ps(value, 0x4E) : _mm256_permute2f128_ps(value, value, 0x01);
+}
+
+__m256 load(const float* state, std::size_t basis) { return _mm256_loadu_ps(state + 2 * basis); }
+
+void store(float* state, std::size_t basis, __m256 value) { _mm256_storeu_ps(state + 2 * basis, value); }
+
+template <typename IndexOf, typename Body>
+void sweep_runs(float* state, const KernelOperation& operation, std::size_t group_begin, std::size_t group_end,
+                std::size_t low_bit, IndexOf index_of, Body body) {
+    const std::size_t stride = std::size_t{1} << low_bit;
+    std::size_t group = group_begin;
+    while (group < group_end) {
+        const std::size_t remaining_in_run = stride - (group & (stride - 1));
+        const std::size_t run = group_end - group < remaining_in_run ? group_end - group : remaining_in_run;
+        const std::size_t basis = index_of(group);
+        std::size_t offset = 0;
+        for (; offset + 4 <= run; offset += 4) body(basis + offset);
+        if (offset < run) apply_kernel_operation_scalar_f32(state, operation, group + offset, group + run);
+        group += run;
+    }
+}
+
+// Calls body(group) for every `per_vector`-aligned block of groups inside
+// [group_begin, group_end) and hands unaligned ends to the scalar reference.
+template <typename Body>
+void sweep_vectors(float* state, const KernelOperation& operation, std::size_t group_begin, std::size_t group_end,
+                   std::size_t per_vector, Body body) {
+    const std::size_t first = (group_begin + per_vector - 1) / per_vector * per_vector;
+    const std::size_t last = group_end / per_vector * per_vector;
+    if (first >= last) {
+        apply_kernel_operation_scalar_f32(state, operation, group_begin, group_end);
+        return;
+    }
+    if (group_begin < first) apply_kernel_operation_scalar_f32(state, operation, group_begin, first);
+    for (std::size_t group = first; group < last; group += per_vector) body(group);
+    if (last < group_end) apply_kernel_operation_scalar_f32(state, operation, last, group_end);
+}
+
+// 2x2 blocks on qubit 0 or 1: each register holds two whole amplitude pairs.
+void apply_low_single(float* state, const KernelOperation& operation, std::size_t group_begin,
+                      std::size_t group_end) {
+    const std::size_t qubit = operation.first;
+    std::size_t direct_entries[4];
+    std::size_t crossed_entries[4];
+    for (std::size_t lane = 0; lane < 4; ++lane) {
+        const bool one = ((lane >> qubit) & 1) != 0;
+        direct_entries[lane] = one ? 3 : 0;
+        crossed_entries[lane] = one ? 2 : 1;
+    }
+    const Coefficient direct = lanes(operation.matrix, direct_entries);
+    const Coefficient crossed = lanes(operation.matrix, crossed_entries);
+    sweep_vectors(state, operation, group_begin, group_end, 2, [&](std::size_t group) {
+        const std::size_t basis = insert_zero_bit(group, qubit);
+        const __m256 value = load(state, basis);
+        store(state, basis, _mm256_add_ps(multiply(direct, value), multiply(crossed, partner(value, qubit))));
+    });
+}
+
+// 4x4 blocks whose lower operand is qubit 0 or 1. With operands (0, 1) one
+// register is one whole group; otherwise a register holds the lower halves of
+// two groups and pairs with the register `high` places above it.
+void apply_low_pair(float* state, const KernelOperation& operation, std::size_t group_begin, std::size_t group_end) {
+    const double* matrix = operation.matrix;
+    const std::size_t low = operation.first;
+    const std::size_t high = operation.second;
+    if (high == 1) {
+        Coefficient offsets[4];
+        for (std::size_t offset = 0; offset < 4; ++offset) {
+            const std::size_t entries[4] = {0 * 4 + (0 ^ offset), 1 * 4 + (1 ^ offset), 2 * 4 + (2 ^ offset),
+                                            3 * 4 + (3 ^ offset)};
+            offsets[offset] = lanes(matrix, entries);
+        }
+        sweep_vectors(state, operation, group_begin, group_end, 1, [&](std::size_t group) {
+            const __m256 value = load(state, 4 * group);
+            const __m256 swapped_low = partner(value, 0);
+            const __m256 swapped_high = partner(value, 1);
+            store(state, 4 * group,
+                  _mm256_add_ps(_mm256_add_ps(multiply(offsets[0], value), multiply(offsets[1], swapped_low)),
+                                _mm256_add_ps(multiply(offsets[2], swapped_high),
+                                              multiply(offsets[3], partner(swapped_high, 0)))));
+        });
+        return;
+    }
+    std::size_t entries[8][4];
+    for (std::size_t lane = 0; lane < 4; ++lane) {
+        const std::size_t bit = (lane >> low) & 1;
+        const std::size_t other = bit ^ 1;
+        entries[0][lane] = bit * 4 + bit;
+        entries[1][lane] = bit * 4 + other;
+        entries[2][lane] = bit * 4 + 2 + bit;
+        entries[3][lane] = bit * 4 + 2 + other;
+        entries[4][lane] = (2 + bit) * 4 + 2 + bit;
+        entries[5][lane] = (2 + bit) * 4 + 2 + other;
+        entries[6][lane] = (2 + bit) * 4 + bit;
+        entries[7][lane] = (2 + bit) * 4 + other;
+    }
+    Coefficient m[8];
+    for (std::size_t index = 0; index < 8; ++index) m[index] = lanes(matrix, entries[index]);
+    const std::size_t high_stride = std::size_t{1} << high;
+    sweep_vectors(state, operation, group_begin, group_end, 2, [&](std::size_t group) {
+        const std::size_t basis = insert_zero_bit(insert_zero_bit(group, low), high);
+        const __m256 lower = load(state, basis);
+        const __m256 upper = load(state, basis + high_stride);
+        const __m256 lower_swapped = partner(lower, low);
+        const __m256 upper_swapped = partner(upper, low);
+        store(state, basis,
+              _mm256_add_ps(_mm256_add_ps(multiply(m[0], lower), multiply(m[1], lower_swapped)),
+                            _mm256_add_ps(multiply(m[2], upper), multiply(m[3], upper_swapped))));
+        store(state, basis + high_stride,
+              _mm256_add_ps(_mm256_add_ps(multiply(m[4], upper), multiply(m[5], upper_swapped)),
+                            _mm256_add_ps(multiply(m[6], lower), multiply(m[7], lower_swapped))));
+    });
+}
+
+// Writes a controlled-x with a low operand as the equivalent exact 0/1 pair
+// block, so it can share the lane-permute pair path.
+KernelOperation controlled_x_as_pair(const KernelOperation& operation) {
+    KernelOperation pair;
+    pair.opcode = KernelOpcode::Pair;
+    pair.first = operation.first < operation.second ? operation.first : operation.second;
+    pair.second = operation.first < operation.second ? operation.second : operation.first;
+    const std::size_t control_bit = operation.first == pair.first ? 1 : 2;
+    const std::size_t target_bit = operation.second == pair.first ? 1 : 2;
+    for (std::size_t column = 0; column < 4; ++column) {
+        const std::size_t row = (column & control_bit) != 0 ? column ^ target_bit : column;
+        pair.matrix[2 * (row * 4 + column)] = 1.0;
+    }
+    return pair;
+}
+
+void apply(float* state, const KernelOperation& operation, std::size_t group_begin, std::size_t group_end) {
+    const double* matrix = operation.matrix;
+    const std::size_t low = operation.first < operation.second ? operation.first : operation.second;
+    const std::size_t high = operation.first < operation.second ? operation.second : operation.first;
+    if (low < 2) {
+        switch (operation.opcode) {
+            case KernelOpcode::Single:
+            case KernelOpcode::Diagonal:
+            case KernelOpcode::PauliX: apply_low_single(state, operation, group_begin, group_end); return;
+            case KernelOpcode::Pair: apply_low_pair(state, operation, group_begin, group_end); return;
+            case KernelOpcode::ControlledX:
+                apply_low_pair(state, controlled_x_as_pair(operation), group_begin, group_end);
+                return;
+        }
+    }
+    const std::size_t low_stride = std::size_t{1} << low;
+    const auto single_index = [low](std::size_t group) { return insert_zero_bit(group, low); };
+    const auto pair_index = [low, high](std::size_t group) {
+        return insert_zero_bit(insert_zero_bit(group, low), high);
+    };
+    switch (operation.opcode) {
+        case KernelOpcode::Single: {
+            const Coefficient a = broadcast(matrix, 0), b = broadcast(matrix, 1);
+            const Coefficient c = broadcast(matrix, 2), d = broadcast(matrix, 3);
+            sweep_runs(state, operation, group_begin, group_end, low, single_index, [&](std::size_t basis) {
+                const __m256 zero = load(state, basis);
+                const __m256 one = load(state, basis + low_stride);
+                store(state, basis, _mm256_add_ps(multiply(a, zero), multiply(b, one)));
+                store(state, basis + low_stride, _mm256_add_ps(multiply(c, zero), multiply(d, one)));
+            });
+            return;
+        }
+        case KernelOpcode::Diagonal: {
+            const bool scale_zero = matrix[0] != 1.0 || matrix[1] != 0.0;
+            const bool scale_one = matrix[6] != 1.0 || matrix[7] != 0.0;
+            const Coefficient d0 = broadcast(matrix, 0), d1 = broadcast(matrix, 3);
+            sweep_runs(state, operation, group_begin, group_end, low, single_index, [&](std::size_t basis) {
+                if (scale_zero) store(state, basis, multiply(d0, load(state, basis)));
+                if (scale_one) store(state, basis + low_stride, multiply(d1, load(state, basis + low_stride)));
+            });
+            return;
+        }
+        case KernelOpcode::PauliX:
+            sweep_runs(state, operation, group_begin, group_end, low, single_index, [&](std::size_t basis) {
+                const __m256 zero = load(state, basis);
+                store(state, basis, load(state, basis + low_stride));
+                store(state, basis + low_stride, zero);
+            });
+            return;
+        case KernelOpcode::Pair: {
+            const std::size_t high_stride = std::size_t{1} << high;
+            Coefficient m[16];
+            for (std::size_t entry = 0; entry < 16; ++entry) m[entry] = broadcast(matrix, entry);
+            sweep_runs(state, operation, group_begin, group_end, low, pair_index, [&](std::size_t basis) {
+                const std::size_t indices[4] = {basis, basis + low_stride, basis + high_stride,
+                                                basis + low_stride + high_stride};
+                const __m256 input[4] = {load(state, indices[0]), load(state, indices[1]), load(state, indices[2]),
+                                         load(state, indices[3])};
+                for (std::size_t row = 0; row < 4; ++row) {
+                    const __m256 left = _mm256_add_ps(multiply(m[row * 4], input[0]), multiply(m[row * 4 + 1], input[1]));
+                    const __m256 right = _mm256_add_ps(multiply(m[row * 4 + 2], input[2]), multiply(m[row * 4 + 3], input[3]));
+                    store(state, indices[row], _mm256_add_ps(left, right));
+                }
+            });
+            return;
+        }
+        case KernelOpcode::ControlledX: {
+            const std::size_t control_mask = std::size_t{1} << operation.first;
+            const std::size_t target_mask = std::size_t{1} << operation.second;
+            sweep_runs(state, operation, group_begin, group_end, low,
+                       [&](std::size_t group) { return pair_index(group) | control_mask; },
+                       [&](std::size_t basis) {
+                           const __m256 unflipped = load(state, basis);
+                           store(state, basis, load(state, basis + target_mask));
+                           store(state, basis + target_mask, unflipped);
+                       });
+            return;
+        }
+    }
+}
+
+}  // namespace single_precision
+
+}  // namespace
+
+bool statevector_avx2_kernels_compiled() { return true; }
+
+void apply_kernel_operation_avx2(double* state, const KernelOperation& operation, std::size_t group_begin,
+                                 std::size_t group_end) {
+    switch (operation.opcode) {
+        case KernelOpcode::Single: apply_single(state, operation, group_begin, group_end); return;
+        case KernelOpcode::Diagonal: apply_diagonal(state, operation, group_begin, group_end); return;
+        case KernelOpcode::PauliX: apply_pauli_x(state, operation, group_begin, group_end); return;
+        case KernelOpcode::Pair: apply_pair(state, operation, group_begin, group_end); return;
+        case KernelOpcode::ControlledX: apply_controlled_x(state, operation, group_begin, group_end); return;
+    }
+}
+
+void apply_kernel_operation_avx2_f32(float* state, const KernelOperation& operation, std::size_t group_begin,
+                                     std::size_t group_end) {
+    single_precision::apply(state, operation, group_begin, group_end);
+}
+
+#else
+
+bool statevector_avx2_kernels_compiled() { return false; }
+
+void apply_kernel_operation_avx2(double* state, const KernelOperation& operation, std::size_t group_begin,
+                                 std::size_t group_end) {
+    apply_kernel_operation_scalar(state, operation, group_begin, group_end);
+}
+
+void apply_kernel_operation_avx2_f32(float* state, const KernelOperation& operation, std::size_t group_begin,
+                                     std::size_t group_end) {
+    apply_kernel_operation_scalar_f32(state, operation, group_begin, group_end);
+}
+
+#endif
+
+}  // namespace synq::compiler
@@ -0,0 +1,174 @@
+// AVX-512F amplitude kernels for strides of at least four amplitudes. Lower
+// strides, where one 512-bit register would straddle amplitude pairs, use the
+// AVX2 kernels. The same raw-double restriction as the AVX2 unit applies.
+#include "statevector_kernels.h"
+
+#if defined(__AVX512F__) && defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+namespace synq::compiler {
+
+#if defined(__AVX512F__) && defined(__AVX2__) && defined(__FMA__)
+namespace {
+
+std::size_t insert_zero_bit(std::size_t value, std::size_t bit) {
+    const std::size_t low_mask = (std::size_t{1} << bit) - 1;
+    return ((value >> bit) << (bit + 1)) | (value & low_mask);
+}
+
+struct Coefficient {
+    __m512d real;
+    __m512d imag;
+};
+
+Coefficient broadcast(const double* matrix, std::size_t entry) {
+    return {_mm512_set1_pd(matrix[2 * entry]), _mm512_set1_pd(matrix[2 * entry + 1])};
+}
+
+__m512d multiply(const Coefficient& coefficient, __m512d value) {
+    return _mm512_fmaddsub_pd(coefficient.real, value,
+                              _mm512_mul_pd(coefficient.imag, _mm512_shuffle_pd(value, value, 0x55)));
+}
+
+__m512d load(const double* state, std::size_t basis) { return _mm512_loadu_pd(state + 2 * basis); }
+
+void store(double* state, std::size_t basis, __m512d value) { _mm512_storeu_pd(state + 2 * basis, value); }
+
+// Calls body(basis) for every four-group vector inside the contiguous runs of
+// [group_begin, group_end) and hands partial run tails to the scalar reference.
+template <typename IndexOf, typename Body>
+void sweep_runs(double* state, const KernelOperation& operation, std::size_t group_begin, std::size_t group_end,
+                std::size_t low_bit, IndexOf index_of, Body body) {
+    const std::size_t stride = std::size_t{1} << low_bit;
+    std::size_t group = group_begin;
+    while (group < group_end) {
+        const std::size_t remaining_in_run = stride - (group & (stride - 1));
+        const std::size_t run = group_end - group < remaining_in_run ? group_end - group : remaining_in_run;
+        const std::size_t basis = index_of(group);
+        std::size_t offset = 0;
+        for (; offset + 4 <= run; offset += 4) body(basis + offset);
+        if (offset < run) apply_kernel_operation_scalar(state, operation, group + offset, group + run);
+        group += run;
+    }
+}
+
+void apply_single(double* state, const KernelOperation& operation, std::size_t group_begin, std::size_t group_end) {
+    const double* matrix = operation.matrix;
+    const std::size_t qubit = operation.first;
+    const Coefficient a = broadcast(matrix, 0), b = broadcast(matrix, 1);
+    const Coefficient c = broadcast(matrix, 2), d = broadcast(matrix, 3);
+    const std::size_t stride = std::size_t{1} << qubit;
+    sweep_runs(state, operation, group_begin, group_end, qubit,
+               [qubit](std::size_t group) { return insert_zero_bit(group, qubit); },
+               [&](std::size_t basis) {
+                   const __m512d zero = load(state, basis);
+                   const __m512d one = load(state, basis + stride);
+                   store(state, basis, _mm512_add_pd(multiply(a, zero), multiply(b, one)));
+                   store(state, basis + stride, _mm512_add_pd(multiply(c, zero), multiply(d, one)));
+               });
+}
+
+void apply_diagonal(double* state, const KernelOperation& operation, std::size_t group_begin, std::size_t group_end) {
+    const double* matrix = operation.matrix;
+    const std::size_t qubit = operation.first;
+    const bool scale_zero = matrix[0] != 1.0 || matrix[1] != 0.0;
+    const bool scale_one = matrix[6] != 1.0 || matrix[7] != 0.0;
+    const Coefficient d0 = broadcast(matrix, 0), d1 = broadcast(matrix, 3);
+    const std::size_t stride = std::size_t{1} << qubit;
+    sweep_runs(state, operation, group_begin, group_end, qubit,
+               [qubit](std::size_t group) { return insert_zero_bit(group, qubit); },
+               [&](std::size_t basis) {
+                   if (scale_zero) store(state, basis, multiply(d0, load(state, basis)));
+                   if (scale_one) store(state, basis + stride, multiply(d1, load(state, basis + stride)));
+               });
+}
+
+void apply_pauli_x(double* state, const KernelOperation& operation, std::size_t group_begin, std::size_t group_end) {
+    const std::size_t qubit = operation.first;
+    const std::size_t stride = std::size_t{1} << qubit;
+    sweep_runs(state, operation, group_begin, group_end, qubit,
+               [qubit](std::size_t group) { return insert_zero_bit(group, qubit); },
+               [&](std::size_t basis) {
+                   const __m512d zero = load(state, basis);
+                   store(state, basis, load(state, basis + stride));
+                   store(state, basis + stride, zero);
+               });
+}
+
+void apply_pair(double* state, const KernelOperation& operation, std::size_t group_begin, std::size_t group_end) {
+    const double* matrix = operation.matrix;
+    const std::size_t low = operation.first;
+    const std::size_t high = operation.second;
+    const std::size_t low_mask = std::size_t{1} << low;
+    const std::size_t high_mask = std::size_t{1} << high;
+    Coefficient m[16];
+    for (std::size_t entry = 0; entry < 16; ++entry) m[entry] = broadcast(matrix, entry);
+    sweep_runs(state, operation, group_begin, group_end, low,
+               [low, high](std::size_t group) { return insert_zero_bit(insert_zero_bit(group, low), high); },
+               [&](std::size_t basis) {
+                   const std::size_t indices[4] = {basis, basis + low_mask, basis + high_mask,
+                                                   basis + low_mask + high_mask};
+                   const __m512d input[4] = {load(state, indices[0]), load(state, indices[1]),
+                                             load(state, indices[2]), load(state, indices[3])};
+                   for (std::size_t row = 0; row < 4; ++row) {
+                       const __m512d left = _mm512_add_pd(multiply(m[row * 4], input[0]), multiply(m[row * 4 + 1], input[1]));
+                       const __m512d right = _mm512_add_pd(multiply(m[row * 4 + 2], input[2]), multiply(m[row * 4 + 3], input[3]));
+                       store(state, indices[row], _mm512_add_pd(left, right));
+                   }
+               });
+}
+
+void apply_controlled_x(double* state, const KernelOperation& operation, std::size_t group_begin,
+                        std::size_t group_end) {
+    const std::size_t control_mask = std::size_t{1} << operation.first;
+    const std::size_t target_mask = std::size_t{1} << operation.second;
+    const std::size_t low = operation.first < operation.second ? operation.first : operation.second;
+    const std::size_t high = operation.first < operation.second ? operation.second : operation.first;
+    sweep_runs(state, operation, group_begin, group_end, low,
+               [=](std::size_t group) { return insert_zero_bit(insert_zero_bit(group, low), high) | control_mask; },
+               [&](std::size_t basis) {
+                   const __m512d unflipped = load(state, basis);
+                   store(state, basis, load(state, basis + target_mask));
+                   store(state, basis + target_mask, unflipped);
+               });
+}
+
+std::size_t lowest_operand(const KernelOperation& operation) {
+    if (operation.opcode == KernelOpcode::Pair || operation.opcode == KernelOpcode::ControlledX) {
+        return operation.first < operation.second ? operation.first : operation.second;
+    }
+    return operation.first;
+}
+
+}  // namespace
+
+bool statevector_avx512_kernels_compiled() { return true; }
+
+void apply_kernel_operation_avx512(double* state, const KernelOperation& operation, std::size_t group_begin,
+                                   std::size_t group_end) {
+    if (lowest_operand(operation) < 2) {
+        apply_kernel_operation_avx2(state, operation, group_begin, group_end);
+        return;
+    }
+    switch (operation.opcode) {
+        case KernelOpcode::Single: apply_single(state, operation, group_begin, group_end); return;
+        case KernelOpcode::Diagonal: apply_diagonal(state, operation, group_begin, group_end); return;
+        case KernelOpcode::PauliX: apply_pauli_x(state, operation, group_begin, group_end); return;
+        case KernelOpcode::Pair: apply_pair(state, operation, group_begin, group_end); return;
+        case KernelOpcode::ControlledX: apply_controlled_x(state, operation, group_begin, group_end); return;
+    }
+}
+
+#else
+
+bool statevector_avx512_kernels_compiled() { return false; }
+
+void apply_kernel_operation_avx512(double* state, const KernelOperation& operation, std::size_t group_begin,
+                                   std::size_t group_end) {
+    apply_kernel_operation_avx2(state, operation, group_begin, group_end);
+}
+
+#endif
+
+}  // namespace synq::compiler
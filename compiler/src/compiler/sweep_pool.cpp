@@ -0,0 +1,68 @@
+#include "sweep_pool.h"
+
+namespace synq::compiler {
+
+SweepPool::SweepPool(std::size_t threads) {
+    for (std::size_t index = 1; index < threads; ++index) workers_.emplace_back([this] { worker_loop(); });
+}
+
+SweepPool::~SweepPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_ready_.notify_all();
+    for (auto& worker : workers_) worker.join();
+}
+
+void SweepPool::run_erased(std::size_t chunk_count, const void* context, ChunkFunction function) {
+    if (workers_.empty() || chunk_count <= 1) {
+        for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) function(context, chunk);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        context_ = context;
+        function_ = function;
+        chunk_count_ = chunk_count;
+        next_chunk_.store(0, std::memory_order_relaxed);
+        active_workers_ = workers_.size();
+        ++generation_;
+    }
+    work_ready_.notify_all();
+    drain();
+    std::unique_lock<std::mutex> lock(mutex_);
+    work_done_.wait(lock, [this] { return active_workers_ == 0; });
+    context_ = nullptr;
+    function_ = nullptr;
+}
+
+void SweepPool::drain() {
+    for (;;) {
+        const std::size_t chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= chunk_count_) return;
+        function_(context_, chunk);
+    }
+}
+
+void SweepPool::worker_loop() {
+    std::size_t seen_generation = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_ready_.wait(lock, [&] { return stopping_ || generation_ != seen_generation; });
+            if (stopping_) return;
+            seen_generation = generation_;
+        }
+        drain();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --active_workers_;
+        }
+        work_done_.notify_one();
+    }
+}
+
+std::size_t sweep_chunk_count(std::size_t groups) { return (groups + kSweepChunkGroups - 1) / kSweepChunkGroups; }
+
+}  // namespace synq::compiler
@@ -0,0 +1,71 @@
+// Opt-in worker pool for bounded-simulator amplitude sweeps. Work is split
+// into fixed-size chunks whose boundaries never depend on the thread count, so
+// chunked reductions combine in the same order and produce bitwise-identical
+// results for every pool size.
+#ifndef SYNQ_COMPILER_SWEEP_POOL_H
+#define SYNQ_COMPILER_SWEEP_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace synq::compiler {
+
+// Amplitude groups per chunk: 16 Ki pairs span 512 KiB of double-precision
+// amplitudes, small enough for a per-core L2 slice.
+constexpr std::size_t kSweepChunkGroups = std::size_t{1} << 14;
+
+// Low qubits spanned by one cache block: 2^15 amplitudes, the footprint of one
+// single-qubit chunk. Operations on these qubits never pair amplitudes from
+// different blocks.
+constexpr std::size_t kSweepBlockQubits = 15;
+
+class SweepPool {
+public:
+    // A pool of one thread runs every chunk inline on the caller.
+    explicit SweepPool(std::size_t threads);
+    ~SweepPool();
+
+    SweepPool(const SweepPool&) = delete;
+    SweepPool& operator=(const SweepPool&) = delete;
+
+    std::size_t thread_count() const { return workers_.size() + 1; }
+
+    // Calls task(chunk) once for every chunk in [0, chunk_count) across the
+    // workers and the calling thread, returning after every chunk finished.
+    // The task is invoked through a plain function pointer, so dispatch never
+    // allocates.
+    template <typename Task>
+    void run(std::size_t chunk_count, const Task& task) {
+        run_erased(chunk_count, &task,
+                   [](const void* context, std::size_t chunk) { (*static_cast<const Task*>(context))(chunk); });
+    }
+
+private:
+    using ChunkFunction = void (*)(const void*, std::size_t);
+
+    void run_erased(std::size_t chunk_count, const void* context, ChunkFunction function);
+    void worker_loop();
+    void drain();
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable work_ready_;
+    std::condition_variable work_done_;
+    const void* context_ = nullptr;
+    ChunkFunction function_ = nullptr;
+    std::size_t chunk_count_ = 0;
+    std::atomic<std::size_t> next_chunk_{0};
+    std::size_t active_workers_ = 0;
+    std::size_t generation_ = 0;
+    bool stopping_ = false;
+};
+
+std::size_t sweep_chunk_count(std::size_t groups);
+
+}  // namespace synq::compiler
+
+#endif
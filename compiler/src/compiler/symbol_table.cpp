@@ -0,0 +1,20 @@
+#include "symbol_table.h"
+
+namespace synq::compiler {
+
+SymbolId SymbolTable::intern(const std::string& name) {
+    const auto found = ids_.find(name);
+    if (found != ids_.end()) return found->second;
+    const auto id = static_cast<SymbolId>(names_.size());
+    names_.push_back(name);
+    ids_.emplace(name, id);
+    return id;
+}
+
+std::optional<SymbolId> SymbolTable::find(const std::string& name) const {
+    const auto found = ids_.find(name);
+    if (found == ids_.end()) return std::nullopt;
+    return found->second;
+}
+
+}  // namespace synq::compiler
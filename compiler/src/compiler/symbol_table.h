@@ -0,0 +1,43 @@
+// Program-scoped register-name interning for Hybrid IR.
+// Lowering assigns each distinct qubit register name a dense SymbolId in first
+// use order, so resolution, simulation, and export compare and index integers
+// and only render the spelling when a diagnostic or emitted program needs it.
+#ifndef SYNQ_COMPILER_SYMBOL_TABLE_H
+#define SYNQ_COMPILER_SYMBOL_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace synq::compiler {
+
+using SymbolId = std::uint32_t;
+
+// Never assigned by a SymbolTable; stands for "no register" in id fields.
+constexpr SymbolId kNoSymbol = static_cast<SymbolId>(-1);
+
+class SymbolTable {
+public:
+    // Returns the existing id for `name`, or assigns the next dense id.
+    SymbolId intern(const std::string& name);
+
+    // Looks up `name` without interning it.
+    std::optional<SymbolId> find(const std::string& name) const;
+
+    // `id` must have been returned by this table.
+    const std::string& name(SymbolId id) const { return names_[id]; }
+
+    // Ids are 0 through size() - 1, so per-symbol tables can be plain vectors.
+    std::size_t size() const { return names_.size(); }
+
+private:
+    std::vector<std::string> names_;
+    std::unordered_map<std::string, SymbolId> ids_;
+};
+
+}  // namespace synq::compiler
+
+#endif
@@ -12,6 +12,8 @@
 #include <memory>
 #include <new>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "compiler/ast.h"
 #include "compiler/openqasm3_exporter.h"
@@ -46,11 +48,11 @@ synq_status return_error(synq_status status, const std::string& message, char**
 
 bool contains_parameterized_routine_node(const ProgramNode& program) {
     for (const ASTNode* statement : program.statements) {
-        const auto* callable = dynamic_cast<const CallableDeclarationNode*>(statement);
+        const auto* callable = node_cast<CallableDeclarationNode>(statement);
         if (callable != nullptr && (!callable->formals.empty() || callable->parameterized_body.has_value())) {
             return true;
         }
-        const auto* call = dynamic_cast<const CallableCallNode*>(statement);
+        const auto* call = node_cast<CallableCallNode>(statement);
         if (call != nullptr && !call->arguments.empty()) return true;
     }
     return false;
@@ -58,7 +60,7 @@ bool contains_parameterized_routine_node(const ProgramNode& program) {
 
 bool contains_measurement_feedback_node(const ProgramNode& program) {
     for (const ASTNode* statement : program.statements) {
-        const auto* measurement = dynamic_cast<const MeasurementNode*>(statement);
+        const auto* measurement = node_cast<MeasurementNode>(statement);
         if (measurement != nullptr && measurement->feedback_enabled && measurement->result_name.has_value()) {
             return true;
         }
@@ -68,16 +70,51 @@ bool contains_measurement_feedback_node(const ProgramNode& program) {
 
 bool contains_classical_callable_runtime_node(const ProgramNode& program) {
     for (const ASTNode* statement : program.statements) {
-        const auto* callable = dynamic_cast<const CallableDeclarationNode*>(statement);
+        const auto* callable = node_cast<CallableDeclarationNode>(statement);
         if (callable != nullptr && (callable->classical_body.has_value() ||
                                     callable->binary_classical_body.has_value())) return true;
-        const auto* declaration = dynamic_cast<const DeclarationNode*>(statement);
+        const auto* declaration = node_cast<DeclarationNode>(statement);
         if (declaration != nullptr && (declaration->classical_callable_invocation.has_value() ||
                                        declaration->binary_classical_callable_invocation.has_value())) return true;
     }
     return false;
 }
 
+// The Alpha nodes the C ABI keeps out of export, as the reason it gives; null
+// when the program has none.
+const char* unsupported_export_reason(const ProgramNode& program) {
+    if (contains_classical_callable_runtime_node(program)) {
+        return "experimental C ABI explicitly rejects Alpha classical callable runtime nodes; use the compiler CLI --eval-runtime path instead";
+    }
+    if (contains_measurement_feedback_node(program)) {
+        return "experimental C ABI explicitly rejects Alpha measurement-feedback nodes; use the compiler CLI strict Hybrid OpenQASM or bounded local simulation paths instead";
+    }
+    if (contains_parameterized_routine_node(program)) {
+        return "experimental C ABI explicitly rejects Alpha parameterized quantum routine nodes; use the compiler CLI strict Hybrid OpenQASM path instead";
+    }
+    return nullptr;
+}
+
+std::string join_diagnostics(const std::vector<std::string>& diagnostics) {
+    std::string joined;
+    for (std::size_t index = 0; index < diagnostics.size(); ++index) {
+        if (index != 0) joined += '\n';
+        joined += diagnostics[index];
+    }
+    return joined;
+}
+
+class WriterOpenQasm3Sink final : public synq::compiler::OpenQasm3Sink {
+public:
+    WriterOpenQasm3Sink(synq_write_fn write, void* user_data) : write_(write), user_data_(user_data) {}
+
+    bool write(std::string_view text) override { return write_(user_data_, text.data(), text.size()) == 0; }
+
+private:
+    synq_write_fn write_;
+    void* user_data_;
+};
+
 }  // namespace
 
 extern "C" unsigned int synq_abi_version(void) {
@@ -171,29 +208,12 @@ extern "C" synq_status synq_export_openqasm3(const synq_program* program,
     }
 
     try {
-        if (contains_classical_callable_runtime_node(*program->program)) {
-            return return_error(SYNQ_STATUS_EXPORT_ERROR,
-                                "experimental C ABI explicitly rejects Alpha classical callable runtime nodes; use the compiler CLI --eval-runtime path instead",
-                                out_diagnostic);
-        }
-        if (contains_measurement_feedback_node(*program->program)) {
-            return return_error(SYNQ_STATUS_EXPORT_ERROR,
-                                "experimental C ABI explicitly rejects Alpha measurement-feedback nodes; use the compiler CLI strict Hybrid OpenQASM or bounded local simulation paths instead",
-                                out_diagnostic);
-        }
-        if (contains_parameterized_routine_node(*program->program)) {
-            return return_error(SYNQ_STATUS_EXPORT_ERROR,
-                                "experimental C ABI explicitly rejects Alpha parameterized quantum routine nodes; use the compiler CLI strict Hybrid OpenQASM path instead",
-                                out_diagnostic);
+        if (const char* reason = unsupported_export_reason(*program->program)) {
+            return return_error(SYNQ_STATUS_EXPORT_ERROR, reason, out_diagnostic);
         }
         const synq::compiler::OpenQasm3ExportResult result = synq::compiler::export_openqasm3(*program->program);
         if (!result.ok()) {
-            std::string diagnostic;
-            for (std::size_t index = 0; index < result.diagnostics.size(); ++index) {
-                if (index != 0) diagnostic += '\n';
-                diagnostic += result.diagnostics[index];
-            }
-            return return_error(SYNQ_STATUS_EXPORT_ERROR, diagnostic, out_diagnostic);
+            return return_error(SYNQ_STATUS_EXPORT_ERROR, join_diagnostics(result.diagnostics), out_diagnostic);
         }
 
         *out_openqasm3 = copy_utf8_string(result.program);
@@ -210,6 +230,43 @@ extern "C" synq_status synq_export_openqasm3(const synq_program* program,
     }
 }
 
+extern "C" synq_status synq_export_openqasm3_to_writer(const synq_program* program,
+                                                        synq_write_fn write,
+                                                        void* user_data,
+                                                        char** out_diagnostic) {
+    clear_output(out_diagnostic);
+    if (write == nullptr) {
+        return return_error(SYNQ_STATUS_INVALID_ARGUMENT, "write must not be NULL", out_diagnostic);
+    }
+    if (program == nullptr || program->program == nullptr) {
+        return return_error(SYNQ_STATUS_INVALID_ARGUMENT, "program must not be NULL", out_diagnostic);
+    }
+
+    try {
+        if (const char* reason = unsupported_export_reason(*program->program)) {
+            return return_error(SYNQ_STATUS_EXPORT_ERROR, reason, out_diagnostic);
+        }
+        WriterOpenQasm3Sink sink(write, user_data);
+        const synq::compiler::OpenQasm3StreamResult result = synq::compiler::export_openqasm3(*program->program, sink);
+        if (result.sink_failed) {
+            return return_error(SYNQ_STATUS_EXPORT_ERROR,
+                                "the write callback stopped the OpenQASM 3 export after " +
+                                    std::to_string(result.bytes_written) + " bytes",
+                                out_diagnostic);
+        }
+        if (!result.ok()) {
+            return return_error(SYNQ_STATUS_EXPORT_ERROR, join_diagnostics(result.diagnostics), out_diagnostic);
+        }
+        return SYNQ_STATUS_OK;
+    } catch (const std::bad_alloc&) {
+        return return_error(SYNQ_STATUS_INTERNAL_ERROR, "SynQ could not allocate exporter state", out_diagnostic);
+    } catch (const std::exception&) {
+        return return_error(SYNQ_STATUS_INTERNAL_ERROR, "SynQ exporter raised an internal exception", out_diagnostic);
+    } catch (...) {
+        return return_error(SYNQ_STATUS_INTERNAL_ERROR, "SynQ exporter raised an unknown internal exception", out_diagnostic);
+    }
+}
+
 extern "C" void synq_string_free(char* value) {
     std::free(value);
 }
@@ -53,5 +53,58 @@ ParamMap parameterShiftGradient(
     return gradient;
 }
 
+ParamMap parameterShiftGradient(
+    const compiler::ResolvedHybridProgram& program,
+    const std::vector<std::string>& columns,
+    const ParamMap& params,
+    const SweepObservableFunction& observable,
+    const compiler::BoundedSimulationOptions& options,
+    std::vector<compiler::Diagnostic>& diagnostics,
+    double shift
+) {
+    std::vector<const double*> column_values;
+    column_values.reserve(columns.size());
+    for (const std::string& name : columns) {
+        const auto found = params.find(name);
+        if (found == params.end()) {
+            diagnostics.push_back({"SYNQ-SIM008", compiler::DiagnosticSeverity::Error, {},
+                                   "gradient column names unknown parameter `" + name + "`",
+                                   "name a parameter of the gradient for every rotation gate"});
+            return {};
+        }
+        column_values.push_back(&found->second);
+    }
+
+    // Rows 2k and 2k + 1 shift every column of the k-th parameter forward and
+    // backward; all other columns keep their current values.
+    compiler::AngleBindings bindings;
+    bindings.binding_count = 2 * params.size();
+    bindings.parameter_count = columns.size();
+    bindings.angles.reserve(bindings.binding_count * bindings.parameter_count);
+    for (const auto& [param, value] : params) {
+        for (const double direction : {shift, -shift}) {
+            for (const double* column : column_values) {
+                bindings.angles.push_back(column == &value ? value + direction : *column);
+            }
+        }
+    }
+
+    auto result = compiler::simulate_parameter_sweep(program, bindings, options);
+    if (!result.ok()) {
+        diagnostics.insert(diagnostics.end(), result.diagnostics.begin(), result.diagnostics.end());
+        return {};
+    }
+
+    ParamMap gradient;
+    std::size_t binding = 0;
+    for (const auto& [param, value] : params) {
+        (void)value;
+        gradient[param] = (observable(*result.sweep, binding) - observable(*result.sweep, binding + 1)) / (2.0 * shift);
+        binding += 2;
+    }
+
+    return gradient;
+}
+
 } // namespace quantum
 } // namespace synq
\ No newline at end of file
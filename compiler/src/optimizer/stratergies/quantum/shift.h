@@ -25,12 +25,17 @@
 #include <map>
 #include <string>
 #include <functional>
+#include <vector>
+
+#include "compiler/bounded_simulator.h"
 
 namespace synq {
 namespace quantum {
 
 using ParamMap = std::map<std::string, double>;
 using ObservableFunction = std::function<double(const ParamMap&)>;
+// Reads one observable value from binding `binding` of a parameter sweep.
+using SweepObservableFunction = std::function<double(const compiler::ParameterSweep&, std::size_t binding)>;
 
 // Estimate gradients for parameters using the parameter-shift rule
 ParamMap parameterShiftGradient(
@@ -39,5 +44,21 @@ ParamMap parameterShiftGradient(
     double shift = 0.1
 );
 
+// Same estimate for a program whose rotation angles are the parameters.
+// `columns` names the parameter bound to each rx, ry, rz, or p gate in source
+// order, so one parameter may drive several gates. The forward and backward
+// points of every parameter, in map order, are the rows of one angle-binding
+// matrix evaluated by a single simulate_parameter_sweep call. A rejected sweep,
+// or a column naming no parameter, appends diagnostics and returns an empty map.
+ParamMap parameterShiftGradient(
+    const compiler::ResolvedHybridProgram& program,
+    const std::vector<std::string>& columns,
+    const ParamMap& params,
+    const SweepObservableFunction& observable,
+    const compiler::BoundedSimulationOptions& options,
+    std::vector<compiler::Diagnostic>& diagnostics,
+    double shift = 0.1
+);
+
 } // namespace quantum
 } // namespace synq
\ No newline at end of file
@@ -6,16 +6,21 @@
 #include <optional>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <variant>
 #include <vector>
 
+#include "compiler/ast.h"
 #include "compiler/bounded_evaluator.h"
 #include "compiler/hybrid_ir.h"
 #include "compiler/name_resolution.h"
+#include "compiler/parse_session.h"
 #include "compiler/parser.h"
 
 namespace {
 
 constexpr std::size_t kMaxCorpusBytes = 4U * 1024U;
+constexpr std::size_t kDifferentialMutants = 256U;
 constexpr std::uint64_t kFnvOffsetBasis = 1469598103934665603ULL;
 constexpr std::uint64_t kFnvPrime = 1099511628211ULL;
 
@@ -39,6 +44,7 @@ struct ReplayOutcome {
 struct ReplaySelector {
     std::optional<std::string> case_name;
     std::optional<std::uint32_t> seed;
+    bool record_parser_digests = false;
 };
 
 bool require(bool condition, const std::string& message) {
@@ -172,6 +178,330 @@ void append_runtime_result(std::ostringstream& output, const synq::compiler::Bou
     append_diagnostics(output, result.diagnostics);
 }
 
+void append_text(std::ostringstream& output, const std::string& text) { output << text.size() << ':' << text << ';'; }
+
+void append_optional_text(std::ostringstream& output, const std::optional<std::string>& text) {
+    if (text.has_value()) {
+        append_text(output, *text);
+    } else {
+        output << "-;";
+    }
+}
+
+void append_span(std::ostringstream& output, std::size_t line, const synq::compiler::SourceSpan& span) {
+    output << '@' << line << ':' << span.line << ':' << span.column_start << ':' << span.column_end << ';';
+}
+
+void append_boolean_expression(std::ostringstream& output, const ClassicalBooleanExpression& expression) {
+    output << "bool(" << static_cast<int>(expression.kind) << ':' << expression.boolean_value << ':';
+    append_text(output, expression.source_text);
+    append_span(output, 0, expression.span);
+    for (const ClassicalBooleanExpression& operand : expression.operands) append_boolean_expression(output, operand);
+    output << ')';
+}
+
+// Field-by-field dump of one parsed statement, so the parser differential
+// compares the whole AST rather than only whether later stages accept it.
+void append_statement(std::ostringstream& output, ASTNode* node) {
+    if (auto* instruction = dynamic_cast<InstructionNode*>(node)) {
+        output << "instruction:";
+        append_text(output, instruction->op);
+        for (const std::string& argument : instruction->args) append_text(output, argument);
+        append_span(output, instruction->line, instruction->span);
+    } else if (auto* gate = dynamic_cast<QuantumGateNode*>(node)) {
+        output << "gate:" << static_cast<int>(gate->kind) << ':';
+        append_text(output, gate->source_name);
+        append_optional_text(output, gate->literal_angle);
+        for (std::size_t index = 0; index < gate->qubit_indices.size(); ++index) {
+            append_text(output, gate->qubit_register_names[index]);
+            output << gate->qubit_indices[index] << ';';
+        }
+        append_span(output, gate->line, gate->span);
+    } else if (auto* measurement = dynamic_cast<MeasurementNode*>(node)) {
+        output << "measure:";
+        append_text(output, measurement->qubit_register_name);
+        output << measurement->qubit_index << ':' << measurement->feedback_enabled << ':';
+        append_optional_text(output, measurement->result_name);
+        append_span(output, measurement->line, measurement->span);
+    } else if (auto* qubits = dynamic_cast<QubitDeclarationNode*>(node)) {
+        output << "qubit:";
+        append_text(output, qubits->name);
+        output << qubits->qubit_count << ';';
+        append_span(output, qubits->line, qubits->span);
+    } else if (auto* callable = dynamic_cast<CallableDeclarationNode*>(node)) {
+        output << "callable:" << static_cast<int>(callable->kind) << ':';
+        append_text(output, callable->name);
+        if (callable->body != nullptr) append_statement(output, callable->body);
+        for (const RoutineFormal& formal : callable->formals) {
+            output << static_cast<int>(formal.kind) << ':';
+            append_text(output, formal.name);
+        }
+        if (callable->parameterized_body.has_value()) {
+            const ParameterizedRoutineBody& body = *callable->parameterized_body;
+            output << "routine:" << static_cast<int>(body.kind) << ':';
+            append_text(output, body.source_name);
+            append_optional_text(output, body.angle_formal);
+            for (const std::string& qubit : body.qubit_formals) append_text(output, qubit);
+            append_span(output, 0, body.span);
+        }
+        if (callable->classical_body.has_value()) {
+            const ClassicalCallableBody& body = *callable->classical_body;
+            output << "unary:" << static_cast<int>(body.parameter_type) << ':' << static_cast<int>(body.expression_kind)
+                   << ':';
+            append_text(output, body.parameter_name);
+            append_text(output, body.source_expression);
+            append_span(output, 0, body.span);
+        }
+        if (callable->binary_classical_body.has_value()) {
+            const BinaryClassicalCallableBody& body = *callable->binary_classical_body;
+            output << "binary:" << static_cast<int>(body.parameter_type) << ':' << static_cast<int>(body.expression_kind)
+                   << ':';
+            append_text(output, body.first_parameter_name);
+            append_text(output, body.second_parameter_name);
+            append_text(output, body.source_expression);
+            append_span(output, 0, body.span);
+        }
+        append_span(output, callable->line, callable->span);
+    } else if (auto* call = dynamic_cast<CallableCallNode*>(node)) {
+        output << "call:";
+        append_text(output, call->name);
+        for (const std::string& argument : call->arguments) append_text(output, argument);
+        append_span(output, call->line, call->span);
+    } else if (auto* control = dynamic_cast<ClassicalControlNode*>(node)) {
+        const ClassicalCondition& condition = control->condition;
+        output << "control:" << static_cast<int>(control->kind) << ':' << control->feedback_enabled << ':'
+               << static_cast<int>(condition.kind) << ':' << condition.boolean_value << ':';
+        append_text(output, condition.source_text);
+        append_span(output, 0, condition.span);
+        append_boolean_expression(output, condition.expression);
+        append_statement(output, control->body);
+        append_span(output, control->line, control->span);
+    } else if (auto* declaration = dynamic_cast<DeclarationNode*>(node)) {
+        output << "let:" << static_cast<int>(declaration->literal_kind) << ':';
+        append_text(output, declaration->name);
+        append_text(output, declaration->value);
+        if (declaration->classical_callable_invocation.has_value()) {
+            const ClassicalCallableInvocation& invocation = *declaration->classical_callable_invocation;
+            output << "invoke:" << static_cast<int>(invocation.actual_kind) << ':';
+            append_text(output, invocation.function_name);
+            append_text(output, invocation.actual_source);
+            append_span(output, 0, invocation.span);
+        }
+        if (declaration->binary_classical_callable_invocation.has_value()) {
+            const BinaryClassicalCallableInvocation& invocation = *declaration->binary_classical_callable_invocation;
+            output << "invoke2:" << static_cast<int>(invocation.first_actual_kind) << ':'
+                   << static_cast<int>(invocation.second_actual_kind) << ':';
+            append_text(output, invocation.function_name);
+            append_text(output, invocation.first_actual_source);
+            append_text(output, invocation.second_actual_source);
+            append_span(output, 0, invocation.span);
+        }
+        append_span(output, declaration->line, declaration->span);
+    } else if (auto* mutable_declaration = dynamic_cast<MutableDeclarationNode*>(node)) {
+        output << "var:" << static_cast<int>(mutable_declaration->literal_kind) << ':';
+        append_text(output, mutable_declaration->name);
+        append_text(output, mutable_declaration->value);
+        append_span(output, mutable_declaration->line, mutable_declaration->span);
+    } else if (auto* assignment = dynamic_cast<AssignmentNode*>(node)) {
+        output << "set:" << static_cast<int>(assignment->literal_kind) << ':';
+        append_text(output, assignment->target);
+        append_text(output, assignment->value);
+        append_span(output, assignment->line, assignment->span);
+    } else {
+        output << "unknown;";
+    }
+    output << '\n';
+}
+
+void append_hybrid_gate(std::ostringstream& output, const synq::compiler::HybridQuantumGate& gate,
+                        const synq::compiler::SymbolTable& symbols) {
+    output << "gate:" << static_cast<int>(gate.kind) << ':';
+    append_text(output, gate.source_name);
+    append_optional_text(output, gate.literal_angle);
+    for (std::size_t index = 0; index < gate.qubit_indices.size(); ++index) {
+        append_text(output, index < gate.qubit_registers.size() ? symbols.name(gate.qubit_registers[index]) : "?");
+        output << gate.qubit_indices[index] << ';';
+    }
+    append_span(output, 0, gate.span);
+}
+
+void append_hybrid_measurement(std::ostringstream& output, const synq::compiler::HybridMeasurement& measurement,
+                               const synq::compiler::SymbolTable& symbols) {
+    output << "measure:";
+    append_text(output, symbols.name(measurement.qubit_register));
+    output << measurement.qubit_index << ':' << measurement.feedback_enabled << ':';
+    append_optional_text(output, measurement.result_name);
+    append_span(output, 0, measurement.span);
+}
+
+// Field dump of a Hybrid program with register ids rendered by name, so the
+// front-end differential compares spellings rather than id assignment order.
+std::string hybrid_transcript(const synq::compiler::HybridProgram& program) {
+    std::ostringstream output;
+    for (const synq::compiler::HybridNode& node : program.nodes) {
+        output << node.index() << '|';
+        if (const auto* declaration = std::get_if<synq::compiler::HybridDeclaration>(&node)) {
+            output << static_cast<int>(declaration->literal_kind) << ':'
+                   << static_cast<int>(declaration->initializer.kind) << ':'
+                   << declaration->classical_callable_invocation.has_value() << ':'
+                   << declaration->binary_classical_callable_invocation.has_value() << ':';
+            append_text(output, declaration->name);
+            append_text(output, declaration->source_value);
+            append_span(output, 0, declaration->span);
+        } else if (const auto* mutable_declaration = std::get_if<synq::compiler::HybridMutableDeclaration>(&node)) {
+            output << static_cast<int>(mutable_declaration->literal_kind) << ':';
+            append_text(output, mutable_declaration->name);
+            append_text(output, mutable_declaration->source_value);
+            append_span(output, 0, mutable_declaration->span);
+        } else if (const auto* assignment = std::get_if<synq::compiler::HybridAssignment>(&node)) {
+            output << static_cast<int>(assignment->literal_kind) << ':';
+            append_text(output, assignment->target_name);
+            append_text(output, assignment->source_value);
+            append_span(output, 0, assignment->span);
+        } else if (const auto* qubits = std::get_if<synq::compiler::HybridQubitDeclaration>(&node)) {
+            append_text(output, program.symbols.name(qubits->name));
+            output << qubits->qubit_count << ';';
+            append_span(output, 0, qubits->span);
+        } else if (const auto* callable = std::get_if<synq::compiler::HybridCallableDeclaration>(&node)) {
+            output << static_cast<int>(callable->kind) << ':' << callable->formals.size() << ':'
+                   << callable->parameterized_body.has_value() << ':' << callable->classical_body.has_value() << ':'
+                   << callable->binary_classical_body.has_value() << ':';
+            append_text(output, callable->name);
+            if (callable->body.has_value()) append_hybrid_gate(output, *callable->body, program.symbols);
+            append_span(output, 0, callable->span);
+        } else if (const auto* call = std::get_if<synq::compiler::HybridCallableCall>(&node)) {
+            append_text(output, call->name);
+            for (const std::string& argument : call->arguments) append_text(output, argument);
+            append_span(output, 0, call->span);
+        } else if (const auto* gate = std::get_if<synq::compiler::HybridQuantumGate>(&node)) {
+            append_hybrid_gate(output, *gate, program.symbols);
+        } else if (const auto* measurement = std::get_if<synq::compiler::HybridMeasurement>(&node)) {
+            append_hybrid_measurement(output, *measurement, program.symbols);
+        } else if (const auto* control = std::get_if<synq::compiler::HybridControlFlow>(&node)) {
+            output << static_cast<int>(control->kind) << ':' << static_cast<int>(control->condition.kind) << ':'
+                   << control->feedback_enabled << ':';
+            append_text(output, control->condition.source_text);
+            append_boolean_expression(output, control->condition.expression);
+            if (const auto* body = std::get_if<synq::compiler::HybridQuantumGate>(&control->body)) {
+                append_hybrid_gate(output, *body, program.symbols);
+            } else {
+                append_hybrid_measurement(output, std::get<synq::compiler::HybridMeasurement>(control->body),
+                                          program.symbols);
+            }
+            append_span(output, 0, control->span);
+        }
+        output << '\n';
+    }
+    return output.str();
+}
+
+// Runs the AST front end and the single-pass Hybrid front end over `source`
+// and requires the same accepted program, or a matching first error: the
+// single-pass parser may report a lowering error that precedes a later parse
+// error the AST path reports first.
+bool front_ends_agree(const std::string& source, std::string& mismatch) {
+    Parser parser;
+    const auto direct = parser.parseSourceToHybridIR(source);
+    const auto parsed = parser.parseSourceWithDiagnostics(source);
+    if (!parsed.ok()) {
+        if (direct.ok()) {
+            mismatch = "single-pass front end accepted a source the AST parser rejects";
+            return false;
+        }
+        std::ostringstream expected;
+        std::ostringstream actual;
+        append_diagnostics(expected, parsed.diagnostics);
+        append_diagnostics(actual, direct.diagnostics);
+        if (expected.str() != actual.str()) {
+            mismatch = "parse diagnostics differ: " + expected.str() + " vs " + actual.str();
+            return false;
+        }
+        return true;
+    }
+    const auto lowered = synq::compiler::lower_to_hybrid_ir(*parsed.program);
+    std::ostringstream expected;
+    std::ostringstream actual;
+    expected << lowered.ok() << ':';
+    actual << direct.ok() << ':';
+    append_diagnostics(expected, lowered.diagnostics);
+    append_diagnostics(actual, direct.diagnostics);
+    if (lowered.ok()) expected << hybrid_transcript(*lowered.program);
+    if (direct.ok()) actual << hybrid_transcript(*direct.program);
+    if (expected.str() != actual.str()) {
+        mismatch = "Hybrid programs differ:\n" + expected.str() + "\nvs\n" + actual.str();
+        return false;
+    }
+    return true;
+}
+
+// Parser-only transcript: diagnostics with their messages, then the full AST.
+std::string parse_transcript(bool ok, const std::vector<synq::compiler::Diagnostic>& diagnostics,
+                             const ProgramNode* program) {
+    std::ostringstream transcript;
+    transcript << (ok ? "ok:" : "error:");
+    append_diagnostics(transcript, diagnostics);
+    for (const synq::compiler::Diagnostic& diagnostic : diagnostics) {
+        append_text(transcript, diagnostic.message);
+        append_text(transcript, diagnostic.help);
+    }
+    if (program != nullptr) {
+        for (ASTNode* statement : program->statements) append_statement(transcript, statement);
+    }
+    return transcript.str();
+}
+
+std::string parse_transcript(const std::string& source) {
+    Parser parser;
+    const auto parsed = parser.parseSourceWithDiagnostics(source);
+    return parse_transcript(parsed.ok(), parsed.diagnostics, parsed.program.get());
+}
+
+// The single edit that turns `from` into `to`: everything between their
+// common prefix and common suffix, as zero-based line/column positions.
+synq::compiler::TextEdit minimal_edit(const std::string& from, const std::string& to) {
+    std::size_t prefix = 0;
+    while (prefix < from.size() && prefix < to.size() && from[prefix] == to[prefix]) ++prefix;
+    std::size_t suffix = 0;
+    while (suffix < from.size() - prefix && suffix < to.size() - prefix &&
+           from[from.size() - 1 - suffix] == to[to.size() - 1 - suffix]) {
+        ++suffix;
+    }
+    const auto position = [&from](std::size_t offset) {
+        synq::compiler::TextPosition result;
+        for (std::size_t index = 0; index < offset; ++index) {
+            if (from[index] == '\n') {
+                ++result.line;
+                result.column = 0;
+            } else {
+                ++result.column;
+            }
+        }
+        return result;
+    };
+    return {position(prefix), position(from.size() - suffix), to.substr(prefix, to.size() - prefix - suffix)};
+}
+
+// Applies `edit` to `session` and requires the same transcript as a full
+// parse of the edited text.
+bool session_matches(synq::compiler::ParseSession& session, const synq::compiler::TextEdit& edit,
+                     const std::string& expected_text, std::string& mismatch) {
+    if (!session.apply_edit(edit)) {
+        mismatch = "edit was rejected";
+        return false;
+    }
+    if (session.text() != expected_text) {
+        mismatch = "edited text differs";
+        return false;
+    }
+    const std::string expected = parse_transcript(expected_text);
+    const std::string actual = parse_transcript(session.ok(), session.diagnostics(), session.program());
+    if (expected != actual) {
+        mismatch = "incremental parse differs:\n" + expected + "\nvs\n" + actual;
+        return false;
+    }
+    return true;
+}
+
 ReplayOutcome replay_pipeline(const std::string& source) {
     ReplayOutcome outcome;
     std::ostringstream transcript;
@@ -221,9 +551,7 @@ ReplayOutcome replay_pipeline(const std::string& source) {
     return outcome;
 }
 
-std::uint64_t digest(const ReplayOutcome& outcome) {
-    std::uint64_t hash = kFnvOffsetBasis;
-    const std::string payload = outcome.stage + ':' + (outcome.accepted ? "accepted:" : "rejected:") + outcome.transcript;
+std::uint64_t fnv1a(std::uint64_t hash, const std::string& payload) {
     for (const unsigned char byte : payload) {
         hash ^= byte;
         hash *= kFnvPrime;
@@ -231,6 +559,11 @@ std::uint64_t digest(const ReplayOutcome& outcome) {
     return hash;
 }
 
+std::uint64_t digest(const ReplayOutcome& outcome) {
+    return fnv1a(kFnvOffsetBasis,
+                 outcome.stage + ':' + (outcome.accepted ? "accepted:" : "rejected:") + outcome.transcript);
+}
+
 std::string hex_digest(std::uint64_t value) {
     std::ostringstream output;
     output << "0x" << std::hex << std::setfill('0') << std::setw(16) << value;
@@ -266,6 +599,8 @@ bool parse_selector(int argc, char** argv, ReplaySelector& selector) {
             std::uint32_t seed = 0;
             if (!require(parse_seed(argv[++index], seed), "--seed parses as an exact uint32 value")) return false;
             selector.seed = seed;
+        } else if (argument == "--record-parser-digests") {
+            selector.record_parser_digests = true;
         } else {
             return require(false, "unknown replay argument: " + argument);
         }
@@ -314,10 +649,158 @@ bool replay_case(const std::filesystem::path& corpus_directory, const std::strin
     return true;
 }
 
+// The kDifferentialMutants sources derived from `source`, with one to four
+// stacked mutations each, in a fixed order.
+std::vector<std::string> differential_mutants(const std::string& source) {
+    std::vector<std::string> mutants;
+    mutants.reserve(kDifferentialMutants);
+    std::uint32_t state = 0x85ebca6bU;
+    for (std::size_t mutant = 0; mutant < kDifferentialMutants; ++mutant) {
+        std::string mutated = source;
+        const std::size_t depth = 1U + mutant % 4U;
+        for (std::size_t step = 0; step < depth; ++step) mutated = mutate_source(mutated, next_random(state));
+        mutants.push_back(std::move(mutated));
+    }
+    return mutants;
+}
+
+// Parser differential: the base source plus its differential mutants. Returns
+// "<base digest> <mutant digest>", where the mutant digest folds every
+// mutant's parse transcript in order.
+std::string parser_digest_line(const std::string& source) {
+    const std::uint64_t base = fnv1a(kFnvOffsetBasis, parse_transcript(source));
+    std::uint64_t mutants = kFnvOffsetBasis;
+    for (const std::string& mutated : differential_mutants(source)) mutants = fnv1a(mutants, parse_transcript(mutated));
+    return hex_digest(base) + " " + hex_digest(mutants);
+}
+
+// Front-end differential over every corpus entry and its mutants.
+bool check_front_ends(const std::filesystem::path& corpus_directory, const std::vector<std::string>& entries) {
+    for (const std::string& entry : entries) {
+        const std::string source = read_file(corpus_directory / entry);
+        std::vector<std::string> inputs = differential_mutants(source);
+        inputs.insert(inputs.begin(), source);
+        for (std::size_t index = 0; index < inputs.size(); ++index) {
+            std::string mismatch;
+            if (!require(front_ends_agree(inputs[index], mismatch),
+                         "front-end differential for " + entry + " input " + std::to_string(index) + ": " + mismatch)) {
+                return false;
+            }
+        }
+    }
+    std::cout << "PASS front-end differential cases=" << entries.size() << " mutants=" << kDifferentialMutants << "\n";
+    return true;
+}
+
+// Incremental differential: one session per corpus entry is edited through
+// each of its mutants in turn, with a line inserted above and removed again
+// after every step so later statements move, and must always match a full
+// parse of its text.
+bool check_incremental_sessions(const std::filesystem::path& corpus_directory, const std::vector<std::string>& entries) {
+    for (const std::string& entry : entries) {
+        const std::string source = read_file(corpus_directory / entry);
+        synq::compiler::ParseSession session;
+        session.open(source);
+        std::string current = source;
+        std::vector<std::string> targets = differential_mutants(source);
+        targets.push_back(source);
+        for (std::size_t index = 0; index < targets.size(); ++index) {
+            const std::string& target = targets[index];
+            const std::string shifted = "// moved\n" + target;
+            std::string mismatch;
+            const bool matches = session_matches(session, minimal_edit(current, target), target, mismatch) &&
+                                 session_matches(session, {{0, 0}, {0, 0}, "// moved\n"}, shifted, mismatch) &&
+                                 session_matches(session, {{0, 0}, {1, 0}, ""}, target, mismatch);
+            if (!require(matches, "incremental differential for " + entry + " target " + std::to_string(index) + ": " + mismatch)) {
+                return false;
+            }
+            current = target;
+        }
+    }
+    std::cout << "PASS incremental differential cases=" << entries.size() << " mutants=" << kDifferentialMutants << "\n";
+    return true;
+}
+
+// Runtime engine differential: every corpus entry or mutant that resolves is
+// evaluated by the bytecode runtime with memoized calls and by the reference
+// tree walker without them, across a sweep of operation and depth limits, and
+// both must report the same bindings and diagnostics.
+// Every limit up to the corpus programs' own operation counts, so a limit
+// falls on each of their operations, then the default.
+constexpr std::size_t kRuntimeOperationLimits[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 128};
+
+bool check_runtime_engines(const std::filesystem::path& corpus_directory, const std::vector<std::string>& entries) {
+    std::size_t programs = 0;
+    for (const std::string& entry : entries) {
+        const std::string source = read_file(corpus_directory / entry);
+        std::vector<std::string> inputs = differential_mutants(source);
+        inputs.insert(inputs.begin(), source);
+        for (std::size_t index = 0; index < inputs.size(); ++index) {
+            Parser parser;
+            const auto parsed = parser.parseSourceWithDiagnostics(inputs[index]);
+            if (!parsed.ok()) continue;
+            const auto lowered = synq::compiler::lower_to_hybrid_ir(*parsed.program);
+            if (!lowered.ok()) continue;
+            const auto resolved = synq::compiler::resolve_hybrid_names(*lowered.program);
+            if (!resolved.ok()) continue;
+            ++programs;
+            for (const std::size_t max_operations : kRuntimeOperationLimits) {
+                for (const std::size_t max_depth : {0U, 1U, 16U}) {
+                    synq::compiler::BoundedRuntimeEvaluationOptions options;
+                    options.allow_experimental_runtime_evaluation = true;
+                    options.max_operations = max_operations;
+                    options.max_expression_depth = max_depth;
+                    std::ostringstream bytecode;
+                    append_runtime_result(bytecode, synq::compiler::evaluate_bounded_runtime(*resolved.program, options));
+                    options.force_tree_walk = true;
+                    options.memoize_invocations = false;
+                    std::ostringstream walked;
+                    append_runtime_result(walked, synq::compiler::evaluate_bounded_runtime(*resolved.program, options));
+                    if (!require(bytecode.str() == walked.str(),
+                                 "runtime engine differential for " + entry + " input " + std::to_string(index) +
+                                     " operations=" + std::to_string(max_operations) + " depth=" +
+                                     std::to_string(max_depth) + ":\n" + bytecode.str() + "\nvs\n" + walked.str())) {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    std::cout << "PASS runtime engine differential cases=" << entries.size() << " programs=" << programs << "\n";
+    return true;
+}
+
+// Compares every corpus entry against parser_digests.txt, recorded from the
+// reference parser. A mismatch means the parser's AST or diagnostics changed.
+bool check_parser_digests(const std::filesystem::path& corpus_directory, const std::vector<std::string>& entries) {
+    std::ifstream expected_file(corpus_directory / "parser_digests.txt");
+    if (!require(static_cast<bool>(expected_file), "opens parser differential digests")) return false;
+    std::vector<std::pair<std::string, std::string>> expected;
+    std::string line;
+    while (std::getline(expected_file, line)) {
+        const std::string entry = trim(line);
+        if (entry.empty() || entry.front() == '#') continue;
+        const std::size_t space = entry.find(' ');
+        if (!require(space != std::string::npos, "parser digest line names a case: " + entry)) return false;
+        expected.emplace_back(entry.substr(0, space), entry.substr(space + 1));
+    }
+    if (!require(expected.size() == entries.size(), "parser digests cover every manifest entry")) return false;
+    for (std::size_t index = 0; index < entries.size(); ++index) {
+        const std::string actual = parser_digest_line(read_file(corpus_directory / entries[index]));
+        if (!require(expected[index].first == entries[index] && expected[index].second == actual,
+                     "parser differential for " + entries[index] + ": expected " + expected[index].second +
+                         ", got " + actual)) {
+            return false;
+        }
+    }
+    std::cout << "PASS parser differential cases=" << entries.size() << " mutants=" << kDifferentialMutants << "\n";
+    return true;
+}
+
 }  // namespace
 
 int main(int argc, char** argv) {
-    if (!require(argc >= 2, "usage: synq_deterministic_replay_smoke <corpus-dir> [--case file.synq --seed uint32]")) return 1;
+    if (!require(argc >= 2, "usage: synq_deterministic_replay_smoke <corpus-dir> [--case file.synq --seed uint32] [--record-parser-digests]")) return 1;
 
     ReplaySelector selector;
     if (!parse_selector(argc, argv, selector)) return 1;
@@ -326,6 +809,13 @@ int main(int argc, char** argv) {
     std::vector<std::string> entries;
     if (!read_manifest(corpus_directory, entries)) return 1;
 
+    if (selector.record_parser_digests) {
+        for (const std::string& case_name : entries) {
+            std::cout << case_name << " " << parser_digest_line(read_file(corpus_directory / case_name)) << "\n";
+        }
+        return 0;
+    }
+
     bool selected_case_found = !selector.case_name.has_value();
     for (const std::string& case_name : entries) {
         if (selector.case_name.has_value() && *selector.case_name != case_name) continue;
@@ -333,6 +823,10 @@ int main(int argc, char** argv) {
         if (!replay_case(corpus_directory, case_name, selector.seed)) return 1;
     }
     if (!require(selected_case_found, "selected --case appears exactly in the fixed manifest")) return 1;
+    if (!selector.case_name.has_value() && !check_parser_digests(corpus_directory, entries)) return 1;
+    if (!selector.case_name.has_value() && !check_front_ends(corpus_directory, entries)) return 1;
+    if (!selector.case_name.has_value() && !check_incremental_sessions(corpus_directory, entries)) return 1;
+    if (!selector.case_name.has_value() && !check_runtime_engines(corpus_directory, entries)) return 1;
 
     std::cout << "SynQ deterministic parser/runtime replay smoke test passed\n";
     return 0;
@@ -12,6 +12,24 @@ static int require(int condition, const char* message) {
     return 1;
 }
 
+typedef struct collected_output {
+    char text[256];
+    size_t length;
+    size_t calls;
+    /* Refuse this call (1-based); 0 accepts every call. */
+    size_t refuse_call;
+} collected_output;
+
+static int collect_output(void* user_data, const char* utf8, size_t length) {
+    collected_output* output = (collected_output*)user_data;
+    ++output->calls;
+    if (output->calls == output->refuse_call || output->length + length >= sizeof(output->text)) return 1;
+    memcpy(output->text + output->length, utf8, length);
+    output->length += length;
+    output->text[output->length] = '\0';
+    return 0;
+}
+
 int main(void) {
     const char* path = "synq_c_abi_smoke.synq";
     const char* semantic_path = "synq_c_abi_semantic_smoke.synq";
@@ -55,6 +73,7 @@ int main(void) {
     synq_program* program = NULL;
     char* diagnostic = NULL;
     char* openqasm = NULL;
+    collected_output written;
     synq_status status;
 
     if (!require(synq_abi_version() == SYNQ_ABI_VERSION, "consumer observes ABI version 1")) return 1;
@@ -140,6 +159,31 @@ int main(void) {
         remove(path);
         return 1;
     }
+    memset(&written, 0, sizeof(written));
+    status = synq_export_openqasm3_to_writer(program, collect_output, &written, &diagnostic);
+    if (!require(status == SYNQ_STATUS_OK && diagnostic == NULL && written.calls != 0 &&
+                 strcmp(written.text, openqasm) == 0,
+                 "C consumer streams the same OpenQASM 3 through a write callback")) {
+        synq_string_free(openqasm);
+        synq_string_free(diagnostic);
+        synq_program_free(program);
+        remove(path);
+        return 1;
+    }
+    memset(&written, 0, sizeof(written));
+    written.refuse_call = 1;
+    status = synq_export_openqasm3_to_writer(program, collect_output, &written, &diagnostic);
+    if (!require(status == SYNQ_STATUS_EXPORT_ERROR && diagnostic != NULL &&
+                 strstr(diagnostic, "write callback stopped") != NULL && written.calls == 1,
+                 "a nonzero write callback result stops the export")) {
+        synq_string_free(openqasm);
+        synq_string_free(diagnostic);
+        synq_program_free(program);
+        remove(path);
+        return 1;
+    }
+    synq_string_free(diagnostic);
+    diagnostic = NULL;
     synq_string_free(openqasm);
     synq_program_free(program);
 
@@ -165,6 +209,17 @@ int main(void) {
         return 1;
     }
     synq_string_free(diagnostic);
+    diagnostic = NULL;
+    memset(&written, 0, sizeof(written));
+    status = synq_export_openqasm3_to_writer(program, collect_output, &written, &diagnostic);
+    if (!require(status == SYNQ_STATUS_EXPORT_ERROR && diagnostic != NULL && written.calls == 0,
+                 "a rejected program never reaches the write callback")) {
+        synq_string_free(diagnostic);
+        synq_program_free(program);
+        remove(path);
+        return 1;
+    }
+    synq_string_free(diagnostic);
     synq_program_free(program);
 
     program = NULL;
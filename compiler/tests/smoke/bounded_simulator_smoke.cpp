@@ -1,11 +1,45 @@
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
+#include <new>
+#include <sstream>
 #include <string>
+#include <vector>
 
 #include "compiler/bounded_simulator.h"
 #include "compiler/hybrid_ir.h"
 #include "compiler/name_resolution.h"
 #include "compiler/parser.h"
+#include "compiler/simulation_plan_format.h"
+
+namespace {
+
+// Counts every heap allocation in this process so the prepared-plan check can
+// observe that a rerun allocates nothing.
+std::atomic<std::size_t> allocation_count{0};
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    ++allocation_count;
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    ++allocation_count;
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    if (void* pointer = std::aligned_alloc(align, (size + align - 1) / align * align)) return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { std::free(pointer); }
 
 namespace {
 
@@ -23,8 +57,8 @@ bool has_code(const std::vector<synq::compiler::Diagnostic>& diagnostics, const
     return diagnostics.size() == 1 && diagnostics.front().code == code;
 }
 
-bool simulate_source(const std::string& source, synq::compiler::BoundedSimulationResult& result,
-                     std::size_t max_qubits = 10) {
+bool simulate_with_options(const std::string& source, const synq::compiler::BoundedSimulationOptions& options,
+                           synq::compiler::BoundedSimulationResult& result) {
     Parser parser;
     const auto parsed = parser.parseSourceWithDiagnostics(source);
     if (!parsed.ok()) return false;
@@ -32,11 +66,22 @@ bool simulate_source(const std::string& source, synq::compiler::BoundedSimulatio
     if (!lowered.ok()) return false;
     const auto resolved = synq::compiler::resolve_hybrid_names(*lowered.program);
     if (!resolved.ok()) return false;
+    result = synq::compiler::simulate_bounded_quantum(*resolved.program, options);
+    return true;
+}
+
+bool simulate_source(const std::string& source, synq::compiler::BoundedSimulationResult& result,
+                     std::size_t max_qubits = 10, std::size_t threads = 1, std::size_t shots = 0,
+                     std::uint64_t seed = 0,
+                     synq::compiler::SimulationPrecision precision = synq::compiler::SimulationPrecision::F64) {
     synq::compiler::BoundedSimulationOptions options;
     options.allow_experimental_local_simulation = true;
     options.max_qubits = max_qubits;
-    result = synq::compiler::simulate_bounded_quantum(*resolved.program, options);
-    return true;
+    options.threads = threads;
+    options.shots = shots;
+    options.seed = seed;
+    options.precision = precision;
+    return simulate_with_options(source, options, result);
 }
 
 bool simulates_bell_and_parameterized_states() {
@@ -66,6 +111,403 @@ bool simulates_bell_and_parameterized_states() {
                    "parameterized rotation simulation retains normalized probability" );
 }
 
+bool fuses_deep_gate_sequences_without_changing_probabilities() {
+    // rx(pi/3) twice composes to rx(2pi/3); the repeated cx pair cancels inside
+    // one fused block; ry(pi/2) twice flips q[2] before it controls q[1].
+    synq::compiler::BoundedSimulationResult fused;
+    if (!require(simulate_source(
+                     "#[experimental(feature = \"qubit-declarations\")]\n"
+                     "#[experimental(feature = \"parameterized-quantum-gates\")]\n"
+                     "qubit q[3]\n"
+                     "quantum rx(pi/3) q[0]\nquantum h q[1]\nquantum cx q[1], q[2]\n"
+                     "quantum rx(pi/3) q[0]\nquantum cx q[1], q[2]\nquantum h q[1]\n"
+                     "quantum ry(pi/2) q[2]\nquantum ry(pi/2) q[2]\nquantum cx q[2], q[1]\n"
+                     "measure q[0]\nmeasure q[1]\nmeasure q[2]\n", fused),
+                 "fusion fixture parses, lowers, and resolves")) return false;
+    return require(fused.ok() && fused.simulation->basis_probabilities.size() == 2 &&
+                       fused.simulation->basis_probabilities[0].basis_index == 6 &&
+                       near(fused.simulation->basis_probabilities[0].probability, 0.25) &&
+                       fused.simulation->basis_probabilities[1].basis_index == 7 &&
+                       near(fused.simulation->basis_probabilities[1].probability, 0.75) &&
+                       near(fused.simulation->measurements[0].probability_one, 0.75) &&
+                       near(fused.simulation->measurements[1].probability_one, 1.0) &&
+                       near(fused.simulation->measurements[2].probability_one, 1.0),
+                   "fused single-qubit and pair blocks preserve the gate-by-gate probabilities");
+}
+
+// Seventeen qubits give every sweep and reduction several fixed-size chunks.
+std::string seventeen_qubit_ladder_source() {
+    std::string source =
+        "#[experimental(feature = \"qubit-declarations\")]\n"
+        "#[experimental(feature = \"parameterized-quantum-gates\")]\n"
+        "qubit q[17]\n";
+    for (int qubit = 0; qubit < 17; ++qubit) {
+        source += "quantum ry(pi/" + std::to_string(qubit + 2) + ") q[" + std::to_string(qubit) + "]\n";
+    }
+    for (int qubit = 0; qubit + 1 < 17; ++qubit) {
+        source += "quantum cx q[" + std::to_string(qubit) + "], q[" + std::to_string(qubit + 1) + "]\n";
+    }
+    return source + "measure q[0]\nmeasure q[16]\n";
+}
+
+bool threaded_sweeps_match_single_thread_results() {
+    // The pooled run must reproduce the inline run exactly.
+    const std::string source = seventeen_qubit_ladder_source();
+    synq::compiler::BoundedSimulationResult inline_run;
+    synq::compiler::BoundedSimulationResult pooled_run;
+    if (!require(simulate_source(source, inline_run, 17, 1) && simulate_source(source, pooled_run, 17, 4) &&
+                     inline_run.ok() && pooled_run.ok(),
+                 "threaded simulation fixture parses, lowers, resolves, and simulates")) return false;
+    const auto& expected = inline_run.simulation->basis_probabilities;
+    const auto& actual = pooled_run.simulation->basis_probabilities;
+    bool identical = expected.size() == actual.size() &&
+                     inline_run.simulation->measurements.size() == pooled_run.simulation->measurements.size();
+    for (std::size_t index = 0; identical && index < expected.size(); ++index) {
+        identical = expected[index].basis_index == actual[index].basis_index &&
+                    expected[index].probability == actual[index].probability;
+    }
+    for (std::size_t index = 0; identical && index < inline_run.simulation->measurements.size(); ++index) {
+        identical = inline_run.simulation->measurements[index].probability_one ==
+                    pooled_run.simulation->measurements[index].probability_one;
+    }
+    return require(identical, "pooled sweeps and reductions reproduce single-thread probabilities bit for bit");
+}
+
+bool cache_blocked_sweeps_match_per_operation_sweeps() {
+    // Runs of low-qubit operations applied block by block must reproduce one
+    // full sweep per operation exactly, on one thread and on a pool.
+    const std::string source = seventeen_qubit_ladder_source();
+    synq::compiler::BoundedSimulationOptions options;
+    options.allow_experimental_local_simulation = true;
+    options.max_qubits = 17;
+    options.cache_block_sweeps = false;
+    synq::compiler::BoundedSimulationResult swept;
+    if (!require(simulate_with_options(source, options, swept) && swept.ok(),
+                 "per-operation sweep fixture simulates")) return false;
+    for (const std::size_t threads : {std::size_t{1}, std::size_t{4}}) {
+        options.cache_block_sweeps = true;
+        options.threads = threads;
+        synq::compiler::BoundedSimulationResult blocked;
+        if (!require(simulate_with_options(source, options, blocked) && blocked.ok(),
+                     "cache-blocked fixture simulates")) return false;
+        const auto& expected = swept.simulation->basis_probabilities;
+        const auto& actual = blocked.simulation->basis_probabilities;
+        bool identical = expected.size() == actual.size();
+        for (std::size_t index = 0; identical && index < expected.size(); ++index) {
+            identical = expected[index].basis_index == actual[index].basis_index &&
+                        expected[index].probability == actual[index].probability;
+        }
+        for (std::size_t index = 0; identical && index < swept.simulation->measurements.size(); ++index) {
+            identical = swept.simulation->measurements[index].probability_one ==
+                        blocked.simulation->measurements[index].probability_one;
+        }
+        if (!require(identical, "cache-blocked sweeps reproduce per-operation sweeps bit for bit")) return false;
+    }
+    return true;
+}
+
+bool single_precision_tracks_double_precision() {
+    using synq::compiler::SimulationPrecision;
+    synq::compiler::BoundedSimulationResult bell;
+    if (!require(simulate_source("#[experimental(feature = \"qubit-declarations\")]\n"
+                                 "qubit q[2]\nquantum bell_pair q[0], q[1]\nmeasure q[0]\nmeasure q[1]\n",
+                                 bell, 10, 1, 0, 0, SimulationPrecision::F32) &&
+                     bell.ok() && bell.simulation->precision == SimulationPrecision::F32 &&
+                     bell.simulation->basis_probabilities.size() == 2 &&
+                     std::abs(bell.simulation->basis_probabilities[0].probability - 0.5) < 1e-6 &&
+                     std::abs(bell.simulation->basis_probabilities[1].probability - 0.5) < 1e-6,
+                 "single-precision Bell simulation keeps the two-outcome support")) return false;
+
+    const std::string source = seventeen_qubit_ladder_source();
+    synq::compiler::BoundedSimulationResult f64_run;
+    synq::compiler::BoundedSimulationResult f32_run;
+    if (!require(simulate_source(source, f64_run, 17, 1) &&
+                     simulate_source(source, f32_run, 17, 4, 0, 0, SimulationPrecision::F32) && f64_run.ok() &&
+                     f32_run.ok(),
+                 "single-precision fixture parses, lowers, resolves, and simulates")) return false;
+    std::vector<double> expected(std::size_t{1} << 17, 0.0);
+    std::vector<double> actual(expected.size(), 0.0);
+    for (const auto& entry : f64_run.simulation->basis_probabilities) expected[entry.basis_index] = entry.probability;
+    for (const auto& entry : f32_run.simulation->basis_probabilities) actual[entry.basis_index] = entry.probability;
+    double largest_error = 0.0;
+    for (std::size_t basis = 0; basis < expected.size(); ++basis) {
+        largest_error = std::max(largest_error, std::abs(expected[basis] - actual[basis]));
+    }
+    for (std::size_t index = 0; index < f64_run.simulation->measurements.size(); ++index) {
+        largest_error = std::max(largest_error, std::abs(f64_run.simulation->measurements[index].probability_one -
+                                                         f32_run.simulation->measurements[index].probability_one));
+    }
+    return require(largest_error < 1e-5, "single-precision probabilities stay within 1e-5 of double precision");
+}
+
+bool runs_clifford_programs_on_the_stabilizer_backend() {
+    using synq::compiler::SimulationBackend;
+    synq::compiler::BoundedSimulationOptions dense;
+    dense.allow_experimental_local_simulation = true;
+    synq::compiler::BoundedSimulationOptions stabilizer = dense;
+    stabilizer.allow_stabilizer_simulation = true;
+
+    // Random Clifford circuits must give the state-vector distribution exactly.
+    const char* single_gates[4] = {"h", "x", "y", "z"};
+    std::uint64_t random = 0x5eed;
+    const auto next = [&random](std::uint64_t bound) {
+        random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<int>((random >> 33) % bound);
+    };
+    for (int circuit = 0; circuit < 24; ++circuit) {
+        std::string source = "#[experimental(feature = \"qubit-declarations\")]\nqubit q[6]\n";
+        for (int gate = 0; gate < 40; ++gate) {
+            const int first = next(6);
+            if (next(3) == 0) {
+                const int second = (first + 1 + next(5)) % 6;
+                source += "quantum cx q[" + std::to_string(first) + "], q[" + std::to_string(second) + "]\n";
+            } else {
+                source += std::string("quantum ") + single_gates[next(4)] + " q[" + std::to_string(first) + "]\n";
+            }
+        }
+        for (int qubit = 0; qubit < 6; ++qubit) source += "measure q[" + std::to_string(qubit) + "]\n";
+        synq::compiler::BoundedSimulationResult expected;
+        synq::compiler::BoundedSimulationResult actual;
+        if (!require(simulate_with_options(source, dense, expected) &&
+                         simulate_with_options(source, stabilizer, actual) && expected.ok() && actual.ok() &&
+                         expected.simulation->backend == SimulationBackend::StateVector &&
+                         actual.simulation->backend == SimulationBackend::Stabilizer,
+                     "random Clifford fixture simulates on both backends")) return false;
+        const auto& dense_basis = expected.simulation->basis_probabilities;
+        const auto& tableau_basis = actual.simulation->basis_probabilities;
+        bool same = dense_basis.size() == tableau_basis.size() && !actual.simulation->basis_probabilities_omitted;
+        for (std::size_t index = 0; same && index < dense_basis.size(); ++index) {
+            same = dense_basis[index].basis_index == tableau_basis[index].basis_index &&
+                   near(dense_basis[index].probability, tableau_basis[index].probability);
+        }
+        for (std::size_t index = 0; same && index < 6; ++index) {
+            same = near(expected.simulation->measurements[index].probability_one,
+                        actual.simulation->measurements[index].probability_one);
+        }
+        if (!require(same, "stabilizer backend reproduces state-vector probabilities for circuit " +
+                               std::to_string(circuit))) return false;
+    }
+
+    std::string ghz = "#[experimental(feature = \"qubit-declarations\")]\nqubit q[200]\nquantum h q[0]\n";
+    for (int qubit = 0; qubit + 1 < 200; ++qubit) {
+        ghz += "quantum cx q[" + std::to_string(qubit) + "], q[" + std::to_string(qubit + 1) + "]\n";
+    }
+    ghz += "measure q[0]\nmeasure q[199]\n";
+    synq::compiler::BoundedSimulationResult wide;
+    if (!require(simulate_with_options(ghz, stabilizer, wide) && wide.ok() &&
+                     wide.simulation->qubit_count == 200 && wide.simulation->basis_probabilities.empty() &&
+                     wide.simulation->basis_probabilities_omitted &&
+                     wide.simulation->measurements[0].probability_one == 0.5 &&
+                     wide.simulation->measurements[1].probability_one == 0.5,
+                 "a 200-qubit GHZ state reports exact marginals beyond max_qubits")) return false;
+    synq::compiler::BoundedSimulationOptions wide_shots = stabilizer;
+    wide_shots.shots = 10;
+    synq::compiler::BoundedSimulationResult wide_sampled;
+    if (!require(simulate_with_options(ghz, wide_shots, wide_sampled) && !wide_sampled.ok() &&
+                     has_code(wide_sampled.diagnostics, "SYNQ-SIM001"),
+                 "stabilizer shots are rejected when basis indices cannot hold the register")) return false;
+
+    std::string flipped = "#[experimental(feature = \"qubit-declarations\")]\nqubit q[40]\n";
+    for (int qubit = 0; qubit < 40; ++qubit) flipped += "quantum x q[" + std::to_string(qubit) + "]\n";
+    flipped += "quantum h q[3]\nmeasure q[3]\nmeasure q[39]\n";
+    synq::compiler::BoundedSimulationResult listed;
+    synq::compiler::BoundedSimulationOptions sampled = stabilizer;
+    sampled.shots = 1000;
+    sampled.seed = 3;
+    synq::compiler::BoundedSimulationResult shots;
+    const std::size_t all_ones = (std::size_t{1} << 40) - 1;
+    if (!require(simulate_with_options(flipped, stabilizer, listed) && listed.ok() &&
+                     listed.simulation->basis_probabilities.size() == 2 &&
+                     listed.simulation->basis_probabilities[0].basis_index == (all_ones ^ 8) &&
+                     listed.simulation->basis_probabilities[1].basis_index == all_ones &&
+                     listed.simulation->basis_probabilities[1].probability == 0.5 &&
+                     listed.simulation->measurements[1].probability_one == 1.0 &&
+                     simulate_with_options(flipped, sampled, shots) && shots.ok() &&
+                     shots.simulation->shot_counts.size() == 2 &&
+                     shots.simulation->shot_counts[0].count + shots.simulation->shot_counts[1].count == 1000,
+                 "a 40-qubit Clifford program lists its support and samples shots")) return false;
+
+    synq::compiler::BoundedSimulationResult rotated;
+    if (!require(simulate_with_options("#[experimental(feature = \"qubit-declarations\")]\n"
+                                       "#[experimental(feature = \"parameterized-quantum-gates\")]\n"
+                                       "qubit q[11]\nquantum rx(pi/3) q[0]\n",
+                                       stabilizer, rotated) &&
+                     !rotated.ok() && has_code(rotated.diagnostics, "SYNQ-SIM001"),
+                 "non-Clifford programs keep the state-vector qubit limit")) return false;
+
+    Parser parser;
+    const auto parsed = parser.parseSourceWithDiagnostics(ghz);
+    const auto lowered = synq::compiler::lower_to_hybrid_ir(*parsed.program);
+    const auto resolved = synq::compiler::resolve_hybrid_names(*lowered.program);
+    const auto prepared = synq::compiler::prepare_bounded_simulation(*resolved.program, stabilizer);
+    const auto digest = synq::compiler::simulation_source_digest(ghz);
+    const std::string bytes = synq::compiler::serialize_simulation_plan(*prepared.plan, digest);
+    const auto loaded = synq::compiler::deserialize_simulation_plan(bytes, stabilizer, &digest);
+    return require(prepared.ok() && prepared.plan->backend == SimulationBackend::Stabilizer &&
+                       prepared.plan->operations.empty() && prepared.plan->clifford_operations.size() == 200 &&
+                       loaded.ok() && loaded.plan->backend == SimulationBackend::Stabilizer &&
+                       loaded.plan->clifford_operations.size() == 200 &&
+                       has_code(synq::compiler::deserialize_simulation_plan(bytes, dense, &digest).diagnostics,
+                                "SYNQ-SIM000"),
+                   "stabilizer plans round-trip and require the stabilizer opt-in to load");
+}
+
+bool sweeps_angle_bindings_over_one_structure() {
+    const auto source_with = [](const std::vector<double>& angles) {
+        std::ostringstream source;
+        source.precision(17);
+        source << "#[experimental(feature = \"qubit-declarations\")]\n"
+                  "#[experimental(feature = \"parameterized-quantum-gates\")]\n"
+                  "qubit q[3]\nquantum ry(" << angles[0] << ") q[0]\nquantum cx q[0], q[1]\n"
+                  "quantum rz(" << angles[1] << ") q[1]\nquantum h q[1]\nquantum rx(" << angles[2] << ") q[2]\n"
+                  "quantum cx q[1], q[2]\nquantum p(" << angles[3] << ") q[2]\nquantum h q[2]\n"
+                  "measure q[0]\nmeasure q[1]\nmeasure q[2]\n";
+        return source.str();
+    };
+    synq::compiler::AngleBindings bindings;
+    bindings.binding_count = 9;
+    bindings.parameter_count = 4;
+    for (std::size_t index = 0; index < bindings.binding_count * bindings.parameter_count; ++index) {
+        bindings.angles.push_back(0.37 * static_cast<double>(index) - 2.0);
+    }
+
+    Parser parser;
+    const auto parsed = parser.parseSourceWithDiagnostics(source_with({0.1, 0.2, 0.3, 0.4}));
+    if (!require(parsed.ok(), "sweep fixture parses")) return false;
+    const auto lowered = synq::compiler::lower_to_hybrid_ir(*parsed.program);
+    const auto resolved = synq::compiler::resolve_hybrid_names(*lowered.program);
+    if (!require(lowered.ok() && resolved.ok() && synq::compiler::count_sweep_parameters(*resolved.program) == 4,
+                 "sweep fixture lowers, resolves, and exposes four rotation parameters")) return false;
+
+    synq::compiler::BoundedSimulationOptions options;
+    options.allow_experimental_local_simulation = true;
+    options.max_qubits = 10;
+    const auto serial = synq::compiler::simulate_parameter_sweep(*resolved.program, bindings, options);
+    options.threads = 4;
+    const auto threaded = synq::compiler::simulate_parameter_sweep(*resolved.program, bindings, options);
+    if (!require(serial.ok() && threaded.ok() && serial.sweep->binding_count == 9 &&
+                     serial.sweep->measurements.size() == 3 &&
+                     serial.sweep->probability_one == threaded.sweep->probability_one,
+                 "parameter sweeps are independent of the worker count")) return false;
+
+    for (std::size_t binding = 0; binding < bindings.binding_count; ++binding) {
+        const std::vector<double> angles(bindings.angles.begin() + static_cast<std::ptrdiff_t>(binding * 4),
+                                         bindings.angles.begin() + static_cast<std::ptrdiff_t>(binding * 4 + 4));
+        synq::compiler::BoundedSimulationResult expected;
+        if (!require(simulate_source(source_with(angles), expected) && expected.ok(),
+                     "literal-angle sweep reference simulates")) return false;
+        for (std::size_t measurement = 0; measurement < 3; ++measurement) {
+            if (!require(near(serial.sweep->probability(measurement, binding),
+                              expected.simulation->measurements[measurement].probability_one),
+                         "each sweep column matches a literal-angle simulation")) return false;
+        }
+    }
+
+    synq::compiler::AngleBindings narrow = bindings;
+    narrow.parameter_count = 3;
+    narrow.binding_count = 12;
+    synq::compiler::AngleBindings non_finite = bindings;
+    non_finite.angles[5] = std::nan("");
+    return require(has_code(synq::compiler::simulate_parameter_sweep(*resolved.program, narrow, options).diagnostics,
+                            "SYNQ-SIM008") &&
+                       has_code(synq::compiler::simulate_parameter_sweep(*resolved.program, non_finite, options)
+                                    .diagnostics,
+                                "SYNQ-SIM008"),
+                   "mismatched or non-finite angle bindings are rejected");
+}
+
+bool samples_seeded_shot_histograms() {
+    const std::string bell_source =
+        "#[experimental(feature = \"qubit-declarations\")]\n"
+        "qubit q[2]\nquantum bell_pair q[0], q[1]\nmeasure q[0]\nmeasure q[1]\n";
+    synq::compiler::BoundedSimulationResult first;
+    synq::compiler::BoundedSimulationResult repeat;
+    if (!require(simulate_source(bell_source, first, 10, 1, 10000, 42) &&
+                     simulate_source(bell_source, repeat, 10, 1, 10000, 42) && first.ok() && repeat.ok(),
+                 "shot fixture parses, lowers, resolves, and simulates")) return false;
+    const auto& counts = first.simulation->shot_counts;
+    if (!require(first.simulation->basis_probabilities.empty() && first.simulation->shots == 10000 &&
+                     counts.size() == 2 && counts[0].basis_index == 0 && counts[1].basis_index == 3 &&
+                     counts[0].count + counts[1].count == 10000 && counts[0].count > 4700 &&
+                     counts[0].count < 5300 && repeat.simulation->shot_counts.size() == 2 &&
+                     repeat.simulation->shot_counts[0].count == counts[0].count &&
+                     near(first.simulation->measurements[0].probability_one, 0.5),
+                 "Bell shots replace the dense list with a reproducible histogram over the support")) return false;
+
+    // A skewed table with an interior zero weight exercises alias donation.
+    const auto skewed = synq::compiler::sample_shots({1, 2, 5, 9}, {0.1, 0.0, 0.2, 0.7}, 100000, 7);
+    return require(skewed.size() == 3 && skewed[0].basis_index == 1 && skewed[1].basis_index == 5 &&
+                       skewed[2].basis_index == 9 && std::abs(static_cast<double>(skewed[0].count) - 10000.0) < 600 &&
+                       std::abs(static_cast<double>(skewed[1].count) - 20000.0) < 800 &&
+                       std::abs(static_cast<double>(skewed[2].count) - 70000.0) < 1000,
+                   "alias-table shots follow the weights and never draw zero-weight outcomes");
+}
+
+bool reruns_and_reloads_prepared_plans() {
+    Parser parser;
+    const auto parsed = parser.parseSourceWithDiagnostics(
+        "#[experimental(feature = \"qubit-declarations\")]\n"
+        "#[experimental(feature = \"parameterized-quantum-gates\")]\n"
+        "#[experimental(feature = \"named-qubit-register-operands\")]\n"
+        "qubit data[2]\nqubit ancilla[1]\nquantum rx(pi/3) data[0]\nquantum cx data[0], ancilla[0]\n"
+        "quantum h data[1]\nmeasure ancilla[0]\nmeasure data[1]\n");
+    if (!require(parsed.ok(), "prepared-plan fixture parses")) return false;
+    const auto lowered = synq::compiler::lower_to_hybrid_ir(*parsed.program);
+    const auto resolved = synq::compiler::resolve_hybrid_names(*lowered.program);
+    synq::compiler::BoundedSimulationOptions options;
+    options.allow_experimental_local_simulation = true;
+    const auto direct = synq::compiler::simulate_bounded_quantum(*resolved.program, options);
+    const auto prepared = synq::compiler::prepare_bounded_simulation(*resolved.program, options);
+    if (!require(direct.ok() && prepared.ok() && prepared.plan->qubit_count == 3 &&
+                     prepared.plan->measurements.size() == 2,
+                 "prepared plan resolves registers and measurements once")) return false;
+
+    synq::compiler::SimulationWorkspace workspace;
+    synq::compiler::BoundedSimulation reused;
+    std::vector<synq::compiler::Diagnostic> diagnostics;
+    if (!require(synq::compiler::run_bounded_simulation(*prepared.plan, options, workspace, reused, diagnostics),
+                 "first prepared run succeeds")) return false;
+    const std::size_t before = allocation_count.load();
+    const bool rerun = synq::compiler::run_bounded_simulation(*prepared.plan, options, workspace, reused, diagnostics);
+    const std::size_t allocations = allocation_count.load() - before;
+    if (!require(rerun && allocations == 0, "prepared rerun reuses workspace and result storage without allocating")) {
+        return false;
+    }
+    bool identical = reused.basis_probabilities.size() == direct.simulation->basis_probabilities.size() &&
+                     reused.measurements.size() == 2 && reused.measurements[0].register_name == "ancilla" &&
+                     reused.measurements[1].register_name == "data" && reused.measurements[1].register_index == 1;
+    for (std::size_t index = 0; identical && index < reused.basis_probabilities.size(); ++index) {
+        identical = reused.basis_probabilities[index].basis_index ==
+                        direct.simulation->basis_probabilities[index].basis_index &&
+                    reused.basis_probabilities[index].probability ==
+                        direct.simulation->basis_probabilities[index].probability;
+    }
+    if (!require(identical, "prepared reruns reproduce simulate_bounded_quantum")) return false;
+
+    const std::string source = "prepared-plan fixture";
+    const auto digest = synq::compiler::simulation_source_digest(source);
+    const std::string bytes = synq::compiler::serialize_simulation_plan(*prepared.plan, digest);
+    const auto loaded = synq::compiler::deserialize_simulation_plan(bytes, options, &digest);
+    synq::compiler::BoundedSimulation replayed;
+    if (!require(loaded.ok() && loaded.plan->operations.size() == prepared.plan->operations.size() &&
+                     synq::compiler::run_bounded_simulation(*loaded.plan, options, workspace, replayed, diagnostics) &&
+                     replayed.basis_probabilities.size() == reused.basis_probabilities.size() &&
+                     replayed.basis_probabilities.back().probability == reused.basis_probabilities.back().probability &&
+                     replayed.measurements[1].register_name == "data",
+                 "serialized plans reload and replay bit for bit")) return false;
+
+    const auto other_source = synq::compiler::simulation_source_digest("edited fixture");
+    synq::compiler::BoundedSimulationOptions narrow = options;
+    narrow.max_qubits = 2;
+    return require(has_code(synq::compiler::deserialize_simulation_plan(bytes, options, &other_source).diagnostics,
+                            "SYNQ-SIM007") &&
+                       has_code(synq::compiler::deserialize_simulation_plan(bytes.substr(0, bytes.size() - 1), options)
+                                    .diagnostics,
+                                "SYNQ-SIM007") &&
+                       has_code(synq::compiler::deserialize_simulation_plan(bytes, narrow).diagnostics, "SYNQ-SIM001"),
+                   "plan loading rejects stale, truncated, and over-limit plans");
+}
+
 bool enforces_opt_in_and_resource_or_semantic_boundaries() {
     Parser parser;
     const auto parsed = parser.parseSourceWithDiagnostics(
@@ -133,6 +575,14 @@ bool enforces_opt_in_and_resource_or_semantic_boundaries() {
 
 int main() {
     if (!simulates_bell_and_parameterized_states()) return 1;
+    if (!fuses_deep_gate_sequences_without_changing_probabilities()) return 1;
+    if (!threaded_sweeps_match_single_thread_results()) return 1;
+    if (!cache_blocked_sweeps_match_per_operation_sweeps()) return 1;
+    if (!single_precision_tracks_double_precision()) return 1;
+    if (!runs_clifford_programs_on_the_stabilizer_backend()) return 1;
+    if (!sweeps_angle_bindings_over_one_structure()) return 1;
+    if (!samples_seeded_shot_histograms()) return 1;
+    if (!reruns_and_reloads_prepared_plans()) return 1;
     if (!enforces_opt_in_and_resource_or_semantic_boundaries()) return 1;
     std::cout << "SynQ bounded simulator smoke test passed\n";
     return 0;
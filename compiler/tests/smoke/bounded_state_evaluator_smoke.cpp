@@ -178,11 +178,35 @@ bool rejects_state_in_quantum_paths() {
 
 }  // namespace
 
+bool reads_operands_through_resolved_slots() {
+    synq::compiler::ResolvedHybridProgram program;
+    const std::string source =
+        "#[experimental(feature = \"mutable-classical-state\")]\n"
+        "#[experimental(feature = \"integer-arithmetic-expressions\")]\n"
+        "let step = 2\n"
+        "var total = step\n"
+        "set total = total + step\n"
+        "set total = step * total\n";
+    if (!require(prepare(source, program), "slot fixture parses, lowers, and resolves")) return false;
+    const auto evaluated = evaluate(program);
+    if (!require(evaluated.ok() && evaluated.evaluation->cells.size() == 1 &&
+                     evaluated.evaluation->cells[0].value.integer_value == 8,
+                 "state evaluation reads each operand from the slot its binding index names")) return false;
+
+    // Operand identity comes from resolution, not from the operand's spelling.
+    auto& assignment = std::get<synq::compiler::ResolvedHybridAssignment>(program.nodes[2]);
+    assignment.value_binding_indices.pop_back();
+    const auto missing = evaluate(program);
+    return require(!missing.ok() && !missing.evaluation.has_value() && has_code(missing.diagnostics, "SYNQ-E003"),
+                   "an operand without a resolved binding index is rejected instead of looked up by name");
+}
+
 int main() {
     if (!evaluates_typed_cells_in_source_order()) return 1;
     if (!enforces_parser_and_resolver_boundaries()) return 1;
     if (!enforces_opt_in_and_resource_bounds_atomically()) return 1;
     if (!rejects_state_in_quantum_paths()) return 1;
+    if (!reads_operands_through_resolved_slots()) return 1;
     std::cout << "SynQ bounded mutable-state evaluator smoke test passed\n";
     return 0;
 }
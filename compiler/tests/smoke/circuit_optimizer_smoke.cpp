@@ -0,0 +1,284 @@
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "compiler/bounded_simulator.h"
+#include "compiler/circuit_optimizer.h"
+#include "compiler/hybrid_ir.h"
+#include "compiler/name_resolution.h"
+#include "compiler/openqasm3_exporter.h"
+#include "compiler/parser.h"
+
+namespace {
+
+const std::string kHeader =
+    "#[experimental(feature = \"qubit-declarations\")]\n"
+    "#[experimental(feature = \"parameterized-quantum-gates\")]\n"
+    "#[experimental(feature = \"callable-declarations\")]\n"
+    "#[experimental(feature = \"classical-control-flow\")]\n";
+
+bool require(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "FAIL: " << message << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool lower_source(const std::string& body, synq::compiler::HybridProgram& program) {
+    Parser parser;
+    const auto parsed = parser.parseSourceWithDiagnostics(kHeader + body);
+    if (!parsed.ok()) return false;
+    auto lowered = synq::compiler::lower_to_hybrid_ir(*parsed.program);
+    if (!lowered.ok()) return false;
+    program = std::move(*lowered.program);
+    return synq::compiler::resolve_hybrid_name_table(program).ok();
+}
+
+// Returns the strict Hybrid export of `program` without the preamble and
+// register declarations.
+bool exported_gates(const synq::compiler::HybridProgram& program, std::string& gates) {
+    const auto exported = synq::compiler::export_hybrid_openqasm3(program);
+    if (!exported.ok()) return false;
+    gates.clear();
+    std::istringstream lines(exported.program);
+    for (std::string line; std::getline(lines, line);) {
+        if (line.rfind("OPENQASM", 0) == 0 || line.rfind("include", 0) == 0 || line.rfind("qubit[", 0) == 0 ||
+            line.rfind("bit[", 0) == 0) {
+            continue;
+        }
+        gates += line + "\n";
+    }
+    return true;
+}
+
+// Optimizes `body` and returns its export as exported_gates() does.
+bool optimized_gates(const std::string& body, std::string& gates,
+                     synq::compiler::CircuitOptimizationReport* report = nullptr,
+                     const synq::compiler::CircuitOptimizationOptions& options = {}) {
+    synq::compiler::HybridProgram program;
+    if (!lower_source(body, program)) return false;
+    const auto optimized = synq::compiler::optimize_hybrid_circuit(program, options);
+    if (report != nullptr) *report = optimized;
+    return exported_gates(program, gates);
+}
+
+// Reorders `body` into layers and returns its export as exported_gates() does.
+bool scheduled_gates(const std::string& body, std::string& gates,
+                     synq::compiler::CircuitSchedulingReport* report = nullptr) {
+    synq::compiler::HybridProgram program;
+    if (!lower_source(body, program)) return false;
+    const auto scheduled = synq::compiler::reorder_hybrid_circuit(program);
+    if (report != nullptr) *report = scheduled;
+    return exported_gates(program, gates);
+}
+
+bool cancels_merges_and_reports_deltas() {
+    std::string gates;
+    synq::compiler::CircuitOptimizationReport report;
+    if (!require(optimized_gates("qubit q[3]\n"
+                                 "quantum h q[0]\nquantum h q[0]\n"
+                                 "quantum rz(pi/4) q[1]\nquantum rz(pi/4) q[1]\n"
+                                 "quantum cx q[0], q[2]\nquantum x q[1]\nquantum cx q[0], q[2]\n"
+                                 "quantum rx(0.25) q[2]\nquantum rx(-0.25) q[2]\n"
+                                 "quantum p(pi) q[0]\nquantum p(pi) q[0]\n"
+                                 "quantum ry(0.0) q[1]\nquantum h q[2]\nmeasure q[1]\n",
+                                 gates, &report),
+                 "redundant fixture optimizes and exports")) return false;
+    if (!require(gates == "rz(pi/2) q[1];\nx q[1];\nh q[2];\nc[1] = measure q[1];\n",
+                 "pairs cancel, rotations fold, and identities disappear: " + gates)) return false;
+    if (!require(report.before.gate_count == 13 && report.after.gate_count == 3 && report.before.depth == 7 &&
+                     report.after.depth == 3,
+                 "report carries gate-count and depth before and after")) return false;
+    if (!require(report.cancelled_pairs == 2 && report.merged_rotations == 3 && report.removed_identities == 3,
+                 "report counts each rewrite")) return false;
+
+    // Removing one pair exposes the next: h x x h collapses completely.
+    if (!require(optimized_gates("qubit q[1]\nquantum h q[0]\nquantum x q[0]\nquantum x q[0]\nquantum h q[0]\n",
+                                 gates, &report) &&
+                     gates.empty() && report.cancelled_pairs == 2 && report.after.depth == 0,
+                 "nested self-inverse pairs cancel")) return false;
+    return require(optimized_gates("qubit q[3]\nquantum cx q[0], q[1]\nquantum h q[2]\nquantum cx q[0], q[1]\n"
+                                   "quantum x q[0]\nquantum y q[2]\nquantum x q[0]\n",
+                                   gates) &&
+                       gates == "h q[2];\ny q[2];\n",
+                   "gates on other qubits do not separate a pair: " + gates);
+}
+
+bool folds_only_exact_literal_sums() {
+    const struct {
+        const char* gates;
+        const char* expected;
+    } cases[] = {
+        {"quantum rz(pi/2) q[0]\nquantum rz(pi/2) q[0]\n", "rz(pi) q[0];\n"},
+        {"quantum rz(-pi/2) q[0]\nquantum rz(-pi/2) q[0]\n", "rz(-pi) q[0];\n"},
+        {"quantum ry(pi/3) q[0]\nquantum ry(pi/6) q[0]\n", "ry(pi/2) q[0];\n"},
+        {"quantum rx(pi/8) q[0]\nquantum rx(-pi/8) q[0]\n", ""},
+        {"quantum p(pi/2) q[0]\nquantum p(pi/2) q[0]\nquantum p(pi) q[0]\n", ""},
+        {"quantum rx(0.1) q[0]\nquantum rx(0.2) q[0]\n", "rx(0.3) q[0];\n"},
+        {"quantum rz(-.75) q[0]\nquantum rz(0.5) q[0]\n", "rz(-0.25) q[0];\n"},
+        // 2*pi is -I for rz but the identity for p; 2*pi/3 has no literal form.
+        {"quantum rz(pi) q[0]\nquantum rz(pi) q[0]\n", "rz(pi) q[0];\nrz(pi) q[0];\n"},
+        {"quantum rz(pi/3) q[0]\nquantum rz(pi/3) q[0]\n", "rz(pi/3) q[0];\nrz(pi/3) q[0];\n"},
+        {"quantum rz(pi/4) q[0]\nquantum rz(0.5) q[0]\n", "rz(pi/4) q[0];\nrz(0.5) q[0];\n"},
+        {"quantum rz(pi/4) q[0]\nquantum rx(pi/4) q[0]\n", "rz(pi/4) q[0];\nrx(pi/4) q[0];\n"},
+    };
+    for (const auto& fixture : cases) {
+        std::string gates;
+        if (!require(optimized_gates(std::string("qubit q[1]\n") + fixture.gates, gates) && gates == fixture.expected,
+                     std::string("literal sum for ") + fixture.gates + "yields " + gates)) return false;
+    }
+    return true;
+}
+
+bool stops_at_measurements_controls_calls_and_disabled_rewrites() {
+    const char* blocked[] = {
+        "quantum h q[0]\nmeasure q[0]\nquantum h q[0]\n",
+        "quantum h q[0]\nquantum cx q[0], q[1]\nquantum h q[0]\n",
+        "quantum cx q[0], q[1]\nquantum cx q[1], q[0]\n",
+        "quantum x q[0]\nlet ready = true\nif ready then quantum h q[1]\nquantum x q[0]\n",
+        "kernel flip() { quantum z q[1] }\nquantum x q[0]\ncall flip()\nquantum x q[0]\n",
+        "quantum x q[0]\nquantum bell_pair q[0], q[1]\nquantum x q[0]\n",
+    };
+    for (const char* body : blocked) {
+        synq::compiler::HybridProgram program;
+        if (!require(lower_source(std::string("qubit q[2]\n") + body, program), "barrier fixture lowers")) return false;
+        const std::size_t nodes = program.nodes.size();
+        const auto report = synq::compiler::optimize_hybrid_circuit(program);
+        if (!require(program.nodes.size() == nodes && report.after.gate_count == report.before.gate_count,
+                     std::string("nothing rewrites across the barrier in ") + body)) return false;
+    }
+
+    synq::compiler::CircuitOptimizationOptions options;
+    options.cancel_self_inverse_pairs = false;
+    options.merge_rotations = false;
+    options.remove_identity_rotations = false;
+    std::string gates;
+    const std::string redundant = "qubit q[1]\nquantum h q[0]\nquantum h q[0]\nquantum rz(pi/4) q[0]\n"
+                                  "quantum rz(pi/4) q[0]\nquantum rx(0) q[0]\n";
+    if (!require(optimized_gates(redundant, gates, nullptr, options) &&
+                     gates == "h q[0];\nh q[0];\nrz(pi/4) q[0];\nrz(pi/4) q[0];\nrx(0) q[0];\n",
+                 "disabled rewrites leave the circuit unchanged")) return false;
+    options.merge_rotations = true;
+    return require(optimized_gates("qubit q[1]\nquantum p(pi) q[0]\nquantum p(pi) q[0]\n", gates, nullptr, options) &&
+                       gates == "p(pi) q[0];\np(pi) q[0];\n",
+                   "a merge that would only produce an identity waits for identity removal");
+}
+
+bool schedules_commuting_gates_into_layers() {
+    // rz commutes with the cx control, so it fills the free layers below cx;
+    // x does not, so it stays after.
+    synq::compiler::HybridProgram program;
+    if (!require(lower_source("qubit q[2]\nquantum h q[1]\nquantum h q[1]\nquantum cx q[0], q[1]\n"
+                              "quantum rz(pi/4) q[0]\nquantum z q[0]\nquantum x q[0]\n",
+                              program),
+                 "layering fixture lowers")) return false;
+    const auto schedule = synq::compiler::schedule_hybrid_circuit(program);
+    const std::size_t expected[][3] = {{1, 1, 2}, {4, 1, 3}, {2, 2, 2}, {5, 2, 3}, {3, 3, 3}, {6, 4, 4}};
+    bool matches = schedule.depth == 4 && schedule.gates.size() == 6 &&
+                   schedule.layer_begin == std::vector<std::size_t>{0, 2, 4, 5, 6};
+    for (std::size_t index = 0; matches && index < 6; ++index) {
+        const auto& gate = schedule.gates[index];
+        matches = gate.node == expected[index][0] && gate.asap_layer == expected[index][1] &&
+                  gate.alap_layer == expected[index][2];
+    }
+    if (!require(matches, "ASAP layers pack commuting gates and ALAP layers bound their slack")) return false;
+
+    std::string gates;
+    synq::compiler::CircuitSchedulingReport report;
+    if (!require(scheduled_gates("qubit q[2]\nquantum h q[1]\nquantum cx q[0], q[1]\nquantum rz(pi/4) q[0]\n",
+                                 gates, &report) &&
+                     gates == "h q[1];\nrz(pi/4) q[0];\ncx q[0], q[1];\n",
+                 "reordering emits gates layer by layer: " + gates)) return false;
+    if (!require(report.before.depth == 3 && report.after.depth == 2 && report.layers == 2 &&
+                     report.moved_gates == 2 && report.after.gate_count == 3,
+                 "scheduling report carries depth before and after")) return false;
+
+    const char* fixed[] = {
+        "quantum cx q[0], q[1]\nquantum cx q[1], q[0]\nquantum cx q[0], q[1]\n",
+        "quantum h q[0]\nquantum x q[0]\nquantum y q[0]\nquantum z q[0]\n",
+        "quantum bell_pair q[0], q[1]\nquantum z q[0]\nquantum rz(pi/2) q[1]\n",
+        "quantum x q[0]\nmeasure q[0]\nquantum h q[1]\n",
+        "quantum x q[0]\nlet ready = true\nif ready then quantum h q[1]\nquantum h q[1]\n",
+        "kernel flip() { quantum z q[1] }\nquantum x q[0]\ncall flip()\nquantum h q[1]\n",
+    };
+    for (const char* body : fixed) {
+        std::string original;
+        synq::compiler::HybridProgram unscheduled;
+        if (!require(lower_source(std::string("qubit q[3]\n") + body, unscheduled) &&
+                         exported_gates(unscheduled, original) &&
+                         scheduled_gates(std::string("qubit q[3]\n") + body, gates, &report),
+                     "barrier fixture schedules")) return false;
+        if (!require(gates == original && report.moved_gates == 0,
+                     std::string("nothing moves past a non-commuting gate or a barrier in ") + body)) return false;
+    }
+    // Layers continue after a barrier, so h follows the measurement.
+    if (!require(lower_source("qubit q[2]\nquantum x q[0]\nmeasure q[0]\nquantum h q[1]\n", program),
+                 "measurement fixture lowers")) return false;
+    const auto split = synq::compiler::schedule_hybrid_circuit(program);
+    return require(split.depth == 2 && split.gates.size() == 2 && split.gates[1].asap_layer == 2 &&
+                       split.gates[1].alap_layer == 2,
+                   "a measurement starts a new run of layers");
+}
+
+bool simulate(const synq::compiler::HybridProgram& program, synq::compiler::BoundedSimulationResult& result) {
+    const auto resolved = synq::compiler::resolve_hybrid_names(program);
+    if (!resolved.ok()) return false;
+    synq::compiler::BoundedSimulationOptions options;
+    options.allow_experimental_local_simulation = true;
+    result = synq::compiler::simulate_bounded_quantum(*resolved.program, options);
+    return result.ok();
+}
+
+bool preserves_simulated_probabilities() {
+    const std::string body =
+        "qubit q[3]\nquantum h q[0]\nquantum rz(pi/8) q[0]\nquantum rz(pi/8) q[0]\nquantum h q[0]\n"
+        "quantum ry(0.3) q[1]\nquantum cx q[1], q[2]\nquantum cx q[1], q[2]\nquantum ry(0.45) q[1]\n"
+        "quantum rx(pi/2) q[2]\nquantum z q[2]\nquantum z q[2]\nquantum rx(pi/2) q[2]\nquantum cx q[0], q[2]\n"
+        "measure q[0]\nmeasure q[1]\nmeasure q[2]\n";
+    synq::compiler::HybridProgram original;
+    if (!require(lower_source(body, original), "equivalence fixture lowers")) return false;
+    synq::compiler::HybridProgram optimized = original;
+    const auto report = synq::compiler::optimize_hybrid_circuit(optimized);
+    synq::compiler::BoundedSimulationResult before;
+    synq::compiler::BoundedSimulationResult after;
+    if (!require(simulate(original, before) && simulate(optimized, after), "both programs simulate")) return false;
+    if (!require(report.after.gate_count == 6 && report.before.gate_count == 13,
+                 "equivalence fixture loses seven gates")) return false;
+    const auto& expected = before.simulation->basis_probabilities;
+    const auto& actual = after.simulation->basis_probabilities;
+    bool same = expected.size() == actual.size();
+    for (std::size_t index = 0; same && index < expected.size(); ++index) {
+        same = expected[index].basis_index == actual[index].basis_index &&
+               std::abs(expected[index].probability - actual[index].probability) < 1e-12;
+    }
+    if (!require(same, "optimization leaves the simulated distribution unchanged")) return false;
+
+    synq::compiler::HybridProgram scheduled = original;
+    const auto layered = synq::compiler::reorder_hybrid_circuit(scheduled);
+    synq::compiler::BoundedSimulationResult reordered;
+    if (!require(simulate(scheduled, reordered) && layered.moved_gates > 0 &&
+                     layered.after.depth < layered.before.depth,
+                 "the scheduled program is shallower and simulates")) return false;
+    const auto& layered_probabilities = reordered.simulation->basis_probabilities;
+    same = expected.size() == layered_probabilities.size();
+    for (std::size_t index = 0; same && index < expected.size(); ++index) {
+        same = expected[index].basis_index == layered_probabilities[index].basis_index &&
+               std::abs(expected[index].probability - layered_probabilities[index].probability) < 1e-12;
+    }
+    return require(same, "scheduling leaves the simulated distribution unchanged");
+}
+
+}  // namespace
+
+int main() {
+    if (!cancels_merges_and_reports_deltas()) return 1;
+    if (!folds_only_exact_literal_sums()) return 1;
+    if (!stops_at_measurements_controls_calls_and_disabled_rewrites()) return 1;
+    if (!schedules_commuting_gates_into_layers()) return 1;
+    if (!preserves_simulated_probabilities()) return 1;
+    std::cout << "SynQ circuit optimizer smoke test passed\n";
+    return 0;
+}
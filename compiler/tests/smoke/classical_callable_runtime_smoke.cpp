@@ -146,6 +146,41 @@ bool enforces_explicit_opt_in_and_atomic_bounds() {
                    "U5 checked body arithmetic uses the explicit operation budget atomically");
 }
 
+bool memoized_calls_keep_exact_budgets() {
+    synq::compiler::ResolvedHybridProgram program;
+    if (!require(prepare(
+                     "#[experimental(feature = \"classical-callable-execution\")]\n"
+                     "fn increment(value: Integer) -> value + 1\n"
+                     "let first = increment(1)\n"
+                     "let again = increment(1)\n"
+                     "let other = increment(2)\n"
+                     "let last = increment(1)\n",
+                     program),
+                 "U5 repeated-call fixture parses, lowers, and resolves")) return false;
+    const auto repeated = evaluate(program);
+    if (!require(repeated.ok() && repeated.evaluation->bindings.size() == 4 &&
+                     repeated.evaluation->bindings[1].value.integer_value == 2 &&
+                     repeated.evaluation->bindings[2].value.integer_value == 3 &&
+                     repeated.evaluation->bindings[3].value.integer_value == 2,
+                 "repeated U5 calls with equal actuals return the first call's value")) return false;
+    const auto operations = evaluate(program, 32, 128, 1, 16, 3);
+    if (!require(!operations.ok() && has_code(operations.diagnostics, "SYNQ-E007"),
+                 "a memoized U5 call is still charged its body operations")) return false;
+    const auto invocations = evaluate(program, 32, 3);
+    if (!require(!invocations.ok() && has_code(invocations.diagnostics, "SYNQ-E012") &&
+                     invocations.diagnostics.front().span.line == 6,
+                 "a memoized U5 call still counts against the invocation limit")) return false;
+    synq::compiler::BoundedRuntimeEvaluationOptions uncached;
+    uncached.allow_experimental_runtime_evaluation = true;
+    uncached.max_operations = 3;
+    uncached.memoize_invocations = false;
+    const auto reference = synq::compiler::evaluate_bounded_runtime(program, uncached);
+    return require(has_code(reference.diagnostics, "SYNQ-E007") &&
+                       reference.diagnostics.front().span.line == operations.diagnostics.front().span.line &&
+                       reference.diagnostics.front().span.column_start == operations.diagnostics.front().span.column_start,
+                   "memoized and uncached U5 calls fail at the same operation");
+}
+
 bool rejects_u5_nodes_in_quantum_paths() {
     synq::compiler::ResolvedHybridProgram resolved_program;
     synq::compiler::HybridProgram lowered_program;
@@ -172,6 +207,7 @@ int main() {
     if (!executes_one_typed_local_frame_per_call()) return 1;
     if (!enforces_gate_parse_and_resolution_boundaries()) return 1;
     if (!enforces_explicit_opt_in_and_atomic_bounds()) return 1;
+    if (!memoized_calls_keep_exact_budgets()) return 1;
     if (!rejects_u5_nodes_in_quantum_paths()) return 1;
     std::cout << "SynQ bounded classical callable runtime smoke test passed\n";
     return 0;
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
@@ -53,13 +54,17 @@ int main(int argc, char** argv) {
     const auto multi_register_simulation = base.string() + "_multi_register_simulation.synq";
     const auto named_registers = base.string() + "_named_registers.synq";
     const auto literal_if = base.string() + "_literal_if.synq";
+    const auto redundant = base.string() + "_redundant.synq";
     const auto invalid = base.string() + "_invalid.synq";
+    const auto late_parse_error = base.string() + "_late_parse_error.synq";
     const auto qasm = base.string() + "_output.qasm";
     const auto hybrid_qasm = base.string() + "_hybrid_output.qasm";
     const auto named_hybrid_qasm = base.string() + "_named_hybrid_output.qasm";
     const auto literal_if_qasm = base.string() + "_literal_if_output.qasm";
+    const auto plan_cache = base.string() + "_simulation.synqplan";
     const auto stdout_path = base.string() + "_stdout.txt";
     const auto stderr_path = base.string() + "_stderr.txt";
+    const auto manifest = base.string() + "_manifest.txt";
 
 #ifdef _WIN32
     const auto launcher = base.string() + "_launcher.cmd";
@@ -118,7 +123,15 @@ int main(int argc, char** argv) {
                             "#[experimental(feature = \"classical-control-flow\")]\n"
                             "qubit q[1]\nif true then quantum h q[0]\n"),
                  "writes literal-if strict-export CLI fixture") ||
-        !require(write_file(invalid, "quantum cx q[0]\n"), "writes invalid CLI fixture")) return 1;
+        !require(write_file(redundant,
+                            "#[experimental(feature = \"qubit-declarations\")]\n"
+                            "#[experimental(feature = \"parameterized-quantum-gates\")]\n"
+                            "qubit q[2]\nquantum h q[0]\nquantum h q[0]\nquantum rz(pi/4) q[1]\n"
+                            "quantum rz(pi/4) q[1]\nquantum cx q[0], q[1]\nmeasure q[0]\nmeasure q[1]\n"),
+                 "writes redundant-gate optimization CLI fixture") ||
+        !require(write_file(invalid, "quantum cx q[0]\n"), "writes invalid CLI fixture") ||
+        !require(write_file(late_parse_error, "let x = 1\nprint x\nquantum cx q[0]\n"),
+                 "writes lowering-then-parse-error CLI fixture")) return 1;
 
     if (!require(std::system((invoke + " --version > " + quote(stdout_path) + " 2> " + quote(stderr_path)).c_str()) == 0 &&
                      read_file(stdout_path).find("synqc 0.1.0-experimental") != std::string::npos,
@@ -198,11 +211,128 @@ int main(int argc, char** argv) {
                      read_file(stdout_path).find("measurement ancilla[0] probability_one = 0.5") != std::string::npos,
                  "simulation mode reports source register identity and deterministic cross-register probabilities")) return 1;
 
+    if (!require(std::system((invoke + " " + quote(simulation) + " --simulate --threads 2 > " + quote(stdout_path) +
+                              " 2> " + quote(stderr_path)).c_str()) == 0 &&
+                     read_file(stdout_path).find("basis |11> probability = 0.5") != std::string::npos,
+                 "simulation mode accepts an explicit sweep thread count")) return 1;
+
+    if (!require(std::system((invoke + " " + quote(simulation) + " --validate --threads 2 > " + quote(stdout_path) +
+                              " 2> " + quote(stderr_path)).c_str()) != 0 &&
+                     read_file(stderr_path).find("--threads, --shots, --precision, --stabilizer, and --plan-cache are supported only with --simulate") != std::string::npos,
+                 "thread count is rejected outside simulation mode")) return 1;
+
+    if (!require(std::system((invoke + " " + quote(simulation) + " --simulate --precision f32 > " + quote(stdout_path) +
+                              " 2> " + quote(stderr_path)).c_str()) == 0 &&
+                     read_file(stdout_path).find("precision = f32") != std::string::npos &&
+                     read_file(stdout_path).find("basis |11> probability = 0.5") != std::string::npos,
+                 "single-precision simulation reports its precision and the usual probabilities")) return 1;
+    if (!require(std::system((invoke + " " + quote(simulation) + " --simulate --precision f16 > " + quote(stdout_path) +
+                              " 2> " + quote(stderr_path)).c_str()) != 0 &&
+                     read_file(stderr_path).find("--precision requires f64 or f32") != std::string::npos,
+                 "unknown precisions are rejected")) return 1;
+    if (!require(std::system((invoke + " " + quote(simulation) + " --simulate --stabilizer > " + quote(stdout_path) +
+                              " 2> " + quote(stderr_path)).c_str()) == 0 &&
+                     read_file(stdout_path).find("backend = stabilizer") != std::string::npos &&
+                     read_file(stdout_path).find("basis |11> probability = 0.5") != std::string::npos,
+                 "stabilizer simulation runs Clifford programs on the tableau backend")) return 1;
+
+    if (!require(std::system((invoke + " " + quote(simulation) + " --simulate --shots 1000 --seed 7 > " +
+                              quote(stdout_path) + " 2> " + quote(stderr_path)).c_str()) == 0 &&
+                     read_file(stdout_path).find("shots = 1000 seed = 7") != std::string::npos &&
+                     read_file(stdout_path).find("shot |00> count = ") != std::string::npos &&
+                     read_file(stdout_path).find("shot |11> count = ") != std::string::npos &&
+                     read_file(stdout_path).find("basis |") == std::string::npos,
+                 "shot mode prints a seeded histogram instead of dense basis probabilities")) return 1;
+
+    if (!require(std::system((invoke + " " + quote(simulation) + " --simulate --seed 7 > " + quote(stdout_path) +
+                              " 2> " + quote(stderr_path)).c_str()) != 0 &&
+                     read_file(stderr_path).find("--seed is supported only with --shots") != std::string::npos,
+                 "seed is rejected without a shot count")) return 1;
+
+    std::string prepared_output;
+    if (!require(std::system((invoke + " " + quote(simulation) + " --simulate --plan-cache " + quote(plan_cache) +
+                              " > " + quote(stdout_path) + " 2> " + quote(stderr_path)).c_str()) == 0 &&
+                     read_file(plan_cache).rfind("SYNQPLAN", 0) == 0 &&
+                     (prepared_output = read_file(stdout_path)).find("basis |11> probability = 0.5") != std::string::npos,
+                 "plan-cache simulation stores a compiled plan and prints the usual probabilities")) return 1;
+    if (!require(std::system((invoke + " " + quote(simulation) + " --simulate --plan-cache " + quote(plan_cache) +
+                              " > " + quote(stdout_path) + " 2> " + quote(stderr_path)).c_str()) == 0 &&
+                     read_file(stdout_path) == prepared_output,
+                 "replaying a cached plan reproduces the prepared output")) return 1;
+
+    if (!require(std::system((invoke + " " + quote(redundant) + " --emit-openqasm-hybrid --optimize > " +
+                              quote(stdout_path) + " 2> " + quote(stderr_path)).c_str()) == 0 &&
+                     read_file(stdout_path).find("h q[0];") == std::string::npos &&
+                     read_file(stdout_path).find("rz(pi/2) q[1];") != std::string::npos &&
+                     read_file(stderr_path).find("synqc: optimize: gates 5 -> 2, depth 4 -> 3") != std::string::npos,
+                 "optimized export folds redundant gates and reports the deltas on standard error")) return 1;
+    std::string unoptimized_output;
+    if (!require(std::system((invoke + " " + quote(redundant) + " --simulate > " + quote(stdout_path) + " 2> " +
+                              quote(stderr_path)).c_str()) == 0 &&
+                     !(unoptimized_output = read_file(stdout_path)).empty() &&
+                     std::system((invoke + " " + quote(redundant) + " --simulate --optimize > " + quote(stdout_path) +
+                                  " 2> " + quote(stderr_path)).c_str()) == 0 &&
+                     read_file(stdout_path) == unoptimized_output,
+                 "optimized simulation prints the unoptimized probabilities")) return 1;
+    if (!require(std::system((invoke + " " + quote(redundant) + " --validate --optimize > " + quote(stdout_path) +
+                              " 2> " + quote(stderr_path)).c_str()) != 0 &&
+                     read_file(stderr_path).find("--optimize is supported only with --emit-openqasm-hybrid or --simulate") != std::string::npos,
+                 "optimization is rejected outside export and simulation")) return 1;
+    if (!require(std::system((invoke + " " + quote(redundant) + " --emit-openqasm-hybrid --schedule > " +
+                              quote(stdout_path) + " 2> " + quote(stderr_path)).c_str()) == 0 &&
+                     read_file(stdout_path).find("h q[0];\nrz(pi/4) q[1];\nh q[0];\nrz(pi/4) q[1];\ncx q[0], q[1];\n") !=
+                         std::string::npos &&
+                     read_file(stderr_path).find("synqc: schedule: depth 4 -> 4 (3 gate layers, 2 moved gates)") !=
+                         std::string::npos,
+                 "scheduled export interleaves commuting gates layer by layer and reports the layers")) return 1;
+    if (!require(std::system((invoke + " " + quote(redundant) + " --simulate --optimize --schedule > " +
+                              quote(stdout_path) + " 2> " + quote(stderr_path)).c_str()) == 0 &&
+                     read_file(stdout_path) == unoptimized_output,
+                 "scheduled simulation prints the unscheduled probabilities")) return 1;
+    if (!require(std::system((invoke + " " + quote(redundant) + " --simulate --schedule --plan-cache " + quote(plan_cache) +
+                              " > " + quote(stdout_path) + " 2> " + quote(stderr_path)).c_str()) != 0 &&
+                     read_file(stderr_path).find("--schedule cannot be combined with --plan-cache") != std::string::npos,
+                 "scheduling is rejected with a cached plan")) return 1;
+
     const int invalid_status = std::system((invoke + " " + quote(invalid) + " --validate > " + quote(stdout_path) +
                                             " 2> " + quote(stderr_path)).c_str());
     if (!require(invalid_status != 0 && read_file(stderr_path).find("SYNQ-S002") != std::string::npos,
                  "validate mode preserves structured diagnostics and nonzero failure")) return 1;
 
+    if (!require(write_file(manifest, simulation + "\n# skipped\n\n" + invalid + "\r\n" + redundant + "\n"),
+                 "writes batch manifest")) return 1;
+    for (const std::string& input : {" --batch " + quote(manifest), " --batch - < " + quote(manifest)}) {
+        const int batch_status = std::system((invoke + input + " --simulate --jobs 2 > " + quote(stdout_path) +
+                                              " 2> " + quote(stderr_path)).c_str());
+        const std::string records = read_file(stdout_path);
+        const auto first = records.find("synq_cli_smoke_simulation.synq\",\"status\":0,");
+        const auto second = records.find("synq_cli_smoke_invalid.synq\",\"status\":3,");
+        const auto third = records.find("synq_cli_smoke_redundant.synq\",\"status\":0,");
+        if (!require(batch_status != 0 && first != std::string::npos && second != std::string::npos &&
+                         third != std::string::npos && first < second && second < third &&
+                         std::count(records.begin(), records.end(), '\n') == 3,
+                     "batch mode prints one JSON record per listed source in manifest order")) return 1;
+        if (!require(records.find("\"code\":\"SYNQ-S002\",\"severity\":\"error\"") != std::string::npos &&
+                         records.find("\"stdout\":\"qubits = 2\\nregister q[2] physical_offset = 0\\n") !=
+                             std::string::npos &&
+                         read_file(stderr_path).find("synqc: batch: 3 sources, 1 failed") != std::string::npos,
+                     "batch records carry diagnostics and each source's output")) return 1;
+    }
+    // The `print` line cannot be lowered, but the parse error after it is the
+    // one reported, with the parse-failure status.
+    if (!require(write_file(manifest, late_parse_error + "\n"), "writes single-source batch manifest")) return 1;
+    std::system((invoke + " --batch " + quote(manifest) + " --validate > " + quote(stdout_path) + " 2> " +
+                 quote(stderr_path)).c_str());
+    if (!require(read_file(stdout_path).find("late_parse_error.synq\",\"status\":3,") != std::string::npos &&
+                     read_file(stdout_path).find("SYNQ-S002") != std::string::npos &&
+                     read_file(stdout_path).find("SYNQ-H001") == std::string::npos,
+                 "a later parse error is reported ahead of an earlier lowering error")) return 1;
+    if (!require(std::system((invoke + " --batch " + quote(manifest) + " --simulate --plan-cache " +
+                              quote(plan_cache) + " > " + quote(stdout_path) + " 2> " + quote(stderr_path)).c_str()) != 0 &&
+                     read_file(stderr_path).find("--out and --plan-cache name one file and are not supported with --batch") !=
+                         std::string::npos,
+                 "batch mode rejects single-file outputs")) return 1;
+
     std::filesystem::remove(quantum);
     std::filesystem::remove(constants);
     std::filesystem::remove(state);
@@ -213,13 +343,17 @@ int main(int argc, char** argv) {
     std::filesystem::remove(multi_register_simulation);
     std::filesystem::remove(named_registers);
     std::filesystem::remove(literal_if);
+    std::filesystem::remove(redundant);
     std::filesystem::remove(invalid);
+    std::filesystem::remove(late_parse_error);
     std::filesystem::remove(qasm);
     std::filesystem::remove(hybrid_qasm);
     std::filesystem::remove(named_hybrid_qasm);
     std::filesystem::remove(literal_if_qasm);
+    std::filesystem::remove(plan_cache);
     std::filesystem::remove(stdout_path);
     std::filesystem::remove(stderr_path);
+    std::filesystem::remove(manifest);
 #ifdef _WIN32
     std::filesystem::remove(launcher);
 #endif
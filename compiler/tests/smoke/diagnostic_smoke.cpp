@@ -3,9 +3,16 @@
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <thread>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#endif
 
 #include "compiler/diagnostic.h"
 #include "compiler/parser.h"
+#include "compiler/source_buffer.h"
 
 namespace {
 
@@ -98,11 +105,55 @@ bool parser_reports_file_and_success_results() {
                    "formatted diagnostics include actionable help");
 }
 
+bool parser_reads_mapped_and_streamed_sources() {
+    const std::string content = "let theta = 0.5\nquantum h q[0]\nmeasure q[0]";
+    const std::string mapped_path = write_fixture("synq_diagnostic_mapped.synq", content);
+    const std::string empty_path = write_fixture("synq_diagnostic_empty.synq", "");
+
+    synq::compiler::SourceBuffer buffer;
+    if (!require(buffer.open(mapped_path) && buffer.text() == content, "source buffers expose the file bytes")) return false;
+#if defined(__unix__) || defined(__APPLE__)
+    if (!require(buffer.mapped(), "regular files are mapped on POSIX hosts")) return false;
+#endif
+    synq::compiler::SourceBuffer moved = std::move(buffer);
+    if (!require(moved.text() == content && buffer.text().empty(), "moving a source buffer transfers its bytes")) return false;
+
+    Parser parser;
+    const auto from_file = parser.parseFileWithDiagnostics(mapped_path);
+    const auto from_source = parser.parseSourceWithDiagnostics(content);
+    const auto empty = parser.parseFileWithDiagnostics(empty_path);
+    std::remove(mapped_path.c_str());
+    std::remove(empty_path.c_str());
+    if (!require(from_file.ok() && from_source.ok() && from_file.program->statements.size() == 3 &&
+                     from_source.program->statements.size() == 3,
+                 "mapped files without a final newline parse like in-memory sources")) return false;
+    if (!require(empty.ok() && empty.program->statements.empty(), "empty files parse to an empty program")) return false;
+
+#if defined(__unix__) || defined(__APPLE__)
+    // A FIFO cannot be mapped, so the parser streams it instead.
+    const std::string fifo_path = (std::filesystem::temp_directory_path() / "synq_diagnostic_fifo.synq").string();
+    std::remove(fifo_path.c_str());
+    if (!require(::mkfifo(fifo_path.c_str(), 0600) == 0, "temporary FIFO can be created")) return false;
+    std::thread writer([&fifo_path, &content]() {
+        std::ofstream fifo(fifo_path, std::ios::binary);
+        fifo << content;
+    });
+    const auto from_fifo = parser.parseFileWithDiagnostics(fifo_path);
+    writer.join();
+    std::remove(fifo_path.c_str());
+    if (!require(from_fifo.ok() && from_fifo.program->statements.size() == 3, "piped sources take the streaming path")) {
+        return false;
+    }
+#endif
+    return true;
+}
+
 }  // namespace
 
 int main() {
     if (!parser_reports_structured_recovery_errors()) return 1;
     if (!parser_reports_file_and_success_results()) return 1;
+    if (!parser_reads_mapped_and_streamed_sources()) return 1;
     std::cout << "SynQ structured diagnostics smoke test passed\n";
     return 0;
 }
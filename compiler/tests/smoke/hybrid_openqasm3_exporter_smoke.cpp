@@ -1,5 +1,8 @@
+#include <cstdio>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "compiler/hybrid_ir.h"
 #include "compiler/openqasm3_exporter.h"
@@ -241,6 +244,106 @@ bool rejects_unsupported_hybrid_boundaries() {
                    "Hybrid export rejects unlowered typed control nodes");
 }
 
+// Records each write separately and refuses write number `refuse_write`
+// (1-based; 0 accepts them all).
+class RecordingSink final : public synq::compiler::OpenQasm3Sink {
+public:
+    explicit RecordingSink(std::size_t refuse_write = 0) : refuse_write_(refuse_write) {}
+
+    bool write(std::string_view text) override {
+        if (writes.size() + 1 == refuse_write_) return false;
+        writes.emplace_back(text);
+        return true;
+    }
+
+    std::string joined() const {
+        std::string text;
+        for (const std::string& write : writes) text += write;
+        return text;
+    }
+
+    std::vector<std::string> writes;
+
+private:
+    std::size_t refuse_write_;
+};
+
+bool streams_exports_through_sinks() {
+    // Large enough to span several output chunks, and through the named
+    // register, if, and feedback lowering that writes piecewise.
+    std::string source =
+        "#[experimental(feature = \"qubit-declarations\")]\n"
+        "#[experimental(feature = \"named-qubit-register-operands\")]\n"
+        "#[experimental(feature = \"classical-control-flow\")]\n"
+        "#[experimental(feature = \"measurement-feedback\")]\n"
+        "qubit data[4]\n"
+        "qubit ancilla[1]\n"
+        "let ready = true\n";
+    for (std::size_t gate = 0; gate < 12000; ++gate) {
+        switch (gate % 3) {
+            case 0: source += "quantum h data[" + std::to_string(gate % 4) + "]\n"; break;
+            case 1: source += "quantum cx data[" + std::to_string(gate % 4) + "], ancilla[0]\n"; break;
+            default: source += "if ready then quantum x data[" + std::to_string(gate % 4) + "]\n"; break;
+        }
+    }
+    source += "measure ancilla[0] as flag\nif flag then quantum x data[0]\nmeasure data[1]\n";
+    bool lowered_ok = false;
+    const auto program = lower_fixture(source, lowered_ok);
+    if (!require(lowered_ok, "large streamed Hybrid fixture lowers")) return false;
+
+    const auto buffered = synq::compiler::export_hybrid_openqasm3(program);
+    if (!require(buffered.ok() && buffered.program.size() > 4 * 64 * 1024,
+                 "large streamed Hybrid fixture exports to a string")) return false;
+
+    RecordingSink recording;
+    const auto streamed = synq::compiler::export_hybrid_openqasm3(program, recording);
+    bool bounded_writes = recording.writes.size() > 1;
+    for (const std::string& write : recording.writes) bounded_writes = bounded_writes && write.size() <= 64 * 1024;
+    if (!require(streamed.ok() && !streamed.sink_failed && streamed.bytes_written == buffered.program.size() &&
+                     recording.joined() == buffered.program,
+                 "a sink receives exactly the string export") ||
+        !require(bounded_writes, "a streamed export reaches the sink in bounded chunks")) {
+        return false;
+    }
+
+    std::string reserved;
+    reserved.reserve(buffered.program.size());
+    synq::compiler::StringOpenQasm3Sink string_sink(reserved);
+    if (!require(synq::compiler::export_hybrid_openqasm3(program, string_sink).ok() && reserved == buffered.program,
+                 "a reserved string sink receives the string export")) {
+        return false;
+    }
+
+    std::FILE* file = std::tmpfile();
+    if (!require(file != nullptr, "streamed export opens a temporary file")) return false;
+    synq::compiler::FileOpenQasm3Sink file_sink(file);
+    const auto filed = synq::compiler::export_hybrid_openqasm3(program, file_sink);
+    std::string file_text(buffered.program.size() + 1, '\0');
+    std::rewind(file);
+    file_text.resize(std::fread(file_text.data(), 1, file_text.size(), file));
+    std::fclose(file);
+    if (!require(filed.ok() && file_text == buffered.program, "a FILE sink receives the string export")) return false;
+
+    RecordingSink refusing(2);
+    const auto stopped = synq::compiler::export_hybrid_openqasm3(program, refusing);
+    if (!require(!stopped.ok() && stopped.sink_failed && refusing.writes.size() == 1 &&
+                     stopped.bytes_written == refusing.writes.front().size() &&
+                     buffered.program.compare(0, stopped.bytes_written, refusing.writes.front()) == 0,
+                 "a refused write stops the export after the accepted prefix")) {
+        return false;
+    }
+
+    bool rejected_ok = false;
+    const auto rejected = lower_fixture(
+        "#[experimental(feature = \"qubit-declarations\")]\nqubit q[1]\nquantum h q[0]\nquantum h q[1]\n",
+        rejected_ok);
+    RecordingSink untouched;
+    const auto rejection = synq::compiler::export_hybrid_openqasm3(rejected, untouched);
+    return require(rejected_ok && !rejection.ok() && !rejection.sink_failed && untouched.writes.empty() &&
+                       rejection.bytes_written == 0,
+                   "a rejected program is never written to the sink");
+}
+
 }  // namespace
 
 int main() {
@@ -248,6 +351,7 @@ int main() {
     if (!exports_explicit_named_register_hybrid_subset()) return 1;
     if (!lowers_bounded_if_gates_and_rejects_wider_control()) return 1;
     if (!rejects_unsupported_hybrid_boundaries()) return 1;
+    if (!streams_exports_through_sinks()) return 1;
     std::cout << "SynQ Hybrid OpenQASM 3 exporter smoke test passed\n";
     return 0;
 }
@@ -133,11 +133,32 @@ bool simulates_branch_enumerated_feedback_without_sampling() {
     const auto reset_lowered = synq::compiler::lower_to_hybrid_ir(*reset_parsed.program);
     const auto reset_resolved = synq::compiler::resolve_hybrid_names(*reset_lowered.program);
     const auto reset_simulated = synq::compiler::simulate_bounded_quantum(*reset_resolved.program, options);
-    return require(reset_parsed.ok() && reset_resolved.ok() && reset_simulated.ok() &&
-                       reset_simulated.simulation->basis_probabilities.size() == 1 &&
-                       reset_simulated.simulation->basis_probabilities.front().basis_index == 0 &&
-                       std::abs(reset_simulated.simulation->basis_probabilities.front().probability - 1.0) < 1e-9,
-                   "same-qubit conditional X correction deterministically restores the ideal |0> branch mixture without sampling");
+    if (!require(reset_parsed.ok() && reset_resolved.ok() && reset_simulated.ok() &&
+                     reset_simulated.simulation->basis_probabilities.size() == 1 &&
+                     reset_simulated.simulation->basis_probabilities.front().basis_index == 0 &&
+                     std::abs(reset_simulated.simulation->basis_probabilities.front().probability - 1.0) < 1e-9,
+                 "same-qubit conditional X correction deterministically restores the ideal |0> branch mixture without sampling")) return false;
+
+    // Unequal branches: P(q[0]=1) = 1/4 and P(q[1]=1) = 1/4 before feedback,
+    // so the corrected branch must flip q[1]'s weights to 3/4.
+    const auto skewed_parsed = parser.parseSourceWithDiagnostics(std::string(u4_prelude()) +
+        "#[experimental(feature = \"parameterized-quantum-gates\")]\n"
+        "qubit q[2]\n"
+        "quantum rx(pi/3) q[0]\n"
+        "quantum ry(pi/3) q[1]\n"
+        "measure q[0] as observed\n"
+        "if observed then quantum x q[1]\n");
+    if (!require(skewed_parsed.ok(), "skewed feedback fixture parses")) return false;
+    const auto skewed_lowered = synq::compiler::lower_to_hybrid_ir(*skewed_parsed.program);
+    const auto skewed_resolved = synq::compiler::resolve_hybrid_names(*skewed_lowered.program);
+    const auto skewed = synq::compiler::simulate_bounded_quantum(*skewed_resolved.program, options);
+    const double expected[4] = {0.5625, 0.0625, 0.1875, 0.1875};
+    bool matches = skewed_resolved.ok() && skewed.ok() && skewed.simulation->basis_probabilities.size() == 4;
+    for (std::size_t basis = 0; matches && basis < 4; ++basis) {
+        const auto& entry = skewed.simulation->basis_probabilities[basis];
+        matches = entry.basis_index == basis && std::abs(entry.probability - expected[basis]) < 1e-9;
+    }
+    return require(matches, "in-place feedback weights each branch and corrects only the observed-one half-space");
 }
 
 bool preserves_legacy_named_result_boundary_without_u4() {
@@ -1,6 +1,7 @@
 // Scoped-name-resolution smoke coverage for the minimal Hybrid IR boundary.
 #include <cstdlib>
 #include <iostream>
+#include <string>
 #include <variant>
 
 #include "compiler/hybrid_ir.h"
@@ -81,5 +82,59 @@ int main() {
     expect(forward.diagnostics[0].span.line == 1,
            "forward binding diagnostic should identify the referring declaration");
 
+    // The side table resolves by node index and expands to the same program.
+    const auto callable_input = lower_successfully(
+        "#[experimental(feature = \"classical-callable-execution\")]\n"
+        "#[experimental(feature = \"multi-formal-classical-callables\")]\n"
+        "fn subtract(left: Integer, right: Integer) -> left - right\n"
+        "let base = 50\n"
+        "let step = 8\n"
+        "let answer = subtract(base, step)\n");
+    const auto callable_table = synq::compiler::resolve_hybrid_name_table(callable_input);
+    expect(callable_table.ok() && callable_table.table->nodes.size() == callable_input.nodes.size(),
+           "the side table should hold one annotation per Hybrid node");
+    const auto& answer = callable_table.table->nodes[3];
+    expect(answer.callable_index == 0 && answer.first_actual_binding_index == 1 &&
+               answer.second_actual_binding_index == 2 &&
+               answer.static_type == synq::compiler::ClassicalStaticType::Integer,
+           "U6 provenance should be recorded as node indices beside the declaration");
+    expect(callable_table.table->binding_nodes.size() == 3 && callable_table.table->binding_nodes[0] == 1,
+           "binding nodes should list the declarations in source order");
+    const auto materialized = synq::compiler::materialize_resolved_program(callable_input, *callable_table.table);
+    const auto* materialized_answer =
+        std::get_if<synq::compiler::ResolvedHybridDeclaration>(&materialized.nodes[3]);
+    expect(materialized_answer != nullptr &&
+               materialized_answer->binary_classical_callable_declaration_index == std::optional<std::size_t>{0} &&
+               materialized_answer->binary_classical_callable_second_actual_binding_index ==
+                   std::optional<std::size_t>{2} &&
+               !materialized_answer->classical_callable_declaration_index.has_value(),
+           "materializing should restore the U6 fields and leave U5 fields absent");
+    const std::string table_rendering =
+        synq::compiler::render_semantic_environment(callable_input, *callable_table.table);
+    expect(table_rendering == synq::compiler::render_semantic_environment(materialized) &&
+               table_rendering.find("binding answer | Value | Integer | line 6 | depends-on base, step") !=
+                   std::string::npos,
+           "the side table should render the same semantic environment as the materialized program");
+
+    const auto feedback_input = lower_successfully(
+        "#[experimental(feature = \"qubit-declarations\")]\n"
+        "#[experimental(feature = \"classical-control-flow\")]\n"
+        "#[experimental(feature = \"measurement-feedback\")]\n"
+        "qubit q[2]\n"
+        "measure q[0] as observed\n"
+        "if observed then quantum x q[1]\n");
+    const auto feedback_table = synq::compiler::resolve_hybrid_name_table(feedback_input);
+    expect(feedback_table.ok() && feedback_table.table->nodes[1].feedback,
+           "the side table should mark a measurement joined with its U4 correction");
+    const auto feedback = synq::compiler::materialize_resolved_program(feedback_input, *feedback_table.table);
+    expect(feedback.nodes.size() == 2 &&
+               std::holds_alternative<synq::compiler::ResolvedHybridMeasurementFeedback>(feedback.nodes[1]),
+           "materializing should fold the feedback pair into one node");
+
+    const auto unknown_table = synq::compiler::resolve_hybrid_name_table(unknown_input);
+    expect(!unknown_table.ok() && !unknown_table.table.has_value() && unknown_table.diagnostics.size() == 1 &&
+               unknown_table.diagnostics[0].code == "SYNQ-R001",
+           "the side table should fail with the same diagnostic and no partial table");
+
     return 0;
 }
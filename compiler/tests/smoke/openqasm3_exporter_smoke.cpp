@@ -4,6 +4,7 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "compiler/ast.h"
 #include "compiler/openqasm3_exporter.h"
@@ -25,9 +26,9 @@ std::string fixture_path(const std::string& filename) {
 
 bool exports_supported_kernels_in_order() {
     ProgramNode program;
-    program.statements.push_back(new InstructionNode("quantum", {"x"}, 1));
-    program.statements.push_back(new InstructionNode("quantum", {"bell_pair"}, 2));
-    program.statements.push_back(new InstructionNode("quantum", {"z"}, 3));
+    program.append<InstructionNode>("quantum", std::vector<std::string>{"x"}, 1);
+    program.append<InstructionNode>("quantum", std::vector<std::string>{"bell_pair"}, 2);
+    program.append<InstructionNode>("quantum", std::vector<std::string>{"z"}, 3);
 
     const auto result = synq::compiler::export_openqasm3(program);
     const std::string expected =
@@ -43,6 +44,33 @@ bool exports_supported_kernels_in_order() {
            require(result.program == expected, "exported OpenQASM 3 matches the bounded fixture exactly");
 }
 
+bool streams_into_a_string_sink() {
+    ProgramNode program;
+    for (std::size_t line = 1; line <= 10000; ++line) {
+        program.append<InstructionNode>("quantum", std::vector<std::string>{"h", "q[" + std::to_string(line % 7) + "]"},
+                                        line);
+        program.append<MeasurementNode>(line % 5, line);
+    }
+    const auto buffered = synq::compiler::export_openqasm3(program);
+    std::string streamed_text;
+    synq::compiler::StringOpenQasm3Sink sink(streamed_text);
+    const auto streamed = synq::compiler::export_openqasm3(program, sink);
+    if (!require(buffered.ok() && streamed.ok() && streamed_text == buffered.program &&
+                     streamed.bytes_written == streamed_text.size() &&
+                     streamed_text.rfind("OPENQASM 3.0;\ninclude \"stdgates.inc\";\nqubit[7] q;\nbit[7] c;\nh q[1];\n", 0) == 0,
+                 "a sink receives the string export, header first")) {
+        return false;
+    }
+
+    program.append<InstructionNode>("quantum", std::vector<std::string>{"swap"}, 20001);
+    std::string rejected_text;
+    synq::compiler::StringOpenQasm3Sink rejected_sink(rejected_text);
+    const auto rejected = synq::compiler::export_openqasm3(program, rejected_sink);
+    return require(!rejected.ok() && !rejected.sink_failed && rejected_text.empty() &&
+                       rejected.diagnostics.size() == 1 && rejected.diagnostics.front().rfind("line 20001:", 0) == 0,
+                   "an export rejected on its last line writes nothing to the sink");
+}
+
 bool exports_parsed_quantum_fixture() {
     const std::string path = fixture_path("synq_openqasm3_fixture.synq");
     std::ofstream fixture(path);
@@ -91,10 +119,9 @@ bool exports_explicit_qubit_operands() {
 
 bool exports_typed_measurements() {
     ProgramNode program;
-    program.statements.push_back(new QuantumGateNode(QuantumGateKind::H, "h", std::nullopt,
-                                                     std::vector<std::size_t>{3}, 1));
-    program.statements.push_back(new MeasurementNode(3, 2));
-    program.statements.push_back(new MeasurementNode(1, 3));
+    program.append<QuantumGateNode>(QuantumGateKind::H, "h", std::nullopt, std::vector<std::size_t>{3}, 1);
+    program.append<MeasurementNode>(3, 2);
+    program.append<MeasurementNode>(1, 3);
 
     const auto result = synq::compiler::export_openqasm3(program);
     const std::string expected =
@@ -111,9 +138,9 @@ bool exports_typed_measurements() {
 
 bool rejects_invalid_explicit_operands() {
     ProgramNode program;
-    program.statements.push_back(new InstructionNode("quantum", {"cx", "q[0]"}, 7));
-    program.statements.push_back(new InstructionNode("quantum", {"h", "q[0]", "q[1]"}, 8));
-    program.statements.push_back(new InstructionNode("quantum", {"x", "q[not-an-index]"}, 9));
+    program.append<InstructionNode>("quantum", std::vector<std::string>{"cx", "q[0]"}, 7);
+    program.append<InstructionNode>("quantum", std::vector<std::string>{"h", "q[0]", "q[1]"}, 8);
+    program.append<InstructionNode>("quantum", std::vector<std::string>{"x", "q[not-an-index]"}, 9);
 
     const auto result = synq::compiler::export_openqasm3(program);
     return require(!result.ok(), "invalid explicit operand forms fail export") &&
@@ -155,9 +182,9 @@ bool exports_literal_angle_gates() {
 
 bool rejects_invalid_parameterized_gates() {
     ProgramNode program;
-    program.statements.push_back(new InstructionNode("quantum", {"rx(pi/2)", "q[0]", "q[1]"}, 10));
-    program.statements.push_back(new InstructionNode("quantum", {"crx(pi/2)", "q[0]"}, 11));
-    program.statements.push_back(new InstructionNode("quantum", {"rz(theta)", "q[0]"}, 12));
+    program.append<InstructionNode>("quantum", std::vector<std::string>{"rx(pi/2)", "q[0]", "q[1]"}, 10);
+    program.append<InstructionNode>("quantum", std::vector<std::string>{"crx(pi/2)", "q[0]"}, 11);
+    program.append<InstructionNode>("quantum", std::vector<std::string>{"rz(theta)", "q[0]"}, 12);
 
     const auto result = synq::compiler::export_openqasm3(program);
     return require(!result.ok(), "invalid parameterized gates fail export") &&
@@ -170,9 +197,9 @@ bool rejects_invalid_parameterized_gates() {
 
 bool rejects_unsupported_recovery_statements() {
     ProgramNode program;
-    program.statements.push_back(new DeclarationNode("theta", "0.5", 4));
-    program.statements.push_back(new InstructionNode("quantum", {"qaoa"}, 5));
-    program.statements.push_back(new InstructionNode("print", {"hello"}, 6));
+    program.append<DeclarationNode>("theta", "0.5", 4);
+    program.append<InstructionNode>("quantum", std::vector<std::string>{"qaoa"}, 5);
+    program.append<InstructionNode>("print", std::vector<std::string>{"hello"}, 6);
 
     const auto result = synq::compiler::export_openqasm3(program);
     return require(!result.ok(), "unsupported statements make the exporter fail") &&
@@ -185,14 +212,14 @@ bool rejects_unsupported_recovery_statements() {
 
 bool writes_reference_parser_fixture(const std::string& path) {
     ProgramNode program;
-    program.statements.push_back(new InstructionNode("quantum", {"h", "q[3]"}, 1));
-    program.statements.push_back(new InstructionNode("quantum", {"cx", "q[3]", "q[5]"}, 2));
-    program.statements.push_back(new InstructionNode("quantum", {"bell_pair", "q[1]", "q[4]"}, 3));
-    program.statements.push_back(new InstructionNode("quantum", {"rx(pi/2)", "q[0]"}, 4));
-    program.statements.push_back(new InstructionNode("quantum", {"ry(-pi/4)", "q[2]"}, 5));
-    program.statements.push_back(new InstructionNode("quantum", {"rz(0.125)", "q[1]"}, 6));
-    program.statements.push_back(new InstructionNode("quantum", {"p(pi)", "q[3]"}, 7));
-    program.statements.push_back(new MeasurementNode(5, 8));
+    program.append<InstructionNode>("quantum", std::vector<std::string>{"h", "q[3]"}, 1);
+    program.append<InstructionNode>("quantum", std::vector<std::string>{"cx", "q[3]", "q[5]"}, 2);
+    program.append<InstructionNode>("quantum", std::vector<std::string>{"bell_pair", "q[1]", "q[4]"}, 3);
+    program.append<InstructionNode>("quantum", std::vector<std::string>{"rx(pi/2)", "q[0]"}, 4);
+    program.append<InstructionNode>("quantum", std::vector<std::string>{"ry(-pi/4)", "q[2]"}, 5);
+    program.append<InstructionNode>("quantum", std::vector<std::string>{"rz(0.125)", "q[1]"}, 6);
+    program.append<InstructionNode>("quantum", std::vector<std::string>{"p(pi)", "q[3]"}, 7);
+    program.append<MeasurementNode>(5, 8);
     const auto result = synq::compiler::export_openqasm3(program);
     if (!require(result.ok(), "reference-parser fixture exports successfully")) return false;
 
@@ -206,6 +233,7 @@ bool writes_reference_parser_fixture(const std::string& path) {
 int main(int argc, char* argv[]) {
     if (!exports_supported_kernels_in_order()) return 1;
     if (!exports_parsed_quantum_fixture()) return 1;
+    if (!streams_into_a_string_sink()) return 1;
     if (!exports_explicit_qubit_operands()) return 1;
     if (!exports_typed_measurements()) return 1;
     if (!rejects_invalid_explicit_operands()) return 1;
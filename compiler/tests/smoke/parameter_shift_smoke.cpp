@@ -0,0 +1,81 @@
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "compiler/bounded_simulator.h"
+#include "compiler/hybrid_ir.h"
+#include "compiler/name_resolution.h"
+#include "compiler/parser.h"
+#include "optimizer/stratergies/quantum/shift.h"
+
+namespace {
+
+bool require(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "FAIL: " << message << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool near(double actual, double expected) { return std::abs(actual - expected) < 1e-9; }
+
+bool has_code(const std::vector<synq::compiler::Diagnostic>& diagnostics, const std::string& code) {
+    return diagnostics.size() == 1 && diagnostics.front().code == code;
+}
+
+// The central difference of P(1) = (1 - cos(k x)) / 2 for a ry rotation by k x.
+double expected_slope(double angle, double shift, double k) {
+    return std::sin(k * angle) * std::sin(k * shift) / (2.0 * shift);
+}
+
+bool sweeps_every_shifted_point_in_one_batch() {
+    const std::string source =
+        "#[experimental(feature = \"qubit-declarations\")]\n"
+        "#[experimental(feature = \"parameterized-quantum-gates\")]\n"
+        "qubit q[2]\nquantum ry(0) q[0]\nquantum ry(0) q[1]\nquantum ry(0) q[1]\n"
+        "measure q[0]\nmeasure q[1]\n";
+    Parser parser;
+    const auto parsed = parser.parseSourceWithDiagnostics(source);
+    if (!require(parsed.ok(), "gradient fixture parses")) return false;
+    const auto lowered = synq::compiler::lower_to_hybrid_ir(*parsed.program);
+    const auto resolved = synq::compiler::resolve_hybrid_names(*lowered.program);
+    if (!require(lowered.ok() && resolved.ok(), "gradient fixture lowers and resolves")) return false;
+
+    synq::compiler::BoundedSimulationOptions options;
+    options.allow_experimental_local_simulation = true;
+    options.threads = 2;
+    // Observable: P(q[0] = 1) + 2 P(q[1] = 1). `phi` drives both q[1] rotations,
+    // so each of its shifted points moves two columns and rotates by 2 phi.
+    const auto observable = [](const synq::compiler::ParameterSweep& sweep, std::size_t binding) {
+        return sweep.probability(0, binding) + 2.0 * sweep.probability(1, binding);
+    };
+    const synq::quantum::ParamMap params{{"phi", 0.4}, {"theta", 0.7}};
+    std::vector<synq::compiler::Diagnostic> diagnostics;
+    const auto gradient = synq::quantum::parameterShiftGradient(*resolved.program, {"theta", "phi", "phi"}, params,
+                                                                observable, options, diagnostics, 0.1);
+    if (!require(diagnostics.empty() && gradient.size() == 2, "gradient sweep runs")) return false;
+    if (!require(near(gradient.at("theta"), expected_slope(0.7, 0.1, 1.0)),
+                 "theta gradient matches the central difference")) return false;
+    if (!require(near(gradient.at("phi"), 2.0 * expected_slope(0.4, 0.1, 2.0)),
+                 "a parameter shared by two columns shifts both")) return false;
+
+    const auto unknown = synq::quantum::parameterShiftGradient(*resolved.program, {"theta", "phi", "psi"}, params,
+                                                               observable, options, diagnostics, 0.1);
+    if (!require(unknown.empty() && has_code(diagnostics, "SYNQ-SIM008"),
+                 "a column naming no parameter is rejected")) return false;
+    diagnostics.clear();
+    const auto narrow = synq::quantum::parameterShiftGradient(*resolved.program, {"theta", "phi"}, params,
+                                                              observable, options, diagnostics, 0.1);
+    return require(narrow.empty() && has_code(diagnostics, "SYNQ-SIM008"),
+                   "a column list narrower than the rotation count is rejected by the sweep");
+}
+
+}  // namespace
+
+int main() {
+    if (!sweeps_every_shifted_point_in_one_batch()) return 1;
+    std::cout << "SynQ parameter-shift gradient smoke test passed\n";
+    return 0;
+}
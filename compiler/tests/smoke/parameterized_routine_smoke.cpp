@@ -218,7 +218,7 @@ bool bounds_export_expansion_and_rejects_unexpanded_nodes() {
                  "strict Hybrid export rejects more than 128 U3 calls")) return false;
 
     HybridProgram malformed;
-    malformed.nodes.emplace_back(HybridQubitDeclaration{"q", 1, SourceSpan{1, 1, 1}});
+    malformed.nodes.emplace_back(HybridQubitDeclaration{malformed.symbols.intern("q"), 1, SourceSpan{1, 1, 1}});
     malformed.nodes.emplace_back(HybridCallableDeclaration{
         CallableDeclarationKind::Kernel,
         "bad",
@@ -7,6 +7,7 @@
 #include <string>
 
 #include "compiler/ast.h"
+#include "compiler/parse_session.h"
 #include "compiler/parser.h"
 #include "compiler/runtime.h"
 
@@ -187,6 +188,32 @@ bool parser_constructs_typed_measurements() {
                    "parser constructs a typed measurement with source provenance");
 }
 
+bool parser_tags_arena_nodes() {
+    Parser parser;
+    const auto parsed = parser.parseSourceWithDiagnostics(
+        "#[experimental(feature = \"classical-control-flow\")]\n"
+        "#[experimental(feature = \"callable-declarations\")]\n"
+        "let theta = 0.5\n"
+        "quantum h q[0]\n"
+        "if true then measure q[0]\n"
+        "kernel prepare() { quantum h q[1] }\n");
+    if (!require(parsed.ok() && parsed.program->statements.size() == 4, "parser accepts the tagging fixture")) {
+        return false;
+    }
+    const ProgramNode& program = *parsed.program;
+    const auto* control = node_cast<ClassicalControlNode>(program.statements[2]);
+    const auto* kernel = node_cast<CallableDeclarationNode>(program.statements[3]);
+    if (!require(program.node_kind() == ASTNodeKind::Program &&
+                     program.statements[0]->node_kind() == ASTNodeKind::Declaration &&
+                     program.statements[1]->node_kind() == ASTNodeKind::QuantumGate &&
+                     node_cast<QuantumGateNode>(program.statements[0]) == nullptr,
+                 "statements carry their node kind and node_cast rejects other kinds")) return false;
+    if (!require(control != nullptr && node_cast<MeasurementNode>(control->body) != nullptr &&
+                     kernel != nullptr && kernel->body != nullptr && kernel->body->node_kind() == ASTNodeKind::QuantumGate,
+                 "nested bodies are tagged like statements")) return false;
+    return require(program.arena.node_count() == 6, "statements and nested bodies share the program arena");
+}
+
 bool parser_accepts_explicit_qubit_operands() {
     const std::string path = write_fixture(
         "synq_parser_explicit_qubits_fixture.synq",
@@ -319,6 +346,86 @@ bool parser_enforces_experimental_feature_gate() {
            require(configured != nullptr, "parser accepts an explicitly configured alpha feature");
 }
 
+// The session must agree with a full parse of its text after every edit.
+bool session_agrees_with_full_parse(const synq::compiler::ParseSession& session, const std::string& label) {
+    Parser parser;
+    const synq::compiler::ParseResult full = parser.parseSourceWithDiagnostics(session.text());
+    bool same = full.ok() == session.ok() && full.diagnostics.size() == session.diagnostics().size();
+    for (std::size_t index = 0; same && index < full.diagnostics.size(); ++index) {
+        const synq::compiler::Diagnostic& expected = full.diagnostics[index];
+        const synq::compiler::Diagnostic& actual = session.diagnostics()[index];
+        same = expected.code == actual.code && expected.message == actual.message &&
+               has_span(actual.span, expected.span.line, expected.span.column_start, expected.span.column_end);
+    }
+    if (same && full.ok()) {
+        same = full.program->statements.size() == session.program()->statements.size();
+        for (std::size_t index = 0; same && index < full.program->statements.size(); ++index) {
+            ASTNode* expected = full.program->statements[index];
+            ASTNode* actual = session.program()->statements[index];
+            same = expected->node_kind() == actual->node_kind() && expected->toString() == actual->toString();
+        }
+    }
+    return require(same, "incremental session matches a full parse: " + label);
+}
+
+bool parse_session_reparses_only_edited_lines() {
+    synq::compiler::ParseSession session;
+    session.open("let a = 1\nlet b = 2\nprint a\n");
+    if (!require(session.ok() && session.line_count() == 4 && session.last_stats().reparsed_lines == 4,
+                 "session opens and parses every line")) {
+        return false;
+    }
+
+    if (!require(session.apply_edit({{2, 6}, {2, 7}, "b"}) && session.ok(), "session applies a one-line edit") ||
+        !require(session.last_stats().reparsed_lines == 1 && session.last_stats().replayed_lines == 1,
+                 "a one-line edit reparses only that line") ||
+        !session_agrees_with_full_parse(session, "one-line edit")) {
+        return false;
+    }
+    const auto* print = node_cast<InstructionNode>(session.program()->statements[2]);
+    if (!require(print != nullptr && print->args.front() == "b" && has_span(print->span, 3, 1, 8),
+                 "edited statement keeps its line")) {
+        return false;
+    }
+
+    if (!require(session.apply_edit({{0, 0}, {0, 0}, "let b = 3\n"}) && !session.ok(),
+                 "an inserted declaration makes the unchanged later one a duplicate") ||
+        !require(session.diagnostics().front().code == "SYNQ-S004" && session.diagnostics().front().span.line == 3,
+                 "the duplicate is reported on the moved line") ||
+        !session_agrees_with_full_parse(session, "inserted duplicate")) {
+        return false;
+    }
+
+    if (!require(session.apply_edit({{0, 0}, {1, 0}, ""}) && session.ok(), "removing the duplicate recovers") ||
+        !require(session.last_stats().reparsed_lines == 2, "the rewritten line and the rejected line are reparsed") ||
+        !session_agrees_with_full_parse(session, "removed duplicate")) {
+        return false;
+    }
+    const auto* declaration = node_cast<DeclarationNode>(session.program()->statements[1]);
+    if (!require(declaration != nullptr && declaration->line == 2 && has_span(declaration->span, 2, 1, 10),
+                 "replayed statements are renumbered after a line is removed")) {
+        return false;
+    }
+
+    session.open("#[experimental(feature = \"classical-control-flow\")]\n"
+                 "measure q[0] as observed\n"
+                 "print gap\n"
+                 "if observed then quantum x q[1]\n");
+    if (!require(session.ok(), "feedback-shaped control flow parses after an unrelated statement") ||
+        !require(session.apply_edit({{2, 0}, {3, 0}, ""}) && !session.ok(),
+                 "removing the gap exposes the measurement feedback gate") ||
+        !require(session.diagnostics().front().code == "SYNQ-P007", "the unchanged if line is revalidated") ||
+        !session_agrees_with_full_parse(session, "feedback gate")) {
+        return false;
+    }
+    return require(session.apply_edit({{0, 0}, {0, 0}, "#[experimental(feature = \"measurement-feedback\")]\n"}) &&
+                       session.ok(),
+                   "an inserted annotation reparses later lines under the new feature set") &&
+           session_agrees_with_full_parse(session, "inserted annotation") &&
+           require(!session.apply_edit({{9, 0}, {9, 0}, "print x"}) && session.ok(),
+                   "an edit outside the document is rejected without changes");
+}
+
 bool runtime_executes_supported_and_fallback_paths() {
     synq::compiler::Program program{
         {
@@ -364,11 +471,13 @@ int main() {
     if (!parser_classifies_classical_literals()) return 1;
     if (!parser_assigns_source_provenance()) return 1;
     if (!parser_constructs_typed_measurements()) return 1;
+    if (!parser_tags_arena_nodes()) return 1;
     if (!parser_accepts_explicit_qubit_operands()) return 1;
     if (!parser_rejects_malformed_qubit_operands()) return 1;
     if (!parser_accepts_literal_angle_parameters()) return 1;
     if (!parser_rejects_unsupported_parameter_forms()) return 1;
     if (!parser_enforces_experimental_feature_gate()) return 1;
+    if (!parse_session_reparses_only_edited_lines()) return 1;
     if (!runtime_executes_supported_and_fallback_paths()) return 1;
 
     std::cout << "SynQ parser and runtime smoke test passed\n";
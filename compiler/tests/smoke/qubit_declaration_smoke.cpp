@@ -1,5 +1,7 @@
 #include <iostream>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "compiler/hybrid_ir.h"
 #include "compiler/name_resolution.h"
@@ -36,7 +38,8 @@ bool parses_lowers_and_resolves_qubit_declarations() {
     const auto lowered = synq::compiler::lower_to_hybrid_ir(*parsed.program);
     if (!require(lowered.ok(), "qubit declaration fixture lowers to Hybrid IR")) return false;
     const auto* hybrid_declaration = std::get_if<synq::compiler::HybridQubitDeclaration>(&lowered.program->nodes.at(0));
-    if (!require(hybrid_declaration != nullptr && hybrid_declaration->name == "register" &&
+    if (!require(hybrid_declaration != nullptr &&
+                     lowered.program->symbols.name(hybrid_declaration->name) == "register" &&
                      hybrid_declaration->qubit_count == 3 && hybrid_declaration->span.line == 2,
                  "Hybrid IR preserves bounded qubit allocation metadata")) return false;
 
@@ -150,6 +153,14 @@ bool validates_named_register_operands() {
     const auto lowered = synq::compiler::lower_to_hybrid_ir(*parsed.program);
     const auto resolved = synq::compiler::resolve_hybrid_names(*lowered.program);
     if (!require(lowered.ok() && resolved.ok(), "declared in-range named operands lower and resolve")) return false;
+    const auto& symbols = lowered.program->symbols;
+    const auto* hybrid_gate = std::get_if<synq::compiler::HybridQuantumGate>(&lowered.program->nodes.at(2));
+    const auto* hybrid_measurement = std::get_if<synq::compiler::HybridMeasurement>(&lowered.program->nodes.at(3));
+    if (!require(symbols.size() == 2 && symbols.name(0) == "data" && symbols.name(1) == "ancilla" &&
+                     hybrid_gate != nullptr && hybrid_gate->qubit_registers == std::vector<synq::compiler::SymbolId>{0, 1} &&
+                     hybrid_measurement != nullptr && hybrid_measurement->qubit_register == 0 &&
+                     resolved.program->symbols.find("ancilla") == std::optional<synq::compiler::SymbolId>{1},
+                 "Hybrid IR interns each register name once in first-use order")) return false;
 
     const auto forward = parser.parseSourceWithDiagnostics(
         "#[experimental(feature = \"qubit-declarations\")]\n"
@@ -0,0 +1,187 @@
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "compiler/statevector_kernels.h"
+
+namespace {
+
+using Complex = std::complex<double>;
+using synq::compiler::KernelOpcode;
+using synq::compiler::KernelOperation;
+
+constexpr std::size_t kQubits = 7;
+constexpr std::size_t kAmplitudes = std::size_t{1} << kQubits;
+
+bool require(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "FAIL: " << message << "\n";
+        return false;
+    }
+    return true;
+}
+
+class Lcg {
+public:
+    double next() {
+        state_ = state_ * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<double>(state_ >> 11) / 9007199254740992.0 - 0.5;
+    }
+    Complex complex() { return {next(), next()}; }
+
+private:
+    std::uint64_t state_ = 0x5eed;
+};
+
+using EntryPoint = void (*)(double*, const KernelOperation&, std::size_t, std::size_t);
+
+// Applies one operation through the reference scalar kernel and `candidate`,
+// over the full group range and over an unaligned interior range that forces
+// partial vector runs, and requires matching amplitudes.
+bool matches_scalar(EntryPoint candidate, const std::string& isa, const KernelOperation& operation,
+                    const std::vector<Complex>& input) {
+    const bool pair = operation.opcode == KernelOpcode::Pair || operation.opcode == KernelOpcode::ControlledX;
+    const std::size_t groups = kAmplitudes >> (pair ? 2 : 1);
+    const std::size_t ranges[2][2] = {{0, groups}, {3, groups - 5}};
+    for (const auto& range : ranges) {
+        std::vector<Complex> expected = input;
+        std::vector<Complex> actual = input;
+        synq::compiler::apply_kernel_operation_scalar(reinterpret_cast<double*>(expected.data()), operation,
+                                                      range[0], range[1]);
+        candidate(reinterpret_cast<double*>(actual.data()), operation, range[0], range[1]);
+        for (std::size_t basis = 0; basis < kAmplitudes; ++basis) {
+            if (std::abs(expected[basis] - actual[basis]) > 1e-12) {
+                return require(false, isa + " kernel matches scalar for opcode " +
+                                          std::to_string(static_cast<int>(operation.opcode)) + " on qubits " +
+                                          std::to_string(operation.first) + "," + std::to_string(operation.second));
+            }
+        }
+    }
+    return true;
+}
+
+bool classifies_specialized_shapes() {
+    const Complex zero{0.0, 0.0}, one{1.0, 0.0}, phase{0.0, 1.0};
+    const Complex diagonal[4] = {one, zero, zero, phase};
+    const Complex pauli_x[4] = {zero, one, one, zero};
+    const Complex hadamard[4] = {one, one, one, -one};
+    Complex controlled_x[16] = {};
+    for (std::size_t column = 0; column < 4; ++column) controlled_x[(column ^ ((column & 1) << 1)) * 4 + column] = one;
+    const KernelOperation controlled = synq::compiler::make_pair_kernel_operation(4, 1, controlled_x);
+    return require(synq::compiler::make_single_kernel_operation(2, diagonal).opcode == KernelOpcode::Diagonal &&
+                       synq::compiler::make_single_kernel_operation(2, pauli_x).opcode == KernelOpcode::PauliX &&
+                       synq::compiler::make_single_kernel_operation(2, hadamard).opcode == KernelOpcode::Single &&
+                       controlled.opcode == KernelOpcode::ControlledX && controlled.first == 4 &&
+                       controlled.second == 1,
+                   "exact diagonal and permutation unitaries select the specialized sweeps");
+}
+
+bool vector_kernels_match_scalar_reference(EntryPoint candidate, const std::string& isa) {
+    Lcg random;
+    std::vector<Complex> input(kAmplitudes);
+    for (auto& amplitude : input) amplitude = random.complex();
+
+    const Complex zero{0.0, 0.0}, one{1.0, 0.0};
+    for (std::size_t qubit = 0; qubit < kQubits; ++qubit) {
+        const Complex general[4] = {random.complex(), random.complex(), random.complex(), random.complex()};
+        const Complex diagonal[4] = {random.complex(), zero, zero, random.complex()};
+        const Complex half_diagonal[4] = {one, zero, zero, random.complex()};
+        const Complex pauli_x[4] = {zero, one, one, zero};
+        for (const Complex* matrix : {general, diagonal, half_diagonal, pauli_x}) {
+            if (!matches_scalar(candidate, isa, synq::compiler::make_single_kernel_operation(qubit, matrix), input)) {
+                return false;
+            }
+        }
+    }
+    Complex controlled_x[16] = {};
+    for (std::size_t column = 0; column < 4; ++column) controlled_x[(column ^ ((column & 1) << 1)) * 4 + column] = one;
+    for (std::size_t first = 0; first < kQubits; ++first) {
+        for (std::size_t second = 0; second < kQubits; ++second) {
+            if (first == second) continue;
+            Complex general[16];
+            for (auto& entry : general) entry = random.complex();
+            if (!matches_scalar(candidate, isa, synq::compiler::make_pair_kernel_operation(first, second, general), input) ||
+                !matches_scalar(candidate, isa, synq::compiler::make_pair_kernel_operation(first, second, controlled_x), input)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Single-precision sweeps: the AVX2 path must match the scalar float kernel,
+// and both must stay close to the double-precision reference.
+bool single_precision_kernels_track_double_precision(bool vector_available) {
+    using ComplexF = std::complex<float>;
+    Lcg random;
+    std::vector<Complex> input(kAmplitudes);
+    for (auto& amplitude : input) amplitude = random.complex();
+    std::vector<KernelOperation> operations;
+    const Complex zero{0.0, 0.0}, one{1.0, 0.0};
+    for (std::size_t qubit = 0; qubit < kQubits; ++qubit) {
+        const Complex general[4] = {random.complex(), random.complex(), random.complex(), random.complex()};
+        const Complex diagonal[4] = {random.complex(), zero, zero, random.complex()};
+        const Complex pauli_x[4] = {zero, one, one, zero};
+        for (const Complex* matrix : {general, diagonal, pauli_x}) {
+            operations.push_back(synq::compiler::make_single_kernel_operation(qubit, matrix));
+        }
+    }
+    Complex controlled_x[16] = {};
+    for (std::size_t column = 0; column < 4; ++column) controlled_x[(column ^ ((column & 1) << 1)) * 4 + column] = one;
+    for (std::size_t first = 0; first < kQubits; ++first) {
+        for (std::size_t second = 0; second < kQubits; ++second) {
+            if (first == second) continue;
+            Complex general[16];
+            for (auto& entry : general) entry = random.complex();
+            operations.push_back(synq::compiler::make_pair_kernel_operation(first, second, general));
+            operations.push_back(synq::compiler::make_pair_kernel_operation(first, second, controlled_x));
+        }
+    }
+
+    for (const auto& operation : operations) {
+        const bool pair = operation.opcode == KernelOpcode::Pair || operation.opcode == KernelOpcode::ControlledX;
+        const std::size_t groups = kAmplitudes >> (pair ? 2 : 1);
+        std::vector<Complex> reference = input;
+        std::vector<ComplexF> scalar(input.begin(), input.end());
+        std::vector<ComplexF> vector = scalar;
+        synq::compiler::apply_kernel_operation_scalar(reinterpret_cast<double*>(reference.data()), operation, 0, groups);
+        synq::compiler::apply_kernel_operation_scalar_f32(reinterpret_cast<float*>(scalar.data()), operation, 0, groups);
+        if (vector_available) {
+            synq::compiler::apply_kernel_operation_avx2_f32(reinterpret_cast<float*>(vector.data()), operation, 0,
+                                                            groups);
+        }
+        for (std::size_t basis = 0; basis < kAmplitudes; ++basis) {
+            const Complex widened(scalar[basis]);
+            if (!require(std::abs(widened - reference[basis]) < 1e-5 &&
+                             (!vector_available || std::abs(vector[basis] - scalar[basis]) < 1e-5f),
+                         "single-precision kernels track double precision for opcode " +
+                             std::to_string(static_cast<int>(operation.opcode)) + " on qubits " +
+                             std::to_string(operation.first) + "," + std::to_string(operation.second))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main() {
+    if (!classifies_specialized_shapes()) return 1;
+    const auto isa = synq::compiler::detect_simulation_kernel_isa();
+    if (isa == synq::compiler::SimulationKernelIsa::Avx512 &&
+        !vector_kernels_match_scalar_reference(synq::compiler::apply_kernel_operation_avx512, "avx512")) {
+        return 1;
+    }
+    if (isa != synq::compiler::SimulationKernelIsa::Scalar &&
+        !vector_kernels_match_scalar_reference(synq::compiler::apply_kernel_operation_avx2, "avx2")) {
+        return 1;
+    }
+    if (!single_precision_kernels_track_double_precision(isa != synq::compiler::SimulationKernelIsa::Scalar)) return 1;
+    std::cout << "SynQ state-vector kernel smoke test passed ("<< synq::compiler::simulation_kernel_isa_name(isa)
+              << ")\n";
+    return 0;
+}
@@ -1,11 +1,21 @@
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
 
+#include "compiler/bounded_evaluator.h"
 #include "compiler/bounded_simulator.h"
+#include "compiler/circuit_optimizer.h"
 #include "compiler/hybrid_ir.h"
 #include "compiler/name_resolution.h"
+#include "compiler/openqasm3_exporter.h"
+#include "compiler/parse_session.h"
 #include "compiler/parser.h"
 
 namespace {
@@ -52,18 +62,551 @@ int main(int argc, char** argv) {
     synq::compiler::BoundedSimulationOptions options;
     options.allow_experimental_local_simulation = true;
     volatile double sink = 0.0;
+    synq::compiler::SimulationKernelIsa kernel_isa = synq::compiler::SimulationKernelIsa::Scalar;
     const auto started = std::chrono::steady_clock::now();
     for (std::size_t iteration = 0; iteration < iterations; ++iteration) {
         const auto simulation = synq::compiler::simulate_bounded_quantum(*resolved.program, options);
         if (!simulation.ok() || simulation.simulation->basis_probabilities.size() != 2) return 5;
         sink += simulation.simulation->measurements.front().probability_one;
+        kernel_isa = simulation.simulation->kernel_isa;
     }
     const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
     const double per_second = static_cast<double>(iterations) / elapsed;
+
+    // The same circuit through a prepared plan and reused workspace, which
+    // skips lowering and reuses every buffer after the first run.
+    const auto prepared = synq::compiler::prepare_bounded_simulation(*resolved.program, options);
+    if (!prepared.ok()) return 5;
+    synq::compiler::SimulationWorkspace workspace;
+    synq::compiler::BoundedSimulation reused;
+    std::vector<synq::compiler::Diagnostic> diagnostics;
+    const auto prepared_started = std::chrono::steady_clock::now();
+    for (std::size_t iteration = 0; iteration < iterations; ++iteration) {
+        if (!synq::compiler::run_bounded_simulation(*prepared.plan, options, workspace, reused, diagnostics) ||
+            reused.basis_probabilities.size() != 2) {
+            return 5;
+        }
+        sink += reused.measurements.front().probability_one;
+    }
+    const auto prepared_elapsed =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - prepared_started).count();
+    const double prepared_per_second = static_cast<double>(iterations) / prepared_elapsed;
+
+    // A register wide enough that amplitude sweeps dominate, run in both
+    // storage precisions through one prepared plan.
+    constexpr std::size_t kWideQubits = 18;
+    std::string wide_source =
+        "#[experimental(feature = \"qubit-declarations\")]\n"
+        "#[experimental(feature = \"parameterized-quantum-gates\")]\n"
+        "qubit q[" + std::to_string(kWideQubits) + "]\n";
+    for (std::size_t qubit = 0; qubit < kWideQubits; ++qubit) {
+        wide_source += "quantum ry(pi/" + std::to_string(qubit + 2) + ") q[" + std::to_string(qubit) + "]\n";
+    }
+    for (std::size_t qubit = 0; qubit + 1 < kWideQubits; ++qubit) {
+        wide_source += "quantum cx q[" + std::to_string(qubit) + "], q[" + std::to_string(qubit + 1) + "]\n";
+    }
+    wide_source += "measure q[0]\n";
+    const auto wide_parsed = parser.parseSourceWithDiagnostics(wide_source);
+    if (!wide_parsed.ok()) return 3;
+    const auto wide_lowered = synq::compiler::lower_to_hybrid_ir(*wide_parsed.program);
+    if (!wide_lowered.ok()) return 4;
+    const auto wide_resolved = synq::compiler::resolve_hybrid_names(*wide_lowered.program);
+    if (!wide_resolved.ok()) return 4;
+    synq::compiler::BoundedSimulationOptions wide_options = options;
+    wide_options.max_qubits = kWideQubits;
+    const auto wide_plan = synq::compiler::prepare_bounded_simulation(*wide_resolved.program, wide_options);
+    if (!wide_plan.ok()) return 5;
+    const std::size_t wide_iterations = iterations / 100 == 0 ? 1 : iterations / 100;
+    const auto time_wide = [&](synq::compiler::SimulationPrecision precision, bool cache_block, double& seconds) {
+        wide_options.precision = precision;
+        wide_options.cache_block_sweeps = cache_block;
+        const auto wide_started = std::chrono::steady_clock::now();
+        for (std::size_t iteration = 0; iteration < wide_iterations; ++iteration) {
+            if (!synq::compiler::run_bounded_simulation(*wide_plan.plan, wide_options, workspace, reused, diagnostics)) {
+                return false;
+            }
+            sink += reused.measurements.front().probability_one;
+        }
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wide_started).count();
+        return true;
+    };
+    // The same f64 run with one full sweep per operation shows what applying
+    // the low-qubit runs block by block saves.
+    double wide_f64_elapsed = 0.0;
+    double wide_f32_elapsed = 0.0;
+    double wide_unblocked_elapsed = 0.0;
+    if (!time_wide(synq::compiler::SimulationPrecision::F64, true, wide_f64_elapsed) ||
+        !time_wide(synq::compiler::SimulationPrecision::F32, true, wide_f32_elapsed) ||
+        !time_wide(synq::compiler::SimulationPrecision::F64, false, wide_unblocked_elapsed)) {
+        return 5;
+    }
+    // Front-end throughput: one generated million-line source, parsed from an
+    // in-memory buffer; the best of three runs is reported.
+    constexpr std::size_t kParseLines = 1000000;
+    std::string parse_source =
+        "#[experimental(feature = \"qubit-declarations\")]\n"
+        "#[experimental(feature = \"parameterized-quantum-gates\")]\n"
+        "qubit q[8]\n";
+    for (std::size_t line = 3; line < kParseLines; ++line) {
+        const std::string qubit = std::to_string(line % 8);
+        switch (line % 5) {
+            case 0: parse_source += "quantum h q[" + qubit + "]\n"; break;
+            case 1: parse_source += "quantum cx q[" + qubit + "], q[" + std::to_string((line + 1) % 8) + "]\n"; break;
+            case 2: parse_source += "quantum rz(pi/4) q[" + qubit + "]  // phase kick\n"; break;
+            case 3: parse_source += "let value" + std::to_string(line) + " = " + std::to_string(line) + "\n"; break;
+            default: parse_source += "measure q[" + qubit + "]\n"; break;
+        }
+    }
+    double parse_elapsed = 0.0;
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        const auto parse_started = std::chrono::steady_clock::now();
+        const auto large = parser.parseSourceWithDiagnostics(parse_source);
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - parse_started).count();
+        if (!large.ok() || large.program->statements.size() != kParseLines - 2) return 3;
+        parse_elapsed = repeat == 0 ? seconds : std::min(parse_elapsed, seconds);
+    }
+
+    // The same source through parseFileWithDiagnostics, which maps the file.
+    const std::string parse_path = (std::filesystem::temp_directory_path() / "synq_benchmark_parse.synq").string();
+    {
+        std::ofstream parse_file(parse_path, std::ios::binary);
+        parse_file << parse_source;
+        if (!parse_file) return 3;
+    }
+    double parse_file_elapsed = 0.0;
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        const auto parse_started = std::chrono::steady_clock::now();
+        const auto large = parser.parseFileWithDiagnostics(parse_path);
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - parse_started).count();
+        if (!large.ok() || large.program->statements.size() != kParseLines - 2) {
+            std::remove(parse_path.c_str());
+            return 3;
+        }
+        parse_file_elapsed = repeat == 0 ? seconds : std::min(parse_file_elapsed, seconds);
+    }
+    std::remove(parse_path.c_str());
+
+    // Parse, lower to HybridIR, and release both: the whole front end for one
+    // source, best of three.
+    double parse_lower_elapsed = 0.0;
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        const auto parse_started = std::chrono::steady_clock::now();
+        std::size_t lowered_nodes = 0;
+        {
+            const auto large = parser.parseSourceWithDiagnostics(parse_source);
+            if (!large.ok()) return 3;
+            const auto lowered = synq::compiler::lower_to_hybrid_ir(*large.program);
+            if (!lowered.ok()) return 3;
+            lowered_nodes = lowered.program->nodes.size();
+        }
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - parse_started).count();
+        if (lowered_nodes != kParseLines - 2) return 3;
+        parse_lower_elapsed = repeat == 0 ? seconds : std::min(parse_lower_elapsed, seconds);
+    }
+
+    // The same front end in one pass, with no whole-program AST.
+    double parse_to_hybrid_elapsed = 0.0;
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        const auto parse_started = std::chrono::steady_clock::now();
+        std::size_t lowered_nodes = 0;
+        {
+            const auto lowered = parser.parseSourceToHybridIR(parse_source);
+            if (!lowered.ok()) return 3;
+            lowered_nodes = lowered.program->nodes.size();
+        }
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - parse_started).count();
+        if (lowered_nodes != kParseLines - 2) return 3;
+        parse_to_hybrid_elapsed = repeat == 0 ? seconds : std::min(parse_to_hybrid_elapsed, seconds);
+    }
+
+    // Editor keystrokes: a one-character edit in the middle of a
+    // kSessionLines-line document, applied through an incremental session
+    // and compared with a full reparse of the same document.
+    constexpr std::size_t kSessionLines = 10000;
+    constexpr std::size_t kSessionEdits = 1000;
+    std::size_t session_end = 0;
+    for (std::size_t line = 0; line < kSessionLines; ++line) session_end = parse_source.find('\n', session_end) + 1;
+    const std::string session_source = parse_source.substr(0, session_end);
+    synq::compiler::ParseSession session;
+    session.open(session_source);
+    if (!session.ok()) return 3;
+    // Line kSessionLines / 2 is `quantum h q[<digit>]`; the edit rewrites the digit.
+    const std::size_t edited_line = kSessionLines / 2;
+    const auto session_started = std::chrono::steady_clock::now();
+    for (std::size_t edit = 0; edit < kSessionEdits; ++edit) {
+        const std::string digit(1, static_cast<char>('0' + edit % 8));
+        if (!session.apply_edit({{edited_line, 12}, {edited_line, 13}, digit}) || !session.ok() ||
+            session.last_stats().reparsed_lines != 1) {
+            return 3;
+        }
+    }
+    const auto session_elapsed =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - session_started).count();
+    const auto session_full_started = std::chrono::steady_clock::now();
+    for (std::size_t edit = 0; edit < kSessionEdits / 100; ++edit) {
+        if (!parser.parseSourceWithDiagnostics(session_source).ok()) return 3;
+    }
+    const auto session_full_elapsed =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - session_full_started).count();
+    const double session_edit_seconds = session_elapsed / static_cast<double>(kSessionEdits);
+    const double session_full_seconds = session_full_elapsed / static_cast<double>(kSessionEdits / 100);
+
+    // Name-resolution scaling: a chain of Boolean declarations, each reading
+    // the one before, resolved at three sizes; best of three per size. The
+    // side-table form is timed on the same chains, and at the largest size the
+    // two forms' top-level footprints are compared; node-owned strings and
+    // vectors only add to the materialized side.
+    constexpr std::size_t kResolveSizes[] = {1000, 10000, 100000};
+    double resolve_elapsed[3] = {};
+    double resolve_table_elapsed[3] = {};
+    std::size_t resolved_program_bytes = 0;
+    std::size_t resolution_table_bytes = 0;
+    for (std::size_t size_index = 0; size_index < 3; ++size_index) {
+        const std::size_t declarations = kResolveSizes[size_index];
+        std::string resolve_source = "#[experimental(feature = \"classical-control-flow\")]\nlet b0 = true\n";
+        for (std::size_t declaration = 1; declaration < declarations; ++declaration) {
+            resolve_source += "let b" + std::to_string(declaration) + " = b" + std::to_string(declaration - 1) +
+                              " and true\n";
+        }
+        const auto resolve_lowered = parser.parseSourceToHybridIR(resolve_source);
+        if (!resolve_lowered.ok()) return 4;
+        for (int repeat = 0; repeat < 3; ++repeat) {
+            const auto resolve_started = std::chrono::steady_clock::now();
+            const auto chain = synq::compiler::resolve_hybrid_names(*resolve_lowered.program);
+            const auto seconds =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - resolve_started).count();
+            if (!chain.ok() || chain.program->semantic_bindings.size() != declarations) return 4;
+            resolve_elapsed[size_index] = repeat == 0 ? seconds : std::min(resolve_elapsed[size_index], seconds);
+
+            const auto table_started = std::chrono::steady_clock::now();
+            const auto table = synq::compiler::resolve_hybrid_name_table(*resolve_lowered.program);
+            const auto table_seconds =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - table_started).count();
+            if (!table.ok() || table.table->binding_nodes.size() != declarations) return 4;
+            resolve_table_elapsed[size_index] =
+                repeat == 0 ? table_seconds : std::min(resolve_table_elapsed[size_index], table_seconds);
+            if (size_index == 2 && repeat == 0) {
+                resolved_program_bytes = chain.program->nodes.size() * sizeof(synq::compiler::ResolvedHybridNode) +
+                                         chain.program->semantic_bindings.size() * sizeof(synq::compiler::SemanticBinding);
+                resolution_table_bytes =
+                    table.table->nodes.size() * sizeof(synq::compiler::HybridNodeResolution) +
+                    (table.table->operand_binding_indices.size() + table.table->binding_nodes.size()) *
+                        sizeof(std::uint32_t);
+            }
+        }
+    }
+
+    // State evaluation: 1,000 mutable cells, then 20,000 whole-cell writes that
+    // each read another cell; best of three.
+    constexpr std::size_t kStateCells = 1000;
+    constexpr std::size_t kStateWrites = 20000;
+    std::string state_source = "#[experimental(feature = \"mutable-classical-state\")]\n"
+                               "#[experimental(feature = \"integer-arithmetic-expressions\")]\n";
+    for (std::size_t cell = 0; cell < kStateCells; ++cell) {
+        state_source += "var c" + std::to_string(cell) + " = " + std::to_string(cell) + "\n";
+    }
+    for (std::size_t write = 0; write < kStateWrites; ++write) {
+        state_source += "set c" + std::to_string(write % kStateCells) + " = c" +
+                        std::to_string((write * 7 + 3) % kStateCells) + " + 1\n";
+    }
+    const auto state_lowered = parser.parseSourceToHybridIR(state_source);
+    if (!state_lowered.ok()) return 4;
+    const auto state_resolved = synq::compiler::resolve_hybrid_names(*state_lowered.program);
+    if (!state_resolved.ok()) return 4;
+    synq::compiler::BoundedStateEvaluationOptions state_options;
+    state_options.allow_experimental_state_evaluation = true;
+    state_options.max_state_cells = kStateCells;
+    state_options.max_state_transitions = kStateCells + kStateWrites;
+    state_options.max_operations = kStateWrites;
+    double state_elapsed = 0.0;
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        const auto state_started = std::chrono::steady_clock::now();
+        const auto state = synq::compiler::evaluate_bounded_state(*state_resolved.program, state_options);
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - state_started).count();
+        if (!state.ok() || state.evaluation->cells.size() != kStateCells) return 4;
+        sink += static_cast<double>(state.evaluation->cells.back().value.integer_value);
+        state_elapsed = repeat == 0 ? seconds : std::min(state_elapsed, seconds);
+    }
+
+    // Runtime evaluation: a generated chain of U5 and U6 invocations and
+    // top-level trees over their results, run by the reference tree walker
+    // and by the bytecode runtime, both without memoized calls; best of three
+    // each.
+    constexpr std::size_t kRuntimeSteps = 2000;
+    std::string runtime_source = "#[experimental(feature = \"classical-callable-execution\")]\n"
+                                 "#[experimental(feature = \"multi-formal-classical-callables\")]\n"
+                                 "#[experimental(feature = \"integer-arithmetic-expressions\")]\n"
+                                 "#[experimental(feature = \"classical-control-flow\")]\n"
+                                 "fn inc(value: Integer) -> value + 1\n"
+                                 "fn add(left: Integer, right: Integer) -> left + right\n"
+                                 "fn flip(flag: Boolean) -> not flag\n"
+                                 "fn both(left: Boolean, right: Boolean) -> left and right\n"
+                                 "let t0 = 0\n"
+                                 "let g0 = true\n";
+    for (std::size_t step = 1; step <= kRuntimeSteps; ++step) {
+        const std::string k = std::to_string(step);
+        const std::string previous = std::to_string(step - 1);
+        runtime_source += "let a" + k + " = inc(t" + previous + ")\n"
+                          "let s" + k + " = add(a" + k + ", 2)\n"
+                          "let t" + k + " = s" + k + " - 1\n"
+                          "let f" + k + " = flip(g" + previous + ")\n"
+                          "let g" + k + " = both(f" + k + ", true)\n"
+                          "let h" + k + " = f" + k + " or g" + k + "\n";
+    }
+    const auto runtime_lowered = parser.parseSourceToHybridIR(runtime_source);
+    if (!runtime_lowered.ok()) return 5;
+    const auto runtime_resolved = synq::compiler::resolve_hybrid_names(*runtime_lowered.program);
+    if (!runtime_resolved.ok()) return 5;
+    synq::compiler::BoundedRuntimeEvaluationOptions runtime_options;
+    runtime_options.allow_experimental_runtime_evaluation = true;
+    runtime_options.max_callable_invocations = 4 * kRuntimeSteps;
+    runtime_options.max_operations = 6 * kRuntimeSteps;
+    runtime_options.memoize_invocations = false;
+    double runtime_elapsed[2] = {0.0, 0.0};
+    for (int engine = 0; engine < 2; ++engine) {
+        runtime_options.force_tree_walk = engine == 0;
+        for (int repeat = 0; repeat < 3; ++repeat) {
+            const auto runtime_started = std::chrono::steady_clock::now();
+            const auto runtime = synq::compiler::evaluate_bounded_runtime(*runtime_resolved.program, runtime_options);
+            const auto seconds =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - runtime_started).count();
+            if (!runtime.ok() || runtime.evaluation->bindings.size() != 2 + 6 * kRuntimeSteps) return 5;
+            sink += static_cast<double>(runtime.evaluation->bindings.back().value.boolean_value);
+            runtime_elapsed[engine] = repeat == 0 ? seconds : std::min(runtime_elapsed[engine], seconds);
+        }
+    }
+
+    // Repeated calls: the same helpers called with the same few literals, as
+    // templated programs do, evaluated without and with memoized calls; best
+    // of three each.
+    constexpr std::size_t kRepeatedCalls = 6000;
+    std::string repeated_source = "#[experimental(feature = \"classical-callable-execution\")]\n"
+                                  "#[experimental(feature = \"multi-formal-classical-callables\")]\n"
+                                  "fn scale(value: Integer) -> value * 3\n"
+                                  "fn add(left: Integer, right: Integer) -> left + right\n"
+                                  "fn both(left: Boolean, right: Boolean) -> left and right\n";
+    for (std::size_t call = 0; call < kRepeatedCalls; ++call) {
+        const std::string name = "let r" + std::to_string(call) + " = ";
+        switch (call % 3) {
+            case 0: repeated_source += name + "scale(" + std::to_string(call % 4) + ")\n"; break;
+            case 1: repeated_source += name + "add(20, 22)\n"; break;
+            default: repeated_source += name + "both(true, false)\n"; break;
+        }
+    }
+    const auto repeated_lowered = parser.parseSourceToHybridIR(repeated_source);
+    if (!repeated_lowered.ok()) return 6;
+    const auto repeated_resolved = synq::compiler::resolve_hybrid_names(*repeated_lowered.program);
+    if (!repeated_resolved.ok()) return 6;
+    synq::compiler::BoundedRuntimeEvaluationOptions repeated_options;
+    repeated_options.allow_experimental_runtime_evaluation = true;
+    repeated_options.max_callable_invocations = kRepeatedCalls;
+    repeated_options.max_operations = kRepeatedCalls;
+    double repeated_elapsed[2] = {0.0, 0.0};
+    for (int memoized = 0; memoized < 2; ++memoized) {
+        repeated_options.memoize_invocations = memoized == 1;
+        for (int repeat = 0; repeat < 3; ++repeat) {
+            const auto repeated_started = std::chrono::steady_clock::now();
+            const auto repeated = synq::compiler::evaluate_bounded_runtime(*repeated_resolved.program, repeated_options);
+            const auto seconds =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - repeated_started).count();
+            if (!repeated.ok() || repeated.evaluation->bindings.size() != kRepeatedCalls) return 6;
+            sink += static_cast<double>(repeated.evaluation->bindings.front().value.integer_value);
+            repeated_elapsed[memoized] = repeat == 0 ? seconds : std::min(repeated_elapsed[memoized], seconds);
+        }
+    }
+
+    // OpenQASM 3 export of a generated kExportGates-gate circuit: into one
+    // string, through a sink into a string reserved up front, and through a
+    // sink into a temporary file; best of three each.
+    constexpr std::size_t kExportGates = 1000000;
+    std::string export_source = "#[experimental(feature = \"qubit-declarations\")]\n"
+                                "#[experimental(feature = \"parameterized-quantum-gates\")]\n"
+                                "qubit q[16]\n";
+    for (std::size_t gate = 0; gate < kExportGates; ++gate) {
+        const std::string qubit = std::to_string(gate % 16);
+        switch (gate % 4) {
+            case 0: export_source += "quantum h q[" + qubit + "]\n"; break;
+            case 1: export_source += "quantum cx q[" + qubit + "], q[" + std::to_string((gate + 1) % 16) + "]\n"; break;
+            case 2: export_source += "quantum rz(pi/4) q[" + qubit + "]\n"; break;
+            default: export_source += "measure q[" + qubit + "]\n"; break;
+        }
+    }
+    const auto export_lowered = parser.parseSourceToHybridIR(export_source);
+    if (!export_lowered.ok()) return 7;
+    std::size_t export_bytes = 0;
+    double export_string_elapsed = 0.0;
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        const auto export_started = std::chrono::steady_clock::now();
+        const auto exported = synq::compiler::export_hybrid_openqasm3(*export_lowered.program);
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - export_started).count();
+        if (!exported.ok()) return 7;
+        export_bytes = exported.program.size();
+        export_string_elapsed = repeat == 0 ? seconds : std::min(export_string_elapsed, seconds);
+    }
+    double export_reserved_elapsed = 0.0;
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        std::string output;
+        output.reserve(export_bytes);
+        const auto export_started = std::chrono::steady_clock::now();
+        synq::compiler::StringOpenQasm3Sink string_sink(output);
+        const auto exported = synq::compiler::export_hybrid_openqasm3(*export_lowered.program, string_sink);
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - export_started).count();
+        if (!exported.ok() || output.size() != export_bytes) return 7;
+        export_reserved_elapsed = repeat == 0 ? seconds : std::min(export_reserved_elapsed, seconds);
+    }
+    const std::string export_path = (std::filesystem::temp_directory_path() / "synq_benchmark_export.qasm").string();
+    double export_file_elapsed = 0.0;
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        std::FILE* export_file = std::fopen(export_path.c_str(), "wb");
+        if (export_file == nullptr) return 7;
+        const auto export_started = std::chrono::steady_clock::now();
+        synq::compiler::FileOpenQasm3Sink file_sink(export_file);
+        const auto exported = synq::compiler::export_hybrid_openqasm3(*export_lowered.program, file_sink);
+        const bool closed = std::fclose(export_file) == 0;
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - export_started).count();
+        if (!exported.ok() || !closed || exported.bytes_written != export_bytes) {
+            std::remove(export_path.c_str());
+            return 7;
+        }
+        export_file_elapsed = repeat == 0 ? seconds : std::min(export_file_elapsed, seconds);
+    }
+    std::remove(export_path.c_str());
+
+    // Peephole optimization of a kOptimizeGates-gate circuit in which every
+    // qubit repeats h h, rz(pi/8) rz(pi/8), a cx pair, and one rx; then the
+    // simulation of its first kOptimizeSimulatedGates gates, unoptimized and
+    // optimized. Best of three each.
+    constexpr std::size_t kOptimizeGates = 1000000;
+    constexpr std::size_t kOptimizeSimulatedGates = 20000;
+    constexpr std::size_t kOptimizeQubits = 12;
+    const auto redundant_circuit = [&](std::size_t gates) {
+        std::string source = "#[experimental(feature = \"qubit-declarations\")]\n"
+                             "#[experimental(feature = \"parameterized-quantum-gates\")]\n"
+                             "qubit q[" + std::to_string(kOptimizeQubits) + "]\n";
+        for (std::size_t gate = 0; gate < gates; ++gate) {
+            const std::size_t step = gate / kOptimizeQubits;
+            const std::string qubit = "q[" + std::to_string(gate % kOptimizeQubits) + "]";
+            const std::string next = "q[" + std::to_string((gate + 1) % kOptimizeQubits) + "]";
+            switch (step % 7) {
+                case 0: case 1: source += "quantum h " + qubit + "\n"; break;
+                case 2: case 3: source += "quantum rz(pi/8) " + qubit + "\n"; break;
+                case 4: case 5: source += "quantum cx " + qubit + ", " + next + "\n"; break;
+                default: source += "quantum rx(0.125) " + qubit + "\n"; break;
+            }
+        }
+        return parser.parseSourceToHybridIR(source);
+    };
+    const auto optimize_lowered = redundant_circuit(kOptimizeGates);
+    if (!optimize_lowered.ok()) return 8;
+    synq::compiler::CircuitOptimizationReport optimize_report;
+    double optimize_elapsed = 0.0;
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        synq::compiler::HybridProgram program = *optimize_lowered.program;
+        const auto optimize_started = std::chrono::steady_clock::now();
+        optimize_report = synq::compiler::optimize_hybrid_circuit(program);
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - optimize_started).count();
+        optimize_elapsed = repeat == 0 ? seconds : std::min(optimize_elapsed, seconds);
+    }
+    const auto simulated_lowered = redundant_circuit(kOptimizeSimulatedGates);
+    if (!simulated_lowered.ok()) return 8;
+    synq::compiler::HybridProgram simulated_optimized = *simulated_lowered.program;
+    const auto simulated_report = synq::compiler::optimize_hybrid_circuit(simulated_optimized);
+    synq::compiler::BoundedSimulationOptions optimize_simulation_options;
+    optimize_simulation_options.allow_experimental_local_simulation = true;
+    optimize_simulation_options.max_qubits = kOptimizeQubits;
+    optimize_simulation_options.max_operations = kOptimizeSimulatedGates;
+    double optimize_simulation_elapsed[2] = {0.0, 0.0};
+    for (int optimized = 0; optimized < 2; ++optimized) {
+        const auto resolved =
+            synq::compiler::resolve_hybrid_names(optimized == 1 ? simulated_optimized : *simulated_lowered.program);
+        if (!resolved.ok()) return 8;
+        for (int repeat = 0; repeat < 3; ++repeat) {
+            const auto simulation_started = std::chrono::steady_clock::now();
+            const auto simulation = synq::compiler::simulate_bounded_quantum(*resolved.program, optimize_simulation_options);
+            const auto seconds =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - simulation_started).count();
+            if (!simulation.ok()) return 8;
+            sink += simulation.simulation->basis_probabilities.front().probability;
+            optimize_simulation_elapsed[optimized] =
+                repeat == 0 ? seconds : std::min(optimize_simulation_elapsed[optimized], seconds);
+        }
+    }
+
+    // Layer scheduling of the same kOptimizeGates-gate circuit, unoptimized.
+    // Best of three.
+    synq::compiler::CircuitSchedulingReport schedule_report;
+    double schedule_elapsed = 0.0;
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        synq::compiler::HybridProgram program = *optimize_lowered.program;
+        const auto schedule_started = std::chrono::steady_clock::now();
+        schedule_report = synq::compiler::reorder_hybrid_circuit(program);
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - schedule_started).count();
+        schedule_elapsed = repeat == 0 ? seconds : std::min(schedule_elapsed, seconds);
+    }
+
     std::cout << "benchmark = bounded_bell_probability\n"
               << "iterations = " << iterations << "\n"
+              << "kernel = " << synq::compiler::simulation_kernel_isa_name(kernel_isa) << "\n"
               << "seconds = " << elapsed << "\n"
               << "simulations_per_second = " << per_second << "\n"
+              << "prepared_seconds = " << prepared_elapsed << "\n"
+              << "prepared_simulations_per_second = " << prepared_per_second << "\n"
+              << "wide_qubits = " << kWideQubits << "\n"
+              << "wide_iterations = " << wide_iterations << "\n"
+              << "wide_f64_seconds = " << wide_f64_elapsed << "\n"
+              << "wide_f32_seconds = " << wide_f32_elapsed << "\n"
+              << "wide_f32_speedup = " << wide_f64_elapsed / wide_f32_elapsed << "\n"
+              << "wide_unblocked_f64_seconds = " << wide_unblocked_elapsed << "\n"
+              << "wide_cache_block_speedup = " << wide_unblocked_elapsed / wide_f64_elapsed << "\n"
+              << "parse_lines = " << kParseLines << "\n"
+              << "parse_seconds = " << parse_elapsed << "\n"
+              << "parse_lines_per_second = " << static_cast<double>(kParseLines) / parse_elapsed << "\n"
+              << "parse_bytes_per_second = " << static_cast<double>(parse_source.size()) / parse_elapsed << "\n"
+              << "parse_file_bytes = " << parse_source.size() << "\n"
+              << "parse_file_seconds = " << parse_file_elapsed << "\n"
+              << "parse_file_bytes_per_second = " << static_cast<double>(parse_source.size()) / parse_file_elapsed << "\n"
+              << "parse_lower_seconds = " << parse_lower_elapsed << "\n"
+              << "parse_lower_lines_per_second = " << static_cast<double>(kParseLines) / parse_lower_elapsed << "\n"
+              << "parse_to_hybrid_seconds = " << parse_to_hybrid_elapsed << "\n"
+              << "parse_to_hybrid_lines_per_second = " << static_cast<double>(kParseLines) / parse_to_hybrid_elapsed << "\n"
+              << "session_lines = " << kSessionLines << "\n"
+              << "session_edit_seconds = " << session_edit_seconds << "\n"
+              << "session_full_parse_seconds = " << session_full_seconds << "\n"
+              << "resolve_1000_seconds = " << resolve_elapsed[0] << "\n"
+              << "resolve_10000_seconds = " << resolve_elapsed[1] << "\n"
+              << "resolve_100000_seconds = " << resolve_elapsed[2] << "\n"
+              << "resolve_table_1000_seconds = " << resolve_table_elapsed[0] << "\n"
+              << "resolve_table_10000_seconds = " << resolve_table_elapsed[1] << "\n"
+              << "resolve_table_100000_seconds = " << resolve_table_elapsed[2] << "\n"
+              << "resolved_program_bytes = " << resolved_program_bytes << "\n"
+              << "resolution_table_bytes = " << resolution_table_bytes << "\n"
+              << "state_writes = " << kStateWrites << "\n"
+              << "state_eval_seconds = " << state_elapsed << "\n"
+              << "runtime_declarations = " << 6 * kRuntimeSteps << "\n"
+              << "runtime_tree_walk_seconds = " << runtime_elapsed[0] << "\n"
+              << "runtime_bytecode_seconds = " << runtime_elapsed[1] << "\n"
+              << "runtime_repeated_calls = " << kRepeatedCalls << "\n"
+              << "runtime_repeated_uncached_seconds = " << repeated_elapsed[0] << "\n"
+              << "runtime_repeated_memoized_seconds = " << repeated_elapsed[1] << "\n"
+              << "export_gates = " << kExportGates << "\n"
+              << "export_bytes = " << export_bytes << "\n"
+              << "export_string_seconds = " << export_string_elapsed << "\n"
+              << "export_reserved_sink_seconds = " << export_reserved_elapsed << "\n"
+              << "export_file_sink_seconds = " << export_file_elapsed << "\n"
+              << "optimize_gates_before = " << optimize_report.before.gate_count << "\n"
+              << "optimize_gates_after = " << optimize_report.after.gate_count << "\n"
+              << "optimize_depth_before = " << optimize_report.before.depth << "\n"
+              << "optimize_depth_after = " << optimize_report.after.depth << "\n"
+              << "optimize_seconds = " << optimize_elapsed << "\n"
+              << "optimize_simulated_gates_before = " << simulated_report.before.gate_count << "\n"
+              << "optimize_simulated_gates_after = " << simulated_report.after.gate_count << "\n"
+              << "optimize_unoptimized_simulation_seconds = " << optimize_simulation_elapsed[0] << "\n"
+              << "optimize_optimized_simulation_seconds = " << optimize_simulation_elapsed[1] << "\n"
+              << "schedule_depth_before = " << schedule_report.before.depth << "\n"
+              << "schedule_depth_after = " << schedule_report.after.depth << "\n"
+              << "schedule_layers = " << schedule_report.layers << "\n"
+              << "schedule_moved_gates = " << schedule_report.moved_gates << "\n"
+              << "schedule_seconds = " << schedule_elapsed << "\n"
               << "checksum = " << sink << "\n";
     return 0;
 }
@@ -1,16 +1,27 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
 #include <fstream>
+#include <iterator>
 #include <iostream>
 #include <optional>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include "compiler/bounded_evaluator.h"
 #include "compiler/bounded_simulator.h"
+#include "compiler/circuit_optimizer.h"
 #include "compiler/diagnostic.h"
 #include "compiler/hybrid_ir.h"
 #include "compiler/name_resolution.h"
 #include "compiler/openqasm3_exporter.h"
 #include "compiler/parser.h"
+#include "compiler/simulation_plan_format.h"
+#include "compiler/sweep_pool.h"
 
 namespace {
 
@@ -28,10 +39,22 @@ enum class Mode {
 struct Command {
     Mode mode = Mode::Validate;
     std::string source_path;
+    // Set by --batch: a file listing one source per line, or "-" for
+    // standard input. Every listed source runs with the same mode and options.
+    std::optional<std::string> batch_manifest;
+    std::size_t batch_jobs = 1;
     std::optional<std::string> output_path;
     std::size_t max_declarations = 64;
     std::size_t max_qubits = 10;
     std::size_t max_operations = 1024;
+    std::size_t simulation_threads = 1;
+    std::size_t shots = 0;
+    std::optional<std::uint64_t> seed;
+    std::optional<std::string> plan_cache_path;
+    synq::compiler::SimulationPrecision precision = synq::compiler::SimulationPrecision::F64;
+    bool stabilizer = false;
+    bool optimize = false;
+    bool schedule = false;
     std::size_t max_state_cells = 64;
     std::size_t max_state_transitions = 128;
     std::size_t max_expression_depth = 16;
@@ -48,12 +71,13 @@ void print_help(std::ostream& output) {
            << "Usage:\n"
            << "  synqc <source.synq> --validate\n"
            << "  synqc <source.synq> --emit-openqasm [--out <file.qasm>]\n"
-           << "  synqc <source.synq> --emit-openqasm-hybrid [--out <file.qasm>]\n"
+           << "  synqc <source.synq> --emit-openqasm-hybrid [--optimize] [--schedule] [--out <file.qasm>]\n"
            << "  synqc <source.synq> --inspect-semantics\n"
            << "  synqc <source.synq> --eval-constants [--max-declarations <n>]\n"
            << "  synqc <source.synq> --eval-state [--max-state-cells <n>] [--max-state-transitions <n>] [--max-expression-depth <n>] [--max-operations <n>]\n"
            << "  synqc <source.synq> --eval-runtime [--max-callables <n>] [--max-invocations <n>] [--max-call-depth <n>] [--max-expression-depth <n>] [--max-operations <n>]\n"
-           << "  synqc <source.synq> --simulate [--max-qubits <n>] [--max-operations <n>]\n\n"
+           << "  synqc <source.synq> --simulate [--max-qubits <n>] [--max-operations <n>] [--threads <n>] [--shots <n> [--seed <n>]] [--precision f64|f32] [--stabilizer] [[--optimize] [--schedule] | --plan-cache <file>]\n"
+           << "  synqc --batch <manifest|-> <mode> [mode options] [--jobs <n>]\n\n"
            << "Modes:\n"
            << "  --validate        Parse, lower, and resolve the documented bounded profile.\n"
            << "  --emit-openqasm   Emit the supported AST OpenQASM 3 source subset.\n"
@@ -62,21 +86,31 @@ void print_help(std::ostream& output) {
            << "  --eval-constants  Explicitly run bounded declaration-only constant evaluation.\n"
            << "  --eval-state      Explicitly run bounded top-level mutable-cell evaluation.\n"
            << "  --eval-runtime    Explicitly run bounded local classical callable evaluation.\n"
-           << "  --simulate        Explicitly calculate deterministic bounded local probabilities.\n\n"
+           << "  --simulate        Explicitly calculate deterministic bounded local probabilities.\n"
+           << "  --optimize        Before export or simulation, cancel and merge adjacent gates.\n"
+           << "  --schedule        Before export or simulation, reorder commuting gates into layers.\n"
+           << "  --batch           Run the mode over every listed source; print one JSON line per source.\n\n"
            << "This command does not submit jobs,\n"
            << "run legacy runtime components, or evaluate general SynQ source.\n";
 }
 
-bool parse_positive_size(const std::string& text, std::size_t& value) {
+bool parse_whole_number(const std::string& text, std::uint64_t& value) {
     if (text.empty()) return false;
     value = 0;
     for (char character : text) {
         if (character < '0' || character > '9') return false;
-        const std::size_t digit = static_cast<std::size_t>(character - '0');
-        if (value > (static_cast<std::size_t>(-1) - digit) / 10) return false;
+        const std::uint64_t digit = static_cast<std::uint64_t>(character - '0');
+        if (value > (static_cast<std::uint64_t>(-1) - digit) / 10) return false;
         value = value * 10 + digit;
     }
-    return value > 0;
+    return true;
+}
+
+bool parse_positive_size(const std::string& text, std::size_t& value) {
+    std::uint64_t parsed = 0;
+    if (!parse_whole_number(text, parsed) || parsed == 0 || parsed > static_cast<std::size_t>(-1)) return false;
+    value = static_cast<std::size_t>(parsed);
+    return true;
 }
 
 bool parse_command(int argc, char** argv, Command& command, std::string& error) {
@@ -84,9 +118,19 @@ bool parse_command(int argc, char** argv, Command& command, std::string& error)
         error = "a source file and one mode are required";
         return false;
     }
-    command.source_path = argv[1];
+    int first_option = 2;
+    if (std::string(argv[1]) == "--batch") {
+        if (argc < 3) {
+            error = "--batch requires a manifest path or -";
+            return false;
+        }
+        command.batch_manifest = argv[2];
+        first_option = 3;
+    } else {
+        command.source_path = argv[1];
+    }
     bool selected_mode = false;
-    for (int index = 2; index < argc; ++index) {
+    for (int index = first_option; index < argc; ++index) {
         const std::string argument = argv[index];
         if (argument == "--validate") {
             if (selected_mode) { error = "select exactly one mode"; return false; }
@@ -133,6 +177,48 @@ bool parse_command(int argc, char** argv, Command& command, std::string& error)
                 error = "--max-qubits requires a positive whole number";
                 return false;
             }
+        } else if (argument == "--threads") {
+            if (++index >= argc || !parse_positive_size(argv[index], command.simulation_threads)) {
+                error = "--threads requires a positive whole number";
+                return false;
+            }
+        } else if (argument == "--jobs") {
+            if (++index >= argc || !parse_positive_size(argv[index], command.batch_jobs)) {
+                error = "--jobs requires a positive whole number";
+                return false;
+            }
+        } else if (argument == "--plan-cache") {
+            if (++index >= argc) {
+                error = "--plan-cache requires a file path";
+                return false;
+            }
+            command.plan_cache_path = argv[index];
+        } else if (argument == "--stabilizer") {
+            command.stabilizer = true;
+        } else if (argument == "--optimize") {
+            command.optimize = true;
+        } else if (argument == "--schedule") {
+            command.schedule = true;
+        } else if (argument == "--precision") {
+            const std::string value = ++index < argc ? argv[index] : "";
+            if (value != "f64" && value != "f32") {
+                error = "--precision requires f64 or f32";
+                return false;
+            }
+            command.precision =
+                value == "f32" ? synq::compiler::SimulationPrecision::F32 : synq::compiler::SimulationPrecision::F64;
+        } else if (argument == "--shots") {
+            if (++index >= argc || !parse_positive_size(argv[index], command.shots)) {
+                error = "--shots requires a positive whole number";
+                return false;
+            }
+        } else if (argument == "--seed") {
+            std::uint64_t parsed = 0;
+            if (++index >= argc || !parse_whole_number(argv[index], parsed)) {
+                error = "--seed requires a whole number";
+                return false;
+            }
+            command.seed = parsed;
         } else if (argument == "--max-operations") {
             std::size_t parsed = 0;
             if (++index >= argc || !parse_positive_size(argv[index], parsed)) {
@@ -196,6 +282,32 @@ bool parse_command(int argc, char** argv, Command& command, std::string& error)
         error = "--max-qubits and --max-operations are supported only with --simulate";
         return false;
     }
+    if ((command.simulation_threads != 1 || command.shots != 0 || command.plan_cache_path.has_value() ||
+         command.precision != synq::compiler::SimulationPrecision::F64 || command.stabilizer) &&
+        command.mode != Mode::Simulate) {
+        error = "--threads, --shots, --precision, --stabilizer, and --plan-cache are supported only with --simulate";
+        return false;
+    }
+    if (command.optimize && command.mode != Mode::EmitHybridOpenQasm && command.mode != Mode::Simulate) {
+        error = "--optimize is supported only with --emit-openqasm-hybrid or --simulate";
+        return false;
+    }
+    if (command.optimize && command.plan_cache_path.has_value()) {
+        error = "--optimize cannot be combined with --plan-cache";
+        return false;
+    }
+    if (command.schedule && command.mode != Mode::EmitHybridOpenQasm && command.mode != Mode::Simulate) {
+        error = "--schedule is supported only with --emit-openqasm-hybrid or --simulate";
+        return false;
+    }
+    if (command.schedule && command.plan_cache_path.has_value()) {
+        error = "--schedule cannot be combined with --plan-cache";
+        return false;
+    }
+    if (command.seed.has_value() && command.shots == 0) {
+        error = "--seed is supported only with --shots";
+        return false;
+    }
     if ((command.max_state_cells != 64 || command.max_state_transitions != 128) && command.mode != Mode::EvaluateState) {
         error = "--max-state-cells and --max-state-transitions are supported only with --eval-state";
         return false;
@@ -214,47 +326,73 @@ bool parse_command(int argc, char** argv, Command& command, std::string& error)
         error = "--max-operations is supported only with --simulate, --eval-state, or --eval-runtime";
         return false;
     }
+    if (command.batch_jobs != 1 && !command.batch_manifest.has_value()) {
+        error = "--jobs is supported only with --batch";
+        return false;
+    }
+    if (command.batch_manifest.has_value() && (command.output_path.has_value() || command.plan_cache_path.has_value())) {
+        error = "--out and --plan-cache name one file and are not supported with --batch";
+        return false;
+    }
     return true;
 }
 
-int render_diagnostics(const std::string& source_path, const std::vector<synq::compiler::Diagnostic>& diagnostics,
-                       int exit_code) {
+// Where one source's results go: the process streams for a single source, or
+// the buffers of one record in --batch mode, which also keeps the reported
+// diagnostics for the record.
+struct Console {
+    std::ostream& out;
+    std::ostream& err;
+    std::vector<synq::compiler::Diagnostic>* diagnostics = nullptr;
+};
+
+int render_diagnostics(Console& console, const std::string& source_path,
+                       const std::vector<synq::compiler::Diagnostic>& diagnostics, int exit_code) {
     for (const auto& diagnostic : diagnostics) {
-        std::cerr << synq::compiler::format_diagnostic(source_path, diagnostic) << "\n";
+        console.err << synq::compiler::format_diagnostic(source_path, diagnostic) << "\n";
+    }
+    if (console.diagnostics != nullptr) {
+        console.diagnostics->insert(console.diagnostics->end(), diagnostics.begin(), diagnostics.end());
     }
     return exit_code;
 }
 
-void print_value(const synq::compiler::EvaluatedBinding& binding) {
-    std::cout << binding.name << " = " << synq::compiler::bounded_value_kind_name(binding.value.kind) << ":";
+// The single-pass front end reports a Hybrid lowering error only for a source
+// that parses, so lowering errors keep their own exit code.
+bool is_lowering_diagnostic(const std::vector<synq::compiler::Diagnostic>& diagnostics) {
+    return !diagnostics.empty() && diagnostics.front().code.rfind("SYNQ-H", 0) == 0;
+}
+
+void print_value(std::ostream& out, const synq::compiler::EvaluatedBinding& binding) {
+    out << binding.name << " = " << synq::compiler::bounded_value_kind_name(binding.value.kind) << ":";
     switch (binding.value.kind) {
         case synq::compiler::BoundedValueKind::Integer:
-            std::cout << binding.value.integer_value;
+            out << binding.value.integer_value;
             break;
         case synq::compiler::BoundedValueKind::Boolean:
-            std::cout << (binding.value.boolean_value ? "true" : "false");
+            out << (binding.value.boolean_value ? "true" : "false");
             break;
         case synq::compiler::BoundedValueKind::String:
-            std::cout << '"' << binding.value.string_value << '"';
+            out << '"' << binding.value.string_value << '"';
             break;
     }
-    std::cout << "\n";
+    out << "\n";
 }
 
-void print_state_cell(const synq::compiler::EvaluatedStateCell& cell) {
-    std::cout << "cell " << cell.name << " = " << synq::compiler::bounded_value_kind_name(cell.value.kind) << ":";
+void print_state_cell(std::ostream& out, const synq::compiler::EvaluatedStateCell& cell) {
+    out << "cell " << cell.name << " = " << synq::compiler::bounded_value_kind_name(cell.value.kind) << ":";
     switch (cell.value.kind) {
         case synq::compiler::BoundedValueKind::Integer:
-            std::cout << cell.value.integer_value;
+            out << cell.value.integer_value;
             break;
         case synq::compiler::BoundedValueKind::Boolean:
-            std::cout << (cell.value.boolean_value ? "true" : "false");
+            out << (cell.value.boolean_value ? "true" : "false");
             break;
         case synq::compiler::BoundedValueKind::String:
-            std::cout << '"' << cell.value.string_value << '"';
+            out << '"' << cell.value.string_value << '"';
             break;
     }
-    std::cout << " | declared line " << cell.declaration_span.line
+    out << " | declared line " << cell.declaration_span.line
               << " | last write line " << cell.last_write_span.line << "\n";
 }
 
@@ -267,116 +405,241 @@ std::string basis_label(std::size_t basis, std::size_t qubits) {
     return label;
 }
 
-}  // namespace
+bool read_binary_file(const std::string& path, std::string& contents) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) return false;
+    contents.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    return !input.bad();
+}
 
-int main(int argc, char** argv) {
-    if (argc == 2 && std::string(argv[1]) == "--help") {
-        print_help(std::cout);
-        return 0;
+synq::compiler::BoundedSimulationOptions simulation_options(const Command& command) {
+    synq::compiler::BoundedSimulationOptions options;
+    options.allow_experimental_local_simulation = true;
+    options.max_qubits = command.max_qubits;
+    options.max_operations = command.max_operations;
+    options.threads = command.simulation_threads;
+    options.shots = command.shots;
+    options.seed = command.seed.value_or(0);
+    options.precision = command.precision;
+    options.allow_stabilizer_simulation = command.stabilizer;
+    return options;
+}
+
+// The optimization summary goes to standard error so that the exported or
+// simulated output on standard output is unchanged.
+void print_optimization_report(std::ostream& err, const synq::compiler::CircuitOptimizationReport& report) {
+    err << "synqc: optimize: gates " << report.before.gate_count << " -> " << report.after.gate_count
+              << ", depth " << report.before.depth << " -> " << report.after.depth << " ("
+              << report.cancelled_pairs << " cancelled pairs, " << report.merged_rotations << " merged rotations, "
+              << report.removed_identities << " removed identity rotations)\n";
+}
+
+void print_scheduling_report(std::ostream& err, const synq::compiler::CircuitSchedulingReport& report) {
+    err << "synqc: schedule: depth " << report.before.depth << " -> " << report.after.depth << " ("
+              << report.layers << " gate layers, " << report.moved_gates << " moved gates)\n";
+}
+
+void print_simulation(std::ostream& out, const synq::compiler::BoundedSimulation& simulation) {
+    out << "qubits = " << simulation.qubit_count << "\n";
+    if (simulation.backend != synq::compiler::SimulationBackend::StateVector) {
+        out << "backend = " << synq::compiler::simulation_backend_name(simulation.backend) << "\n";
     }
-    if (argc == 2 && std::string(argv[1]) == "--version") {
-        std::cout << "synqc " << SYNQ_RECOVERY_CLI_VERSION << "\n";
-        return 0;
+    if (simulation.precision != synq::compiler::SimulationPrecision::F64) {
+        out << "precision = " << synq::compiler::simulation_precision_name(simulation.precision) << "\n";
     }
+    for (const auto& register_info : simulation.registers) {
+        out << "register " << register_info.name << "[" << register_info.qubit_count
+                  << "] physical_offset = " << register_info.physical_offset << "\n";
+    }
+    for (const auto& basis : simulation.basis_probabilities) {
+        out << "basis |" << basis_label(basis.basis_index, simulation.qubit_count)
+                  << "> probability = " << basis.probability << "\n";
+    }
+    if (simulation.basis_probabilities_omitted) {
+        out << "basis probabilities omitted: support too large to list\n";
+    }
+    if (simulation.shots != 0) {
+        out << "shots = " << simulation.shots << " seed = " << simulation.seed << "\n";
+    }
+    for (const auto& outcome : simulation.shot_counts) {
+        out << "shot |" << basis_label(outcome.basis_index, simulation.qubit_count)
+                  << "> count = " << outcome.count << "\n";
+    }
+    for (const auto& measurement : simulation.measurements) {
+        out << "measurement " << measurement.register_name << "[" << measurement.register_index
+                  << "] probability_one = "
+                  << measurement.probability_one << "\n";
+    }
+}
 
-    Command command;
-    std::string argument_error;
-    if (!parse_command(argc, argv, command, argument_error)) {
-        std::cerr << "synqc: usage error: " << argument_error << "\n\n";
-        print_help(std::cerr);
-        return 2;
+int run_simulation_plan(Console& console, const Command& command, const synq::compiler::SimulationPlan& plan) {
+    const auto options = simulation_options(command);
+    synq::compiler::SimulationWorkspace workspace(options.threads);
+    synq::compiler::BoundedSimulation simulation;
+    std::vector<synq::compiler::Diagnostic> diagnostics;
+    if (!synq::compiler::run_bounded_simulation(plan, options, workspace, simulation, diagnostics)) {
+        return render_diagnostics(console, command.source_path, diagnostics, 5);
     }
+    print_simulation(console.out, simulation);
+    return 0;
+}
 
-    Parser parser;
-    const auto parsed = parser.parseFileWithDiagnostics(command.source_path);
-    if (!parsed.ok()) return render_diagnostics(command.source_path, parsed.diagnostics, 3);
+// Sends export text to the console's output or to --out, which is opened on
+// the first write so a rejected program leaves no file behind.
+class ExportOutput final : public synq::compiler::OpenQasm3Sink {
+public:
+    ExportOutput(std::ostream& out, const std::optional<std::string>& path) : out_(out), path_(path) {}
 
-    if (command.mode == Mode::EmitOpenQasm) {
-        const auto exported = synq::compiler::export_openqasm3(*parsed.program);
-        if (!exported.ok()) {
-            for (const auto& diagnostic : exported.diagnostics) {
-                std::cerr << command.source_path << ": error[openqasm-export]: " << diagnostic << "\n";
-            }
-            return 5;
+    bool write(std::string_view text) override {
+        if (!path_.has_value()) {
+            return static_cast<bool>(out_.write(text.data(), static_cast<std::streamsize>(text.size())));
         }
-        if (command.output_path.has_value()) {
-            std::ofstream output(*command.output_path, std::ios::binary);
-            if (!output) {
-                std::cerr << "synqc: error: cannot write " << *command.output_path << "\n";
-                return 6;
-            }
-            output << exported.program;
-            if (!output) {
-                std::cerr << "synqc: error: failed while writing " << *command.output_path << "\n";
-                return 6;
-            }
-        } else {
-            std::cout << exported.program;
+        if (!file_.is_open()) {
+            file_.open(*path_, std::ios::binary);
+            if (!file_) return false;
+            opened_ = true;
         }
-        return 0;
+        return static_cast<bool>(file_.write(text.data(), static_cast<std::streamsize>(text.size())));
     }
 
-    const auto lowered = synq::compiler::lower_to_hybrid_ir(*parsed.program);
-    if (!lowered.ok()) return render_diagnostics(command.source_path, lowered.diagnostics, 4);
-    const auto resolved = synq::compiler::resolve_hybrid_names(*lowered.program);
-    if (!resolved.ok()) return render_diagnostics(command.source_path, resolved.diagnostics, 4);
+    // Flushes standard output or closes the --out file; false if the text did
+    // not all reach it.
+    bool close() {
+        if (!path_.has_value()) return static_cast<bool>(out_.flush());
+        if (!file_.is_open()) return true;
+        file_.close();
+        return !file_.fail();
+    }
 
-    if (command.mode == Mode::EmitHybridOpenQasm) {
-        const auto exported = synq::compiler::export_hybrid_openqasm3(*lowered.program);
-        if (!exported.ok()) {
-            for (const auto& diagnostic : exported.diagnostics) {
-                std::cerr << command.source_path << ": error[hybrid-openqasm-export]: " << diagnostic << "\n";
+    bool opened() const { return opened_; }
+
+private:
+    std::ostream& out_;
+    const std::optional<std::string>& path_;
+    std::ofstream file_;
+    bool opened_ = false;
+};
+
+// Streams one OpenQASM 3 export to --out or standard output; `export_into`
+// runs the exporter on the sink it is given.
+template <typename Export>
+int emit_openqasm3(Console& console, const Command& command, const char* category, const Export& export_into) {
+    ExportOutput output(console.out, command.output_path);
+    const synq::compiler::OpenQasm3StreamResult exported = export_into(output);
+    const bool closed = output.close();
+    if (!exported.sink_failed && !exported.ok()) {
+        for (const auto& diagnostic : exported.diagnostics) {
+            console.err << command.source_path << ": error[" << category << "]: " << diagnostic << "\n";
+            // Exporter diagnostics are plain messages; the category stands in
+            // for a code in batch records.
+            if (console.diagnostics != nullptr) {
+                synq::compiler::Diagnostic recorded;
+                recorded.code = category;
+                recorded.message = diagnostic;
+                console.diagnostics->push_back(std::move(recorded));
             }
-            return 5;
         }
-        if (command.output_path.has_value()) {
-            std::ofstream output(*command.output_path, std::ios::binary);
-            if (!output) {
-                std::cerr << "synqc: error: cannot write " << *command.output_path << "\n";
-                return 6;
-            }
-            output << exported.program;
-            if (!output) {
-                std::cerr << "synqc: error: failed while writing " << *command.output_path << "\n";
-                return 6;
-            }
+        return 5;
+    }
+    if (exported.sink_failed || !closed) {
+        if (!command.output_path.has_value()) {
+            console.err << "synqc: error: failed while writing standard output\n";
+        } else if (!output.opened()) {
+            console.err << "synqc: error: cannot write " << *command.output_path << "\n";
         } else {
-            std::cout << exported.program;
+            console.err << "synqc: error: failed while writing " << *command.output_path << "\n";
         }
-        return 0;
+        return 6;
+    }
+    return 0;
+}
+
+// Runs one source in the selected mode and returns its exit status.
+int run_source(Console& console, const Command& command) {
+    // A plan cache whose recorded digest matches the current source replays the
+    // stored plan without parsing, lowering, or resolving the program.
+    std::optional<synq::compiler::SimulationSourceDigest> source_digest;
+    if (command.plan_cache_path.has_value()) {
+        std::string source;
+        std::string stored_plan;
+        if (read_binary_file(command.source_path, source)) {
+            source_digest = synq::compiler::simulation_source_digest(source);
+            if (read_binary_file(*command.plan_cache_path, stored_plan)) {
+                const auto cached = synq::compiler::deserialize_simulation_plan(
+                    stored_plan, simulation_options(command), &*source_digest);
+                if (cached.ok()) return run_simulation_plan(console, command, *cached.plan);
+            }
+        }
+    }
+
+    Parser parser;
+    if (command.mode == Mode::EmitOpenQasm) {
+        const auto parsed = parser.parseFileWithDiagnostics(command.source_path);
+        if (!parsed.ok()) return render_diagnostics(console, command.source_path, parsed.diagnostics, 3);
+        return emit_openqasm3(console, command, "openqasm-export", [&parsed](synq::compiler::OpenQasm3Sink& sink) {
+            return synq::compiler::export_openqasm3(*parsed.program, sink);
+        });
+    }
+
+    // Every other mode starts from Hybrid IR, so skip the whole-program AST.
+    auto lowered = parser.parseFileToHybridIR(command.source_path);
+    if (!lowered.ok()) {
+        return render_diagnostics(console, command.source_path, lowered.diagnostics,
+                                  is_lowering_diagnostic(lowered.diagnostics) ? 4 : 3);
+    }
+    // The side table is enough to validate and to inspect; only the evaluators
+    // and the simulator take the materialized program.
+    auto resolution = synq::compiler::resolve_hybrid_name_table(*lowered.program);
+    if (!resolution.ok()) return render_diagnostics(console, command.source_path, resolution.diagnostics, 4);
+
+    if (command.optimize) {
+        print_optimization_report(console.err, synq::compiler::optimize_hybrid_circuit(*lowered.program));
+    }
+    if (command.schedule) print_scheduling_report(console.err, synq::compiler::reorder_hybrid_circuit(*lowered.program));
+    // Removed and reordered gates shift the node indices the table was built
+    // over.
+    if ((command.optimize || command.schedule) && command.mode == Mode::Simulate) {
+        resolution = synq::compiler::resolve_hybrid_name_table(*lowered.program);
+        if (!resolution.ok()) return render_diagnostics(console, command.source_path, resolution.diagnostics, 4);
+    }
+
+    if (command.mode == Mode::EmitHybridOpenQasm) {
+        return emit_openqasm3(console, command, "hybrid-openqasm-export", [&lowered](synq::compiler::OpenQasm3Sink& sink) {
+            return synq::compiler::export_hybrid_openqasm3(*lowered.program, sink);
+        });
     }
 
     if (command.mode == Mode::Validate) {
-        std::cout << "synqc: valid bounded recovery-profile program: " << command.source_path << "\n";
+        console.out << "synqc: valid bounded recovery-profile program: " << command.source_path << "\n";
         return 0;
     }
 
     if (command.mode == Mode::InspectSemantics) {
-        std::cout << synq::compiler::render_semantic_environment(*resolved.program);
+        console.out << synq::compiler::render_semantic_environment(*lowered.program, *resolution.table);
         return 0;
     }
 
+    const synq::compiler::ResolvedHybridProgram resolved =
+        synq::compiler::materialize_resolved_program(*lowered.program, *resolution.table);
+
     if (command.mode == Mode::Simulate) {
-        synq::compiler::BoundedSimulationOptions options;
-        options.allow_experimental_local_simulation = true;
-        options.max_qubits = command.max_qubits;
-        options.max_operations = command.max_operations;
-        const auto simulation = synq::compiler::simulate_bounded_quantum(*resolved.program, options);
-        if (!simulation.ok()) return render_diagnostics(command.source_path, simulation.diagnostics, 5);
-        std::cout << "qubits = " << simulation.simulation->qubit_count << "\n";
-        for (const auto& register_info : simulation.simulation->registers) {
-            std::cout << "register " << register_info.name << "[" << register_info.qubit_count
-                      << "] physical_offset = " << register_info.physical_offset << "\n";
-        }
-        for (const auto& basis : simulation.simulation->basis_probabilities) {
-            std::cout << "basis |" << basis_label(basis.basis_index, simulation.simulation->qubit_count)
-                      << "> probability = " << basis.probability << "\n";
-        }
-        for (const auto& measurement : simulation.simulation->measurements) {
-            std::cout << "measurement " << measurement.register_name << "[" << measurement.register_index
-                      << "] probability_one = "
-                      << measurement.probability_one << "\n";
+        const auto options = simulation_options(command);
+        if (command.plan_cache_path.has_value()) {
+            const auto prepared = synq::compiler::prepare_bounded_simulation(resolved, options);
+            if (!prepared.ok()) return render_diagnostics(console, command.source_path, prepared.diagnostics, 5);
+            if (source_digest.has_value()) {
+                std::ofstream output(*command.plan_cache_path, std::ios::binary);
+                output << synq::compiler::serialize_simulation_plan(*prepared.plan, *source_digest);
+                if (!output) {
+                    console.err << "synqc: error: cannot write " << *command.plan_cache_path << "\n";
+                    return 6;
+                }
+            }
+            return run_simulation_plan(console, command, *prepared.plan);
         }
+        const auto simulation = synq::compiler::simulate_bounded_quantum(resolved, options);
+        if (!simulation.ok()) return render_diagnostics(console, command.source_path, simulation.diagnostics, 5);
+        print_simulation(console.out, *simulation.simulation);
         return 0;
     }
 
@@ -387,9 +650,9 @@ int main(int argc, char** argv) {
         options.max_state_transitions = command.max_state_transitions;
         options.max_expression_depth = command.max_expression_depth;
         options.max_operations = command.max_state_operations;
-        const auto evaluation = synq::compiler::evaluate_bounded_state(*resolved.program, options);
-        if (!evaluation.ok()) return render_diagnostics(command.source_path, evaluation.diagnostics, 5);
-        for (const auto& cell : evaluation.evaluation->cells) print_state_cell(cell);
+        const auto evaluation = synq::compiler::evaluate_bounded_state(resolved, options);
+        if (!evaluation.ok()) return render_diagnostics(console, command.source_path, evaluation.diagnostics, 5);
+        for (const auto& cell : evaluation.evaluation->cells) print_state_cell(console.out, cell);
         return 0;
     }
 
@@ -401,17 +664,159 @@ int main(int argc, char** argv) {
         options.max_call_depth = command.max_call_depth;
         options.max_expression_depth = command.max_expression_depth;
         options.max_operations = command.max_runtime_operations;
-        const auto evaluation = synq::compiler::evaluate_bounded_runtime(*resolved.program, options);
-        if (!evaluation.ok()) return render_diagnostics(command.source_path, evaluation.diagnostics, 5);
-        for (const auto& binding : evaluation.evaluation->bindings) print_value(binding);
+        const auto evaluation = synq::compiler::evaluate_bounded_runtime(resolved, options);
+        if (!evaluation.ok()) return render_diagnostics(console, command.source_path, evaluation.diagnostics, 5);
+        for (const auto& binding : evaluation.evaluation->bindings) print_value(console.out, binding);
         return 0;
     }
 
     synq::compiler::BoundedEvaluationOptions options;
     options.allow_experimental_constant_evaluation = true;
     options.max_declarations = command.max_declarations;
-    const auto evaluation = synq::compiler::evaluate_bounded_constants(*resolved.program, options);
-    if (!evaluation.ok()) return render_diagnostics(command.source_path, evaluation.diagnostics, 5);
-    for (const auto& binding : evaluation.evaluation->bindings) print_value(binding);
+    const auto evaluation = synq::compiler::evaluate_bounded_constants(resolved, options);
+    if (!evaluation.ok()) return render_diagnostics(console, command.source_path, evaluation.diagnostics, 5);
+    for (const auto& binding : evaluation.evaluation->bindings) print_value(console.out, binding);
     return 0;
 }
+
+// Reads the --batch manifest: one source path per line. Blank lines and lines
+// starting with '#' are skipped, and a trailing carriage return is dropped.
+bool read_manifest(const std::string& path, std::vector<std::string>& sources) {
+    std::ifstream file;
+    if (path != "-") {
+        file.open(path, std::ios::binary);
+        if (!file) return false;
+    }
+    std::istream& input = path == "-" ? std::cin : file;
+    for (std::string line; std::getline(input, line);) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line.front() == '#') continue;
+        sources.push_back(line);
+    }
+    return !input.bad();
+}
+
+void write_json_string(std::ostream& out, std::string_view text) {
+    out << '"';
+    for (const char character : text) {
+        switch (character) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(character) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(character));
+                    out << escaped;
+                } else {
+                    out << character;
+                }
+        }
+    }
+    out << '"';
+}
+
+struct BatchRecord {
+    int status = 0;
+    double seconds = 0.0;
+    std::string out;
+    std::string err;
+    std::vector<synq::compiler::Diagnostic> diagnostics;
+};
+
+void write_batch_record(std::ostream& out, const std::string& source, const BatchRecord& record) {
+    out << "{\"source\":";
+    write_json_string(out, source);
+    out << ",\"status\":" << record.status << ",\"seconds\":" << record.seconds << ",\"diagnostics\":[";
+    for (std::size_t index = 0; index < record.diagnostics.size(); ++index) {
+        const auto& diagnostic = record.diagnostics[index];
+        out << (index == 0 ? "" : ",") << "{\"code\":";
+        write_json_string(out, diagnostic.code);
+        out << ",\"severity\":\"" << synq::compiler::diagnostic_severity_name(diagnostic.severity)
+            << "\",\"line\":" << diagnostic.span.line << ",\"column\":" << diagnostic.span.column_start
+            << ",\"message\":";
+        write_json_string(out, diagnostic.message);
+        out << ",\"help\":";
+        write_json_string(out, diagnostic.help);
+        out << "}";
+    }
+    out << "],\"stdout\":";
+    write_json_string(out, record.out);
+    out << ",\"stderr\":";
+    write_json_string(out, record.err);
+    out << "}\n";
+}
+
+// Sources per pool dispatch. Records are written in manifest order after each
+// window, so memory stays bounded and output starts before the batch ends.
+constexpr std::size_t kBatchWindow = 256;
+
+// Runs every manifest source with the command's mode and options on a pool of
+// --jobs workers, printing one JSON line per source in manifest order. Returns
+// 0 when every source succeeded, otherwise the highest source status.
+int run_batch(const Command& command) {
+    std::vector<std::string> sources;
+    if (!read_manifest(*command.batch_manifest, sources)) {
+        std::cerr << "synqc: error: cannot read batch manifest " << *command.batch_manifest << "\n";
+        return 2;
+    }
+    const auto batch_started = std::chrono::steady_clock::now();
+    synq::compiler::SweepPool pool(command.batch_jobs);
+    std::vector<BatchRecord> records(std::min(sources.size(), kBatchWindow));
+    int status = 0;
+    std::size_t failed = 0;
+    for (std::size_t begin = 0; begin < sources.size(); begin += kBatchWindow) {
+        const std::size_t count = std::min(kBatchWindow, sources.size() - begin);
+        pool.run(count, [&](std::size_t offset) {
+            Command single = command;
+            single.source_path = sources[begin + offset];
+            BatchRecord& record = records[offset];
+            std::ostringstream out;
+            std::ostringstream err;
+            record.diagnostics.clear();
+            Console console{out, err, &record.diagnostics};
+            const auto started = std::chrono::steady_clock::now();
+            record.status = run_source(console, single);
+            record.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+            record.out = out.str();
+            record.err = err.str();
+        });
+        for (std::size_t offset = 0; offset < count; ++offset) {
+            write_batch_record(std::cout, sources[begin + offset], records[offset]);
+            status = std::max(status, records[offset].status);
+            if (records[offset].status != 0) ++failed;
+        }
+        std::cout.flush();
+    }
+    std::cerr << "synqc: batch: " << sources.size() << " sources, " << failed << " failed, "
+              << std::chrono::duration<double>(std::chrono::steady_clock::now() - batch_started).count()
+              << " seconds\n";
+    return status;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 2 && std::string(argv[1]) == "--help") {
+        print_help(std::cout);
+        return 0;
+    }
+    if (argc == 2 && std::string(argv[1]) == "--version") {
+        std::cout << "synqc " << SYNQ_RECOVERY_CLI_VERSION << "\n";
+        return 0;
+    }
+
+    Command command;
+    std::string argument_error;
+    if (!parse_command(argc, argv, command, argument_error)) {
+        std::cerr << "synqc: usage error: " << argument_error << "\n\n";
+        print_help(std::cerr);
+        return 2;
+    }
+
+    if (command.batch_manifest.has_value()) return run_batch(command);
+    Console console{std::cout, std::cerr};
+    return run_source(console, command);
+}